@@ -30,6 +30,7 @@
 #include "PartitionResolver.hpp"
 #include "RegionAttributes.hpp"
 #include "DiskPolicyType.hpp"
+#include "EvictionPolicyType.hpp"
 #include "Pool.hpp"
 
 /**
@@ -287,6 +288,17 @@ class CPPCACHE_EXPORT AttributesFactory {
    */
   void setInitialCapacity(int initialCapacity);
 
+  /** Sets the number of entries the region is expected to hold for the next
+   * <code>RegionAttributes</code> created. The map that holds the entries is
+   * sized up front so that loading that many entries does not have to grow
+   * it. This takes precedence over the initial capacity when it calls for a
+   * larger map. The default is 0, meaning no hint.
+   * @param expectedEntries the expected number of entries
+   * @throws IllegalArgumentException if expectedEntries is negative.
+   * @see Region#reserve
+   */
+  void setExpectedEntries(int expectedEntries);
+
   /** Sets the entry load factor for the next <code>RegionAttributes</code>
    * created. This value is
    * used in initializing the map that holds the entries.
@@ -317,6 +329,17 @@ class CPPCACHE_EXPORT AttributesFactory {
    */
   void setDiskPolicy(const DiskPolicyType::PolicyType diskPolicy);
 
+  /** Sets the way entries are chosen for eviction once the LRU entries
+   * limit is reached, for the next <code>RegionAttributes</code> created.
+   * <code>SAMPLED_LRU</code> keeps no list of the entries and evicts the
+   * least recently used of a few entries sampled at random, which saves
+   * memory and contention on regions with many entries. The default is
+   * <code>LRU</code>.
+   * @param evictionPolicy the type of eviction policy to use for the region
+   * @see RegionAttributes#getEvictionPolicy()
+   */
+  void setEvictionPolicy(const EvictionPolicyType::PolicyType evictionPolicy);
+
   /**
    * Set caching enabled flag for this region. If set to false, then no data is
    * stored
@@ -362,6 +385,17 @@ class CPPCACHE_EXPORT AttributesFactory {
   */
   void setConcurrencyChecksEnabled(bool concurrencyChecksEnabled);
 
+  /**
+  * Enables or disables concurrent reads of the entry map. When enabled,
+  * lookups in a segment of the map do not block each other and wait only
+  * for updates to the same segment, which suits regions that are read far
+  * more often than they are written. Updates pay a small extra cost.
+  * The default is <code>false</code>.
+  * @param concurrentReadsEnabled whether lookups may run concurrently
+  * @see RegionAttributes#getConcurrentReadsEnabled()
+  */
+  void setConcurrentReadsEnabled(bool concurrentReadsEnabled);
+
   // FACTORY METHOD
 
   /** Creates a <code>RegionAttributes</code> with the current settings.
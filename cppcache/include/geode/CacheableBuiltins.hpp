@@ -174,40 +174,75 @@ inline void copyArray(
   }
 }
 
+/**
+ * Read an array of primitive types for <code>CacheableArrayType</code>.
+ * Only byte arrays can be read as a slice of the received message.
+ */
+template <typename TObj>
+inline void readArray(DataInput& input, TObj*& value, int32_t& length,
+                      std::shared_ptr<const uint8_t>& slice,
+                      int32_t& sliceBufferLength) {
+  apache::geode::client::serializer::readObject(input, value, length);
+}
+
+inline void readArray(DataInput& input, uint8_t*& value, int32_t& length,
+                      std::shared_ptr<const uint8_t>& slice,
+                      int32_t& sliceBufferLength) {
+  input.readBytesSlice(&value, &length, slice, &sliceBufferLength);
+}
+
 /** Template class for array of primitive types. */
 template <typename TObj, int8_t TYPEID>
 class CacheableArrayType : public Cacheable {
  protected:
   TObj* m_value;
   int32_t m_length;
+  // when set m_value points into a received message kept alive by this,
+  // of which the whole m_sliceBufferLength bytes are held on to
+  std::shared_ptr<const uint8_t> m_slice;
+  int32_t m_sliceBufferLength;
+
+  inline void releaseValue() {
+    if (m_slice == nullptr) {
+      GF_SAFE_DELETE_ARRAY(m_value);
+    } else {
+      m_value = nullptr;
+      m_slice.reset();
+      m_sliceBufferLength = 0;
+    }
+  }
 
-  inline CacheableArrayType() : m_value(nullptr), m_length(0) {}
+  inline CacheableArrayType()
+      : m_value(nullptr), m_length(0), m_sliceBufferLength(0) {}
 
-  inline CacheableArrayType(int32_t length) : m_length(length) {
+  inline CacheableArrayType(int32_t length)
+      : m_length(length), m_sliceBufferLength(0) {
     if (length > 0) {
       GF_NEW(m_value, TObj[length]);
     }
   }
 
   inline CacheableArrayType(TObj* value, int32_t length)
-      : m_value(value), m_length(length) {}
+      : m_value(value), m_length(length), m_sliceBufferLength(0) {}
 
   inline CacheableArrayType(const TObj* value, int32_t length, bool copy)
-      : m_value(nullptr), m_length(length) {
+      : m_value(nullptr), m_length(length), m_sliceBufferLength(0) {
     if (length > 0) {
       GF_NEW(m_value, TObj[length]);
       copyArray(m_value, value, length);
     }
   }
 
-  virtual ~CacheableArrayType() { GF_SAFE_DELETE_ARRAY(m_value); }
+  virtual ~CacheableArrayType() { releaseValue(); }
 
   FRIEND_STD_SHARED_PTR(CacheableArrayType)
 
  private:
   // Private to disable copy constructor and assignment operator.
   CacheableArrayType(const CacheableArrayType& other)
-      : m_value(other.m_value), m_length(other.m_length) {}
+      : m_value(other.m_value),
+        m_length(other.m_length),
+        m_sliceBufferLength(0) {}
 
   CacheableArrayType& operator=(const CacheableArrayType& other) {
     return *this;
@@ -238,8 +273,8 @@ class CacheableArrayType : public Cacheable {
 
   /** Deserialize this object from the given <code>DataInput</code>. */
   virtual void fromData(DataInput& input) {
-    GF_SAFE_DELETE_ARRAY(m_value);
-    apache::geode::client::serializer::readObject(input, m_value, m_length);
+    releaseValue();
+    readArray(input, m_value, m_length, m_slice, m_sliceBufferLength);
   }
 
   /**
@@ -267,6 +302,11 @@ class CacheableArrayType : public Cacheable {
    * cache memory utilization.
    */
   virtual uint32_t objectSize() const {
+    if (m_slice != nullptr) {
+      // the array cannot be freed without the rest of the message
+      return static_cast<uint32_t>(sizeof(CacheableArrayType) +
+                                   m_sliceBufferLength);
+    }
     return static_cast<uint32_t>(
         sizeof(CacheableArrayType) +
         apache::geode::client::serializer::objectSize(m_value, m_length));
@@ -24,6 +24,7 @@
 #include "ExceptionTypes.hpp"
 #include <cstring>
 #include <string>
+#include <memory>
 #include "geode_types.hpp"
 #include "Serializable.hpp"
 #include "CacheableString.hpp"
@@ -48,6 +49,7 @@ extern int gf_sprintf(char* buffer, const char* fmt, ...);
 
 class SerializationRegistry;
 class DataInputInternal;
+class ReceiveBuffer;
 
 /**
  * Provide operations for reading primitive data values, byte arrays,
@@ -149,6 +151,19 @@ class CPPCACHE_EXPORT DataInput {
     *bytes = buffer;
   }
 
+  /*
+   * This is for internal use.
+   * Read an array of unsigned bytes like <code>readBytes</code>. When this
+   * <code>DataInput</code> reads a shared receive buffer and the array is
+   * large enough, the array is not copied: bytes then points into the buffer,
+   * slice is set to keep the buffer alive and bufferLength to the length of
+   * the whole buffer. Otherwise the array is allocated as in
+   * <code>readBytes</code>, slice is reset and bufferLength set to 0.
+   */
+  void readBytesSlice(uint8_t** bytes, int32_t* len,
+                      std::shared_ptr<const uint8_t>& slice,
+                      int32_t* bufferLength);
+
   /**
    * Read an array of signed bytes from the <code>DataInput</code>
    * expecting to find the length of array in the stream at the start.
@@ -353,6 +368,52 @@ class CPPCACHE_EXPORT DataInput {
     *value = v.d;
   }
 
+  /**
+   * Read an array of big-endian 16-bit signed integers without a length
+   * from the <code>DataInput</code>. This is equivalent to but faster than
+   * calling <code>readInt</code> for each element.
+   *
+   * @param values output array of at least length elements
+   * @param length the number of elements to be read
+   */
+  void readInts(int16_t* values, int32_t length);
+
+  /**
+   * Read an array of big-endian 32-bit signed integers without a length
+   * from the <code>DataInput</code>.
+   *
+   * @param values output array of at least length elements
+   * @param length the number of elements to be read
+   */
+  void readInts(int32_t* values, int32_t length);
+
+  /**
+   * Read an array of big-endian 64-bit signed integers without a length
+   * from the <code>DataInput</code>.
+   *
+   * @param values output array of at least length elements
+   * @param length the number of elements to be read
+   */
+  void readInts(int64_t* values, int32_t length);
+
+  /**
+   * Read an array of float values written by
+   * <code>DataOutput::writeFloats</code> from the <code>DataInput</code>.
+   *
+   * @param values output array of at least length elements
+   * @param length the number of elements to be read
+   */
+  void readFloats(float* values, int32_t length);
+
+  /**
+   * Read an array of double values written by
+   * <code>DataOutput::writeDoubles</code> from the <code>DataInput</code>.
+   *
+   * @param values output array of at least length elements
+   * @param length the number of elements to be read
+   */
+  void readDoubles(double* values, int32_t length);
+
   /**
    * free the C string allocated by <code>readASCII</code>,
    * <code>readASCIIHuge</code>, <code>readUTF</code>,
@@ -451,10 +512,8 @@ class CPPCACHE_EXPORT DataInput {
     char* str;
     GF_NEW(str, char[decodedLen + 1]);
     *value = str;
-    for (uint16_t i = 0; i < decodedLen; i++) {
-      decodeChar(str++);
-    }
-    *str = '\0';  // null terminate for c-string.
+    decodeUTF(str, decodedLen);
+    str[decodedLen] = '\0';  // null terminate for c-string.
   }
 
   /**
@@ -470,10 +529,8 @@ class CPPCACHE_EXPORT DataInput {
     wchar_t* str;
     GF_NEW(str, wchar_t[decodedLen + 1]);
     *value = str;
-    for (uint16_t i = 0; i < decodedLen; i++) {
-      decodeChar(str++);
-    }
-    *str = L'\0';  // null terminate for c-string.
+    decodeUTF(str, decodedLen);
+    str[decodedLen] = L'\0';  // null terminate for c-string.
   }
 
   /**
@@ -499,14 +556,9 @@ class CPPCACHE_EXPORT DataInput {
     char* str;
     GF_NEW(str, char[length + 1]);
     *value = str;
-    for (uint32_t i = 0; i < length; i++) {
-      int8_t item;
-      read(&item);  // ignore this - should be higher order zero byte
-      read(&item);
-      *str = item;
-      str++;
-    }
-    *str = '\0';  // null terminate for c-string.
+    // the higher order byte of each character should be zero and is ignored
+    decodeUTF16(str, length);
+    str[length] = '\0';  // null terminate for c-string.
   }
 
   /**
@@ -537,10 +589,8 @@ class CPPCACHE_EXPORT DataInput {
     wchar_t* str;
     GF_NEW(str, wchar_t[decodedLen + 1]);
     *value = str;
-    for (uint16_t i = 0; i < decodedLen; i++) {
-      decodeChar(str++);
-    }
-    *str = L'\0';  // null terminate for c-string.
+    decodeUTF(str, decodedLen);
+    str[decodedLen] = L'\0';  // null terminate for c-string.
   }
 
   /**
@@ -566,16 +616,8 @@ class CPPCACHE_EXPORT DataInput {
     wchar_t* str;
     GF_NEW(str, wchar_t[length + 1]);
     *value = str;
-    for (uint32_t i = 0; i < length; i++) {
-      uint8_t hibyte;
-      read(&hibyte);
-      uint8_t lobyte;
-      read(&lobyte);
-      *str = ((static_cast<uint16_t>(hibyte)) << 8) |
-             static_cast<uint16_t>(lobyte);
-      str++;
-    }
-    *str = L'\0';  // null terminate for c-string.
+    decodeUTF16(str, length);
+    str[length] = L'\0';  // null terminate for c-string.
   }
 
   /**
@@ -724,23 +766,23 @@ class CPPCACHE_EXPORT DataInput {
   }
 
   inline void readShortArray(int16_t** value, int32_t& length) {
-    readObject(value, length);
+    readNumberArray(value, length);
   }
 
   inline void readIntArray(int32_t** value, int32_t& length) {
-    readObject(value, length);
+    readNumberArray(value, length);
   }
 
   inline void readLongArray(int64_t** value, int32_t& length) {
-    readObject(value, length);
+    readNumberArray(value, length);
   }
 
   inline void readFloatArray(float** value, int32_t& length) {
-    readObject(value, length);
+    readNumberArray(value, length);
   }
 
   inline void readDoubleArray(double** value, int32_t& length) {
-    readObject(value, length);
+    readNumberArray(value, length);
   }
 
   inline void readString(char** value) {
@@ -868,31 +910,7 @@ class CPPCACHE_EXPORT DataInput {
    * @return The length of the decoded string.
    * @see DataOutput::getEncodedLength
    */
-  static int32_t getDecodedLength(const uint8_t* value, int32_t length) {
-    const uint8_t* end = value + length;
-    int32_t decodedLen = 0;
-    while (value < end) {
-      // get next byte unsigned
-      int32_t b = *value++ & 0xff;
-      int32_t k = b >> 5;
-      // classify based on the high order 3 bits
-      switch (k) {
-        case 6: {
-          value++;
-          break;
-        }
-        case 7: {
-          value += 2;
-          break;
-        }
-        default:
-          break;
-      }
-      decodedLen += 1;
-    }
-    if (value > end) decodedLen--;
-    return decodedLen;
-  }
+  static int32_t getDecodedLength(const uint8_t* value, int32_t length);
 
   /** destructor */
   ~DataInput() {}
@@ -960,6 +978,15 @@ class CPPCACHE_EXPORT DataInput {
    */
   void setPoolName(const char* poolName) { m_poolName = poolName; }
 
+  /*
+   * This is for internal use.
+   * Set the reference counted buffer that this input reads, which allows
+   * readBytesSlice() to alias it.
+   */
+  void setReceiveBuffer(const std::shared_ptr<ReceiveBuffer>& buffer) {
+    m_receiveBuffer = buffer;
+  }
+
   virtual const Cache* getCache();
 
  protected:
@@ -979,6 +1006,7 @@ class CPPCACHE_EXPORT DataInput {
   int32_t m_bufLength;
   const char* m_poolName;
   const Cache* m_cache;
+  std::shared_ptr<ReceiveBuffer> m_receiveBuffer;
 
   void readObjectInternal(SerializablePtr& ptr, int8_t typeId = -1);
 
@@ -1000,6 +1028,39 @@ class CPPCACHE_EXPORT DataInput {
     }
   }
 
+  // like readObject(mType**, int32_t&) but reading the elements in bulk
+  template <typename mType>
+  void readNumberArray(mType** value, int32_t& length) {
+    int arrayLen;
+    readArrayLen(&arrayLen);
+    length = arrayLen;
+    if (arrayLen > 0) {
+      std::unique_ptr<mType[]> objArray(new mType[arrayLen]);
+      readNumbers(objArray.get(), arrayLen);
+      *value = objArray.release();
+    }
+  }
+
+  inline void readNumbers(int16_t* values, int32_t length) {
+    readInts(values, length);
+  }
+
+  inline void readNumbers(int32_t* values, int32_t length) {
+    readInts(values, length);
+  }
+
+  inline void readNumbers(int64_t* values, int32_t length) {
+    readInts(values, length);
+  }
+
+  inline void readNumbers(float* values, int32_t length) {
+    readFloats(values, length);
+  }
+
+  inline void readNumbers(double* values, int32_t length) {
+    readDoubles(values, length);
+  }
+
   inline void readPdxChar(char* value) {
     int16_t val = 0;
     readInt(&val);
@@ -1017,6 +1078,19 @@ class CPPCACHE_EXPORT DataInput {
     }
   }
 
+  // decode length characters; runs of ASCII characters take a vectorized
+  // path
+  void decodeUTF(char* str, uint32_t length);
+  void decodeUTF(wchar_t* str, uint32_t length);
+
+  // read length big-endian UTF-16 code units
+  void decodeUTF16(char* str, uint32_t length);
+  void decodeUTF16(wchar_t* str, uint32_t length);
+
+  // check that length elements of elementSize bytes can be read, returning
+  // where they start and skipping past them
+  const uint8_t* readArrayBytes(int32_t length, int32_t elementSize);
+
   inline void decodeChar(char* str) {
     uint8_t bt = *(m_buf++);
     if (bt & 0x80) {
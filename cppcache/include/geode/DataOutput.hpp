@@ -29,6 +29,7 @@
 #include <cstring>
 #include <string>
 #include <cstdlib>
+#include <vector>
 
 /**
  * @file
@@ -278,6 +279,52 @@ class CPPCACHE_EXPORT DataOutput {
     writeInt(v.ll);
   }
 
+  /**
+   * Write an array of 16-bit signed integers to the <code>DataOutput</code>
+   * in big-endian order without a length. This is equivalent to but faster
+   * than calling <code>writeInt</code> for each element.
+   *
+   * @param values the array of integers to be written
+   * @param length the number of elements to be written
+   */
+  void writeInts(const int16_t* values, int32_t length);
+
+  /**
+   * Write an array of 32-bit signed integers to the <code>DataOutput</code>
+   * in big-endian order without a length.
+   *
+   * @param values the array of integers to be written
+   * @param length the number of elements to be written
+   */
+  void writeInts(const int32_t* values, int32_t length);
+
+  /**
+   * Write an array of 64-bit signed integers to the <code>DataOutput</code>
+   * in big-endian order without a length.
+   *
+   * @param values the array of integers to be written
+   * @param length the number of elements to be written
+   */
+  void writeInts(const int64_t* values, int32_t length);
+
+  /**
+   * Write an array of float values to the <code>DataOutput</code> without a
+   * length, each as if by <code>writeFloat</code>.
+   *
+   * @param values the array of float values to be written
+   * @param length the number of elements to be written
+   */
+  void writeFloats(const float* values, int32_t length);
+
+  /**
+   * Write an array of double values to the <code>DataOutput</code> without
+   * a length, each as if by <code>writeDouble</code>.
+   *
+   * @param values the array of double values to be written
+   * @param length the number of elements to be written
+   */
+  void writeDoubles(const double* values, int32_t length);
+
   /**
    * Writes the given ASCII string supporting maximum length of 64K
    * (i.e. unsigned 16-bit integer).
@@ -344,15 +391,12 @@ class CPPCACHE_EXPORT DataOutput {
    */
   inline void writeFullUTF(const char* value, uint32_t length = 0) {
     if (value != nullptr) {
-      int32_t encodedLen = getEncodedLength(value, length);
+      uint32_t valLength;
+      int32_t encodedLen = getEncodedLength(value, length, &valLength);
       writeInt(encodedLen);
       ensureCapacity(encodedLen);
       write(static_cast<int8_t>(0));  // isObject = 0 BYTE_CODE
-      uint8_t* end = m_buf + encodedLen;
-      while (m_buf < end) {
-        encodeChar(*value++);
-      }
-      if (m_buf > end) m_buf = end;
+      encodeUTF(value, valLength, m_buf + encodedLen);
     } else {
       writeInt(static_cast<uint16_t>(0));
     }
@@ -371,15 +415,12 @@ class CPPCACHE_EXPORT DataOutput {
    */
   inline void writeUTF(const char* value, uint32_t length = 0) {
     if (value != nullptr) {
-      int32_t len = getEncodedLength(value, length);
+      uint32_t valLength;
+      int32_t len = getEncodedLength(value, length, &valLength);
       uint16_t encodedLen = static_cast<uint16_t>(len > 0xFFFF ? 0xFFFF : len);
       writeInt(encodedLen);
       ensureCapacity(encodedLen);
-      uint8_t* end = m_buf + encodedLen;
-      while (m_buf < end) {
-        encodeChar(*value++);
-      }
-      if (m_buf > end) m_buf = end;
+      encodeUTF(value, valLength, m_buf + encodedLen);
     } else {
       writeInt(static_cast<uint16_t>(0));
     }
@@ -404,10 +445,7 @@ class CPPCACHE_EXPORT DataOutput {
       }
       writeInt(length);
       ensureCapacity(length * 2);
-      for (uint32_t pos = 0; pos < length; pos++) {
-        writeNoCheck(static_cast<int8_t>(0));
-        writeNoCheck(static_cast<int8_t>(value[pos]));
-      }
+      encodeUTF16(value, length);
     } else {
       writeInt(static_cast<uint32_t>(0));
     }
@@ -426,15 +464,12 @@ class CPPCACHE_EXPORT DataOutput {
    */
   inline void writeUTF(const wchar_t* value, uint32_t length = 0) {
     if (value != nullptr) {
-      int32_t len = getEncodedLength(value, length);
+      uint32_t valLength;
+      int32_t len = getEncodedLength(value, length, &valLength);
       uint16_t encodedLen = static_cast<uint16_t>(len > 0xFFFF ? 0xFFFF : len);
       writeInt(encodedLen);
       ensureCapacity(encodedLen);
-      uint8_t* end = m_buf + encodedLen;
-      while (m_buf < end) {
-        encodeChar(*value++);
-      }
-      if (m_buf > end) m_buf = end;
+      encodeUTF(value, valLength, m_buf + encodedLen);
     } else {
       writeInt(static_cast<uint16_t>(0));
     }
@@ -457,11 +492,7 @@ class CPPCACHE_EXPORT DataOutput {
       }
       writeInt(length);
       ensureCapacity(length * 2);
-      for (uint32_t pos = 0; pos < length; pos++) {
-        uint16_t item = static_cast<uint16_t>(value[pos]);
-        writeNoCheck(static_cast<uint8_t>((item & 0xFF00) >> 8));
-        writeNoCheck(static_cast<uint8_t>(item & 0xFF));
-      }
+      encodeUTF16(value, length);
     } else {
       writeInt(static_cast<uint32_t>(0));
     }
@@ -477,30 +508,8 @@ class CPPCACHE_EXPORT DataOutput {
    *         UTF-8 format.
    * @see DataInput::getDecodedLength
    */
-  inline static int32_t getEncodedLength(const char* value, int32_t length = 0,
-                                         uint32_t* valLength = nullptr) {
-    if (value == nullptr) return 0;
-    char currentChar;
-    int32_t encodedLen = 0;
-    const char* start = value;
-    if (length == 0) {
-      while ((currentChar = *value) != '\0') {
-        getEncodedLength(currentChar, encodedLen);
-        value++;
-      }
-    } else {
-      const char* end = value + length;
-      while (value < end) {
-        currentChar = *value;
-        getEncodedLength(currentChar, encodedLen);
-        value++;
-      }
-    }
-    if (valLength != nullptr) {
-      *valLength = static_cast<uint32_t>(value - start);
-    }
-    return encodedLen;
-  }
+  static int32_t getEncodedLength(const char* value, int32_t length = 0,
+                                  uint32_t* valLength = nullptr);
 
   /**
    * Get the length required to represent a given wide-character string in
@@ -512,31 +521,8 @@ class CPPCACHE_EXPORT DataOutput {
    *         UTF-8 format.
    * @see DataInput::getDecodedLength
    */
-  inline static int32_t getEncodedLength(const wchar_t* value,
-                                         int32_t length = 0,
-                                         uint32_t* valLength = nullptr) {
-    if (value == nullptr) return 0;
-    wchar_t currentChar;
-    int32_t encodedLen = 0;
-    const wchar_t* start = value;
-    if (length == 0) {
-      while ((currentChar = *value) != 0) {
-        getEncodedLength(currentChar, encodedLen);
-        value++;
-      }
-    } else {
-      const wchar_t* end = value + length;
-      while (value < end) {
-        currentChar = *value;
-        getEncodedLength(currentChar, encodedLen);
-        value++;
-      }
-    }
-    if (valLength != nullptr) {
-      *valLength = static_cast<uint32_t>(value - start);
-    }
-    return encodedLen;
-  }
+  static int32_t getEncodedLength(const wchar_t* value, int32_t length = 0,
+                                  uint32_t* valLength = nullptr);
 
   /**
    * Write a <code>Serializable</code> object to the <code>DataOutput</code>.
@@ -639,20 +625,58 @@ class CPPCACHE_EXPORT DataOutput {
     return static_cast<uint32_t>(m_buf - m_bytes);
   }
 
+  /*
+   * This is for internal use.
+   * Append len bytes owned by owner to the stream without copying them into
+   * the internal buffer, the counterpart of <code>writeBytesOnly</code> for
+   * large payloads. The bytes are kept at the current position of the cursor;
+   * the buffer before that position may still be overwritten in place but the
+   * cursor must not be left behind it. The referenced bytes are not part of
+   * getBufferLength() and must not be modified until the stream is sent or
+   * flattened.
+   */
+  void writeBytesReference(const uint8_t* bytes, uint32_t len,
+                           const SerializablePtr& owner);
+
+  /*
+   * This is for internal use.
+   * Total length of the bytes appended by writeBytesReference().
+   */
+  inline uint32_t getReferencedLength() const { return m_referencedLength; }
+
+  /*
+   * This is for internal use.
+   * Number of segments making up the stream: the internal buffer is split at
+   * every referenced payload, so this is twice the number of payloads plus one.
+   */
+  inline uint32_t getSegmentCount() const {
+    return static_cast<uint32_t>(m_references.size()) * 2 + 1;
+  }
+
+  /*
+   * This is for internal use.
+   * Get the segment at the given index in stream order; its length, which
+   * may be zero, is filled in the length output parameter.
+   */
+  const uint8_t* getSegment(uint32_t index, uint32_t* length) const;
+
+  /*
+   * This is for internal use.
+   * Copy all referenced payloads into the internal buffer so that
+   * getBuffer() holds the whole stream.
+   */
+  void flatten();
+
   /**
    * Reset the internal cursor to the start of the buffer.
    */
   inline void reset() {
+    m_references.clear();
+    m_referencedLength = 0;
     if (m_haveBigBuffer) {
-      // free existing buffer
-      std::free(m_bytes);
-      // create smaller buffer
-      m_bytes = (uint8_t *) std::malloc(m_lowWaterMark* sizeof(uint8_t));
-      if (m_bytes == nullptr) {
-        throw OutOfMemoryException(
-            "Out of Memory while resizing buffer");
-      }
-      m_size = m_lowWaterMark;
+      // give back the big buffer and start over with a small one
+      DataOutput::checkinBuffer(m_bytes, m_size);
+      m_bytes = DataOutput::checkoutBuffer(&m_size);
       // reset the flag
       m_haveBigBuffer = false;
       // release the lock
@@ -665,22 +689,7 @@ class CPPCACHE_EXPORT DataOutput {
   inline void ensureCapacity(uint32_t size) {
     uint32_t offset = static_cast<uint32_t>(m_buf - m_bytes);
     if ((m_size - offset) < size) {
-      uint32_t newSize = m_size * 2 + (8192 * (size / 8192));
-      if (newSize >= m_highWaterMark && !m_haveBigBuffer) {
-        // acquire the lock
-        acquireLock();
-        // set flag
-        m_haveBigBuffer = true;
-      }
-      m_size = newSize;
-
-      auto tmp = (uint8_t *) std::realloc(m_bytes, m_size * sizeof(uint8_t));
-      if (tmp == nullptr) {
-        throw OutOfMemoryException(
-            "Out of Memory while resizing buffer");
-      }
-      m_bytes = tmp;
-      m_buf = m_bytes + offset;
+      growBuffer(size);
     }
   }
 
@@ -736,6 +745,16 @@ class CPPCACHE_EXPORT DataOutput {
   volatile bool m_haveBigBuffer;
   const Cache* m_cache;
 
+  // a payload written by reference, kept at offset in m_bytes
+  struct ReferencedBytes {
+    uint32_t m_offset;
+    const uint8_t* m_bytes;
+    uint32_t m_length;
+    SerializablePtr m_owner;
+  };
+  std::vector<ReferencedBytes> m_references;
+  uint32_t m_referencedLength;
+
   inline static void getEncodedLength(const char val, int32_t& encodedLen) {
     if ((val == 0) || (val & 0x80)) {
       // two byte.
@@ -789,6 +808,15 @@ class CPPCACHE_EXPORT DataOutput {
     }
   }
 
+  // encode length characters up to the end of the buffer reserved for them;
+  // runs of ASCII characters take a vectorized path
+  void encodeUTF(const char* value, uint32_t length, uint8_t* end);
+  void encodeUTF(const wchar_t* value, uint32_t length, uint8_t* end);
+
+  // write length characters as big-endian UTF-16 code units
+  void encodeUTF16(const char* value, uint32_t length);
+  void encodeUTF16(const wchar_t* value, uint32_t length);
+
   inline void writeNoCheck(uint8_t value) { *(m_buf++) = value; }
 
   inline void writeNoCheck(int8_t value) {
@@ -797,6 +825,7 @@ class CPPCACHE_EXPORT DataOutput {
 
   static uint8_t* checkoutBuffer(uint32_t* size);
   static void checkinBuffer(uint8_t* buffer, uint32_t size);
+  void growBuffer(uint32_t size);
 
   // disable copy constructor and assignment
   DataOutput(const DataOutput&);
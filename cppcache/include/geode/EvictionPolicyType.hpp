@@ -0,0 +1,75 @@
+#pragma once
+
+#ifndef GEODE_EVICTIONPOLICYTYPE_H_
+#define GEODE_EVICTIONPOLICYTYPE_H_
+
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ */
+#include "geode_globals.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+/**
+ * @class EvictionPolicyType EvictionPolicyType.hpp
+ * Enumerated type for the way entries are chosen for eviction once the
+ * LRU entries limit of a region is reached.
+ * @see RegionAttributes::getEvictionPolicy
+ * @see AttributesFactory::setEvictionPolicy
+ */
+class CPPCACHE_EXPORT EvictionPolicyType {
+  // public static methods
+ public:
+  /**
+   * Values for setting PolicyType.
+   * <code>LRU</code> keeps the entries in a list in the order they were
+   * added and skips the ones used since. <code>SAMPLED_LRU</code> keeps no
+   * list; it looks at a few entries picked at random and evicts the one
+   * used least recently, which saves the memory of the list and its
+   * locking at the price of a less exact order. <code>TINY_LFU</code>
+   * estimates how often the keys are used; new entries go to a small LRU
+   * window and, once out of it, only take the place of the least recently
+   * used of the other entries if their key is used more often, so that a
+   * scan of many keys does not flush out the frequently used ones.
+   */
+  typedef enum { LRU = 0, SAMPLED_LRU, TINY_LFU } PolicyType;
+
+  /** Returns the name of the eviction policy represented by the ordinal. */
+  static const char* fromOrdinal(const uint8_t ordinal);
+
+  /** Returns the type of the eviction policy represented by name. */
+  static PolicyType fromName(const char* name);
+
+  /** Return whether this is <code>SAMPLED_LRU</code>. */
+  inline static bool isSampled(const PolicyType type) {
+    return (type == EvictionPolicyType::SAMPLED_LRU);
+  }
+
+ private:
+  /** No instance allowed. */
+  EvictionPolicyType(){};
+  static const char* names[];
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_EVICTIONPOLICYTYPE_H_
@@ -33,6 +33,14 @@
 #define MAX_PAGE_COUNT "MaxPageCount"
 #define PAGE_SIZE "PageSize"
 #define PERSISTENCE_DIR "PersistenceDirectory"
+/** overflowed entries written to disk together, 0 writes each at once */
+#define WRITE_BATCH_SIZE "WriteBatchSize"
+/** the longest time in milliseconds an overflowed entry waits for its batch */
+#define WRITE_BATCH_LATENCY "WriteBatchLatency"
+/** the size in bytes of the files of an overflow log */
+#define SEGMENT_SIZE "SegmentSize"
+/** the percentage of dead records that has an overflow log file compacted */
+#define COMPACTION_THRESHOLD "CompactionThreshold"
 
 namespace apache {
 namespace geode {
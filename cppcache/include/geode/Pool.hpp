@@ -88,6 +88,11 @@ class CPPCACHE_EXPORT Pool : public std::enable_shared_from_this<Pool> {
    * @see PoolFactory#setMaxConnections(int)
    */
   int getMaxConnections() const;
+  /**
+   * Gets the maximum number of requests in flight on a connection.
+   * @see PoolFactory#setMaxRequestsPerConnection(int)
+   */
+  int getMaxRequestsPerConnection() const;
   /**
    * Gets the idle connection timeout for this pool.
    * @see PoolFactory#setIdleTimeout(long)
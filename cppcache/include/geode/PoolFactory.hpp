@@ -105,6 +105,12 @@ class CPPCACHE_EXPORT PoolFactory {
    */
   static const int DEFAULT_MAX_CONNECTIONS = -1;
 
+  /**
+   * The default maximum number of requests in flight on a connection.
+   * <p>Current value: <code>1</code>.
+   */
+  static const int DEFAULT_MAX_REQUESTS_PER_CONNECTION = 1;
+
   /**
    * The default amount of time in milliseconds, to wait for a connection to
    * become idle.
@@ -298,6 +304,22 @@ class CPPCACHE_EXPORT PoolFactory {
    */
   void setMaxConnections(int maxConnections);
 
+  /**
+   * Sets the maximum number of requests that may be in flight on a single
+   * client to server connection. With more than one, simple operations on
+   * keys such as get, put, destroy, invalidate and containsKey share one
+   * connection per server, sending their requests without waiting for the
+   * replies to earlier ones, instead of each taking a connection of the pool
+   * for the whole round trip. Other operations, operations in a transaction
+   * and pools with security or multiuser mode keep using a pool connection
+   * of their own.
+   * @param maxRequests is the maximum number of requests in flight on a
+   * connection. <code>1</code>, the default, disables sharing connections.
+   * @throws IllegalArgumentException if <code>maxRequests</code>
+   * is less than <code>1</code>.
+   */
+  void setMaxRequestsPerConnection(int maxRequests);
+
   /**
    * Sets the amount of time a connection can be idle before expiring the
    * connection.
@@ -45,6 +45,9 @@
 #include "AttributesFactory.hpp"
 #include "CacheableKey.hpp"
 #include "Query.hpp"
+
+#include <future>
+
 #define DEFAULT_RESPONSE_TIMEOUT 15
 
 namespace apache {
@@ -382,6 +385,53 @@ class CPPCACHE_EXPORT Region : public std::enable_shared_from_this<Region> {
     put(key, createValue(value), arg);
   }
 
+  /**
+   * Starts a <code>get</code> of the value for the given key and returns
+   * without waiting for it. The value, or the exception <code>get</code>
+   * would have thrown, is delivered through the returned future.
+   *
+   * This only moves the blocking <code>get</code> off the calling thread:
+   * it runs on one of the <code>max-async-threads</code> threads of the
+   * cache, which it holds until the reply arrives, and is not part of a
+   * transaction of the calling thread. Once all of those threads are busy,
+   * further operations queue for one. Operations not started when the
+   * cache is closed fail with CacheClosedException; closing the cache
+   * waits for those that have started.
+   *
+   * @see get
+   */
+  virtual std::future<CacheablePtr> getAsync(
+      const CacheableKeyPtr& key,
+      const SerializablePtr& aCallbackArgument = nullptr);
+
+  /** Convenience method allowing key to be a const char* */
+  template <class KEYTYPE>
+  inline std::future<CacheablePtr> getAsync(
+      const KEYTYPE& key, const SerializablePtr& callbackArg = nullptr) {
+    return getAsync(createKey(key), callbackArg);
+  }
+
+  /**
+   * Starts a <code>put</code> of the value with the given key and returns
+   * without waiting for it. The returned future becomes ready when the put
+   * completed, or holds the exception <code>put</code> would have thrown.
+   * Asynchronous puts of the same key may complete in any order.
+   *
+   * See getAsync for the threads the operation runs on.
+   *
+   * @see put
+   */
+  virtual std::future<void> putAsync(
+      const CacheableKeyPtr& key, const CacheablePtr& value,
+      const SerializablePtr& aCallbackArgument = nullptr);
+
+  /** Convenience method allowing both key and value to be a const char* */
+  template <class KEYTYPE, class VALUETYPE>
+  inline std::future<void> putAsync(const KEYTYPE& key, const VALUETYPE& value,
+                                    const SerializablePtr& arg = nullptr) {
+    return putAsync(createKey(key), createValue(value), arg);
+  }
+
   /**
    * Places a set of new values in this region with the specified keys
    * given as a map of key/value pairs.
@@ -1311,6 +1361,23 @@ class CPPCACHE_EXPORT Region : public std::enable_shared_from_this<Region> {
                       bool addToLocalCache = false,
                       const SerializablePtr& aCallbackArgument = nullptr) = 0;
 
+  /**
+   * Reads the values of the given keys that were overflowed to disk back
+   * into memory, several of them in parallel on the threads of the cache,
+   * and returns once all are read. Meant to be called before a batch of
+   * operations on the keys, so the operations do not wait for the disk one
+   * key after the other. Only the client's cache is looked at: keys not in
+   * the region are skipped, and nothing is fetched from the server or a
+   * cache loader. Keys beyond the LRU entries limit of the region evict
+   * each other again, so the key set should fit within the limit.
+   *
+   * Does nothing for regions that do not overflow to disk.
+   *
+   * @param keys the keys of the values to read from disk
+   * @throws RegionDestroyedException If region destroy is pending.
+   */
+  virtual void prefetch(const VectorOfCacheableKey& keys) = 0;
+
   /**
    * Executes the query on the server based on the predicate.
    * Valid only for a Native Client region.
@@ -1434,6 +1501,16 @@ class CPPCACHE_EXPORT Region : public std::enable_shared_from_this<Region> {
    */
   virtual uint32_t size() = 0;
 
+  /**
+   * Sizes the local cache of this region up front to hold the given number
+   * of entries, so that a bulk load such as {@link #putAll} does not have to
+   * grow it entry by entry. The local cache is never shrunk.
+   * @param expectedEntries the number of entries the local cache should hold
+   * @throws RegionDestroyedException If region destroy is pending.
+   * @see AttributesFactory#setExpectedEntries
+   */
+  virtual void reserve(uint32_t expectedEntries) = 0;
+
   virtual const PoolPtr& getPool() = 0;
 
   inline CachePtr& getCache() { return m_cache; }
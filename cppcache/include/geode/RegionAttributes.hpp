@@ -34,6 +34,7 @@
 #include "Properties.hpp"
 #include "Serializable.hpp"
 #include "DiskPolicyType.hpp"
+#include "EvictionPolicyType.hpp"
 #include "PersistenceManager.hpp"
 
 namespace apache {
@@ -145,6 +146,13 @@ class CPPCACHE_EXPORT RegionAttributes : public Serializable {
    */
   int getInitialCapacity() const;
 
+  /** Returns the number of entries the entry's local cache is sized for when
+   * the region is created, or 0 if no hint was given.
+   * @return the expected number of entries in the local cache
+   * @see AttributesFactory#setExpectedEntries
+   */
+  int getExpectedEntries() const;
+
   /** Returns the load factor of the entry's local cache.
    * @return the load factor of the entry's local cache
    */
@@ -169,6 +177,14 @@ class CPPCACHE_EXPORT RegionAttributes : public Serializable {
    */
   DiskPolicyType::PolicyType getDiskPolicy() const;
 
+  /** Returns the way entries are chosen for eviction once the LRU entries
+   * limit is reached.
+   *
+   * @return the <code>EvictionPolicyType::PolicyType</code>, default is
+   * EvictionPolicyType::LRU.
+   */
+  EvictionPolicyType::PolicyType getEvictionPolicy() const;
+
   /**
    * Returns the ExpirationAction used for LRU Eviction, default is
    * LOCAL_DESTROY.
@@ -313,6 +329,13 @@ class CPPCACHE_EXPORT RegionAttributes : public Serializable {
    * @return true if concurrent update checks are turned on
    */
   bool getConcurrencyChecksEnabled() { return m_isConcurrencyChecksEnabled; }
+
+  /**
+   * Returns true if lookups in the entry map of this region run concurrently
+   * with each other and are only serialized against updates.
+   * @see AttributesFactory#setConcurrentReadsEnabled
+   */
+  bool getConcurrentReadsEnabled() const { return m_isConcurrentReadsEnabled; }
   const RegionAttributes& operator=(const RegionAttributes&) = delete;
 
  private:
@@ -337,7 +360,9 @@ class CPPCACHE_EXPORT RegionAttributes : public Serializable {
   void setCachingEnabled(bool enable);
   void setLruEntriesLimit(int limit);
   void setDiskPolicy(DiskPolicyType::PolicyType diskPolicy);
+  void setEvictionPolicy(EvictionPolicyType::PolicyType evictionPolicy);
   void setConcurrencyChecksEnabled(bool enable);
+  void setConcurrentReadsEnabled(bool enable);
   inline bool getEntryExpiryEnabled() const {
     return (m_entryTimeToLive != 0 || m_entryIdleTimeout != 0);
   }
@@ -367,6 +392,7 @@ class CPPCACHE_EXPORT RegionAttributes : public Serializable {
   uint32_t m_regionIdleTimeout;
   uint32_t m_regionTimeToLive;
   uint32_t m_initialCapacity;
+  uint32_t m_expectedEntries;
   float m_loadFactor;
   uint8_t m_concurrencyLevel;
   char* m_cacheLoaderLibrary;
@@ -378,6 +404,7 @@ class CPPCACHE_EXPORT RegionAttributes : public Serializable {
   char* m_cacheListenerFactory;
   char* m_partitionResolverFactory;
   DiskPolicyType::PolicyType m_diskPolicy;
+  EvictionPolicyType::PolicyType m_evictionPolicy;
   char* m_endpoints;
   bool m_clientNotificationEnabled;
   char* m_persistenceLibrary;
@@ -387,6 +414,7 @@ class CPPCACHE_EXPORT RegionAttributes : public Serializable {
   char* m_poolName;
   bool m_isClonable;
   bool m_isConcurrencyChecksEnabled;
+  bool m_isConcurrentReadsEnabled;
   friend class AttributesFactory;
   friend class AttributesMutator;
   friend class Cache;
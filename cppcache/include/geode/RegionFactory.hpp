@@ -176,6 +176,15 @@ class CPPCACHE_EXPORT RegionFactory {
    */
   RegionFactory& setInitialCapacity(int initialCapacity);
 
+  /** Sets the number of entries the region is expected to hold for the next
+   * <code>RegionAttributes</code> created.
+   * @param expectedEntries the expected number of entries
+   * @return a reference to <code>this</code>
+   * @throws IllegalArgumentException if expectedEntries is negative.
+   * @see AttributesFactory#setExpectedEntries
+   */
+  RegionFactory& setExpectedEntries(int expectedEntries);
+
   /** Sets the entry load factor for the next <code>RegionAttributes</code>
    * created. This value is
    * used in initializing the map that holds the entries.
@@ -211,6 +220,15 @@ class CPPCACHE_EXPORT RegionFactory {
    */
   RegionFactory& setDiskPolicy(const DiskPolicyType::PolicyType diskPolicy);
 
+  /** Sets the way entries are chosen for eviction once the LRU entries
+   * limit is reached.
+   * @param evictionPolicy the type of eviction policy to use for the region
+   * @return a reference to <code>this</code>
+   * @see AttributesFactory#setEvictionPolicy
+   */
+  RegionFactory& setEvictionPolicy(
+      const EvictionPolicyType::PolicyType evictionPolicy);
+
   /**
    * Set caching enabled flag for this region. If set to false, then no data is
    * stored
@@ -249,6 +267,14 @@ class CPPCACHE_EXPORT RegionFactory {
    */
   RegionFactory& setConcurrencyChecksEnabled(bool enable);
 
+  /**
+   * Enables or disables concurrent reads of the entry map.
+   * @param enable whether lookups may run concurrently
+   * @return a reference to <code>this</code>
+   * @see AttributesFactory#setConcurrentReadsEnabled
+   */
+  RegionFactory& setConcurrentReadsEnabled(bool enable);
+
   /**
    * Sets time out for tombstones
    * @since 7.0
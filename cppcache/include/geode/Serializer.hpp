@@ -271,6 +271,113 @@ inline void readObject(apache::geode::client::DataInput& input, TObj*& array,
   }
 }
 
+// Arrays of fixed size numbers are converted to big-endian in bulk
+
+inline void writeObject(apache::geode::client::DataOutput& output,
+                        const int16_t* array, int32_t len) {
+  if (array == nullptr) {
+    output.write(static_cast<int8_t>(-1));
+  } else {
+    output.writeArrayLen(len);
+    output.writeInts(array, len);
+  }
+}
+
+inline void readObject(apache::geode::client::DataInput& input, int16_t*& array,
+                       int32_t& len) {
+  input.readArrayLen(&len);
+  if (len > 0) {
+    GF_NEW(array, int16_t[len]);
+    input.readInts(array, len);
+  } else {
+    array = nullptr;
+  }
+}
+
+inline void writeObject(apache::geode::client::DataOutput& output,
+                        const int32_t* array, int32_t len) {
+  if (array == nullptr) {
+    output.write(static_cast<int8_t>(-1));
+  } else {
+    output.writeArrayLen(len);
+    output.writeInts(array, len);
+  }
+}
+
+inline void readObject(apache::geode::client::DataInput& input, int32_t*& array,
+                       int32_t& len) {
+  input.readArrayLen(&len);
+  if (len > 0) {
+    GF_NEW(array, int32_t[len]);
+    input.readInts(array, len);
+  } else {
+    array = nullptr;
+  }
+}
+
+inline void writeObject(apache::geode::client::DataOutput& output,
+                        const int64_t* array, int32_t len) {
+  if (array == nullptr) {
+    output.write(static_cast<int8_t>(-1));
+  } else {
+    output.writeArrayLen(len);
+    output.writeInts(array, len);
+  }
+}
+
+inline void readObject(apache::geode::client::DataInput& input, int64_t*& array,
+                       int32_t& len) {
+  input.readArrayLen(&len);
+  if (len > 0) {
+    GF_NEW(array, int64_t[len]);
+    input.readInts(array, len);
+  } else {
+    array = nullptr;
+  }
+}
+
+inline void writeObject(apache::geode::client::DataOutput& output,
+                        const float* array, int32_t len) {
+  if (array == nullptr) {
+    output.write(static_cast<int8_t>(-1));
+  } else {
+    output.writeArrayLen(len);
+    output.writeFloats(array, len);
+  }
+}
+
+inline void readObject(apache::geode::client::DataInput& input, float*& array,
+                       int32_t& len) {
+  input.readArrayLen(&len);
+  if (len > 0) {
+    GF_NEW(array, float[len]);
+    input.readFloats(array, len);
+  } else {
+    array = nullptr;
+  }
+}
+
+inline void writeObject(apache::geode::client::DataOutput& output,
+                        const double* array, int32_t len) {
+  if (array == nullptr) {
+    output.write(static_cast<int8_t>(-1));
+  } else {
+    output.writeArrayLen(len);
+    output.writeDoubles(array, len);
+  }
+}
+
+inline void readObject(apache::geode::client::DataInput& input, double*& array,
+                       int32_t& len) {
+  input.readArrayLen(&len);
+  if (len > 0) {
+    GF_NEW(array, double[len]);
+    input.readDoubles(array, len);
+  } else {
+    array = nullptr;
+  }
+}
+
 template <typename TObj, typename TLen,
           typename std::enable_if<!std::is_base_of<Serializable, TObj>::value,
                                   Serializable>::type* = nullptr>
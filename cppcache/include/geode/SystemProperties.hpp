@@ -70,6 +70,33 @@ class CPPCACHE_EXPORT SystemProperties {
 
   const uint32_t threadPoolSize() const { return m_threadPoolSize; }
 
+  /**
+   * Returns the number of threads that run the asynchronous region
+   * operations, such as Region::getAsync, and with that the number of them
+   * that can be in progress at once.
+   */
+  const uint32_t asyncThreadPoolSize() const { return m_asyncThreadPoolSize; }
+
+  /**
+   * Returns the number of threads that read the subscription channels and
+   * the replies of pipelined connections of all servers.
+   */
+  const uint32_t ioThreads() const { return m_ioThreads; }
+
+  /**
+   * Returns the number of threads that apply subscription events to the
+   * regions and call the CacheListeners and CqListeners for them, each key
+   * and each CQ seeing its events in order. When 0, the events are applied
+   * one at a time on a single thread.
+   *
+   * When greater than 0, the listeners of a region are called concurrently
+   * for events of different keys, and the CqListeners of different CQs
+   * concurrently; listeners must then be thread safe.
+   */
+  const uint32_t notificationDispatchThreads() const {
+    return m_notificationDispatchThreads;
+  }
+
   /**
    * Returns the sampling interval of the sampling thread.
    * This would be how often the statistics thread writes to disk in seconds.
@@ -154,6 +181,14 @@ class CPPCACHE_EXPORT SystemProperties {
    * it has exceeded the HeapLRULimit. Defaults to 10%
    */
   const int32_t heapLRUDelta() const { return m_heapLRUDelta; }
+
+  /**
+   * Returns the number of threads that evict entries from the regions
+   * when the HeapLRULimit is exceeded. Defaults to 2
+   */
+  const uint32_t heapLRUEvictionThreads() const {
+    return m_heapLRUEvictionThreads;
+  }
   /**
    * Returns  the maximum socket buffer size to use
    */
@@ -268,6 +303,12 @@ class CPPCACHE_EXPORT SystemProperties {
    */
   bool disableChunkHandlerThread() const { return m_disableChunkHandlerThread; }
 
+  /**
+   * Returns the number of threads of each pool that deserialize the chunks
+   * of chunked replies, like those of queries and getAll.
+   */
+  uint32_t chunkHandlerThreads() const { return m_chunkHandlerThreads; }
+
   /**
    * This can be call to know whether read timeout unit is in milli second
    */
@@ -403,6 +444,13 @@ class CPPCACHE_EXPORT SystemProperties {
     return m_tombstoneTimeoutInMSec;
   }
 
+  /**
+   * Returns true if the expiry of entries, regions and tombstones is kept
+   * on a timing wheel with one second buckets rather than on the timer
+   * heap of the expiry thread.
+   */
+  bool expiryTimingWheel() const { return m_expiryTimingWheel; }
+
  private:
   uint32_t m_statisticsSampleInterval;
 
@@ -439,6 +487,7 @@ class CPPCACHE_EXPORT SystemProperties {
 
   int32_t m_heapLRULimit;
   int32_t m_heapLRUDelta;
+  uint32_t m_heapLRUEvictionThreads;
   int32_t m_maxSocketBufferSize;
   int32_t m_pingInterval;
   int32_t m_redundancyMonitorInterval;
@@ -474,9 +523,14 @@ class CPPCACHE_EXPORT SystemProperties {
   char* m_conflateEvents;
 
   uint32_t m_threadPoolSize;
+  uint32_t m_asyncThreadPoolSize;
+  uint32_t m_ioThreads;
+  uint32_t m_notificationDispatchThreads;
   uint32_t m_suspendedTxTimeout;
   uint32_t m_tombstoneTimeoutInMSec;
+  bool m_expiryTimingWheel;
   bool m_disableChunkHandlerThread;
+  uint32_t m_chunkHandlerThreads;
   bool m_readTimeoutUnitInMillis;
   bool m_onClientDisconnectClearPdxTypeIds;
 
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testEntriesMapLoadPerf"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include "CacheHelper.hpp"
+
+/**
+ * Measures how long it takes to putAll ENTRY_COUNT entries into a fresh local
+ * region that starts at the default initial capacity, one that is sized
+ * through the expected-entries attribute, and one that is sized with
+ * Region::reserve() right before the load.
+ */
+
+namespace {
+
+const int ENTRY_COUNT = 10000000;
+const int BATCH_SIZE = 10000;
+
+perf::PerfSuite perfSuite("EntriesMapLoadPerf");
+
+enum Sizing { DEFAULT_CAPACITY, EXPECTED_ENTRIES, RESERVE };
+
+void runLoad(const char* regionName, const char* label, Sizing sizing) {
+  AttributesFactory attrFactory;
+  if (sizing == EXPECTED_ENTRIES) {
+    attrFactory.setExpectedEntries(ENTRY_COUNT);
+  }
+  RegionPtr region = CacheHelper::getHelper().rootRegionPtr->createSubregion(
+      regionName, attrFactory.createRegionAttributes());
+  ASSERT(region != nullptr, "failed to create region.");
+
+  perf::TimeStamp startTime;
+  if (sizing == RESERVE) {
+    region->reserve(ENTRY_COUNT);
+  }
+  for (int batch = 0; batch < ENTRY_COUNT; batch += BATCH_SIZE) {
+    HashMapOfCacheable map;
+    for (int i = batch; i < batch + BATCH_SIZE; i++) {
+      map.emplace(CacheableInt32::create(i), CacheableInt32::create(i));
+    }
+    region->putAll(map);
+  }
+  perf::TimeStamp stopTime;
+
+  ASSERT(region->size() == static_cast<uint32_t>(ENTRY_COUNT),
+         "unexpected region size.");
+  perfSuite.addRecord(label, ENTRY_COUNT, startTime, stopTime);
+
+  region->localDestroyRegion();
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, LoadDefaultCapacity)
+  { runLoad("LoadDefaultCapacity", "default capacity", DEFAULT_CAPACITY); }
+END_TASK(LoadDefaultCapacity)
+
+DUNIT_TASK(s1p1, LoadExpectedEntries)
+  { runLoad("LoadExpectedEntries", "expected entries", EXPECTED_ENTRIES); }
+END_TASK(LoadExpectedEntries)
+
+DUNIT_TASK(s1p1, LoadReserve)
+  { runLoad("LoadReserve", "reserve", RESERVE); }
+END_TASK(LoadReserve)
+
+DUNIT_TASK(s1p1, Finish)
+  {
+    perfSuite.save();
+    CacheHelper::getHelper().disconnect();
+  }
+END_TASK(Finish)
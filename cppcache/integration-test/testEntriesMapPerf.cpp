@@ -0,0 +1,127 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testEntriesMapPerf"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include "CacheHelper.hpp"
+
+/**
+ * Measures local get throughput of the entries map from 1 to MAX_THREADS
+ * threads, once with the default segment locking and once with concurrent
+ * reads enabled. Each thread reads the same small key set so that all of
+ * them hit the same segments; every UPDATE_INTERVAL-th operation is a put so
+ * that readers also have to get past writers.
+ */
+
+namespace {
+
+const int KEY_COUNT = 10000;
+const int OPS_PER_THREAD = 500000;
+const int MAX_THREADS = 64;
+
+perf::PerfSuite perfSuite("EntriesMapPerf");
+
+std::vector<CacheableKeyPtr> g_keys;
+std::atomic<int> g_threadIndex(0);
+
+class GetTask : public perf::Thread {
+ private:
+  RegionPtr m_region;
+  int m_updateInterval;
+
+ public:
+  GetTask(const RegionPtr& region, int updateInterval)
+      : Thread(), m_region(region), m_updateInterval(updateInterval) {}
+
+  virtual void perftask() {
+    // spread the threads over the key set
+    int offset = (g_threadIndex++ * 997) % KEY_COUNT;
+    CacheablePtr value = CacheableInt32::create(0);
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+      const CacheableKeyPtr& key = g_keys[(offset + i * 7) % KEY_COUNT];
+      if (m_updateInterval > 0 && (i % m_updateInterval) == 0) {
+        m_region->put(key, value);
+      } else {
+        m_region->get(key);
+      }
+    }
+  }
+};
+
+void runGets(const char* regionName, const char* label, bool concurrentReads,
+             int updateInterval) {
+  AttributesFactory attrFactory;
+  attrFactory.setInitialCapacity(KEY_COUNT);
+  attrFactory.setConcurrentReadsEnabled(concurrentReads);
+  RegionPtr region = CacheHelper::getHelper().rootRegionPtr->createSubregion(
+      regionName, attrFactory.createRegionAttributes());
+  ASSERT(region != nullptr, "failed to create region.");
+
+  if (g_keys.empty()) {
+    for (int i = 0; i < KEY_COUNT; i++) {
+      g_keys.push_back(CacheableInt32::create(i));
+    }
+  }
+  for (int i = 0; i < KEY_COUNT; i++) {
+    region->put(g_keys[i], CacheableInt32::create(i));
+  }
+
+  for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    GetTask task(region, updateInterval);
+    perf::ThreadLauncher launcher(threads, task);
+    launcher.go();
+
+    char testName[256];
+    ACE_OS::snprintf(testName, 256, "%s, %d threads", label, threads);
+    perfSuite.addRecord(testName, OPS_PER_THREAD * threads,
+                        launcher.startTime(), launcher.stopTime());
+  }
+
+  region->localDestroyRegion();
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, SegmentLockGets)
+  { runGets("SegmentLockGets", "segment lock, gets only", false, 0); }
+END_TASK(SegmentLockGets)
+
+DUNIT_TASK(s1p1, ConcurrentReadGets)
+  { runGets("ConcurrentReadGets", "concurrent reads, gets only", true, 0); }
+END_TASK(ConcurrentReadGets)
+
+DUNIT_TASK(s1p1, SegmentLockMixed)
+  { runGets("SegmentLockMixed", "segment lock, 10% puts", false, 10); }
+END_TASK(SegmentLockMixed)
+
+DUNIT_TASK(s1p1, ConcurrentReadMixed)
+  { runGets("ConcurrentReadMixed", "concurrent reads, 10% puts", true, 10); }
+END_TASK(ConcurrentReadMixed)
+
+DUNIT_TASK(s1p1, Finish)
+  {
+    perfSuite.save();
+    g_keys.clear();
+    CacheHelper::getHelper().disconnect();
+  }
+END_TASK(Finish)
@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testEvictionPolicyHitRatio"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CacheHelper.hpp"
+
+/**
+ * Replays a trace of key accesses against regions with the LRU and the
+ * TINY_LFU eviction policy and reports their hit ratio. Each access gets
+ * the key and puts it on a miss, the way a client caching region fetches
+ * a value it does not have.
+ *
+ * The trace is read from the file named by the TRACE_FILE environment
+ * variable, one key per line, if it is set. Otherwise a trace is made up of
+ * rounds of accesses to a set of keys with a Zipf distribution, each
+ * followed by a scan of keys accessed only once, larger than the region.
+ */
+
+namespace {
+
+const int ENTRIES_LIMIT = 10000;
+const int KEY_COUNT = 50000;
+const double ZIPF_EXPONENT = 1.1;
+const int ROUNDS = 20;
+const int ACCESSES_PER_ROUND = 50000;
+const int SCAN_LENGTH = 15000;
+
+perf::PerfSuite perfSuite("EvictionPolicyHitRatio");
+
+std::vector<CacheableKeyPtr> g_trace;
+
+void makeTrace() {
+  const char* traceFile = ACE_OS::getenv("TRACE_FILE");
+  if (traceFile != nullptr) {
+    std::ifstream in(traceFile);
+    ASSERT(in.good(), "failed to open the trace file.");
+    std::string line;
+    while (std::getline(in, line)) {
+      if (!line.empty()) {
+        g_trace.push_back(CacheableString::create(line.c_str()));
+      }
+    }
+    return;
+  }
+
+  std::vector<double> cumulative(KEY_COUNT);
+  double total = 0;
+  for (int i = 0; i < KEY_COUNT; i++) {
+    total += 1.0 / std::pow(i + 1, ZIPF_EXPONENT);
+    cumulative[i] = total;
+  }
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> uniform(0, total);
+  int scanKey = KEY_COUNT;
+  for (int round = 0; round < ROUNDS; round++) {
+    for (int i = 0; i < ACCESSES_PER_ROUND; i++) {
+      int key = static_cast<int>(
+          std::upper_bound(cumulative.begin(), cumulative.end(),
+                           uniform(random)) -
+          cumulative.begin());
+      g_trace.push_back(CacheableInt32::create(std::min(key, KEY_COUNT - 1)));
+    }
+    for (int i = 0; i < SCAN_LENGTH; i++) {
+      g_trace.push_back(CacheableInt32::create(scanKey++));
+    }
+  }
+}
+
+void replay(const char* regionName, const char* label,
+            EvictionPolicyType::PolicyType evictionPolicy) {
+  AttributesFactory attrFactory;
+  attrFactory.setInitialCapacity(ENTRIES_LIMIT);
+  attrFactory.setLruEntriesLimit(ENTRIES_LIMIT);
+  attrFactory.setEvictionPolicy(evictionPolicy);
+  RegionPtr region = CacheHelper::getHelper().rootRegionPtr->createSubregion(
+      regionName, attrFactory.createRegionAttributes());
+  ASSERT(region != nullptr, "failed to create region.");
+
+  if (g_trace.empty()) {
+    makeTrace();
+  }
+  CacheablePtr value = CacheableInt32::create(0);
+  long hits = 0;
+  perf::TimeStamp start;
+  for (const auto& key : g_trace) {
+    if (region->get(key) != nullptr) {
+      hits++;
+    } else {
+      region->put(key, value);
+    }
+  }
+  perf::TimeStamp stop;
+
+  char message[256];
+  ACE_OS::snprintf(message, 256, "%s: hit ratio %.2f%% over %ld accesses",
+                   label, 100.0 * hits / g_trace.size(),
+                   static_cast<long>(g_trace.size()));
+  LOG(message);
+  char testName[256];
+  ACE_OS::snprintf(testName, 256, "%s, trace replay", label);
+  perfSuite.addRecord(testName, static_cast<long>(g_trace.size()), start,
+                      stop);
+
+  region->localDestroyRegion();
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, LRU)
+  { replay("LRU", "lru", EvictionPolicyType::LRU); }
+END_TASK(LRU)
+
+DUNIT_TASK(s1p1, TinyLFU)
+  { replay("TinyLFU", "tiny lfu", EvictionPolicyType::TINY_LFU); }
+END_TASK(TinyLFU)
+
+DUNIT_TASK(s1p1, Finish)
+  {
+    perfSuite.save();
+    g_trace.clear();
+    CacheHelper::getHelper().disconnect();
+  }
+END_TASK(Finish)
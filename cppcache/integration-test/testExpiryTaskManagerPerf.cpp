@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testExpiryTaskManagerPerf"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <ace/OS.h>
+
+#include "ExpiryTaskManager.hpp"
+
+/**
+ * Measures scheduling, cancelling and expiring entry expiry tasks on the
+ * timer heap of the ExpiryTaskManager and on its timing wheel, with 1M and
+ * 10M tasks outstanding. The tasks are spread over the hour ahead, as the
+ * entries of a region with a one hour time to live would be; the expiry
+ * runs tasks scheduled to expire a second later, from the first of them to
+ * the last.
+ */
+
+namespace {
+
+perf::PerfSuite perfSuite("ExpiryTaskManagerPerf");
+
+std::atomic<long> g_expired(0);
+std::atomic<int64_t> g_firstExpiry(0);
+
+class CountingHandler : public ACE_Event_Handler {
+ public:
+  virtual int handle_timeout(const ACE_Time_Value& current_time,
+                             const void* arg) {
+    if (g_expired++ == 0) {
+      g_firstExpiry = perf::TimeStamp().msec();
+    }
+    return 0;
+  }
+
+  virtual int handle_close(ACE_HANDLE, ACE_Reactor_Mask) { return 0; }
+};
+
+void runTasks(const char* label, bool useTimingWheel, long count) {
+  ExpiryTaskManager expiryTaskManager(useTimingWheel);
+  expiryTaskManager.begin();
+
+  std::vector<CountingHandler*> handlers;
+  std::vector<long> ids;
+  handlers.reserve(count);
+  ids.reserve(count);
+  for (long i = 0; i < count; i++) {
+    handlers.push_back(new CountingHandler());
+  }
+
+  perf::TimeStamp scheduleStart;
+  for (long i = 0; i < count; i++) {
+    ids.push_back(expiryTaskManager.scheduleCoarseExpiryTask(
+        handlers[i], 60 + static_cast<uint32_t>(i % 3600)));
+  }
+  perf::TimeStamp scheduleStop;
+
+  for (long i = 0; i < count; i++) {
+    ASSERT(expiryTaskManager.cancelTask(ids[i]) == 1, "task not cancelled.");
+  }
+  perf::TimeStamp cancelStop;
+  for (auto handler : handlers) {
+    delete handler;
+  }
+  handlers.clear();
+
+  // deleted by the ExpiryTaskManager once expired
+  g_expired = 0;
+  for (long i = 0; i < count; i++) {
+    expiryTaskManager.scheduleCoarseExpiryTask(new CountingHandler(), 1);
+  }
+  while (g_expired < count) {
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  perf::TimeStamp expireStop;
+
+  char testName[256];
+  ACE_OS::snprintf(testName, 256, "%s, schedule %ld tasks", label, count);
+  perfSuite.addRecord(testName, count, scheduleStart, scheduleStop);
+  ACE_OS::snprintf(testName, 256, "%s, cancel %ld tasks", label, count);
+  perfSuite.addRecord(testName, count, scheduleStop, cancelStop);
+  ACE_OS::snprintf(testName, 256, "%s, expire %ld tasks", label, count);
+  perfSuite.addRecord(testName, count, perf::TimeStamp(g_firstExpiry),
+                      expireStop);
+
+  expiryTaskManager.stopExpiryTaskManager();
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, TimerHeap1M)
+  { runTasks("timer heap", false, 1000000); }
+END_TASK(TimerHeap1M)
+
+DUNIT_TASK(s1p1, TimingWheel1M)
+  { runTasks("timing wheel", true, 1000000); }
+END_TASK(TimingWheel1M)
+
+DUNIT_TASK(s1p1, TimerHeap10M)
+  { runTasks("timer heap", false, 10000000); }
+END_TASK(TimerHeap10M)
+
+DUNIT_TASK(s1p1, TimingWheel10M)
+  { runTasks("timing wheel", true, 10000000); }
+END_TASK(TimingWheel10M)
+
+DUNIT_TASK(s1p1, Finish)
+  { perfSuite.save(); }
+END_TASK(Finish)
@@ -0,0 +1,162 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testHeapLRUAccounting"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <atomic>
+
+#include "CacheHelper.hpp"
+#include "CacheImpl.hpp"
+#include "CacheRegionHelper.hpp"
+#include "EvictionController.hpp"
+
+/**
+ * Fills a region left idle afterwards and then puts several times the
+ * heap-lru-limit into a second region from 1 to MAX_THREADS threads.
+ * Records the throughput of the puts, the most the heap LRU size went over
+ * the limit and the time it took to get back under it. testHeapLRUSize
+ * checks what the idle region gives up and the accounted size.
+ */
+
+namespace {
+
+const int HEAP_LRU_LIMIT_MB = 64;
+const int VALUE_SIZE = 1024;
+const int COLD_ENTRIES = 20000;
+const int PUTS_PER_THREAD = 100000;
+const int MAX_THREADS = 8;
+
+perf::PerfSuite perfSuite("HeapLRUAccounting");
+
+CacheHelper* cacheHelper = nullptr;
+std::atomic<int> g_nextKey(0);
+std::atomic<int64_t> g_maxHeapSize(0);
+
+EvictionController* evictionController() {
+  return CacheRegionHelper::getCacheImpl(cacheHelper->getCache().get())
+      ->getEvictionController();
+}
+
+class PutTask : public perf::Thread {
+ private:
+  RegionPtr m_region;
+
+ public:
+  explicit PutTask(const RegionPtr& region) : Thread(), m_region(region) {}
+
+  virtual void perftask() {
+    EvictionController* controller = evictionController();
+    for (int i = 0; i < PUTS_PER_THREAD; i++) {
+      m_region->put(CacheableInt32::create(g_nextKey++),
+                    CacheableBytes::create(VALUE_SIZE));
+      if (i % 1000 == 0) {
+        int64_t heapSize = controller->getHeapSize();
+        int64_t maxHeapSize = g_maxHeapSize;
+        while (heapSize > maxHeapSize &&
+               !g_maxHeapSize.compare_exchange_weak(maxHeapSize, heapSize)) {
+        }
+      }
+    }
+  }
+};
+
+// waits for the heap LRU size to get under the limit, returns false if it
+// did not within ten seconds
+bool waitUnderLimit(int64_t limit) {
+  for (int i = 0; i < 100; i++) {
+    if (evictionController()->getHeapSize() <= limit) {
+      return true;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return false;
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, CreateCache)
+  {
+    PropertiesPtr pp = Properties::create();
+    pp->insert("heap-lru-limit", HEAP_LRU_LIMIT_MB);
+    pp->insert("heap-lru-delta", 10);
+    cacheHelper = new CacheHelper(ROOT_NAME, pp, true);
+    ASSERT(evictionController() != nullptr, "heap LRU not enabled.");
+  }
+END_TASK(CreateCache)
+
+DUNIT_TASK(s1p1, Evict)
+  {
+    const int64_t limit = HEAP_LRU_LIMIT_MB * 1024LL * 1024LL;
+    CachePtr cache = cacheHelper->getCache();
+    RegionPtr cold = cache->createRegionFactory(LOCAL).create("Cold");
+    RegionPtr hot = cache->createRegionFactory(LOCAL).create("Hot");
+
+    for (int i = 0; i < COLD_ENTRIES; i++) {
+      cold->put(CacheableInt32::create(i), CacheableBytes::create(VALUE_SIZE));
+    }
+    // the clock the regions note their use with ticks in seconds
+    ACE_OS::sleep(3);
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+      g_maxHeapSize = 0;
+      PutTask task(hot);
+      perf::ThreadLauncher launcher(threads, task);
+      launcher.go();
+      perf::TimeStamp putsDone;
+      ASSERT(waitUnderLimit(limit), "heap LRU size not back under the limit.");
+      perf::TimeStamp underLimit;
+
+      char testName[256];
+      ACE_OS::snprintf(testName, 256, "heap lru puts, %d threads", threads);
+      perfSuite.addRecord(testName, PUTS_PER_THREAD * threads,
+                          launcher.startTime(), launcher.stopTime());
+      ACE_OS::snprintf(testName, 256, "heap lru back under limit, %d threads",
+                       threads);
+      perfSuite.addRecord(testName, 1, putsDone, underLimit);
+
+      char message[256];
+      ACE_OS::snprintf(
+          message, 256, "%d threads: at most %lld bytes over the limit",
+          threads, static_cast<long long>(g_maxHeapSize - limit));
+      LOG(message);
+    }
+
+    int64_t evicted = CacheRegionHelper::getCacheImpl(cache.get())
+                          ->getCachePerfStats()
+                          .getHeapLRUEvictedBytes();
+    char message[256];
+    ACE_OS::snprintf(message, 256,
+                     "%lld bytes evicted, cold region kept %u of %d entries",
+                     static_cast<long long>(evicted), cold->size(),
+                     COLD_ENTRIES);
+    LOG(message);
+
+    cold->localDestroyRegion();
+    hot->localDestroyRegion();
+  }
+END_TASK(Evict)
+
+DUNIT_TASK(s1p1, Finish)
+  {
+    perfSuite.save();
+    delete cacheHelper;
+    cacheHelper = nullptr;
+  }
+END_TASK(Finish)
@@ -0,0 +1,162 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testHeapLRUEvictionThreads"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include "CacheHelper.hpp"
+#include "CacheImpl.hpp"
+#include "CacheRegionHelper.hpp"
+#include "EvictionController.hpp"
+
+/**
+ * Puts several times the heap-lru-limit into REGIONS regions from
+ * PUT_THREADS threads, with 1 to MAX_EVICTION_THREADS eviction threads.
+ * Records the throughput of the puts and of the eviction, the most the heap
+ * LRU size went over the limit and how many puts were held back because
+ * eviction fell behind; checks that the size stays within reach of the
+ * limit and gets back under it once the puts stop.
+ */
+
+namespace {
+
+const int HEAP_LRU_LIMIT_MB = 64;
+const int VALUE_SIZE = 1024;
+const int REGIONS = 4;
+const int PUT_THREADS = 8;
+const int PUTS_PER_THREAD = 100000;
+const int MAX_EVICTION_THREADS = 4;
+
+perf::PerfSuite perfSuite("HeapLRUEvictionThreads");
+
+CacheHelper* cacheHelper = nullptr;
+std::vector<RegionPtr> g_regions;
+std::atomic<int> g_nextKey(0);
+std::atomic<int64_t> g_maxHeapSize(0);
+
+CacheImpl* cacheImpl() {
+  return CacheRegionHelper::getCacheImpl(cacheHelper->getCache().get());
+}
+
+class PutTask : public perf::Thread {
+ public:
+  PutTask() : Thread() {}
+
+  virtual void perftask() {
+    EvictionController* controller = cacheImpl()->getEvictionController();
+    for (int i = 0; i < PUTS_PER_THREAD; i++) {
+      int key = g_nextKey++;
+      g_regions[key % REGIONS]->put(CacheableInt32::create(key),
+                                    CacheableBytes::create(VALUE_SIZE));
+      if (i % 1000 == 0) {
+        int64_t heapSize = controller->getHeapSize();
+        int64_t maxHeapSize = g_maxHeapSize;
+        while (heapSize > maxHeapSize &&
+               !g_maxHeapSize.compare_exchange_weak(maxHeapSize, heapSize)) {
+        }
+      }
+    }
+  }
+};
+
+// waits for the heap LRU size to get under the limit, returns false if it
+// did not within ten seconds
+bool waitUnderLimit(int64_t limit) {
+  for (int i = 0; i < 100; i++) {
+    if (cacheImpl()->getEvictionController()->getHeapSize() <= limit) {
+      return true;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return false;
+}
+
+void runPuts(int evictionThreads) {
+  const int64_t limit = HEAP_LRU_LIMIT_MB * 1024LL * 1024LL;
+  PropertiesPtr pp = Properties::create();
+  pp->insert("heap-lru-limit", HEAP_LRU_LIMIT_MB);
+  pp->insert("heap-lru-delta", 10);
+  pp->insert("heap-lru-eviction-threads", evictionThreads);
+  cacheHelper = new CacheHelper(ROOT_NAME, pp, true);
+  CachePtr cache = cacheHelper->getCache();
+  ASSERT(cacheImpl()->getEvictionController() != nullptr,
+         "heap LRU not enabled.");
+  for (int i = 0; i < REGIONS; i++) {
+    char name[32];
+    ACE_OS::snprintf(name, 32, "Region%d", i);
+    g_regions.push_back(cache->createRegionFactory(LOCAL).create(name));
+  }
+
+  g_maxHeapSize = 0;
+  PutTask task;
+  perf::ThreadLauncher launcher(PUT_THREADS, task);
+  launcher.go();
+  perf::TimeStamp putsDone;
+  ASSERT(waitUnderLimit(limit), "heap LRU size not back under the limit.");
+  perf::TimeStamp underLimit;
+
+  CachePerfStats& stats = cacheImpl()->getCachePerfStats();
+  int64_t evicted = stats.getHeapLRUEvictedBytes();
+  char testName[256];
+  ACE_OS::snprintf(testName, 256, "heap lru puts, %d eviction threads",
+                   evictionThreads);
+  perfSuite.addRecord(testName, PUTS_PER_THREAD * PUT_THREADS,
+                      launcher.startTime(), launcher.stopTime());
+  ACE_OS::snprintf(testName, 256, "heap lru evicted MB, %d eviction threads",
+                   evictionThreads);
+  perfSuite.addRecord(testName, static_cast<int>(evicted >> 20),
+                      launcher.startTime(), underLimit);
+
+  char message[256];
+  ACE_OS::snprintf(message, 256,
+                   "%d eviction threads: at most %lld bytes over the limit, "
+                   "%d puts held back",
+                   evictionThreads,
+                   static_cast<long long>(g_maxHeapSize - limit),
+                   stats.getHeapLRUPutDelays());
+  LOG(message);
+  ASSERT(evicted > 0, "nothing evicted.");
+  // puts are held back from heap-lru-delta percent over the limit, a few
+  // more get in before the size is looked at again
+  ASSERT(g_maxHeapSize < limit * 2, "heap LRU size ran away from the limit.");
+
+  for (auto& region : g_regions) {
+    region->localDestroyRegion();
+  }
+  g_regions.clear();
+  delete cacheHelper;
+  cacheHelper = nullptr;
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, Evict)
+  {
+    for (int threads = 1; threads <= MAX_EVICTION_THREADS; threads *= 2) {
+      runPuts(threads);
+    }
+  }
+END_TASK(Evict)
+
+DUNIT_TASK(s1p1, Finish)
+  { perfSuite.save(); }
+END_TASK(Finish)
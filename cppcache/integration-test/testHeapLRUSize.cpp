@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geode/GeodeCppCache.hpp>
+
+#include <ace/OS.h>
+
+#include "fw_helper.hpp"
+
+using namespace apache::geode::client;
+
+#define ROOT_NAME "testHeapLRUSize"
+
+#include "CacheHelper.hpp"
+#include "CacheImpl.hpp"
+#include "CacheRegionHelper.hpp"
+#include "EvictionController.hpp"
+
+/**
+ * Checks the heap LRU accounting of local regions: a region left idle gives
+ * up most of its entries when another one is put over the heap-lru-limit,
+ * and the accounted size goes back to nothing once all the entries are
+ * destroyed.
+ */
+
+namespace {
+
+const int HEAP_LRU_LIMIT_MB = 4;
+const int VALUE_SIZE = 1024;
+const int COLD_ENTRIES = 2000;
+const int HOT_ENTRIES = 4 * HEAP_LRU_LIMIT_MB * 1024;
+
+EvictionController* evictionController(const CachePtr& cache) {
+  return CacheRegionHelper::getCacheImpl(cache.get())->getEvictionController();
+}
+
+void destroyAll(const RegionPtr& region) {
+  VectorOfCacheableKey keys;
+  region->keys(keys);
+  for (const auto& key : keys) {
+    region->localDestroy(key);
+  }
+}
+
+}  // namespace
+
+BEGIN_TEST(IdleRegionGivesUpEntries)
+  {
+    PropertiesPtr pp = Properties::create();
+    pp->insert("heap-lru-limit", HEAP_LRU_LIMIT_MB);
+    pp->insert("heap-lru-delta", 10);
+    CacheHelper cacheHelper(ROOT_NAME, pp, true);
+    CachePtr cache = cacheHelper.getCache();
+    EvictionController* controller = evictionController(cache);
+    ASSERT(controller != nullptr, "heap LRU not enabled.");
+    const int64_t limit = HEAP_LRU_LIMIT_MB * 1024LL * 1024LL;
+
+    RegionPtr cold = cache->createRegionFactory(LOCAL).create("Cold");
+    RegionPtr hot = cache->createRegionFactory(LOCAL).create("Hot");
+    for (int i = 0; i < COLD_ENTRIES; i++) {
+      cold->put(CacheableInt32::create(i), CacheableBytes::create(VALUE_SIZE));
+    }
+    ASSERT(static_cast<int>(cold->size()) == COLD_ENTRIES,
+           "entries evicted under the limit.");
+    // the clock the regions note their use with ticks in seconds
+    ACE_OS::sleep(3);
+
+    for (int i = 0; i < HOT_ENTRIES; i++) {
+      hot->put(CacheableInt32::create(i), CacheableBytes::create(VALUE_SIZE));
+    }
+    bool underLimit = false;
+    for (int i = 0; i < 100 && !underLimit; i++) {
+      underLimit = controller->getHeapSize() <= limit;
+      if (!underLimit) {
+        ACE_OS::sleep(ACE_Time_Value(0, 100000));
+      }
+    }
+    ASSERT(underLimit, "heap LRU size not back under the limit.");
+
+    char message[256];
+    ACE_OS::snprintf(message, 256, "cold region kept %u of %d entries",
+                     cold->size(), COLD_ENTRIES);
+    LOG(message);
+    ASSERT(static_cast<int>(cold->size()) * 2 < COLD_ENTRIES,
+           "the idle region did not give up most of its entries.");
+
+    // the bytes added for an entry are taken off again when it goes, once
+    // the eviction still under way is done
+    ACE_OS::sleep(1);
+    destroyAll(cold);
+    destroyAll(hot);
+    ASSERT(controller->getHeapSize() == 0,
+           "heap LRU size not back to nothing.");
+
+    cold->localDestroyRegion();
+    hot->localDestroyRegion();
+  }
+END_TEST(IdleRegionGivesUpEntries)
@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testLRUEvictionPerf"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <atomic>
+#include <cstdio>
+
+#include "CacheHelper.hpp"
+
+/**
+ * Compares the LRU and SAMPLED_LRU eviction policies: the memory an entry
+ * of a full region takes, from the growth of the resident set while the
+ * region is filled up to its limit, and the throughput of puts of new keys
+ * into the full region, each of which evicts an entry, from 1 to
+ * MAX_THREADS threads.
+ */
+
+namespace {
+
+const int ENTRIES_LIMIT = 1000000;
+const int PUTS_PER_THREAD = 200000;
+const int MAX_THREADS = 8;
+
+perf::PerfSuite perfSuite("LRUEvictionPerf");
+
+std::atomic<int> g_nextKey(0);
+
+// resident set size in bytes, 0 where it cannot be read
+int64_t residentSetSize() {
+  int64_t pages = 0;
+#ifdef __linux__
+  FILE* statm = ACE_OS::fopen("/proc/self/statm", "r");
+  if (statm != nullptr) {
+    long size, resident;
+    if (fscanf(statm, "%ld %ld", &size, &resident) == 2) {
+      pages = resident;
+    }
+    ACE_OS::fclose(statm);
+  }
+#endif
+  return pages * ACE_OS::getpagesize();
+}
+
+class PutTask : public perf::Thread {
+ private:
+  RegionPtr m_region;
+
+ public:
+  explicit PutTask(const RegionPtr& region) : Thread(), m_region(region) {}
+
+  virtual void perftask() {
+    CacheablePtr value = CacheableInt32::create(0);
+    for (int i = 0; i < PUTS_PER_THREAD; i++) {
+      m_region->put(CacheableInt32::create(g_nextKey++), value);
+    }
+  }
+};
+
+void runEvictions(const char* regionName, const char* label,
+                  EvictionPolicyType::PolicyType evictionPolicy) {
+  AttributesFactory attrFactory;
+  attrFactory.setInitialCapacity(ENTRIES_LIMIT);
+  attrFactory.setLruEntriesLimit(ENTRIES_LIMIT);
+  attrFactory.setEvictionPolicy(evictionPolicy);
+  RegionPtr region = CacheHelper::getHelper().rootRegionPtr->createSubregion(
+      regionName, attrFactory.createRegionAttributes());
+  ASSERT(region != nullptr, "failed to create region.");
+
+  g_nextKey = 0;
+  CacheablePtr value = CacheableInt32::create(0);
+  int64_t before = residentSetSize();
+  for (int i = 0; i < ENTRIES_LIMIT; i++) {
+    region->put(CacheableInt32::create(g_nextKey++), value);
+  }
+  int64_t after = residentSetSize();
+  ASSERT(region->size() == ENTRIES_LIMIT, "region not filled up.");
+
+  char message[256];
+  ACE_OS::snprintf(message, 256, "%s: %lld bytes per entry", label,
+                   static_cast<long long>((after - before) / ENTRIES_LIMIT));
+  LOG(message);
+
+  for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    PutTask task(region);
+    perf::ThreadLauncher launcher(threads, task);
+    launcher.go();
+
+    char testName[256];
+    ACE_OS::snprintf(testName, 256, "%s, evicting puts, %d threads", label,
+                     threads);
+    perfSuite.addRecord(testName, PUTS_PER_THREAD * threads,
+                        launcher.startTime(), launcher.stopTime());
+  }
+  ASSERT(region->size() == ENTRIES_LIMIT, "region not kept at its limit.");
+
+  region->localDestroyRegion();
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, LRU)
+  { runEvictions("LRU", "lru", EvictionPolicyType::LRU); }
+END_TASK(LRU)
+
+DUNIT_TASK(s1p1, SampledLRU)
+  {
+    runEvictions("SampledLRU", "sampled lru",
+                 EvictionPolicyType::SAMPLED_LRU);
+  }
+END_TASK(SampledLRU)
+
+DUNIT_TASK(s1p1, Finish)
+  {
+    perfSuite.save();
+    CacheHelper::getHelper().disconnect();
+  }
+END_TASK(Finish)
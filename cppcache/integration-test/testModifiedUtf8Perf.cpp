@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testModifiedUtf8Perf"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <string>
+
+#include "CacheHelper.hpp"
+#include "ModifiedUtf8.hpp"
+
+/**
+ * Measures the modified UTF-8 and UTF-16 string encoding of DataOutput and
+ * the decoding of DataInput with each implementation the CPU supports, for
+ * ASCII strings, for strings with an occasional non-ASCII character and for
+ * the huge string format. The scalar numbers are the baseline.
+ */
+
+namespace {
+
+const int STRING_LENGTH = 1000;
+const int ITERATIONS = 200000;
+
+perf::PerfSuite perfSuite("ModifiedUtf8Perf");
+
+const char* implementationName(ModifiedUtf8::Implementation implementation) {
+  switch (implementation) {
+    case ModifiedUtf8::SSE42:
+      return "sse4.2";
+    case ModifiedUtf8::AVX2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+}
+
+std::wstring makeString(int specialInterval) {
+  std::wstring value;
+  for (int i = 0; i < STRING_LENGTH; i++) {
+    if (specialInterval > 0 && (i % specialInterval) == specialInterval - 1) {
+      value += static_cast<wchar_t>(0xE9 + i);
+    } else {
+      value += static_cast<wchar_t>('a' + i % 26);
+    }
+  }
+  return value;
+}
+
+class CodecTask : public perf::Thread {
+ private:
+  const std::wstring& m_value;
+  std::string m_narrow;
+  bool m_wide;
+  bool m_huge;
+
+ public:
+  CodecTask(const std::wstring& value, bool wide, bool huge)
+      : Thread(), m_value(value), m_wide(wide), m_huge(huge) {
+    for (wchar_t c : value) m_narrow += static_cast<char>(c);
+  }
+
+  virtual void perftask() {
+    CachePtr cache = CacheHelper::getHelper().getCache();
+    for (int i = 0; i < ITERATIONS; i++) {
+      auto output = cache->createDataOutput();
+      if (m_wide) {
+        if (m_huge) {
+          output->writeUTFHuge(m_value.c_str(), STRING_LENGTH);
+        } else {
+          output->writeUTF(m_value.c_str(), STRING_LENGTH);
+        }
+      } else if (m_huge) {
+        output->writeUTFHuge(m_narrow.c_str(), STRING_LENGTH);
+      } else {
+        output->writeUTF(m_narrow.c_str(), STRING_LENGTH);
+      }
+
+      uint32_t length;
+      const uint8_t* bytes = output->getBuffer(&length);
+      auto input = cache->createDataInput(bytes, length);
+      if (m_wide) {
+        wchar_t* value;
+        if (m_huge) {
+          input->readUTFHuge(&value);
+        } else {
+          input->readUTF(&value);
+        }
+        DataInput::freeUTFMemory(value);
+      } else {
+        char* value;
+        if (m_huge) {
+          input->readUTFHuge(&value);
+        } else {
+          input->readUTF(&value);
+        }
+        DataInput::freeUTFMemory(value);
+      }
+    }
+  }
+};
+
+void runCodec(const char* label, int specialInterval, bool wide, bool huge) {
+  std::wstring value = makeString(specialInterval);
+  ModifiedUtf8::Implementation best = ModifiedUtf8::getImplementation();
+  for (auto implementation :
+       {ModifiedUtf8::SCALAR, ModifiedUtf8::SSE42, ModifiedUtf8::AVX2}) {
+    if (!ModifiedUtf8::setImplementation(implementation)) continue;
+    CodecTask task(value, wide, huge);
+    perf::ThreadLauncher launcher(1, task);
+    launcher.go();
+
+    char testName[256];
+    ACE_OS::snprintf(testName, 256, "%s, %s", label,
+                     implementationName(implementation));
+    perfSuite.addRecord(testName, ITERATIONS, launcher.startTime(),
+                        launcher.stopTime());
+  }
+  ModifiedUtf8::setImplementation(best);
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, AsciiChars)
+  { runCodec("ascii char string", 0, false, false); }
+END_TASK(AsciiChars)
+
+DUNIT_TASK(s1p1, AsciiWide)
+  { runCodec("ascii wide string", 0, true, false); }
+END_TASK(AsciiWide)
+
+DUNIT_TASK(s1p1, MixedWide)
+  { runCodec("wide string, 1 in 16 non-ascii", 16, true, false); }
+END_TASK(MixedWide)
+
+DUNIT_TASK(s1p1, HugeChars)
+  { runCodec("huge char string", 0, false, true); }
+END_TASK(HugeChars)
+
+DUNIT_TASK(s1p1, HugeWide)
+  { runCodec("huge wide string, 1 in 16 non-ascii", 16, true, true); }
+END_TASK(HugeWide)
+
+DUNIT_TASK(s1p1, Finish)
+  {
+    perfSuite.save();
+    CacheHelper::getHelper().disconnect();
+  }
+END_TASK(Finish)
@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testNotificationDispatcherPerf"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <ace/OS.h>
+
+#include "NotificationDispatcher.hpp"
+
+/**
+ * Measures the subscription events the NotificationProcessor gets through
+ * per second when they are dispatched on its thread, and when they are
+ * dispatched on 1 to 16 threads of the NotificationDispatcher. Each event
+ * is for one of KEYS keys and spends LISTENER_MICROS in its listener; the
+ * events of a key are checked to arrive in the order they were read.
+ */
+
+namespace {
+
+const int EVENTS = 200000;
+const int KEYS = 10000;
+const int LISTENER_MICROS = 20;
+const uint32_t MAX_THREADS = 16;
+
+perf::PerfSuite perfSuite("NotificationDispatcherPerf");
+
+std::vector<int> g_lastSeq;
+std::atomic<int> g_outOfOrder(0);
+
+// stands in for applying the event and calling the CacheListener
+void onEvent(int key, int seq) {
+  auto until = std::chrono::steady_clock::now() +
+               std::chrono::microseconds(LISTENER_MICROS);
+  while (std::chrono::steady_clock::now() < until) {
+  }
+  // only the thread of the key writes its entry
+  if (g_lastSeq[key] != seq - 1) {
+    ++g_outOfOrder;
+  }
+  g_lastSeq[key] = seq;
+}
+
+void runEvents(uint32_t threads) {
+  g_lastSeq.assign(KEYS, -1);
+  g_outOfOrder = 0;
+  NotificationDispatcher* dispatcher = nullptr;
+  if (threads > 0) {
+    dispatcher = new NotificationDispatcher(threads);
+    dispatcher->start();
+  }
+
+  perf::TimeStamp start;
+  for (int i = 0; i < EVENTS; i++) {
+    int key = i % KEYS;
+    int seq = i / KEYS;
+    if (dispatcher != nullptr) {
+      ASSERT(dispatcher->dispatch(static_cast<size_t>(key),
+                                  [key, seq] { onEvent(key, seq); }),
+             "event not dispatched.");
+    } else {
+      onEvent(key, seq);
+    }
+  }
+  if (dispatcher != nullptr) {
+    dispatcher->barrier();
+  }
+  perf::TimeStamp stop;
+
+  char testName[256];
+  if (dispatcher != nullptr) {
+    ACE_OS::snprintf(testName, 256, "dispatch events, %u threads", threads);
+    dispatcher->stop();
+    delete dispatcher;
+  } else {
+    ACE_OS::snprintf(testName, 256, "dispatch events on one thread");
+  }
+  perfSuite.addRecord(testName, EVENTS, start, stop);
+
+  ASSERT(g_outOfOrder == 0, "events of a key dispatched out of order.");
+  for (int key = 0; key < KEYS; key++) {
+    ASSERT(g_lastSeq[key] == EVENTS / KEYS - 1, "event not dispatched.");
+  }
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, Inline)
+  { runEvents(0); }
+END_TASK(Inline)
+
+DUNIT_TASK(s1p1, Dispatch)
+  {
+    for (uint32_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+      runEvents(threads);
+    }
+  }
+END_TASK(Dispatch)
+
+DUNIT_TASK(s1p1, Finish)
+  { perfSuite.save(); }
+END_TASK(Finish)
@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define ROOT_NAME "testOverflowPutGetMmapLog"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <string>
+
+#include <CacheableToken.hpp>
+
+#include "CacheHelper.hpp"
+
+/**
+ * Overflows a region to the memory mapped log with files small enough for
+ * the entries to span many of them, rewrites and destroys most entries so
+ * that the files get compacted, and reads all entries back. Also reads
+ * overflowed entries back with Region::prefetch.
+ */
+
+namespace {
+
+const int LRU_LIMIT = 10;
+const int ENTRY_COUNT = 5000;
+
+RegionPtr createRegion(const char* regionName) {
+  PropertiesPtr logProperties = Properties::create();
+  logProperties->insert(PERSISTENCE_DIR, "MmapLogRegionData");
+  logProperties->insert(SEGMENT_SIZE, "65536");
+  logProperties->insert(COMPACTION_THRESHOLD, "50");
+
+  AttributesFactory attrFactory;
+  attrFactory.setCachingEnabled(true);
+  attrFactory.setLruEntriesLimit(LRU_LIMIT);
+  attrFactory.setInitialCapacity(ENTRY_COUNT);
+  attrFactory.setDiskPolicy(DiskPolicyType::OVERFLOWS);
+  attrFactory.setPersistenceManager("MmapLogImpl", "createMmapLogInstance",
+                                    logProperties);
+  RegionPtr region = CacheHelper::getHelper().rootRegionPtr->createSubregion(
+      regionName, attrFactory.createRegionAttributes());
+  ASSERT(region != nullptr, "failed to create region.");
+  return region;
+}
+
+void putAll(RegionPtr& region, int round) {
+  std::string value(512, 'A' + round);
+  for (int i = 0; i < ENTRY_COUNT; i++) {
+    char suffix[32];
+    sprintf(suffix, "-%d", i);
+    region->put(CacheableInt32::create(i),
+                CacheableString::create((value + suffix).c_str()));
+  }
+}
+
+void checkAll(RegionPtr& region, int round, int destroyed) {
+  std::string value(512, 'A' + round);
+  int overflowed = 0;
+  for (int i = 0; i < ENTRY_COUNT; i++) {
+    RegionEntryPtr entry = region->getEntry(CacheableInt32::create(i));
+    if (i < destroyed) {
+      ASSERT(entry == nullptr, "destroyed entry found.");
+      continue;
+    }
+    if (CacheableToken::isOverflowed(entry->getValue())) {
+      overflowed++;
+    }
+    char suffix[32];
+    sprintf(suffix, "-%d", i);
+    auto read = std::dynamic_pointer_cast<CacheableString>(
+        region->get(CacheableInt32::create(i)));
+    ASSERT(read != nullptr, "entry not read back.");
+    ASSERT(value + suffix == read->asChar(), "entry read back changed.");
+  }
+  ASSERT(overflowed > 0, "no entry overflowed.");
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, OverflowAndReadBack)
+  {
+    RegionPtr region = createRegion("OverflowAndReadBack");
+    putAll(region, 0);
+    checkAll(region, 0, 0);
+    region->localDestroyRegion();
+  }
+END_TASK(OverflowAndReadBack)
+
+DUNIT_TASK(s1p1, RewriteAndCompact)
+  {
+    RegionPtr region = createRegion("RewriteAndCompact");
+    putAll(region, 0);
+    putAll(region, 1);
+    putAll(region, 2);
+    int destroyed = ENTRY_COUNT / 2;
+    for (int i = 0; i < destroyed; i++) {
+      region->destroy(CacheableInt32::create(i));
+    }
+    // leave the compactor time to copy the live records
+    SLEEP(1000);
+    checkAll(region, 2, destroyed);
+    region->localDestroyRegion();
+  }
+END_TASK(RewriteAndCompact)
+
+DUNIT_TASK(s1p1, Prefetch)
+  {
+    RegionPtr region = createRegion("Prefetch");
+    putAll(region, 0);
+    // half the limit, the entries read in do not evict each other
+    VectorOfCacheableKey keys;
+    for (int i = 0; i < LRU_LIMIT / 2; i++) {
+      auto key = CacheableInt32::create(i);
+      ASSERT(CacheableToken::isOverflowed(region->getEntry(key)->getValue()),
+             "entry put first not overflowed.");
+      keys.push_back(key);
+    }
+    region->prefetch(keys);
+    for (const auto& key : keys) {
+      ASSERT(!CacheableToken::isOverflowed(region->getEntry(key)->getValue()),
+             "prefetched entry still overflowed.");
+    }
+    checkAll(region, 0, 0);
+    region->localDestroyRegion();
+  }
+END_TASK(Prefetch)
+
+DUNIT_TASK(s1p1, Finish)
+  { CacheHelper::getHelper().disconnect(); }
+END_TASK(Finish)
@@ -489,7 +489,12 @@ BEGIN_TEST(OverFlowTest_SqLiteFull)
     ASSERT(regionPtr != nullptr, "Expected regionPtr to be NON-nullptr");
 
     try {
-      doNput(regionPtr, 100);
+      // the overflowed entries are written behind, a put fails once a batch
+      // of them could not be written
+      for (uint32_t i = 0; i < 50; i++) {
+        doNput(regionPtr, (i + 1) * 100, i * 100);
+        ACE_OS::sleep(ACE_Time_Value(0, 100000));
+      }
       FAIL("Didn't get the expected exception");
     } catch (apache::geode::client::Exception
                  ex) {  // expected sqlite full exception
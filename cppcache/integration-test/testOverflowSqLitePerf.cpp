@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define ROOT_NAME "testOverflowSqLitePerf"
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <string>
+
+#include "CacheHelper.hpp"
+
+/**
+ * Measures how many entries per second a region with an LRU entries limit
+ * overflows to SQLite, with every overflowed entry written on its own and
+ * with the writes batched by the write-behind thread. Each put beyond the
+ * limit evicts one entry to disk; the time includes writing the entries
+ * still queued at the end.
+ */
+
+namespace {
+
+const int LRU_LIMIT = 1000;
+const int ENTRY_COUNT = 100000;
+const int VALUE_SIZE = 1024;
+
+perf::PerfSuite perfSuite("OverflowSqLitePerf");
+
+void runOverflow(const char* regionName, const char* label,
+                 const char* writeBatchSize) {
+  PropertiesPtr sqliteProperties = Properties::create();
+  sqliteProperties->insert(MAX_PAGE_COUNT, "1073741823");
+  sqliteProperties->insert(PAGE_SIZE, "65536");
+  sqliteProperties->insert(PERSISTENCE_DIR, "SqLitePerfData");
+  sqliteProperties->insert(WRITE_BATCH_SIZE, writeBatchSize);
+
+  AttributesFactory attrFactory;
+  attrFactory.setCachingEnabled(true);
+  attrFactory.setLruEntriesLimit(LRU_LIMIT);
+  attrFactory.setInitialCapacity(ENTRY_COUNT);
+  attrFactory.setDiskPolicy(DiskPolicyType::OVERFLOWS);
+  attrFactory.setPersistenceManager("SqLiteImpl", "createSqLiteInstance",
+                                    sqliteProperties);
+  RegionPtr region = CacheHelper::getHelper().rootRegionPtr->createSubregion(
+      regionName, attrFactory.createRegionAttributes());
+  ASSERT(region != nullptr, "failed to create region.");
+
+  std::string value(VALUE_SIZE, 'A');
+  perf::TimeStamp start;
+  for (int i = 0; i < ENTRY_COUNT; i++) {
+    region->put(CacheableInt32::create(i),
+                CacheableString::create(value.c_str()));
+  }
+  region->getAttributes()->getPersistenceManager()->writeAll();
+  perf::TimeStamp stop;
+
+  // the overflowed entries read back, some of them from the queue
+  for (int i = 0; i < ENTRY_COUNT; i += 97) {
+    CacheablePtr read = region->get(CacheableInt32::create(i));
+    ASSERT(read != nullptr, "overflowed entry not found.");
+  }
+
+  char testName[256];
+  ACE_OS::snprintf(testName, 256, "%s, %d entries overflowed", label,
+                   ENTRY_COUNT - LRU_LIMIT);
+  perfSuite.addRecord(testName, ENTRY_COUNT - LRU_LIMIT, start, stop);
+
+  region->localDestroyRegion();
+}
+
+}  // namespace
+
+DUNIT_TASK(s1p1, WriteThrough)
+  { runOverflow("WriteThrough", "write through", "0"); }
+END_TASK(WriteThrough)
+
+DUNIT_TASK(s1p1, SmallBatches)
+  { runOverflow("SmallBatches", "batches of 100", "100"); }
+END_TASK(SmallBatches)
+
+DUNIT_TASK(s1p1, DefaultBatches)
+  { runOverflow("DefaultBatches", "batches of 1000", "1000"); }
+END_TASK(DefaultBatches)
+
+DUNIT_TASK(s1p1, Finish)
+  {
+    perfSuite.save();
+    CacheHelper::getHelper().disconnect();
+  }
+END_TASK(Finish)
@@ -220,3 +220,83 @@ BEGIN_TEST(TestEmptiedMap)
   ASSERT(vecKeys.size() == 10, "expected more entries");
 
 END_TEST(TestEmptiedMap)
+
+BEGIN_TEST(TestRehashKeepsEntries)
+  // The plain region starts out with room for 10 entries, so the segments
+  // rehash many times; every entry must stay visible while the old tables
+  // are being drained.
+  CacheHelper& cacheHelper = CacheHelper::getHelper();
+  RegionPtr regionPtr;
+  cacheHelper.createPlainRegion(fwtest_Name, regionPtr);
+  const int32_t count = 20000;
+  int32_t i;
+  for (i = 0; i < count; i++) {
+    regionPtr->put(CacheableInt32::create(i), CacheableInt32::create(i));
+    int32_t earlier = (i * 7) % (i + 1);
+    auto valuePtr = std::dynamic_pointer_cast<CacheableInt32>(
+        regionPtr->get(CacheableInt32::create(earlier)));
+    ASSERT(valuePtr != nullptr, "expected to find an earlier key.");
+    ASSERT(valuePtr->value() == earlier, "unexpected value.");
+    if (i % 1000 == 0) {
+      VectorOfCacheableKey vecKeys;
+      regionPtr->keys(vecKeys);
+      ASSERT(vecKeys.size() == static_cast<size_t>(i + 1),
+             "unexpected entries count");
+    }
+  }
+  for (i = 0; i < count; i += 2) {
+    regionPtr->destroy(CacheableInt32::create(i));
+  }
+  for (i = 0; i < count; i++) {
+    ASSERT(regionPtr->containsKey(CacheableInt32::create(i)) == (i % 2 == 1),
+           "unexpected containsKey result.");
+  }
+  VectorOfCacheableKey vecKeys;
+  regionPtr->keys(vecKeys);
+  ASSERT(vecKeys.size() == static_cast<size_t>(count / 2),
+         "unexpected entries count");
+END_TEST(TestRehashKeepsEntries)
+
+BEGIN_TEST(TestReserve)
+  CacheHelper& cacheHelper = CacheHelper::getHelper();
+  RegionPtr regionPtr;
+  cacheHelper.createPlainRegion(fwtest_Name, regionPtr);
+  int32_t i;
+  for (i = 0; i < 100; i++) {
+    regionPtr->put(CacheableInt32::create(i), CacheableInt32::create(i));
+  }
+  // widening a populated region must keep its entries
+  regionPtr->reserve(50000);
+  for (i = 100; i < 1000; i++) {
+    regionPtr->put(CacheableInt32::create(i), CacheableInt32::create(i));
+  }
+  // a smaller reservation never shrinks the region
+  regionPtr->reserve(10);
+  for (i = 0; i < 1000; i++) {
+    ASSERT(regionPtr->containsKey(CacheableInt32::create(i)),
+           "expected to find key after reserve.");
+  }
+  ASSERT(regionPtr->size() == 1000, "unexpected entries count");
+END_TEST(TestReserve)
+
+BEGIN_TEST(TestReserveDuringRehash)
+  CacheHelper& cacheHelper = CacheHelper::getHelper();
+  RegionPtr regionPtr;
+  cacheHelper.createPlainRegion(fwtest_Name, regionPtr);
+  int32_t i;
+  for (i = 0; i < 1000; i++) {
+    regionPtr->put(CacheableInt32::create(i), CacheableInt32::create(i));
+  }
+  // the second reservation comes while the entries are still moved over
+  // for the first, it is applied by the writes once they are done
+  regionPtr->reserve(50000);
+  regionPtr->reserve(200000);
+  for (i = 1000; i < 3000; i++) {
+    regionPtr->put(CacheableInt32::create(i), CacheableInt32::create(i));
+  }
+  for (i = 0; i < 3000; i++) {
+    ASSERT(regionPtr->containsKey(CacheableInt32::create(i)),
+           "expected to find key after reserve.");
+  }
+  ASSERT(regionPtr->size() == 3000, "unexpected entries count");
+END_TEST(TestReserveDuringRehash)
@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testThinClientBulkOpsPerf"
+#define ROOT_SCOPE DISTRIBUTED_ACK
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include "CacheHelper.hpp"
+#include "ThinClientHelper.hpp"
+
+/**
+ * Measures the latency of single hop getAll and putAll on a partitioned
+ * region of two servers against the number of keys in the batch, from
+ * batches that go out as one message per server to batches that are split
+ * into sub-batches with several of them in flight per server.
+ */
+
+#define CLIENT1 s1p1
+#define SERVER1 s2p1
+#define SERVER2 s1p2
+
+bool isLocalServer = false;
+static bool isLocator = false;
+const char* locatorsG =
+    CacheHelper::getLocatorHostPort(isLocator, isLocalServer, 1);
+
+namespace {
+
+// keys put and got for each batch size
+const int TOTAL_KEYS = 400000;
+const int VALUE_SIZE = 100;
+
+perf::PerfSuite perfSuite("ThinClientBulkOpsPerf");
+
+void runBatches(int batchSize) {
+  RegionPtr region = getHelper()->getRegion(regionNames[0]);
+  int batches = TOTAL_KEYS / batchSize;
+  std::string value(VALUE_SIZE, 'v');
+
+  HashMapOfCacheable map;
+  VectorOfCacheableKey keys;
+  for (int i = 0; i < batchSize; i++) {
+    auto key = CacheableInt32::create(i);
+    map.emplace(key, CacheableString::create(value.c_str()));
+    keys.push_back(key);
+  }
+
+  perf::TimeStamp putStart;
+  for (int i = 0; i < batches; i++) {
+    region->putAll(map);
+  }
+  perf::TimeStamp putStop;
+
+  perf::TimeStamp getStart;
+  for (int i = 0; i < batches; i++) {
+    auto values = std::make_shared<HashMapOfCacheable>();
+    region->getAll(keys, values, nullptr, false);
+    ASSERT(static_cast<int>(values->size()) == batchSize,
+           "getAll did not return all keys");
+  }
+  perf::TimeStamp getStop;
+
+  char testName[256];
+  ACE_OS::snprintf(testName, 256, "putAll, %d keys per batch", batchSize);
+  perfSuite.addRecord(testName, batches, putStart, putStop);
+  ACE_OS::snprintf(testName, 256, "getAll, %d keys per batch", batchSize);
+  perfSuite.addRecord(testName, batches, getStart, getStop);
+}
+
+}  // namespace
+
+DUNIT_TASK(SERVER1, CreateLocator1)
+  {
+    if (isLocator) CacheHelper::initLocator(1);
+    LOG("Locator1 started");
+  }
+END_TASK(CreateLocator1)
+
+DUNIT_TASK(SERVER1, CreateServer1)
+  {
+    if (isLocalServer) {
+      CacheHelper::initServer(1, "cacheserver1_partitioned.xml", locatorsG);
+    }
+    LOG("SERVER1 started");
+  }
+END_TASK(CreateServer1)
+
+DUNIT_TASK(SERVER2, CreateServer2)
+  {
+    if (isLocalServer) {
+      CacheHelper::initServer(2, "cacheserver2_partitioned.xml", locatorsG);
+    }
+    LOG("SERVER2 started");
+  }
+END_TASK(CreateServer2)
+
+DUNIT_TASK(CLIENT1, CreateClient)
+  {
+    initClient(true);
+    getHelper()->createPoolWithLocators("__TEST_POOL1__", locatorsG);
+    getHelper()->createRegionAndAttachPool(regionNames[0], USE_ACK,
+                                           "__TEST_POOL1__", false);
+    LOG("CreateClient complete.");
+  }
+END_TASK(CreateClient)
+
+DUNIT_TASK(CLIENT1, WarmUp)
+  {
+    // gets the single hop metadata of the region to the client
+    RegionPtr region = getHelper()->getRegion(regionNames[0]);
+    for (int i = 0; i < 1000; i++) {
+      region->put(CacheableInt32::create(i), CacheableInt32::create(i));
+    }
+    SLEEP(5000);
+    runBatches(1000);
+    LOG("WarmUp complete.");
+  }
+END_TASK(WarmUp)
+
+DUNIT_TASK(CLIENT1, Batches)
+  {
+    for (int batchSize : {100, 1000, 10000, 50000, 200000}) {
+      runBatches(batchSize);
+    }
+  }
+END_TASK(Batches)
+
+DUNIT_TASK(CLIENT1, Finish)
+  {
+    perfSuite.save();
+    cleanProc();
+  }
+END_TASK(Finish)
+
+DUNIT_TASK(SERVER1, CloseServer1)
+  {
+    if (isLocalServer) {
+      CacheHelper::closeServer(1);
+      LOG("SERVER1 stopped");
+    }
+  }
+END_TASK(CloseServer1)
+
+DUNIT_TASK(SERVER2, CloseServer2)
+  {
+    if (isLocalServer) {
+      CacheHelper::closeServer(2);
+      LOG("SERVER2 stopped");
+    }
+  }
+END_TASK(CloseServer2)
+
+DUNIT_TASK(SERVER1, CloseLocator1)
+  {
+    if (isLocator) {
+      CacheHelper::closeLocator(1);
+      LOG("Locator1 stopped");
+    }
+  }
+END_TASK(CloseLocator1)
@@ -0,0 +1,232 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testThinClientIoReactorPerf"
+#define ROOT_SCOPE DISTRIBUTED_ACK
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+
+#include "CacheHelper.hpp"
+#include "ThinClientHelper.hpp"
+
+/**
+ * Measures the number of threads of a client with subscription channels to
+ * two servers and pipelined pool connections, and the 99th percentile of the
+ * latency of gets issued at a fixed rate of TARGET_RATE per second. The
+ * latency is taken from the time each get was due, so a stalled thread
+ * counts against the gets it delayed.
+ */
+
+#define CLIENT1 s1p1
+#define SERVER1 s2p1
+#define SERVER2 s1p2
+
+bool isLocalServer = false;
+static bool isLocator = false;
+const char* locatorsG =
+    CacheHelper::getLocatorHostPort(isLocator, isLocalServer, 1);
+
+namespace {
+
+const int KEY_COUNT = 1000;
+const int TARGET_RATE = 10000;
+const int THREADS = 32;
+const int SECONDS = 20;
+const int OPS_PER_THREAD = TARGET_RATE / THREADS * SECONDS;
+
+perf::PerfSuite perfSuite("ThinClientIoReactorPerf");
+
+std::atomic<int> g_threadIndex(0);
+std::mutex g_latenciesLock;
+std::vector<int64_t> g_latencies;
+
+// the threads of this process, or -1 where that is not known
+int threadCount() {
+#ifndef _WIN32
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) {
+    return -1;
+  }
+  int count = 0;
+  while (struct dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      count++;
+    }
+  }
+  closedir(dir);
+  return count;
+#else
+  return -1;
+#endif
+}
+
+int64_t nowMicros() {
+  ACE_Time_Value now = ACE_OS::gettimeofday();
+  return static_cast<int64_t>(now.sec()) * 1000000 + now.usec();
+}
+
+class PacedGetTask : public perf::Thread {
+ private:
+  RegionPtr m_region;
+
+ public:
+  explicit PacedGetTask(const RegionPtr& region)
+      : Thread(), m_region(region) {}
+
+  virtual void perftask() {
+    int index = g_threadIndex++;
+    const int64_t interval = 1000000LL * THREADS / TARGET_RATE;
+    // spread the threads over the interval
+    int64_t due = nowMicros() + (interval * index) / THREADS;
+    std::vector<int64_t> latencies;
+    latencies.reserve(OPS_PER_THREAD);
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+      int64_t now = nowMicros();
+      if (due > now) {
+        ACE_OS::sleep(ACE_Time_Value(0, static_cast<suseconds_t>(due - now)));
+      }
+      m_region->get(CacheableInt32::create((index * 997 + i) % KEY_COUNT));
+      latencies.push_back(nowMicros() - due);
+      due += interval;
+    }
+    std::lock_guard<std::mutex> guard(g_latenciesLock);
+    g_latencies.insert(g_latencies.end(), latencies.begin(), latencies.end());
+  }
+};
+
+}  // namespace
+
+DUNIT_TASK(SERVER1, CreateLocator1)
+  {
+    if (isLocator) CacheHelper::initLocator(1);
+    LOG("Locator1 started");
+  }
+END_TASK(CreateLocator1)
+
+DUNIT_TASK(SERVER1, CreateServer1)
+  {
+    if (isLocalServer) {
+      CacheHelper::initServer(1, "cacheserver_notify_subscription.xml",
+                              locatorsG);
+    }
+    LOG("SERVER1 started");
+  }
+END_TASK(CreateServer1)
+
+DUNIT_TASK(SERVER2, CreateServer2)
+  {
+    if (isLocalServer) {
+      CacheHelper::initServer(2, "cacheserver_notify_subscription2.xml",
+                              locatorsG);
+    }
+    LOG("SERVER2 started");
+  }
+END_TASK(CreateServer2)
+
+DUNIT_TASK(CLIENT1, CreateClient)
+  {
+    initClient(true);
+    int idleThreads = threadCount();
+    PoolFactoryPtr poolFactory =
+        getHelper()->getCache()->getPoolManager().createFactory();
+    getHelper()->addServerLocatorEPs(locatorsG, poolFactory);
+    poolFactory->setSubscriptionEnabled(true);
+    poolFactory->setSubscriptionRedundancy(1);
+    poolFactory->setMaxConnections(8);
+    poolFactory->setMaxRequestsPerConnection(16);
+    poolFactory->create("__TEST_POOL1__");
+    getHelper()->createRegionAndAttachPool(regionNames[0], USE_ACK,
+                                           "__TEST_POOL1__", false);
+    RegionPtr region = getHelper()->getRegion(regionNames[0]);
+    region->registerAllKeys();
+    for (int i = 0; i < KEY_COUNT; i++) {
+      region->put(CacheableInt32::create(i), CacheableInt32::create(i));
+    }
+    char buf[256];
+    ACE_OS::snprintf(buf, 256, "Client threads: %d before the pool, %d after",
+                     idleThreads, threadCount());
+    LOG(buf);
+    LOG("CreateClient complete.");
+  }
+END_TASK(CreateClient)
+
+DUNIT_TASK(CLIENT1, PacedGets)
+  {
+    RegionPtr region = getHelper()->getRegion(regionNames[0]);
+    PacedGetTask task(region);
+    perf::ThreadLauncher launcher(THREADS, task);
+    launcher.go();
+    // the load threads have ended, the rest belong to the client
+    int clientThreads = threadCount();
+
+    std::sort(g_latencies.begin(), g_latencies.end());
+    int64_t p50 = g_latencies[g_latencies.size() / 2];
+    int64_t p99 = g_latencies[g_latencies.size() * 99 / 100];
+    char buf[256];
+    ACE_OS::snprintf(buf, 256,
+                     "%d gets/s: p50 %lld us, p99 %lld us, client threads %d",
+                     TARGET_RATE, static_cast<long long>(p50),
+                     static_cast<long long>(p99), clientThreads);
+    LOG(buf);
+    perfSuite.addRecord("paced gets", OPS_PER_THREAD * THREADS,
+                        launcher.startTime(), launcher.stopTime());
+  }
+END_TASK(PacedGets)
+
+DUNIT_TASK(CLIENT1, Finish)
+  {
+    perfSuite.save();
+    cleanProc();
+  }
+END_TASK(Finish)
+
+DUNIT_TASK(SERVER1, CloseServer1)
+  {
+    if (isLocalServer) {
+      CacheHelper::closeServer(1);
+      LOG("SERVER1 stopped");
+    }
+  }
+END_TASK(CloseServer1)
+
+DUNIT_TASK(SERVER2, CloseServer2)
+  {
+    if (isLocalServer) {
+      CacheHelper::closeServer(2);
+      LOG("SERVER2 stopped");
+    }
+  }
+END_TASK(CloseServer2)
+
+DUNIT_TASK(SERVER1, CloseLocator1)
+  {
+    if (isLocator) {
+      CacheHelper::closeLocator(1);
+      LOG("Locator1 stopped");
+    }
+  }
+END_TASK(CloseLocator1)
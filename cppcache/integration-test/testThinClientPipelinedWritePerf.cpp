@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ROOT_NAME "testThinClientPipelinedWritePerf"
+#define ROOT_SCOPE DISTRIBUTED_ACK
+
+#include "fw_dunit.hpp"
+#include <geode/GeodeCppCache.hpp>
+
+#include <ace/OS.h>
+
+#include "CacheHelper.hpp"
+#include "ThinClientHelper.hpp"
+
+/**
+ * Measures the throughput of small puts and gets from many threads, once on
+ * a pool with a request per connection and once on a pool with pipelined
+ * connections, where the requests queued up while one is written go out in
+ * one write. The socket writes of the pipelined requests are counted and
+ * checked to be fewer than the requests.
+ */
+
+#define CLIENT1 s1p1
+#define SERVER1 s2p1
+
+bool isLocalServer = false;
+static bool isLocator = false;
+const char* locatorsG =
+    CacheHelper::getLocatorHostPort(isLocator, isLocalServer, 1);
+
+namespace {
+
+const int KEY_COUNT = 1000;
+const int THREADS = 64;
+const int OPS_PER_THREAD = 20000;
+
+perf::PerfSuite perfSuite("ThinClientPipelinedWritePerf");
+
+class PutGetTask : public perf::Thread {
+ private:
+  RegionPtr m_region;
+
+ public:
+  explicit PutGetTask(const RegionPtr& region) : Thread(), m_region(region) {}
+
+  virtual void perftask() {
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+      auto key = CacheableInt32::create(i % KEY_COUNT);
+      if (i % 2 == 0) {
+        m_region->put(key, CacheableInt32::create(i));
+      } else {
+        m_region->get(key);
+      }
+    }
+  }
+};
+
+void createPool(const char* poolName, int maxRequestsPerConnection) {
+  PoolFactoryPtr poolFactory =
+      getHelper()->getCache()->getPoolManager().createFactory();
+  getHelper()->addServerLocatorEPs(locatorsG, poolFactory);
+  poolFactory->setMaxConnections(8);
+  poolFactory->setMaxRequestsPerConnection(maxRequestsPerConnection);
+  poolFactory->create(poolName);
+}
+
+void runPutGets(const char* regionName, const char* testName) {
+  RegionPtr region = getHelper()->getRegion(regionName);
+  PutGetTask task(region);
+  perf::ThreadLauncher launcher(THREADS, task);
+  launcher.go();
+  perfSuite.addRecord(testName, OPS_PER_THREAD * THREADS, launcher.startTime(),
+                      launcher.stopTime());
+}
+
+int64_t getCacheStat(const char* name) {
+  auto factory = getHelper()->getCache()->getStatisticsFactory();
+  auto type = factory->findType("CachePerfStats");
+  ASSERT(type != nullptr, "CachePerfStats not found.");
+  auto stats = factory->findFirstStatisticsByType(type);
+  ASSERT(stats != nullptr, "CachePerfStats not found.");
+  return stats->getLong(const_cast<char*>(name));
+}
+
+}  // namespace
+
+DUNIT_TASK(SERVER1, CreateLocator1)
+  {
+    if (isLocator) CacheHelper::initLocator(1);
+    LOG("Locator1 started");
+  }
+END_TASK(CreateLocator1)
+
+DUNIT_TASK(SERVER1, CreateServer1)
+  {
+    if (isLocalServer) {
+      CacheHelper::initServer(1, "cacheserver_notify_subscription.xml",
+                              locatorsG);
+    }
+    LOG("SERVER1 started");
+  }
+END_TASK(CreateServer1)
+
+DUNIT_TASK(CLIENT1, CreateClient)
+  {
+    initClient(true);
+    createPool("__TEST_POOL1__", 1);
+    createPool("__TEST_POOL2__", 16);
+    getHelper()->createRegionAndAttachPool(regionNames[0], USE_ACK,
+                                           "__TEST_POOL1__", false);
+    getHelper()->createRegionAndAttachPool(regionNames[1], USE_ACK,
+                                           "__TEST_POOL2__", false);
+    LOG("CreateClient complete.");
+  }
+END_TASK(CreateClient)
+
+DUNIT_TASK(CLIENT1, NoPipelining)
+  {
+    runPutGets(regionNames[0], "put/get, 1 request per connection");
+  }
+END_TASK(NoPipelining)
+
+DUNIT_TASK(CLIENT1, Pipelining)
+  {
+    runPutGets(regionNames[1], "put/get, 16 requests per connection");
+
+    int64_t requests = getCacheStat("pipelinedRequests");
+    int64_t writes = getCacheStat("pipelinedWrites");
+    char message[256];
+    ACE_OS::snprintf(message, 256,
+                     "%lld pipelined requests went out in %lld socket writes, "
+                     "%.2f requests per write",
+                     static_cast<long long>(requests),
+                     static_cast<long long>(writes),
+                     writes > 0 ? static_cast<double>(requests) / writes : 0.0);
+    LOG(message);
+    ASSERT(requests > 0, "no request was pipelined.");
+    ASSERT(writes < requests, "the pipelined requests were not coalesced.");
+  }
+END_TASK(Pipelining)
+
+DUNIT_TASK(CLIENT1, Finish)
+  {
+    perfSuite.save();
+    cleanProc();
+  }
+END_TASK(Finish)
+
+DUNIT_TASK(SERVER1, CloseServer1)
+  {
+    if (isLocalServer) {
+      CacheHelper::closeServer(1);
+      LOG("SERVER1 stopped");
+    }
+  }
+END_TASK(CloseServer1)
+
+DUNIT_TASK(SERVER1, CloseLocator1)
+  {
+    if (isLocator) {
+      CacheHelper::closeLocator(1);
+      LOG("Locator1 stopped");
+    }
+  }
+END_TASK(CloseLocator1)
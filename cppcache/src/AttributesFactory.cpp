@@ -97,6 +97,13 @@ void AttributesFactory::setInitialCapacity(int initialCapacity) {
   m_regionAttributes.m_initialCapacity = initialCapacity;
 }
 
+void AttributesFactory::setExpectedEntries(int expectedEntries) {
+  if (expectedEntries < 0) {
+    throw IllegalArgumentException("expectedEntries must be >= 0");
+  }
+  m_regionAttributes.m_expectedEntries = expectedEntries;
+}
+
 void AttributesFactory::setLoadFactor(float loadFactor) {
   m_regionAttributes.m_loadFactor = loadFactor;
 }
@@ -172,6 +179,11 @@ void AttributesFactory::setDiskPolicy(
   m_regionAttributes.m_diskPolicy = diskPolicy;
 }
 
+void AttributesFactory::setEvictionPolicy(
+    const EvictionPolicyType::PolicyType evictionPolicy) {
+  m_regionAttributes.m_evictionPolicy = evictionPolicy;
+}
+
 void AttributesFactory::setCachingEnabled(bool cachingEnabled) {
   m_regionAttributes.m_caching = cachingEnabled;
 }
@@ -198,6 +210,9 @@ void AttributesFactory::setCloningEnabled(bool isClonable) {
 void AttributesFactory::setConcurrencyChecksEnabled(bool enable) {
   m_regionAttributes.setConcurrencyChecksEnabled(enable);
 }
+void AttributesFactory::setConcurrentReadsEnabled(bool enable) {
+  m_regionAttributes.setConcurrentReadsEnabled(enable);
+}
 
 }  // namespace client
 }  // namespace geode
@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BigEndian.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define GEODE_BIGENDIAN_HOST
+#elif (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (__GNUC__ > 4) ||        \
+     (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define GEODE_BIGENDIAN_X86
+#include <immintrin.h>
+#define GEODE_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace apache {
+namespace geode {
+namespace client {
+
+namespace {
+
+#ifndef GEODE_BIGENDIAN_HOST
+
+typedef void (*SwapFunction)(const uint8_t*, size_t, uint8_t*);
+
+template <size_t SIZE>
+void swapScalar(const uint8_t* src, size_t count, uint8_t* dst) {
+  for (size_t i = 0; i < count; i++) {
+    for (size_t j = 0; j < SIZE; j++) {
+      dst[j] = src[SIZE - 1 - j];
+    }
+    src += SIZE;
+    dst += SIZE;
+  }
+}
+
+#ifdef GEODE_BIGENDIAN_X86
+
+// shuffle control reversing each SIZE byte value of a 16 byte lane
+template <size_t SIZE>
+GEODE_TARGET("ssse3")
+__m128i swapMask() {
+  uint8_t mask[16];
+  for (size_t i = 0; i < 16; i++) {
+    mask[i] = static_cast<uint8_t>(i - i % SIZE + SIZE - 1 - i % SIZE);
+  }
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+template <size_t SIZE>
+GEODE_TARGET("ssse3")
+void swapSsse3(const uint8_t* src, size_t count, uint8_t* dst) {
+  const __m128i mask = swapMask<SIZE>();
+  size_t length = count * SIZE;
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_shuffle_epi8(v, mask));
+  }
+  swapScalar<SIZE>(src + i, (length - i) / SIZE, dst + i);
+}
+
+template <size_t SIZE>
+GEODE_TARGET("avx2")
+void swapAvx2(const uint8_t* src, size_t count, uint8_t* dst) {
+  // vpshufb works within 128-bit lanes, which is all a byte swap needs
+  const __m256i mask = _mm256_broadcastsi128_si256(swapMask<SIZE>());
+  size_t length = count * SIZE;
+  size_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i high =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_shuffle_epi8(low, mask));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32),
+                        _mm256_shuffle_epi8(high, mask));
+  }
+  swapSsse3<SIZE>(src + i, (length - i) / SIZE, dst + i);
+}
+
+#endif  // GEODE_BIGENDIAN_X86
+
+struct Swappers {
+  SwapFunction swap16;
+  SwapFunction swap32;
+  SwapFunction swap64;
+};
+
+Swappers selectSwappers() {
+#ifdef GEODE_BIGENDIAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Swappers{swapAvx2<2>, swapAvx2<4>, swapAvx2<8>};
+  } else if (__builtin_cpu_supports("ssse3")) {
+    return Swappers{swapSsse3<2>, swapSsse3<4>, swapSsse3<8>};
+  }
+#endif
+  return Swappers{swapScalar<2>, swapScalar<4>, swapScalar<8>};
+}
+
+const Swappers& swappers() {
+  static const Swappers swappers = selectSwappers();
+  return swappers;
+}
+
+#endif  // !GEODE_BIGENDIAN_HOST
+}  // namespace
+
+void BigEndian::copy16(const void* src, size_t count, void* dst) {
+#ifdef GEODE_BIGENDIAN_HOST
+  std::memcpy(dst, src, count * 2);
+#else
+  swappers().swap16(static_cast<const uint8_t*>(src), count,
+                    static_cast<uint8_t*>(dst));
+#endif
+}
+
+void BigEndian::copy32(const void* src, size_t count, void* dst) {
+#ifdef GEODE_BIGENDIAN_HOST
+  std::memcpy(dst, src, count * 4);
+#else
+  swappers().swap32(static_cast<const uint8_t*>(src), count,
+                    static_cast<uint8_t*>(dst));
+#endif
+}
+
+void BigEndian::copy64(const void* src, size_t count, void* dst) {
+#ifdef GEODE_BIGENDIAN_HOST
+  std::memcpy(dst, src, count * 8);
+#else
+  swappers().swap64(static_cast<const uint8_t*>(src), count,
+                    static_cast<uint8_t*>(dst));
+#endif
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
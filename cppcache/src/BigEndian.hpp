@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_BIGENDIAN_H_
+#define GEODE_BIGENDIAN_H_
+
+#include <cstddef>
+
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * Bulk conversion of arrays of fixed size numbers between host and
+ * big-endian byte order, used for the primitive arrays of DataOutput and
+ * DataInput.
+ *
+ * Each function copies count values from src to dst, which must not
+ * overlap, and reverses the bytes of every value on little-endian hosts.
+ * The conversion is its own inverse so the same call serves both
+ * directions. Like ModifiedUtf8 the byte swapping uses SSSE3 or AVX2 when
+ * the CPU has them.
+ */
+class CPPCACHE_EXPORT BigEndian {
+ public:
+  static void copy16(const void* src, size_t count, void* dst);
+  static void copy32(const void* src, size_t count, void* dst);
+  static void copy64(const void* src, size_t count, void* dst);
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_BIGENDIAN_H_
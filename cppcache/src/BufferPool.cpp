@@ -0,0 +1,230 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferPool.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include <geode/ExceptionTypes.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+const uint32_t BufferPool::MIN_BUFFER_SIZE;
+const int BufferPool::SIZE_CLASSES;
+const uint32_t BufferPool::MAX_POOLED_SIZE;
+
+// constant initialized, so it stays readable after the pool itself is
+// destroyed; threads that exit after static destruction see it cleared
+static std::atomic<bool> g_poolAlive(false);
+
+/** Buffers of the smallest size classes cached by a single thread. */
+class BufferPool::Magazine {
+ public:
+  uint8_t* m_buffers[MAGAZINE_CLASSES][MAGAZINE_SIZE];
+  int m_counts[MAGAZINE_CLASSES];
+
+  Magazine() : m_counts() {}
+
+  // hand whatever the exiting thread still holds back to the depots, or
+  // free it when the pool is already gone
+  ~Magazine() {
+    if (!g_poolAlive) {
+      for (int sizeClass = 0; sizeClass < MAGAZINE_CLASSES; sizeClass++) {
+        while (m_counts[sizeClass] > 0) {
+          std::free(m_buffers[sizeClass][--m_counts[sizeClass]]);
+        }
+      }
+      return;
+    }
+    BufferPool& pool = BufferPool::getInstance();
+    for (int sizeClass = 0; sizeClass < MAGAZINE_CLASSES; sizeClass++) {
+      while (m_counts[sizeClass] > 0) {
+        pool.m_magazineBytes -= MIN_BUFFER_SIZE << sizeClass;
+        pool.putInDepot(sizeClass,
+                        m_buffers[sizeClass][--m_counts[sizeClass]]);
+      }
+    }
+  }
+};
+
+BufferPool::BufferPool()
+    : m_maxPooledBytes(16 * 1024 * 1024),
+      m_depotBytes(0),
+      m_magazineBytes(0),
+      m_hits(0),
+      m_misses(0),
+      m_reallocs(0) {
+  g_poolAlive = true;
+}
+
+BufferPool::~BufferPool() {
+  g_poolAlive = false;
+  trim();
+}
+
+BufferPool& BufferPool::getInstance() {
+  static BufferPool instance;
+  return instance;
+}
+
+BufferPool::Magazine& BufferPool::getMagazine() {
+  static thread_local Magazine magazine;
+  return magazine;
+}
+
+int BufferPool::classFor(uint32_t size) {
+  int sizeClass = 0;
+  while (sizeClass < SIZE_CLASSES && (MIN_BUFFER_SIZE << sizeClass) < size) {
+    sizeClass++;
+  }
+  return sizeClass;
+}
+
+int BufferPool::exactClassOf(uint32_t size) {
+  int sizeClass = classFor(size);
+  if (sizeClass < SIZE_CLASSES && (MIN_BUFFER_SIZE << sizeClass) == size) {
+    return sizeClass;
+  }
+  return -1;
+}
+
+uint8_t* BufferPool::allocate(uint32_t size) {
+  auto buffer = static_cast<uint8_t*>(std::malloc(size * sizeof(uint8_t)));
+  if (buffer == nullptr) {
+    throw OutOfMemoryException("Out of Memory while resizing buffer");
+  }
+  return buffer;
+}
+
+uint8_t* BufferPool::takeFromDepot(int sizeClass) {
+  Depot& depot = m_depots[sizeClass];
+  std::lock_guard<spinlock_mutex> guard(depot.m_lock);
+  if (depot.m_buffers.empty()) {
+    return nullptr;
+  }
+  uint8_t* buffer = depot.m_buffers.back();
+  depot.m_buffers.pop_back();
+  m_depotBytes -= MIN_BUFFER_SIZE << sizeClass;
+  return buffer;
+}
+
+void BufferPool::putInDepot(int sizeClass, uint8_t* buffer) {
+  uint32_t size = MIN_BUFFER_SIZE << sizeClass;
+  if (m_depotBytes + size > m_maxPooledBytes) {
+    std::free(buffer);
+    return;
+  }
+  Depot& depot = m_depots[sizeClass];
+  std::lock_guard<spinlock_mutex> guard(depot.m_lock);
+  depot.m_buffers.push_back(buffer);
+  m_depotBytes += size;
+}
+
+uint8_t* BufferPool::acquire(uint32_t minSize, uint32_t* size) {
+  int sizeClass = classFor(minSize);
+  if (sizeClass == SIZE_CLASSES) {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    *size = minSize;
+    return allocate(minSize);
+  }
+
+  *size = MIN_BUFFER_SIZE << sizeClass;
+  if (sizeClass < MAGAZINE_CLASSES) {
+    Magazine& magazine = getMagazine();
+    if (magazine.m_counts[sizeClass] > 0) {
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+      m_magazineBytes -= *size;
+      return magazine.m_buffers[sizeClass][--magazine.m_counts[sizeClass]];
+    }
+  }
+  uint8_t* buffer = takeFromDepot(sizeClass);
+  if (buffer != nullptr) {
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return buffer;
+  }
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+  return allocate(*size);
+}
+
+void BufferPool::release(uint8_t* buffer, uint32_t size) {
+  if (buffer == nullptr) return;
+  int sizeClass = exactClassOf(size);
+  if (sizeClass < 0) {
+    std::free(buffer);
+    return;
+  }
+  if (sizeClass < MAGAZINE_CLASSES) {
+    Magazine& magazine = getMagazine();
+    if (magazine.m_counts[sizeClass] < MAGAZINE_SIZE) {
+      magazine.m_buffers[sizeClass][magazine.m_counts[sizeClass]++] = buffer;
+      m_magazineBytes += size;
+      return;
+    }
+  }
+  putInDepot(sizeClass, buffer);
+}
+
+uint8_t* BufferPool::grow(uint8_t* buffer, uint32_t size, uint32_t used,
+                          uint32_t minSize, uint32_t* newSize) {
+  m_reallocs.fetch_add(1, std::memory_order_relaxed);
+  if (classFor(minSize) < SIZE_CLASSES) {
+    uint8_t* result = acquire(minSize, newSize);
+    std::memcpy(result, buffer, used);
+    release(buffer, size);
+    return result;
+  }
+  // beyond the pooled classes let the allocator grow the buffer in place
+  auto result =
+      static_cast<uint8_t*>(std::realloc(buffer, minSize * sizeof(uint8_t)));
+  if (result == nullptr) {
+    throw OutOfMemoryException("Out of Memory while resizing buffer");
+  }
+  *newSize = minSize;
+  return result;
+}
+
+void BufferPool::trim() {
+  for (int sizeClass = 0; sizeClass < SIZE_CLASSES; sizeClass++) {
+    std::vector<uint8_t*> buffers;
+    {
+      Depot& depot = m_depots[sizeClass];
+      std::lock_guard<spinlock_mutex> guard(depot.m_lock);
+      buffers.swap(depot.m_buffers);
+      m_depotBytes -=
+          static_cast<int64_t>(buffers.size()) * (MIN_BUFFER_SIZE << sizeClass);
+    }
+    for (auto buffer : buffers) {
+      std::free(buffer);
+    }
+  }
+}
+
+BufferPool::Stats BufferPool::getStats() const {
+  Stats stats;
+  stats.bytesPooled = m_depotBytes + m_magazineBytes;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.reallocs = m_reallocs;
+  return stats;
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
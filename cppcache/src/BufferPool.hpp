@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_BUFFERPOOL_H_
+#define GEODE_BUFFERPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <geode/geode_globals.hpp>
+
+#include "util/concurrent/spinlock_mutex.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+using util::concurrent::spinlock_mutex;
+
+/**
+ * Process wide pool of serialization buffers shared by all threads.
+ *
+ * Buffers come in power of two size classes from MIN_BUFFER_SIZE to
+ * MAX_POOLED_SIZE. Each class has a shared depot guarded by a spinlock; the
+ * smallest classes are also cached in a small per-thread magazine so that
+ * the common checkout/checkin of a DataOutput does not touch shared state.
+ * A full magazine spills into the depot, the depot frees buffers once it
+ * holds more than getMaxPooledBytes(), and a thread's magazine is handed back
+ * to the depot when the thread exits, or freed if the pool has already been
+ * destroyed by then.
+ *
+ * Buffers larger than MAX_POOLED_SIZE are plain heap allocations that are
+ * freed on release.
+ */
+class CPPCACHE_EXPORT BufferPool {
+ public:
+  static const uint32_t MIN_BUFFER_SIZE = 8192;
+  static const int SIZE_CLASSES = 8;
+  static const uint32_t MAX_POOLED_SIZE = MIN_BUFFER_SIZE
+                                          << (SIZE_CLASSES - 1);
+
+  /** Counters of the pool, see getStats(). */
+  struct Stats {
+    // bytes currently held by the depots and magazines
+    int64_t bytesPooled;
+    // checkouts served from the pool
+    int64_t hits;
+    // checkouts that had to allocate a new buffer
+    int64_t misses;
+    // buffers grown by moving their contents to a larger one
+    int64_t reallocs;
+  };
+
+  static BufferPool& getInstance();
+
+  /**
+   * Check out a buffer of at least minSize bytes; its actual size is
+   * returned in size. Throws OutOfMemoryException on allocation failure.
+   */
+  uint8_t* acquire(uint32_t minSize, uint32_t* size);
+
+  /** Check in a buffer obtained from acquire() or grow(). */
+  void release(uint8_t* buffer, uint32_t size);
+
+  /**
+   * Replace a checked out buffer with one of at least minSize bytes that
+   * holds the first used bytes of the old one. The old buffer is released.
+   */
+  uint8_t* grow(uint8_t* buffer, uint32_t size, uint32_t used,
+                uint32_t minSize, uint32_t* newSize);
+
+  /** Free every buffer held by the depots. */
+  void trim();
+
+  Stats getStats() const;
+
+  /** Upper bound on the bytes held by the depots. */
+  inline void setMaxPooledBytes(int64_t maxPooledBytes) {
+    m_maxPooledBytes = maxPooledBytes;
+  }
+
+  inline int64_t getMaxPooledBytes() const { return m_maxPooledBytes; }
+
+ private:
+  // only the smallest classes are cached per thread, which bounds what an
+  // idle thread can pin
+  static const int MAGAZINE_CLASSES = 3;
+  static const int MAGAZINE_SIZE = 2;
+
+  struct Depot {
+    spinlock_mutex m_lock;
+    std::vector<uint8_t*> m_buffers;
+  };
+
+  class Magazine;
+
+  Depot m_depots[SIZE_CLASSES];
+  std::atomic<int64_t> m_maxPooledBytes;
+  std::atomic<int64_t> m_depotBytes;
+  std::atomic<int64_t> m_magazineBytes;
+  std::atomic<int64_t> m_hits;
+  std::atomic<int64_t> m_misses;
+  std::atomic<int64_t> m_reallocs;
+
+  BufferPool();
+  ~BufferPool();
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  static Magazine& getMagazine();
+
+  // index of the smallest class holding size bytes, SIZE_CLASSES if none
+  static int classFor(uint32_t size);
+  // index of the class of exactly size bytes, -1 if none
+  static int exactClassOf(uint32_t size);
+
+  static uint8_t* allocate(uint32_t size);
+
+  uint8_t* takeFromDepot(int sizeClass);
+  void putInDepot(int sizeClass, uint8_t* buffer);
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_BUFFERPOOL_H_
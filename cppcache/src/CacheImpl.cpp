@@ -43,6 +43,7 @@
 #include "PdxTypeRegistry.hpp"
 #include "SerializationRegistry.hpp"
 #include "ThreadPool.hpp"
+#include "BufferPool.hpp"
 
 using namespace apache::geode::client;
 
@@ -69,26 +70,33 @@ CacheImpl::CacheImpl(Cache* c, const std::string& name,
           *(std::make_shared<MemberListForVersionStamp>())),
       m_serializationRegistry(std::make_shared<SerializationRegistry>()),
       m_pdxTypeRegistry(std::make_shared<PdxTypeRegistry>(c)),
-      m_expiryTaskManager(
-          std::unique_ptr<ExpiryTaskManager>(new ExpiryTaskManager())),
       m_clientProxyMembershipIDFactory(m_distributedSystem->getName()),
       m_threadPool(new ThreadPool(
-          m_distributedSystem->getSystemProperties().threadPoolSize())) {
+          m_distributedSystem->getSystemProperties().threadPoolSize())),
+      m_asyncThreadPool(nullptr),
+      m_asyncWorks(0),
+      m_asyncClosed(false) {
   m_cacheTXManager = InternalCacheTransactionManager2PCPtr(
       new InternalCacheTransactionManager2PCImpl(c));
 
   m_regions = new MapOfRegionWithLock();
   auto& prop = m_distributedSystem->getSystemProperties();
+  m_expiryTaskManager = std::unique_ptr<ExpiryTaskManager>(
+      new ExpiryTaskManager(prop.expiryTimingWheel()));
   if (prop.heapLRULimitEnabled()) {
     m_evictionControllerPtr =
-        new EvictionController(prop.heapLRULimit(), prop.heapLRUDelta(), this);
-    m_evictionControllerPtr->start();
-    LOGINFO("Heap LRU eviction controller thread started");
+        new EvictionController(prop.heapLRULimit(), prop.heapLRUDelta(),
+                               prop.heapLRUEvictionThreads(), this);
   }
 
   m_cacheStats = new CachePerfStats(m_distributedSystem.get()
                                         ->getStatisticsManager()
                                         ->getStatisticsFactory());
+  // the controller records its statistics from the start
+  if (m_evictionControllerPtr != nullptr) {
+    m_evictionControllerPtr->start();
+    LOGINFO("Heap LRU eviction controller thread started");
+  }
   m_expiryTaskManager->begin();
 
   m_initialized = true;
@@ -258,6 +266,8 @@ void CacheImpl::close(bool keepalive) {
     m_destroyPending = true;
   }
 
+  stopAsyncWorks();
+
   if (m_closed || (!m_initialized)) return;
 
   // Close the distribution manager used for queries.
@@ -325,6 +335,9 @@ void CacheImpl::close(bool keepalive) {
 
   m_expiryTaskManager->stopExpiryTaskManager();
 
+  // let go of the idle serialization buffers pooled for this cache's threads
+  BufferPool::getInstance().trim();
+
   m_closed = true;
 
   LOGFINE("Cache closed.");
@@ -794,6 +807,44 @@ SerializationRegistryPtr CacheImpl::getSerializationRegistry() const {
 
 ThreadPool* CacheImpl::getThreadPool() { return m_threadPool; }
 
+bool CacheImpl::performAsync(ACE_Method_Request* work) {
+  std::lock_guard<std::mutex> guard(m_asyncLock);
+  if (m_asyncClosed) {
+    return false;
+  }
+  if (m_asyncThreadPool == nullptr) {
+    m_asyncThreadPool = new ThreadPool(
+        m_distributedSystem->getSystemProperties().asyncThreadPoolSize());
+  }
+  ++m_asyncWorks;
+  m_asyncThreadPool->perform(work);
+  return true;
+}
+
+void CacheImpl::asyncWorkDone() {
+  std::lock_guard<std::mutex> guard(m_asyncLock);
+  if (--m_asyncWorks == 0) {
+    m_asyncCond.notify_all();
+  }
+}
+
+void CacheImpl::stopAsyncWorks() {
+  ThreadPool* threadPool;
+  {
+    std::unique_lock<std::mutex> lock(m_asyncLock);
+    m_asyncClosed = true;
+    // the works that did not start yet see the cache closing and fail
+    m_asyncCond.wait(lock, [this] { return m_asyncWorks == 0; });
+    threadPool = m_asyncThreadPool;
+    m_asyncThreadPool = nullptr;
+  }
+  if (threadPool != nullptr) {
+    threadPool->shutDown();
+    delete threadPool;
+    LOGFINE("Stopped the thread pool of asynchronous region operations");
+  }
+}
+
 CacheTransactionManagerPtr CacheImpl::getCacheTransactionManager() {
   return m_cacheTXManager;
 }
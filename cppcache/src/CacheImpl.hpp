@@ -23,7 +23,9 @@
 #include <atomic>
 
 #include <geode/geode_globals.hpp>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 #include <geode/Cache.hpp>
 #include <geode/CacheAttributes.hpp>
@@ -32,6 +34,7 @@
 #include <ace/ACE.h>
 #include <ace/Time_Value.h>
 #include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
 #include <ace/Recursive_Thread_Mutex.h>
 #include "Condition.hpp"
 #include "TcrConnectionManager.hpp"
@@ -282,6 +285,18 @@ class CPPCACHE_EXPORT CacheImpl : private NonCopyable, private NonAssignable {
 
   ThreadPool* getThreadPool();
 
+  /**
+   * Runs the work of an asynchronous region operation on a thread pool
+   * created on first use. The pool is kept apart from getThreadPool(),
+   * because the operations may wait for works in that pool. Returns false,
+   * without running the work, once the cache is closing. close() waits for
+   * the works started to call asyncWorkDone() and then stops the pool.
+   */
+  bool performAsync(ACE_Method_Request* work);
+
+  /** Called by a work passed to performAsync() once it has run. */
+  void asyncWorkDone();
+
  private:
   std::atomic<bool> m_networkhop;
   std::atomic<int> m_blacklistBucketTimeout;
@@ -307,6 +322,10 @@ class CPPCACHE_EXPORT CacheImpl : private NonCopyable, private NonAssignable {
 
   void sendNotificationCloseMsgs();
 
+  // fails the asynchronous region operations not started yet, waits for
+  // the others and stops their pool
+  void stopAsyncWorks();
+
   void validateRegionAttributes(const char* name,
                                 const RegionAttributesPtr& attrs) const;
 
@@ -343,6 +362,13 @@ class CPPCACHE_EXPORT CacheImpl : private NonCopyable, private NonAssignable {
   SerializationRegistryPtr m_serializationRegistry;
   PdxTypeRegistryPtr m_pdxTypeRegistry;
   ThreadPool* m_threadPool;
+  // the pool of the asynchronous region operations, the works passed to it
+  // that have not run yet and whether it takes more
+  std::mutex m_asyncLock;
+  std::condition_variable m_asyncCond;
+  ThreadPool* m_asyncThreadPool;
+  uint32_t m_asyncWorks;
+  bool m_asyncClosed;
 
   friend class CacheFactory;
   friend class Cache;
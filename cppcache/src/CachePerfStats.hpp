@@ -40,7 +40,7 @@ class CPPCACHE_EXPORT CachePerfStats {
 
     if (statsType == nullptr) {
       const bool largerIsBetter = true;
-      StatisticDescriptor** statDescArr = new StatisticDescriptor*[24];
+      StatisticDescriptor** statDescArr = new StatisticDescriptor*[35];
 
       statDescArr[0] = factory->createIntCounter(
           "creates", "The total number of cache creates", "entries",
@@ -134,10 +134,63 @@ class CPPCACHE_EXPORT CachePerfStats {
           "pdxDeserializedBytes",
           "Total number of bytes read by pdx deserialization.", "entries",
           !largerIsBetter);
+      statDescArr[24] = factory->createLongGauge(
+          "rehashPauseTimeMax",
+          "The longest time, in nanoseconds, a single operation spent "
+          "rehashing a region entries map segment",
+          "nanoseconds", !largerIsBetter);
+      statDescArr[25] = factory->createLongGauge(
+          "heapLRUSize",
+          "The bytes the entries of the regions with heap LRU take, as "
+          "accounted for by the eviction controller",
+          "bytes", !largerIsBetter);
+      statDescArr[26] = factory->createLongCounter(
+          "heapLRUEvictedBytes",
+          "Total number of bytes freed by heap LRU eviction", "bytes",
+          !largerIsBetter);
+      statDescArr[27] = factory->createLongGauge(
+          "heapLRUAccountingError",
+          "The bytes by which the accounted heap LRU size was off at its last "
+          "recount",
+          "bytes", !largerIsBetter);
+      statDescArr[28] = factory->createLongGauge(
+          "heapLRUEvictionLag",
+          "The time, in nanoseconds, the heap LRU size has been over the "
+          "limit, or was at the last time it went over",
+          "nanoseconds", !largerIsBetter);
+      statDescArr[29] = factory->createLongGauge(
+          "heapLRUEvictionBacklog",
+          "The bytes ordered to be evicted by heap LRU that the eviction "
+          "threads have not got to yet",
+          "bytes", !largerIsBetter);
+      statDescArr[30] = factory->createIntCounter(
+          "heapLRUPutDelays",
+          "Total number of puts held back because heap LRU eviction fell "
+          "behind",
+          "operations", !largerIsBetter);
+      statDescArr[31] = factory->createLongCounter(
+          "heapLRUPutDelayTime",
+          "Total time, in nanoseconds, puts were held back because heap LRU "
+          "eviction fell behind",
+          "nanoseconds", !largerIsBetter);
+      statDescArr[32] = factory->createIntCounter(
+          "heapLRUPutsNotDelayed",
+          "Total number of puts not held back although heap LRU eviction "
+          "fell behind, because its last round freed nothing",
+          "operations", !largerIsBetter);
+      statDescArr[33] = factory->createLongCounter(
+          "pipelinedRequests",
+          "Total number of requests written on pipelined connections",
+          "operations", largerIsBetter);
+      statDescArr[34] = factory->createLongCounter(
+          "pipelinedWrites",
+          "Total number of socket writes the requests on pipelined "
+          "connections took",
+          "operations", !largerIsBetter);
 
       statsType = factory->createType("CachePerfStats",
                                       "Statistics about native client cache",
-                                      statDescArr, 24);
+                                      statDescArr, 35);
     }
     GF_D_ASSERT(statsType != nullptr);
     // Create Statistics object
@@ -172,6 +225,17 @@ class CPPCACHE_EXPORT CachePerfStats {
     m_pdxSerializedBytesId = statsType->nameToId("pdxSerializedBytes");
     m_pdxDeserializationsId = statsType->nameToId("pdxDeserializations");
     m_pdxDeserializedBytesId = statsType->nameToId("pdxDeserializedBytes");
+    m_rehashPauseTimeMaxId = statsType->nameToId("rehashPauseTimeMax");
+    m_heapLRUSizeId = statsType->nameToId("heapLRUSize");
+    m_heapLRUEvictedBytesId = statsType->nameToId("heapLRUEvictedBytes");
+    m_heapLRUAccountingErrorId = statsType->nameToId("heapLRUAccountingError");
+    m_heapLRUEvictionLagId = statsType->nameToId("heapLRUEvictionLag");
+    m_heapLRUEvictionBacklogId = statsType->nameToId("heapLRUEvictionBacklog");
+    m_heapLRUPutDelaysId = statsType->nameToId("heapLRUPutDelays");
+    m_heapLRUPutDelayTimeId = statsType->nameToId("heapLRUPutDelayTime");
+    m_heapLRUPutsNotDelayedId = statsType->nameToId("heapLRUPutsNotDelayed");
+    m_pipelinedRequestsId = statsType->nameToId("pipelinedRequests");
+    m_pipelinedWritesId = statsType->nameToId("pipelinedWrites");
 
     // Set initial value
     m_cachePerfStats->setInt(m_destroysId, 0);
@@ -198,6 +262,17 @@ class CPPCACHE_EXPORT CachePerfStats {
     m_cachePerfStats->setLong(m_pdxSerializedBytesId, 0);
     m_cachePerfStats->setInt(m_pdxDeserializationsId, 0);
     m_cachePerfStats->setLong(m_pdxDeserializedBytesId, 0);
+    m_cachePerfStats->setLong(m_rehashPauseTimeMaxId, 0);
+    m_cachePerfStats->setLong(m_heapLRUSizeId, 0);
+    m_cachePerfStats->setLong(m_heapLRUEvictedBytesId, 0);
+    m_cachePerfStats->setLong(m_heapLRUAccountingErrorId, 0);
+    m_cachePerfStats->setLong(m_heapLRUEvictionLagId, 0);
+    m_cachePerfStats->setLong(m_heapLRUEvictionBacklogId, 0);
+    m_cachePerfStats->setInt(m_heapLRUPutDelaysId, 0);
+    m_cachePerfStats->setLong(m_heapLRUPutDelayTimeId, 0);
+    m_cachePerfStats->setInt(m_heapLRUPutsNotDelayedId, 0);
+    m_cachePerfStats->setLong(m_pipelinedRequestsId, 0);
+    m_cachePerfStats->setLong(m_pipelinedWritesId, 0);
   }
 
   virtual ~CachePerfStats() { m_cachePerfStats = nullptr; }
@@ -329,6 +404,58 @@ class CPPCACHE_EXPORT CachePerfStats {
     return m_cachePerfStats->getLong(m_pdxDeserializedBytesId);
   }
 
+  inline void setMaxRehashPauseTime(int64_t nanos) {
+    if (nanos > m_cachePerfStats->getLong(m_rehashPauseTimeMaxId)) {
+      m_cachePerfStats->setLong(m_rehashPauseTimeMaxId, nanos);
+    }
+  }
+
+  inline int64_t getMaxRehashPauseTime() {
+    return m_cachePerfStats->getLong(m_rehashPauseTimeMaxId);
+  }
+
+  inline void setHeapLRUSize(int64_t bytes) {
+    m_cachePerfStats->setLong(m_heapLRUSizeId, bytes);
+  }
+
+  inline void incHeapLRUEvictedBytes(int64_t bytes) {
+    m_cachePerfStats->incLong(m_heapLRUEvictedBytesId, bytes);
+  }
+
+  inline int64_t getHeapLRUEvictedBytes() {
+    return m_cachePerfStats->getLong(m_heapLRUEvictedBytesId);
+  }
+
+  inline void setHeapLRUAccountingError(int64_t bytes) {
+    m_cachePerfStats->setLong(m_heapLRUAccountingErrorId, bytes);
+  }
+
+  inline void setHeapLRUEvictionLag(int64_t nanos) {
+    m_cachePerfStats->setLong(m_heapLRUEvictionLagId, nanos);
+  }
+
+  inline void setHeapLRUEvictionBacklog(int64_t bytes) {
+    m_cachePerfStats->setLong(m_heapLRUEvictionBacklogId, bytes);
+  }
+
+  inline void incHeapLRUPutDelays(int64_t nanos) {
+    m_cachePerfStats->incInt(m_heapLRUPutDelaysId, 1);
+    m_cachePerfStats->incLong(m_heapLRUPutDelayTimeId, nanos);
+  }
+
+  inline int32_t getHeapLRUPutDelays() {
+    return m_cachePerfStats->getInt(m_heapLRUPutDelaysId);
+  }
+
+  inline void incHeapLRUPutsNotDelayed() {
+    m_cachePerfStats->incInt(m_heapLRUPutsNotDelayedId, 1);
+  }
+
+  inline void incPipelinedWrites(int64_t requests, int64_t writes) {
+    m_cachePerfStats->incLong(m_pipelinedRequestsId, requests);
+    m_cachePerfStats->incLong(m_pipelinedWritesId, writes);
+  }
+
  private:
   Statistics* m_cachePerfStats;
 
@@ -356,6 +483,17 @@ class CPPCACHE_EXPORT CachePerfStats {
   int32_t m_pdxSerializedBytesId;
   int32_t m_pdxDeserializationsId;
   int32_t m_pdxDeserializedBytesId;
+  int32_t m_rehashPauseTimeMaxId;
+  int32_t m_heapLRUSizeId;
+  int32_t m_heapLRUEvictedBytesId;
+  int32_t m_heapLRUAccountingErrorId;
+  int32_t m_heapLRUEvictionLagId;
+  int32_t m_heapLRUEvictionBacklogId;
+  int32_t m_heapLRUPutDelaysId;
+  int32_t m_heapLRUPutDelayTimeId;
+  int32_t m_heapLRUPutsNotDelayedId;
+  int32_t m_pipelinedRequestsId;
+  int32_t m_pipelinedWritesId;
 };
 }  // namespace client
 }  // namespace geode
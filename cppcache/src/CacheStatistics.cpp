@@ -31,7 +31,10 @@ void CacheStatistics::setLastModifiedTime(uint32_t lmt) {
 }
 
 void CacheStatistics::setLastAccessedTime(uint32_t lat) {
-  m_lastAccessTime = lat;
+  // set on every read of the region, stored once a second
+  if (m_lastAccessTime.load(std::memory_order_relaxed) != lat) {
+    m_lastAccessTime.store(lat, std::memory_order_relaxed);
+  }
 }
 
 uint32_t CacheStatistics::getLastModifiedTime() const {
@@ -41,6 +41,8 @@ CacheXml::CacheXml() {
 
   DISK_POLICY = "disk-policy";
 
+  EVICTION_POLICY = "eviction-policy";
+
   ENDPOINTS = "endpoints";
 
   /** The name of the <code>region-time-to-live</code> element */
@@ -89,6 +91,9 @@ CacheXml::CacheXml() {
   /** The name of the <code>initial-capacity</code> attribute */
   INITIAL_CAPACITY = "initial-capacity";
 
+  /** The name of the <code>expected-entries</code> attribute */
+  EXPECTED_ENTRIES = "expected-entries";
+
   /** The name of the <code>initial-capacity</code> attribute */
   CONCURRENCY_LEVEL = "concurrency-level";
 
@@ -148,6 +153,8 @@ CacheXml::CacheXml() {
 
   CONCURRENCY_CHECKS_ENABLED = "concurrency-checks-enabled";
 
+  CONCURRENT_READS_ENABLED = "concurrent-reads-enabled";
+
   TOMBSTONE_TIMEOUT = "tombstone-timeout";
 
   /** Pool elements and attributes */
@@ -57,6 +57,9 @@ class CPPCACHE_EXPORT CacheXml {
   /** The name of the <code>lru-eviction-action</code> attribute **/
   const char* DISK_POLICY;
 
+  /** The name of the <code>eviction-policy</code> attribute **/
+  const char* EVICTION_POLICY;
+
   /** The name of the <code>endpoints</code> attribute **/
   const char* ENDPOINTS;
 
@@ -109,6 +112,9 @@ class CPPCACHE_EXPORT CacheXml {
   /** The name of the <code>initial-capacity</code> attribute */
   const char* INITIAL_CAPACITY;
 
+  /** The name of the <code>expected-entries</code> attribute */
+  const char* EXPECTED_ENTRIES;
+
   /** The name of the <code>initial-capacity</code> attribute */
   const char* CONCURRENCY_LEVEL;
 
@@ -202,6 +208,7 @@ class CPPCACHE_EXPORT CacheXml {
   const char* MULTIUSER_SECURE_MODE;
   const char* PR_SINGLE_HOP_ENABLED;
   const char* CONCURRENCY_CHECKS_ENABLED;
+  const char* CONCURRENT_READS_ENABLED;
   const char* TOMBSTONE_TIMEOUT;
 
   /** Name of the named region attributes */
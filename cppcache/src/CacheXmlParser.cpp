@@ -21,6 +21,10 @@
 #include "AutoDelete.hpp"
 #include "CacheImpl.hpp"
 
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
 #if defined(_WIN32)
 #include <windows.h>
 #else
@@ -875,6 +879,21 @@ void CacheXmlParser::startRegionAttributes(const xmlChar** atts) {
         i++;
         char* initialCapacity = (char*)atts[i];
         attrsFactory->setInitialCapacity(atoi(initialCapacity));
+      } else if (strcmp(EXPECTED_ENTRIES, (char*)atts[i]) == 0) {
+        i++;
+        char* expectedEntries = (char*)atts[i];
+        char* end = nullptr;
+        errno = 0;
+        long value = strtol(expectedEntries, &end, 10);
+        if (end == expectedEntries || *end != '\0' || errno == ERANGE ||
+            value < 0 || value > INT_MAX) {
+          std::string temp(expectedEntries);
+          std::string s =
+              "XML: " + temp +
+              " is not a valid value for the attribute <expected-entries>";
+          throw CacheXmlException(s.c_str());
+        }
+        attrsFactory->setExpectedEntries(static_cast<int>(value));
       } else if (strcmp(CONCURRENCY_LEVEL, (char*)atts[i]) == 0) {
         i++;
         char* concurrencyLevel = (char*)atts[i];
@@ -928,6 +947,20 @@ void CacheXmlParser::startRegionAttributes(const xmlChar** atts) {
               " is not a valid value for the attribute <disk-policy>";
           throw CacheXmlException(s.c_str());
         }
+      } else if (strcmp(EVICTION_POLICY, (char*)atts[i]) == 0) {
+        i++;
+        char* evictionPolicy = (char*)atts[i];
+        EvictionPolicyType::PolicyType policy =
+            EvictionPolicyType::fromName(evictionPolicy);
+        if (strcmp(EvictionPolicyType::fromOrdinal(policy), evictionPolicy) !=
+            0) {
+          std::string temp(evictionPolicy);
+          std::string s =
+              "XML: " + temp +
+              " is not a valid value for the attribute <eviction-policy>";
+          throw CacheXmlException(s.c_str());
+        }
+        attrsFactory->setEvictionPolicy(policy);
       } else if (strcmp(ENDPOINTS, (char*)atts[i]) == 0) {
         i++;
         if (m_poolFactory) {
@@ -986,6 +1019,25 @@ void CacheXmlParser::startRegionAttributes(const xmlChar** atts) {
           throw CacheXmlException(s.c_str());
         }
         attrsFactory->setConcurrencyChecksEnabled(flag);
+      } else if (strcmp(CONCURRENT_READS_ENABLED, (char*)atts[i]) == 0) {
+        bool flag = false;
+        i++;
+        char* concurrentReadsEnabled = (char*)atts[i];
+        if (strcmp("true", concurrentReadsEnabled) == 0 ||
+            strcmp("TRUE", concurrentReadsEnabled) == 0) {
+          flag = true;
+        } else if (strcmp("false", concurrentReadsEnabled) == 0 ||
+                   strcmp("FALSE", concurrentReadsEnabled) == 0) {
+          flag = false;
+        } else {
+          char* name = (char*)atts[i];
+          std::string temp(name);
+          std::string s = "XML: " + temp +
+                          " is not a valid value for the attribute "
+                          "<concurrent-reads-enabled>";
+          throw CacheXmlException(s.c_str());
+        }
+        attrsFactory->setConcurrentReadsEnabled(flag);
       }
     }  // for loop
   }    // atts is nullptr
@@ -27,7 +27,7 @@ bool EntriesMap::boolVal = false;
 ConcurrentEntriesMap::ConcurrentEntriesMap(
     ExpiryTaskManager* expiryTaskManager,
     std::unique_ptr<EntryFactory> entryFactory, bool concurrencyChecksEnabled,
-    RegionInternal* region, uint8_t concurrency)
+    RegionInternal* region, uint8_t concurrency, bool concurrentReads)
     : EntriesMap(std::move(entryFactory)),
       m_expiryTaskManager(expiryTaskManager),
       m_concurrency(0),
@@ -35,7 +35,8 @@ ConcurrentEntriesMap::ConcurrentEntriesMap(
       m_size(0),
       m_region(region),
       m_numDestroyTrackers(0),
-      m_concurrencyChecksEnabled(concurrencyChecksEnabled) {
+      m_concurrencyChecksEnabled(concurrencyChecksEnabled),
+      m_concurrentReads(concurrentReads) {
   GF_DEV_ASSERT(entryFactory != nullptr);
 
   uint8_t maxConcurrency = TableOfPrimes::getMaxPrimeForConcurrency();
@@ -52,7 +53,7 @@ void ConcurrentEntriesMap::open(uint32_t initialCapacity) {
   for (int index = 0; index < m_concurrency; ++index) {
     m_segments[index].open(m_region, getEntryFactory(), m_expiryTaskManager,
                            segSize, &m_numDestroyTrackers,
-                           m_concurrencyChecksEnabled);
+                           m_concurrencyChecksEnabled, m_concurrentReads);
   }
 }
 
@@ -61,6 +62,14 @@ void ConcurrentEntriesMap::close() {
     m_segments[index].close();
   }
 }
+
+void ConcurrentEntriesMap::reserve(uint32_t expectedEntries) {
+  if (expectedEntries == 0) return;
+  uint32_t segSize = 1 + (expectedEntries - 1) / m_concurrency;
+  for (int index = 0; index < m_concurrency; ++index) {
+    m_segments[index].reserve(segSize);
+  }
+}
 void ConcurrentEntriesMap::clear() {
   for (uint32_t index = 0; index < m_concurrency; index++) {
     m_segments[index].clear();
@@ -224,6 +233,17 @@ uint32_t ConcurrentEntriesMap::totalSegmentRehashes() const {
   }
   return result;
 }
+
+/**
+ * @brief return the longest rehash pause of any segment.
+ */
+int64_t ConcurrentEntriesMap::maxSegmentRehashPause() const {
+  int64_t result = 0;
+  for (int index = 0; index < m_concurrency; ++index) {
+    result = std::max(result, m_segments[index].maxRehashPause());
+  }
+  return result;
+}
 void ConcurrentEntriesMap::reapTombstones(
     std::map<uint16_t, int64_t>& gcVersions) {
   for (int index = 0; index < m_concurrency; ++index) {
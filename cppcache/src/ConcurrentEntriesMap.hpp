@@ -45,6 +45,7 @@ class CPPCACHE_EXPORT ConcurrentEntriesMap : public EntriesMap {
   RegionInternal* m_region;
   std::atomic<int32_t> m_numDestroyTrackers;
   bool m_concurrencyChecksEnabled;
+  bool m_concurrentReads;
   // TODO:  hashcode() is invoked 3-4 times -- need a better
   // implementation (STLport hash_map?) that will invoke it only once
   /**
@@ -70,11 +71,13 @@ class CPPCACHE_EXPORT ConcurrentEntriesMap : public EntriesMap {
  public:
   /**
    * @brief constructor, must call open before using map.
+   * If concurrentReads is true, lookups in a segment proceed in parallel
+   * and are serialized only against writers to that segment.
    */
   ConcurrentEntriesMap(ExpiryTaskManager* expiryTaskManager,
                        std::unique_ptr<EntryFactory> entryFactory,
                        bool concurrencyChecksEnabled, RegionInternal* region,
-                       uint8_t concurrency = 16);
+                       uint8_t concurrency = 16, bool concurrentReads = false);
 
   /**
    * Initialize segments with proper EntryFactory.
@@ -83,6 +86,8 @@ class CPPCACHE_EXPORT ConcurrentEntriesMap : public EntriesMap {
 
   virtual void close();
 
+  virtual void reserve(uint32_t expectedEntries);
+
   virtual ~ConcurrentEntriesMap();
 
   virtual void clear();
@@ -167,6 +172,12 @@ class CPPCACHE_EXPORT ConcurrentEntriesMap : public EntriesMap {
    * has rehashed.
    */
   uint32_t totalSegmentRehashes() const;
+
+  /**
+   * for internal testing, return the longest time, in nanoseconds, that a
+   * single operation spent rehashing any segment.
+   */
+  int64_t maxSegmentRehashPause() const;
 };  // class EntriesMap
 }  // namespace client
 }  // namespace geode
@@ -20,6 +20,7 @@
  * limitations under the License.
  */
 
+#include <ace/os_include/sys/os_uio.h>
 #include <geode/geode_globals.hpp>
 #include <geode/ExceptionTypes.hpp>
 
@@ -84,6 +85,31 @@ class Connector {
   virtual int32_t send(const char *b, int32_t len, uint32_t waitSeconds,
                        uint32_t waitMicroSeconds) = 0;
 
+  /**
+   * Writes the <code>count</code> buffers in <code>segments</code>, in order,
+   * to the underlying output stream. Connectors that cannot gather the
+   * buffers into one write fall back to sending them one by one.
+   *
+   * @param      segments   the buffers to write.
+   * @param      count   the number of buffers.
+   * @param      waitSeconds   the number of seconds to allow the write to
+   * complete.
+   * @return     the actual number of bytes written.
+   * @exception  GeodeIOException, TimeoutException, IllegalArgumentException.
+   */
+  virtual int32_t sendv(const iovec *segments, int32_t count,
+                        uint32_t waitSeconds, uint32_t waitMicroSeconds) {
+    int32_t totalsend = 0;
+    for (int32_t i = 0; i < count; i++) {
+      int32_t len = static_cast<int32_t>(segments[i].iov_len);
+      int32_t sent = send(static_cast<const char *>(segments[i].iov_base), len,
+                          waitSeconds, waitMicroSeconds);
+      totalsend += sent;
+      if (sent < len) break;
+    }
+    return totalsend;
+  }
+
   /**
    * Initialises the connection.
    */
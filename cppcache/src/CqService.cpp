@@ -31,7 +31,6 @@ CqService::CqService(ThinClientBaseDM* tccdm,
                      StatisticsFactory* statisticsFactory)
     : m_tccdm(tccdm),
       m_statisticsFactory(statisticsFactory),
-      m_notificationSema(1),
       m_stats(std::make_shared<CqServiceVsdStats>(m_statisticsFactory)) {
   m_cqQueryMap = new MapOfCqQueryWithLock();
   m_running = true;
@@ -71,9 +70,9 @@ void CqService::updateStats() {
 
 bool CqService::checkAndAcquireLock() {
   if (m_running) {
-    m_notificationSema.acquire();
+    m_notificationLock.acquire_read();
     if (m_running == false) {
-      m_notificationSema.release();
+      m_notificationLock.release();
       return false;
     }
     return true;
@@ -356,9 +355,9 @@ CqServiceStatisticsPtr CqService::getCqServiceStatistics() { return m_stats; }
 void CqService::closeCqService() {
   if (m_running) {
     m_running = false;
-    m_notificationSema.acquire();
+    m_notificationLock.acquire_write();
     cleanup();
-    m_notificationSema.release();
+    m_notificationLock.release();
   }
 }
 void CqService::closeAllCqs() {
@@ -406,7 +405,7 @@ void CqService::receiveNotification(TcrMessage* msg) {
   invokeCqListeners(msg->getCqs(), msg->getMessageTypeForCq(), msg->getKey(),
                     msg->getValue(), msg->getDeltaBytes(), msg->getEventId());
   GF_SAFE_DELETE(msg);
-  m_notificationSema.release();
+  m_notificationLock.release();
 }
 
 /**
@@ -29,6 +29,7 @@
 #include <ace/Time_Value.h>
 #include <ace/Guard_T.h>
 #include <ace/Recursive_Thread_Mutex.h>
+#include <ace/RW_Thread_Mutex.h>
 #include <ace/Semaphore.h>
 #include <geode/CacheableKey.hpp>
 #include <geode/CqOperation.hpp>
@@ -68,7 +69,8 @@ class CPPCACHE_EXPORT CqService
   statistics::StatisticsFactory* m_statisticsFactory;
   ACE_Recursive_Thread_Mutex m_mutex;
   std::string m_queryString;
-  ACE_Semaphore m_notificationSema;
+  // held shared while listeners are invoked, exclusively to close
+  ACE_RW_Thread_Mutex m_notificationLock;
 
   bool m_running;
   MapOfCqQueryWithLock* m_cqQueryMap;
@@ -19,7 +19,10 @@
 
 #include "CacheRegionHelper.hpp"
 #include <SerializationRegistry.hpp>
+#include "BigEndian.hpp"
 #include "CacheImpl.hpp"
+#include "ModifiedUtf8.hpp"
+#include "ReceiveBuffer.hpp"
 
 namespace apache {
 namespace geode {
@@ -29,6 +32,142 @@ void DataInput::readObjectInternal(SerializablePtr& ptr, int8_t typeId) {
   ptr = getSerializationRegistry().deserialize(*this, typeId);
 }
 
+void DataInput::readBytesSlice(uint8_t** bytes, int32_t* len,
+                               std::shared_ptr<const uint8_t>& slice,
+                               int32_t* bufferLength) {
+  int32_t length;
+  readArrayLen(&length);
+  *len = length;
+  if (m_receiveBuffer != nullptr && m_receiveBuffer->isSliceable(length)) {
+    checkBufferSize(length);
+    slice = m_receiveBuffer->slice(m_buf);
+    *bufferLength = m_receiveBuffer->getLength();
+    *bytes = const_cast<uint8_t*>(m_buf);
+    m_buf += length;
+    return;
+  }
+  slice.reset();
+  *bufferLength = 0;
+  uint8_t* buffer = nullptr;
+  if (length > 0) {
+    checkBufferSize(length);
+    GF_NEW(buffer, uint8_t[length]);
+    std::memcpy(buffer, m_buf, length);
+    m_buf += length;
+  }
+  *bytes = buffer;
+}
+
+const uint8_t* DataInput::readArrayBytes(int32_t length, int32_t elementSize) {
+  if (length <= 0) return m_buf;
+  // the length comes off the wire, so check it without overflowing
+  int64_t size = static_cast<int64_t>(length) * elementSize;
+  checkBufferSize(size > INT32_MAX ? INT32_MAX : static_cast<int32_t>(size));
+  const uint8_t* bytes = m_buf;
+  m_buf += size;
+  return bytes;
+}
+
+void DataInput::readInts(int16_t* values, int32_t length) {
+  const uint8_t* bytes = readArrayBytes(length, 2);
+  if (length > 0) BigEndian::copy16(bytes, length, values);
+}
+
+void DataInput::readInts(int32_t* values, int32_t length) {
+  const uint8_t* bytes = readArrayBytes(length, 4);
+  if (length > 0) BigEndian::copy32(bytes, length, values);
+}
+
+void DataInput::readInts(int64_t* values, int32_t length) {
+  const uint8_t* bytes = readArrayBytes(length, 8);
+  if (length > 0) BigEndian::copy64(bytes, length, values);
+}
+
+void DataInput::readFloats(float* values, int32_t length) {
+  static_assert(sizeof(float) == 4, "float must be 32-bit");
+  const uint8_t* bytes = readArrayBytes(length, 4);
+  if (length > 0) BigEndian::copy32(bytes, length, values);
+}
+
+void DataInput::readDoubles(double* values, int32_t length) {
+  static_assert(sizeof(double) == 8, "double must be 64-bit");
+  const uint8_t* bytes = readArrayBytes(length, 8);
+  if (length > 0) BigEndian::copy64(bytes, length, values);
+}
+
+int32_t DataInput::getDecodedLength(const uint8_t* value, int32_t length) {
+  const uint8_t* end = value + length;
+  int32_t decodedLen = 0;
+  while (value < end) {
+    size_t ascii = ModifiedUtf8::asciiLength(value, end - value);
+    decodedLen += static_cast<int32_t>(ascii);
+    value += ascii;
+    if (value == end) break;
+    // get next byte unsigned
+    int32_t b = *value++ & 0xff;
+    int32_t k = b >> 5;
+    // classify based on the high order 3 bits
+    switch (k) {
+      case 6: {
+        value++;
+        break;
+      }
+      case 7: {
+        value += 2;
+        break;
+      }
+      default:
+        break;
+    }
+    decodedLen += 1;
+  }
+  if (value > end) decodedLen--;
+  return decodedLen;
+}
+
+// Each decoded character takes at least one encoded byte, so the ASCII runs
+// below never look beyond the encoded string.
+
+void DataInput::decodeUTF(char* str, uint32_t length) {
+  char* end = str + length;
+  while (str < end) {
+    size_t ascii = ModifiedUtf8::asciiLength(m_buf, end - str);
+    std::memcpy(str, m_buf, ascii);
+    str += ascii;
+    m_buf += ascii;
+    if (str < end) {
+      decodeChar(str++);
+    }
+  }
+}
+
+void DataInput::decodeUTF(wchar_t* str, uint32_t length) {
+  wchar_t* end = str + length;
+  while (str < end) {
+    size_t ascii = ModifiedUtf8::asciiLength(m_buf, end - str);
+    ModifiedUtf8::widen(m_buf, ascii, str);
+    str += ascii;
+    m_buf += ascii;
+    if (str < end) {
+      decodeChar(str++);
+    }
+  }
+}
+
+void DataInput::decodeUTF16(char* str, uint32_t length) {
+  int64_t size = static_cast<int64_t>(length) * 2;
+  checkBufferSize(size > INT32_MAX ? INT32_MAX : static_cast<int32_t>(size));
+  ModifiedUtf8::fromUtf16(m_buf, length, str);
+  m_buf += size;
+}
+
+void DataInput::decodeUTF16(wchar_t* str, uint32_t length) {
+  int64_t size = static_cast<int64_t>(length) * 2;
+  checkBufferSize(size > INT32_MAX ? INT32_MAX : static_cast<int32_t>(size));
+  ModifiedUtf8::fromUtf16(m_buf, length, str);
+  m_buf += size;
+}
+
 const SerializationRegistry& DataInput::getSerializationRegistry() const {
   return *CacheRegionHelper::getCacheImpl(m_cache)->getSerializationRegistry();
 }
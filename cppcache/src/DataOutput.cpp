@@ -18,12 +18,15 @@
 #include <geode/DataOutput.hpp>
 #include <geode/SystemProperties.hpp>
 #include <SerializationRegistry.hpp>
-#include <ace/TSS_T.h>
+
+#include <algorithm>
 
 #include <ace/Recursive_Thread_Mutex.h>
-#include <vector>
+#include "BigEndian.hpp"
+#include "BufferPool.hpp"
 #include "CacheImpl.hpp"
 #include "CacheRegionHelper.hpp"
+#include "ModifiedUtf8.hpp"
 
 namespace apache {
 namespace geode {
@@ -33,95 +36,214 @@ ACE_Recursive_Thread_Mutex g_bigBufferLock;
 uint32_t DataOutput::m_highWaterMark = 50 * 1024 * 1024;
 uint32_t DataOutput::m_lowWaterMark = 8192;
 
-/** This represents a allocation in this thread local pool. */
-class BufferDesc {
- public:
-  uint8_t* m_buf;
-  uint32_t m_size;
+DataOutput::DataOutput(const Cache* cache)
+    : m_cache(cache),
+      m_poolName(nullptr),
+      m_size(0),
+      m_haveBigBuffer(false),
+      m_referencedLength(0) {
+  m_buf = m_bytes = DataOutput::checkoutBuffer(&m_size);
+}
 
-  BufferDesc(uint8_t* buf, uint32_t size) : m_buf(buf), m_size(size) {}
+uint8_t* DataOutput::checkoutBuffer(uint32_t* size) {
+  return BufferPool::getInstance().acquire(m_lowWaterMark, size);
+}
 
-  BufferDesc() : m_buf(nullptr), m_size(0) {}
+void DataOutput::checkinBuffer(uint8_t* buffer, uint32_t size) {
+  BufferPool::getInstance().release(buffer, size);
+}
 
-  ~BufferDesc() {}
+void DataOutput::growBuffer(uint32_t size) {
+  uint32_t offset = static_cast<uint32_t>(m_buf - m_bytes);
+  uint32_t newSize = m_size * 2 + (8192 * (size / 8192));
+  if (newSize >= m_highWaterMark && !m_haveBigBuffer) {
+    // acquire the lock
+    acquireLock();
+    // set flag
+    m_haveBigBuffer = true;
+  }
+  m_bytes =
+      BufferPool::getInstance().grow(m_bytes, m_size, offset, newSize, &m_size);
+  m_buf = m_bytes + offset;
+}
 
-  BufferDesc& operator=(const BufferDesc& other) {
-    /* adongre
-     * CID 28889: Other violation (SELF_ASSIGN)No protection against the object
-     * assigning to itself.
-     */
-    if (this != &other) {
-      m_buf = other.m_buf;
-      m_size = other.m_size;
-    }
-    return *this;
+void DataOutput::writeBytesReference(const uint8_t* bytes, uint32_t len,
+                                     const SerializablePtr& owner) {
+  if (len == 0) return;
+  ReferencedBytes reference;
+  reference.m_offset = getBufferLength();
+  reference.m_bytes = bytes;
+  reference.m_length = len;
+  reference.m_owner = owner;
+  m_references.push_back(reference);
+  m_referencedLength += len;
+}
+
+const uint8_t* DataOutput::getSegment(uint32_t index,
+                                      uint32_t* length) const {
+  uint32_t reference = index / 2;
+  if (index % 2 == 1) {
+    *length = m_references[reference].m_length;
+    return m_references[reference].m_bytes;
   }
+  // the part of the buffer between the previous payload and this one
+  uint32_t start = reference == 0 ? 0 : m_references[reference - 1].m_offset;
+  uint32_t end = reference < m_references.size()
+                     ? m_references[reference].m_offset
+                     : getBufferLength();
+  *length = end - start;
+  return m_bytes + start;
+}
 
-  BufferDesc(const BufferDesc& other)
-      : m_buf(other.m_buf), m_size(other.m_size) {}
-};
-
-/** Thread local pool of buffers for DataOutput objects. */
-class TSSDataOutput {
- private:
-  std::vector<BufferDesc> m_buffers;
-
- public:
-  TSSDataOutput();
-  ~TSSDataOutput();
-
-  uint8_t* getBuffer(uint32_t* size) {
-    if (!m_buffers.empty()) {
-      BufferDesc desc = m_buffers.back();
-      m_buffers.pop_back();
-      *size = desc.m_size;
-      return desc.m_buf;
-    } else {
-      uint8_t* buf;
-      *size = 8192;
-      buf = (uint8_t *) std::malloc(8192 * sizeof(uint8_t));
-      if (buf == nullptr) {
-        throw OutOfMemoryException(
-            "Out of Memory while resizing buffer");
-      }
-      return buf;
+void DataOutput::flatten() {
+  if (m_references.empty()) return;
+  std::vector<ReferencedBytes> references;
+  references.swap(m_references);
+  m_referencedLength = 0;
+
+  // rewind to the first payload and write everything after it again
+  uint32_t start = references.front().m_offset;
+  std::vector<uint8_t> tail(m_bytes + start, m_buf);
+  m_buf = m_bytes + start;
+  for (size_t i = 0; i < references.size(); i++) {
+    const ReferencedBytes& reference = references[i];
+    writeBytesOnly(reference.m_bytes, reference.m_length);
+    uint32_t end = i + 1 < references.size() ? references[i + 1].m_offset
+                                             : start + static_cast<uint32_t>(
+                                                           tail.size());
+    uint32_t from = reference.m_offset - start;
+    if (end > reference.m_offset) {
+      writeBytesOnly(tail.data() + from, end - reference.m_offset);
     }
   }
+}
 
-  void poolBuffer(uint8_t* buf, uint32_t size) {
-    BufferDesc desc(buf, size);
-    m_buffers.push_back(desc);
-  }
+void DataOutput::writeInts(const int16_t* values, int32_t length) {
+  if (length <= 0) return;
+  ensureCapacity(static_cast<uint32_t>(length) * 2);
+  BigEndian::copy16(values, length, m_buf);
+  m_buf += static_cast<uint32_t>(length) * 2;
+}
 
-  static ACE_TSS<TSSDataOutput> s_tssDataOutput;
-};
+void DataOutput::writeInts(const int32_t* values, int32_t length) {
+  if (length <= 0) return;
+  ensureCapacity(static_cast<uint32_t>(length) * 4);
+  BigEndian::copy32(values, length, m_buf);
+  m_buf += static_cast<uint32_t>(length) * 4;
+}
 
-TSSDataOutput::TSSDataOutput() : m_buffers() {
-  m_buffers.reserve(10);
-  LOGDEBUG("DATAOUTPUT poolsize is %d", m_buffers.size());
+void DataOutput::writeInts(const int64_t* values, int32_t length) {
+  if (length <= 0) return;
+  ensureCapacity(static_cast<uint32_t>(length) * 8);
+  BigEndian::copy64(values, length, m_buf);
+  m_buf += static_cast<uint32_t>(length) * 8;
 }
 
-TSSDataOutput::~TSSDataOutput() {
-  while (!m_buffers.empty()) {
-    BufferDesc desc = m_buffers.back();
-    m_buffers.pop_back();
-    std::free(desc.m_buf);
+void DataOutput::writeFloats(const float* values, int32_t length) {
+  static_assert(sizeof(float) == 4, "float must be 32-bit");
+  if (length <= 0) return;
+  ensureCapacity(static_cast<uint32_t>(length) * 4);
+  BigEndian::copy32(values, length, m_buf);
+  m_buf += static_cast<uint32_t>(length) * 4;
+}
+
+void DataOutput::writeDoubles(const double* values, int32_t length) {
+  static_assert(sizeof(double) == 8, "double must be 64-bit");
+  if (length <= 0) return;
+  ensureCapacity(static_cast<uint32_t>(length) * 8);
+  BigEndian::copy64(values, length, m_buf);
+  m_buf += static_cast<uint32_t>(length) * 8;
+}
+
+int32_t DataOutput::getEncodedLength(const char* value, int32_t length,
+                                     uint32_t* valLength) {
+  if (value == nullptr) return 0;
+  if (length == 0) {
+    length = static_cast<int32_t>(strlen(value));
+  }
+  int32_t encodedLen = 0;
+  const char* start = value;
+  const char* end = value + length;
+  while (value < end) {
+    size_t ascii = ModifiedUtf8::asciiLength(value, end - value);
+    encodedLen += static_cast<int32_t>(ascii);
+    value += ascii;
+    if (value < end) {
+      getEncodedLength(*value++, encodedLen);
+    }
   }
+  if (valLength != nullptr) {
+    *valLength = static_cast<uint32_t>(value - start);
+  }
+  return encodedLen;
 }
 
-ACE_TSS<TSSDataOutput> TSSDataOutput::s_tssDataOutput;
+int32_t DataOutput::getEncodedLength(const wchar_t* value, int32_t length,
+                                     uint32_t* valLength) {
+  if (value == nullptr) return 0;
+  if (length == 0) {
+    length = static_cast<int32_t>(wcslen(value));
+  }
+  int32_t encodedLen = 0;
+  const wchar_t* start = value;
+  const wchar_t* end = value + length;
+  while (value < end) {
+    size_t ascii = ModifiedUtf8::asciiLength(value, end - value);
+    encodedLen += static_cast<int32_t>(ascii);
+    value += ascii;
+    if (value < end) {
+      getEncodedLength(*value++, encodedLen);
+    }
+  }
+  if (valLength != nullptr) {
+    *valLength = static_cast<uint32_t>(value - start);
+  }
+  return encodedLen;
+}
 
-DataOutput::DataOutput(const Cache* cache)
-    : m_cache(cache), m_poolName(nullptr), m_size(0), m_haveBigBuffer(false) {
-  m_buf = m_bytes = DataOutput::checkoutBuffer(&m_size);
+void DataOutput::encodeUTF(const char* value, uint32_t length, uint8_t* end) {
+  const char* valueEnd = value + length;
+  while (m_buf < end) {
+    if (value < valueEnd) {
+      size_t ascii = ModifiedUtf8::asciiLength(
+          value, std::min<size_t>(valueEnd - value, end - m_buf));
+      std::memcpy(m_buf, value, ascii);
+      m_buf += ascii;
+      value += ascii;
+    }
+    if (m_buf < end) {
+      encodeChar(*value++);
+    }
+  }
+  if (m_buf > end) m_buf = end;
 }
 
-uint8_t* DataOutput::checkoutBuffer(uint32_t* size) {
-  return TSSDataOutput::s_tssDataOutput->getBuffer(size);
+void DataOutput::encodeUTF(const wchar_t* value, uint32_t length,
+                           uint8_t* end) {
+  const wchar_t* valueEnd = value + length;
+  while (m_buf < end) {
+    if (value < valueEnd) {
+      size_t ascii = ModifiedUtf8::asciiLength(
+          value, std::min<size_t>(valueEnd - value, end - m_buf));
+      ModifiedUtf8::narrow(value, ascii, m_buf);
+      m_buf += ascii;
+      value += ascii;
+    }
+    if (m_buf < end) {
+      encodeChar(*value++);
+    }
+  }
+  if (m_buf > end) m_buf = end;
 }
 
-void DataOutput::checkinBuffer(uint8_t* buffer, uint32_t size) {
-  TSSDataOutput::s_tssDataOutput->poolBuffer(buffer, size);
+void DataOutput::encodeUTF16(const char* value, uint32_t length) {
+  ModifiedUtf8::toUtf16(value, length, m_buf);
+  m_buf += static_cast<uint32_t>(length) * 2;
+}
+
+void DataOutput::encodeUTF16(const wchar_t* value, uint32_t length) {
+  ModifiedUtf8::toUtf16(value, length, m_buf);
+  m_buf += static_cast<uint32_t>(length) * 2;
 }
 
 void DataOutput::writeObjectInternal(const Serializable* ptr, bool isDelta) {
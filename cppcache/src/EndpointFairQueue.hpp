@@ -0,0 +1,284 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_ENDPOINTFAIRQUEUE_H_
+#define GEODE_ENDPOINTFAIRQUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <ace/ACE.h>
+#include <ace/Condition_T.h>
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Time_Value.h>
+#include <ace/Token.h>
+
+#include <geode/geode_globals.hpp>
+
+#include "util/concurrent/spinlock_mutex.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+using util::concurrent::spinlock_mutex;
+
+/**
+ * A FairQueue of idle items that belong to an endpoint, as returned by
+ * T::getEndpointObject(), for the connections of a pool.
+ *
+ * The items are kept in shards by endpoint, each a deque guarded by its own
+ * spinlock, so that putting and getting an item only contends with threads
+ * using the same shard, and getting an item of a given endpoint only looks at
+ * that endpoint's shard. Within a shard items are handed out oldest first and
+ * getting any item starts at the next shard in turn, which spreads the use
+ * over all the idle items like the single deque of FairQueue did.
+ *
+ * Threads that have to wait for an item still queue up on a token so they
+ * are served in order. The mutex only exists for the users of
+ * getQueueLock(), none of the queue operations take it.
+ */
+template <class T, class MUTEX = ACE_Thread_Mutex>
+class EndpointFairQueue {
+ public:
+  EndpointFairQueue()
+      : m_cond(m_waitLock), m_closed(false), m_waiting(0), m_nextShard(0) {}
+
+  virtual ~EndpointFairQueue() { close(); }
+
+  int waiters() { return m_queueGetLock.waiters(); }
+
+  /** get without wait */
+  T* getNoWait() {
+    bool isClosed;
+    return popFromQueue(isClosed);
+  }
+
+  /** get without wait an item of the given endpoint */
+  T* getNoWait(const void* endpoint) {
+    Shard& shard = shardFor(endpoint);
+    if (shard.m_size == 0) {
+      return nullptr;
+    }
+
+    std::lock_guard<spinlock_mutex> guard(shard.m_lock);
+    for (auto itr = shard.m_queue.begin(); itr != shard.m_queue.end(); itr++) {
+      if ((*itr)->getEndpointObject() == endpoint) {
+        T* mp = *itr;
+        shard.m_queue.erase(itr);
+        shard.m_size--;
+        return mp;
+      }
+    }
+    return nullptr;
+  }
+
+  /** wait sec time until notified */
+  T* getUntil(int64_t& sec) {
+    bool isClosed;
+    T* mp = popFromQueue(isClosed);
+
+    if (mp == nullptr && !isClosed) {
+      mp = getUntilWithToken(sec, isClosed, (void*)nullptr);
+    }
+    return mp;
+  }
+
+  void put(T* mp, bool openQueue) {
+    GF_DEV_ASSERT(mp != 0);
+
+    bool delMp = false;
+    {
+      Shard& shard = shardFor(mp->getEndpointObject());
+      std::lock_guard<spinlock_mutex> guard(shard.m_lock);
+      if (openQueue || !m_closed) {
+        shard.m_queue.push_front(mp);
+        shard.m_size++;
+        m_closed = false;
+      } else {
+        delMp = true;
+      }
+    }
+    if (delMp) {
+      mp->close();
+      delete mp;
+    } else if (m_waiting > 0) {
+      ACE_Guard<ACE_Thread_Mutex> _guard(m_waitLock);
+      m_cond.signal();
+    }
+  }
+
+  uint32_t size() {
+    uint32_t size = 0;
+    for (auto& shard : m_shards) {
+      size += shard.m_size;
+    }
+    return size;
+  }
+
+  bool empty() { return (size() == 0); }
+
+  void close() {
+    m_closed = true;
+
+    std::vector<T*> items = removeFromQueue(nullptr);
+    LOGDEBUG("Internal fair queue size while closing is %d",
+             static_cast<int32_t>(items.size()));
+    for (auto mp : items) {
+      mp->close();
+      delete mp;
+      deleteAction();
+    }
+    LOGDEBUG("EndpointFairQueue::close( ): queue closed ");
+
+    ACE_Guard<ACE_Thread_Mutex> _guard(m_waitLock);
+    m_cond.signal();
+  }
+
+  void reset() { m_closed = false; }
+
+  MUTEX& getQueueLock() { return m_queueLock; }
+
+ private:
+  static const size_t SHARDS = 16;
+
+  struct Shard {
+    spinlock_mutex m_lock;
+    std::deque<T*> m_queue;
+    // read without the lock to skip empty shards
+    std::atomic<uint32_t> m_size;
+
+    Shard() : m_size(0) {}
+  };
+
+  Shard m_shards[SHARDS];
+  ACE_Thread_Mutex m_waitLock;
+  ACE_Condition<ACE_Thread_Mutex> m_cond;
+  ACE_Token m_queueGetLock;
+  std::atomic<bool> m_closed;
+  std::atomic<int32_t> m_waiting;
+  std::atomic<uint32_t> m_nextShard;
+
+  Shard& shardFor(const void* endpoint) {
+    auto key = reinterpret_cast<uintptr_t>(endpoint);
+    return m_shards[((key >> 4) ^ (key >> 12)) % SHARDS];
+  }
+
+  bool exclude(T* mp, void*) { return false; }
+
+ protected:
+  MUTEX m_queueLock;
+
+  inline T* popFromQueue(bool& isClosed) {
+    isClosed = m_closed;
+    if (isClosed) {
+      return nullptr;
+    }
+
+    uint32_t first = m_nextShard.fetch_add(1, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < SHARDS; i++) {
+      Shard& shard = m_shards[(first + i) % SHARDS];
+      if (shard.m_size == 0) {
+        continue;
+      }
+      std::lock_guard<spinlock_mutex> guard(shard.m_lock);
+      if (!shard.m_queue.empty()) {
+        T* mp = shard.m_queue.back();
+        shard.m_queue.pop_back();
+        shard.m_size--;
+        return mp;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Takes all the items of the given endpoint, or all items when endpoint
+   * is null, out of the queue.
+   */
+  std::vector<T*> removeFromQueue(const void* endpoint) {
+    std::vector<T*> items;
+    // every shard is locked, an empty one may be taking a put that has not
+    // seen the queue closing yet
+    for (auto& shard : m_shards) {
+      std::lock_guard<spinlock_mutex> guard(shard.m_lock);
+      for (auto itr = shard.m_queue.begin(); itr != shard.m_queue.end();) {
+        if (endpoint == nullptr || (*itr)->getEndpointObject() == endpoint) {
+          items.push_back(*itr);
+          itr = shard.m_queue.erase(itr);
+          shard.m_size--;
+        } else {
+          itr++;
+        }
+      }
+    }
+    return items;
+  }
+
+  template <typename U>
+  T* getUntilWithToken(int64_t& sec, bool& isClosed, U* excludeList = nullptr) {
+    T* mp = nullptr;
+
+    ACE_Guard<ACE_Token> _guard(m_queueGetLock);
+
+    ACE_Time_Value currTime(ACE_OS::gettimeofday());
+    ACE_Time_Value stopAt(currTime);
+    stopAt += sec;
+
+    isClosed = m_closed;
+    if (!isClosed) {
+      // announce the wait before looking at the queue, so a put either
+      // leaves an item to be found here or signals the condition
+      m_waiting++;
+      do {
+        {
+          ACE_Guard<ACE_Thread_Mutex> _guard1(m_waitLock);
+          mp = popFromQueue(isClosed);
+          if (mp == nullptr && !isClosed) {
+            m_cond.wait(&stopAt);
+            mp = popFromQueue(isClosed);
+          }
+        }
+        if (mp && excludeList) {
+          if (exclude(mp, excludeList)) {
+            mp->close();
+            GF_SAFE_DELETE(mp);
+            deleteAction();
+          }
+        }
+      } while (mp == nullptr && (currTime = ACE_OS::gettimeofday()) < stopAt &&
+               !isClosed);
+      m_waiting--;
+      sec = (stopAt - currTime).sec();
+    }
+
+    return mp;
+  }
+
+  virtual void deleteAction() {}
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_ENDPOINTFAIRQUEUE_H_
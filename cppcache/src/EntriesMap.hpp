@@ -29,11 +29,14 @@
 #include <geode/CacheableKey.hpp>
 #include "MapSegment.hpp"
 #include <geode/RegionEntry.hpp>
+#include <geode/VectorT.hpp>
 
 namespace apache {
 namespace geode {
 namespace client {
 
+class ThreadPool;
+
 #define SYNCHRONIZE_SEGMENT_FOR_KEY(keyPtr) \
   SegmentMutexGuard _segment_guard(((EntriesMap*)m_entries)->segmentFor(keyPtr))
 
@@ -53,6 +56,11 @@ class CPPCACHE_EXPORT EntriesMap {
   /** @brief Close the map. */
   virtual void close() = 0;
 
+  /**
+   * @brief size the map to hold the given number of entries without growing.
+   */
+  virtual void reserve(uint32_t expectedEntries) = 0;
+
   /**
    * @brief put a value in the map, replacing if key already exists.
    */
@@ -157,6 +165,13 @@ class CPPCACHE_EXPORT EntriesMap {
     return nullptr;
   }
 
+  /**
+   * @brief read the overflowed values of the keys back from disk, in
+   * parallel on the thread pool; maps that do not overflow have none
+   */
+  virtual void prefetch(const VectorOfCacheableKey& keys,
+                        ThreadPool* threadPool) {}
+
   virtual void reapTombstones(std::map<uint16_t, int64_t>& gcVersions) = 0;
 
   virtual void reapTombstones(CacheableHashSetPtr removedKeys) = 0;
@@ -36,12 +36,19 @@ EntriesMap* EntriesMapFactory::createMap(RegionInternal* region,
                                          const RegionAttributesPtr& attrs) {
   EntriesMap* result = nullptr;
   uint32_t initialCapacity = attrs->getInitialCapacity();
+  // size the segments so the expected entries fit without a rehash
+  uint32_t expectedEntries = attrs->getExpectedEntries();
+  if (expectedEntries > initialCapacity) {
+    initialCapacity = expectedEntries;
+  }
   uint8_t concurrency = attrs->getConcurrencyLevel();
   /** @TODO will need a statistics entry factory... */
   uint32_t lruLimit = attrs->getLruEntriesLimit();
   uint32_t ttl = attrs->getEntryTimeToLive();
   uint32_t idle = attrs->getEntryIdleTimeout();
   bool concurrencyChecksEnabled = attrs->getConcurrencyChecksEnabled();
+  bool concurrentReads = attrs->getConcurrentReadsEnabled();
+  EvictionPolicyType::PolicyType evictionPolicy = attrs->getEvictionPolicy();
   bool heapLRUEnabled = false;
 
   auto cache = region->getCacheImpl();
@@ -66,14 +73,14 @@ EntriesMap* EntriesMapFactory::createMap(RegionInternal* region,
           std::unique_ptr<LRUExpEntryFactory>(
               new LRUExpEntryFactory(concurrencyChecksEnabled)),
           region, lruEvictionAction, lruLimit, concurrencyChecksEnabled,
-          concurrency, heapLRUEnabled);
+          concurrency, heapLRUEnabled, concurrentReads, evictionPolicy);
     } else {
       result = new LRUEntriesMap(
           &expiryTaskmanager,
           std::unique_ptr<LRUEntryFactory>(
               new LRUEntryFactory(concurrencyChecksEnabled)),
           region, lruEvictionAction, lruLimit, concurrencyChecksEnabled,
-          concurrency, heapLRUEnabled);
+          concurrency, heapLRUEnabled, concurrentReads, evictionPolicy);
     }
   } else if (ttl != 0 || idle != 0) {
     // create entries with a ExpEntryFactory.
@@ -81,14 +88,14 @@ EntriesMap* EntriesMapFactory::createMap(RegionInternal* region,
         &expiryTaskmanager,
         std::unique_ptr<ExpEntryFactory>(
             new ExpEntryFactory(concurrencyChecksEnabled)),
-        concurrencyChecksEnabled, region, concurrency);
+        concurrencyChecksEnabled, region, concurrency, concurrentReads);
   } else {
     // create plain concurrent map.
     result = new ConcurrentEntriesMap(
         &expiryTaskmanager,
         std::unique_ptr<EntryFactory>(
             new EntryFactory(concurrencyChecksEnabled)),
-        concurrencyChecksEnabled, region, concurrency);
+        concurrencyChecksEnabled, region, concurrency, concurrentReads);
   }
   result->open(initialCapacity);
   return result;
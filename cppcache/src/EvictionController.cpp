@@ -18,153 +18,276 @@
 #include "EvictionController.hpp"
 #include "CacheImpl.hpp"
 #include "CacheRegionHelper.hpp"
+#include "LRUEntriesMap.hpp"
 #include "RegionInternal.hpp"
 #include <geode/DistributedSystem.hpp>
 #include "ReadWriteLock.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <string>
 
 namespace apache {
 namespace geode {
 namespace client {
 
+const long EvictionController::MAX_PUT_DELAY;
+const int64_t EvictionController::MIN_TASK_BYTES;
+
 const char* EvictionController::NC_EC_Thread = "NC EC Thread";
 EvictionController::EvictionController(size_t maxHeapSize,
-                                       int32_t heapSizeDelta, CacheImpl* cache)
+                                       int32_t heapSizeDelta,
+                                       uint32_t evictionThreads,
+                                       CacheImpl* cache)
     : m_run(false),
       m_maxHeapSize(maxHeapSize * 1024 * 1024),
       m_heapSizeDelta(heapSizeDelta),
+      m_throttleSize(m_maxHeapSize + m_maxHeapSize * m_heapSizeDelta / 100),
       m_cacheImpl(cache),
-      m_currentHeapSize(0) {
-  evictionThreadPtr = new EvictionThread(this);
+      m_currentHeapSize(0),
+      m_clock(static_cast<uint32_t>(ACE_OS::time())),
+      m_wakeUp(false),
+      m_backlog(0),
+      m_evictedBytes(0),
+      m_orderEvictedBytes(0),
+      m_evictionStalled(false),
+      m_lastHeapSize(0),
+      m_inflow(0),
+      m_overLimit(false),
+      m_lastRecount(m_clock),
+      m_throttled(0) {
+  evictionThreadPtr = new EvictionThread(
+      this, evictionThreads,
+      cache->getDistributedSystem()
+          .getStatisticsManager()
+          ->getStatisticsFactory());
   LOGINFO("Maximum heap size for Heap LRU set to %ld bytes", m_maxHeapSize);
-  //  m_currentHeapSize =
-  //  DistributedSystem::getSystemProperties()->gfHighWaterMark(),
-  //  DistributedSystem::getSystemProperties()->gfMessageSize();
 }
 
 EvictionController::~EvictionController() { GF_SAFE_DELETE(evictionThreadPtr); }
 
 void EvictionController::updateRegionHeapInfo(int64_t info) {
-  // LOGINFO("updateRegionHeapInfo is %d", info);
-  m_queue.put(info);
-  // We could block here if we wanted to prevent any further memory use
-  // until the evictions had been completed.
+  int64_t heapSize = (m_currentHeapSize += info);
+  // one wake up is queued until the controller runs
+  if (info > 0 && heapSize > m_maxHeapSize &&
+      !m_wakeUp.load(std::memory_order_relaxed) && !m_wakeUp.exchange(true)) {
+    m_queue.put(1);
+  }
+}
+
+void EvictionController::waitForEviction() {
+  // not while stopping, nor from a listener called in an eviction
+  if (!m_run || EvictionThread::isEvictionThread()) {
+    return;
+  }
+  if (m_evictionStalled) {
+    m_cacheImpl->getCachePerfStats().incHeapLRUPutsNotDelayed();
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+  {
+    std::unique_lock<std::mutex> lock(m_throttleLock);
+    ++m_throttled;
+    m_throttleCond.wait_for(
+        lock, std::chrono::milliseconds(MAX_PUT_DELAY), [this] {
+          return !m_run || m_currentHeapSize <= m_throttleSize ||
+                 m_evictionStalled;
+        });
+    --m_throttled;
+  }
+  m_cacheImpl->getCachePerfStats().incHeapLRUPutDelays(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+}
+
+void EvictionController::releaseThrottled() {
+  // a put held back counts itself in before it looks at the size again
+  if (m_throttled > 0) {
+    std::lock_guard<std::mutex> guard(m_throttleLock);
+    m_throttleCond.notify_all();
+  }
 }
 
 int EvictionController::svc() {
   DistributedSystemImpl::setThreadName(NC_EC_Thread);
-  int64_t pendingEvictions = 0;
   while (m_run) {
-    int64_t readInfo = 0;
-    readInfo = m_queue.get(1500);
-    if (readInfo == 0) continue;
+    m_queue.get(CONTROL_INTERVAL);
+    m_wakeUp = false;
+    processHeapInfo();
+  }
+  return 1;
+}
+
+void EvictionController::processHeapInfo() {
+  auto now = std::chrono::steady_clock::now();
+  m_clock = static_cast<uint32_t>(ACE_OS::time());
+  CachePerfStats& stats = m_cacheImpl->getCachePerfStats();
+  int64_t heapSize = m_currentHeapSize;
+  stats.setHeapLRUSize(heapSize);
+  stats.setHeapLRUEvictionBacklog(m_backlog);
+  // entries destroyed by the application free bytes as well
+  releaseThrottled();
 
-    processHeapInfo(readInfo, pendingEvictions);
+  // the bytes put in since the last time, smoothed over the last few
+  int64_t inflow = heapSize - m_lastHeapSize + m_evictedBytes.exchange(0);
+  m_lastHeapSize = heapSize;
+  m_inflow = (3 * m_inflow + std::max<int64_t>(inflow, 0)) / 4;
+
+  if (m_clock - m_lastRecount >= RECOUNT_INTERVAL) {
+    recountHeapSize();
+    m_lastRecount = m_clock;
   }
-  int32_t size = m_queue.size();
-  for (int i = 0; i < size; i++) {
-    int64_t readInfo = 0;
-    readInfo = m_queue.get();
-    if (readInfo == 0) continue;
-    processHeapInfo(readInfo, pendingEvictions);
+
+  if (!m_overLimit) {
+    if (heapSize <= m_maxHeapSize) {
+      return;
+    }
+    m_overLimit = true;
+    m_overLimitSince = now;
   }
-  return 1;
+  stats.setHeapLRUEvictionLag(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now -
+                                                           m_overLimitSince)
+          .count());
+
+  // evicting below the limit keeps it from going over again at once
+  int64_t target = m_maxHeapSize - m_maxHeapSize * m_heapSizeDelta / 100;
+  if (heapSize <= target) {
+    m_overLimit = false;
+    return;
+  }
+  // the size is measured again once the last order has been carried out
+  if (m_backlog > 0) {
+    return;
+  }
+  orderEviction(std::min(heapSize - target + m_inflow, heapSize));
 }
 
-void EvictionController::processHeapInfo(int64_t& readInfo,
-                                         int64_t& pendingEvictions) {
-  m_currentHeapSize += readInfo;
-
-  // Waiting for evictions to catch up.Negative numbers
-  // are attributed to evictions that were triggered by the
-  // EvictionController
-  int64_t sizeToCompare = 0;
-  if (readInfo < 0 && pendingEvictions > 0) {
-    pendingEvictions += readInfo;
-    if (pendingEvictions < 0) pendingEvictions = 0;
-    return;  // as long as you are still evicting, don't do the rest of the work
-  } else {
-    sizeToCompare = m_currentHeapSize - pendingEvictions;
-  }
-
-  if (sizeToCompare > m_maxHeapSize) {
-    // Check if overflow is above the delta
-    int64_t sizeOverflow = sizeToCompare - m_maxHeapSize;
-
-    // Calculate the percentage that we are over the limit.
-    int32_t fractionalOverflow =
-        static_cast<int32_t>(((sizeOverflow * 100) % m_maxHeapSize) > 0) ? 1
-                                                                         : 0;
-    int32_t percentage =
-        static_cast<int32_t>((sizeOverflow * 100) / m_maxHeapSize) +
-        fractionalOverflow;
-    // need to evict
-    int32_t evictionPercentage =
-        static_cast<int32_t>(percentage + m_heapSizeDelta);
-    int32_t bytesToEvict =
-        static_cast<int32_t>((sizeToCompare * evictionPercentage) / 100);
-    pendingEvictions += bytesToEvict;
-    if (evictionPercentage > 100) evictionPercentage = 100;
-    orderEvictions(evictionPercentage);
+void EvictionController::recountHeapSize() {
+  int64_t error = 0;
+  {
+    ReadGuard guard(m_regionLock);
+    for (const auto map : m_regions) {
+      error += std::abs(map->recountMapSize());
+    }
+  }
+  m_cacheImpl->getCachePerfStats().setHeapLRUAccountingError(error);
+  if (error != 0) {
+    LOGFINE("Heap LRU size was off by %lld bytes", error);
   }
 }
 
-void EvictionController::registerRegion(std::string& name) {
+void EvictionController::registerRegion(LRUEntriesMap* map) {
   WriteGuard guard(m_regionLock);
-  m_regions.push_back(name);
+  m_regions.push_back(map);
   LOGFINE("Registered region with Heap LRU eviction controller: name is %s",
-          name.c_str());
+          map->getName().c_str());
 }
 
-void EvictionController::deregisterRegion(std::string& name) {
-  // Iterate over regions vector and remove the one that we need to remove
+void EvictionController::deregisterRegion(LRUEntriesMap* map) {
   WriteGuard guard(m_regionLock);
-  for (size_t i = 0; i < m_regions.size(); i++) {
-    std::string str = m_regions.at(i);
-    if (str == name) {
-      std::vector<std::string>::iterator iter = m_regions.begin();
-      m_regions.erase(iter + i);
-      LOGFINE(
-          "Deregistered region with Heap LRU eviction controller: name is %s",
-          name.c_str());
-      break;
-    }
+  auto iter = std::find(m_regions.begin(), m_regions.end(), map);
+  if (iter != m_regions.end()) {
+    m_regions.erase(iter);
+    LOGFINE(
+        "Deregistered region with Heap LRU eviction controller: name is %s",
+        map->getName().c_str());
   }
 }
 
-void EvictionController::orderEvictions(int32_t percentage) {
-  evictionThreadPtr->putEvictionInfo(percentage);
-}
-
-void EvictionController::evict(int32_t percentage) {
-  // TODO:  Shouldn't we take the CacheImpl::m_regions
-  // lock here? Otherwise we might invoke eviction on a region
-  // that has been destroyed or is being destroyed.
-  // Its important to not hold this lock for too long
-  // because it prevents new regions from getting created or destroyed
-  // On the flip side, this requires a copy of the registered region list
-  // every time eviction is ordered and that might not be cheap
-  //@TODO: Discuss with team
-  VectorOfString regionTmpVector;
+void EvictionController::orderEviction(int64_t bytes) {
+  // the regions are looked up by their path and evicted without the lock,
+  // which would otherwise keep regions from being created or destroyed
+  struct Share {
+    std::string m_path;
+    int64_t m_bytes;
+    double m_weight;
+  };
+  std::vector<Share> shares;
+  double totalWeight = 0;
+  uint32_t now = m_clock;
   {
     ReadGuard guard(m_regionLock);
-    for (size_t i = 0; i < m_regions.size(); i++) {
-      regionTmpVector.push_back(m_regions.at(i));
+    for (const auto map : m_regions) {
+      int64_t mapSize = map->getMapSize();
+      if (mapSize <= 0) continue;
+      // a region left unused gives up more than one in use
+      uint32_t lastUsed = map->getLastUsed();
+      uint32_t idle = now > lastUsed ? now - lastUsed : 0;
+      double weight = static_cast<double>(mapSize) * (1 + idle);
+      shares.push_back({map->getName(), mapSize, weight});
+      totalWeight += weight;
     }
   }
 
-  for (size_t i = 0; i < regionTmpVector.size(); i++) {
-    std::string str = regionTmpVector.at(i);
-    RegionPtr rptr;
-    m_cacheImpl->getRegion(str.c_str(), rptr);
-    if (rptr != nullptr) {
-      RegionInternal* rimpl = dynamic_cast<RegionInternal*>(rptr.get());
-      if (rimpl != nullptr) {
-        rimpl->evict(percentage);
+  int64_t ordered = 0;
+  for (auto& share : shares) {
+    // what a region cannot give up is ordered again in the next round
+    share.m_bytes = std::min(
+        share.m_bytes,
+        static_cast<int64_t>(static_cast<double>(bytes) * share.m_weight /
+                             totalWeight) +
+            1);
+    ordered += share.m_bytes;
+  }
+  if (ordered == 0) {
+    // no region has anything to give up
+    m_evictionStalled = true;
+    releaseThrottled();
+    return;
+  }
+  m_backlog += ordered;
+
+  // the tasks of the regions take turns in the queue, so that the threads
+  // get to all of them at once; a share is split among the threads, but
+  // not into tasks too small to be worth queuing
+  int64_t threads = evictionThreadPtr->threads();
+  std::vector<int64_t> taskBytes;
+  for (const auto& share : shares) {
+    taskBytes.push_back(
+        std::max(MIN_TASK_BYTES, (share.m_bytes + threads - 1) / threads));
+  }
+  bool queued = true;
+  while (queued) {
+    queued = false;
+    for (size_t i = 0; i < shares.size(); i++) {
+      int64_t bytesToEvict = std::min(shares[i].m_bytes, taskBytes[i]);
+      if (bytesToEvict > 0) {
+        evictionThreadPtr->putEvictionTask(shares[i].m_path, bytesToEvict);
+        shares[i].m_bytes -= bytesToEvict;
+        queued = true;
       }
     }
   }
 }
+
+int64_t EvictionController::evict(const std::string& path, int64_t bytes) {
+  int64_t evicted = 0;
+  RegionPtr rptr;
+  m_cacheImpl->getRegion(path.c_str(), rptr);
+  if (rptr != nullptr) {
+    RegionInternal* rimpl = dynamic_cast<RegionInternal*>(rptr.get());
+    if (rimpl != nullptr) {
+      try {
+        evicted = rimpl->evict(bytes);
+      } catch (const Exception& ex) {
+        LOGERROR("Exception evicting from region %s: %s: %s", path.c_str(),
+                 ex.getName(), ex.getMessage());
+      }
+    }
+  }
+  m_cacheImpl->getCachePerfStats().incHeapLRUEvictedBytes(evicted);
+  m_evictedBytes += evicted;
+  m_orderEvictedBytes += evicted;
+  // the task is carried out whether or not the region could give it all up
+  if ((m_backlog -= bytes) <= 0) {
+    // the order is carried out, until the next one is the puts are held
+    // back only if it freed something
+    m_evictionStalled = m_orderEvictedBytes.exchange(0) == 0;
+  }
+  releaseThrottled();
+  return evicted;
+}
 }  // namespace client
 }  // namespace geode
 }  // namespace apache
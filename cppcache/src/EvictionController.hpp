@@ -27,7 +27,11 @@
 #include <ace/Task.h>
 #include <geode/DataOutput.hpp>
 #include <geode/Log.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include "IntQueue.hpp"
 #include "EvictionThread.hpp"
 #include <string>
@@ -35,45 +39,52 @@
 
 /**
  * This class ensures that the cache consumes only as much memory as
- * specified by the heap-lru-limit. Every region that is created in the
- * system registers with the EvictionController. Everytime there is any
- * activity that changes the memory usage in the region, it puts a message
- * into a queue that the EvictionController waits on. The message contains
- * the full region name, the total size of the region (inclusive of keys and
- * values) and the total number of entries.The EvictionController thread picks
- * up the message, updates the total memory size as well as the size of the
- * region in question. It determines whether memory usage is within limits.
- * If so, it goes back to waiting on the queue. If memory usage is out of bounds
- * it does the following.
- *  1> Figures out the delta between specified and actual
- *  2> Determines the size percentage that needs to be evicted
- *  3> Determines the nmber of entries per region (based on size per entry) that
-       needs to be evicted. This is a slice of the total eviction that is
- needed.
-    4> Invokes a method on each region to trigger eviction of entries.The evict
-       method on the region will return the total size evicted for the entries.
-    5> Goes back and checks queue size and recalculates the heap size usage
+ * specified by the heap-lru-limit. Every region with an LRU entries map
+ * registers with the EvictionController. Each map accounts for the bytes its
+ * entries take, keys, values, the entries themselves with their version
+ * stamps and the nodes holding them in the map and the LRU list, and adds
+ * every change to it to the heap LRU size of the cache kept here.
  *
+ * The EvictionController thread is woken up when the size goes over the
+ * limit, and looks at it every CONTROL_INTERVAL besides. Once over the limit
+ * it has the eviction threads evict the bytes over heap-lru-delta percent
+ * below the limit, plus the bytes put in during a round as measured over
+ * the last few, and measures the size again each round until it is under
+ * that. An order is not repeated until it has been carried out, so that
+ * the same excess is not evicted twice.
  *
- * When a region is destroyed, it deregisters itself with the EvictionController
- * Format of object that is put into the region map (int size, int numEntries)
+ * The bytes ordered are shared among the regions in proportion to their
+ * size and to the time since they were last used; each region evicts its
+ * share in the order of its eviction policy. The shares are queued to the
+ * eviction threads as tasks, those of a large region split among them.
+ *
+ * Should the size still climb heap-lru-delta percent over the limit, the
+ * eviction threads have fallen behind: puts into the maps are then held
+ * back until they catch up, for at most MAX_PUT_DELAY each.
+ *
+ * Every RECOUNT_INTERVAL the sizes of the maps are recounted from their
+ * entries and corrected: a value changed in place after it was put takes
+ * a different number of bytes without its map knowing.
+ *
+ * When a region is destroyed, it deregisters itself with the
+ * EvictionController.
  */
 namespace apache {
 namespace geode {
 namespace client {
 
 typedef IntQueue<int64_t> HeapSizeInfoQueue;
-typedef std::vector<std::string> VectorOfString;
 
 class EvictionController;
 class EvictionThread;
 class CacheImpl;
+class LRUEntriesMap;
 typedef std::shared_ptr<EvictionController> EvictionControllerPtr;
 
 class CPPCACHE_EXPORT EvictionController : public ACE_Task_Base {
  public:
   EvictionController(size_t maxHeapSize, int32_t heapSizeDelta,
-                     CacheImpl* cache);
+                     uint32_t evictionThreads, CacheImpl* cache);
 
   ~EvictionController();
 
@@ -86,6 +97,7 @@ class CPPCACHE_EXPORT EvictionController : public ACE_Task_Base {
 
   inline void stop() {
     m_run = false;
+    releaseThrottled();
     evictionThreadPtr->stop();
     this->wait();
     m_regions.clear();
@@ -96,25 +108,90 @@ class CPPCACHE_EXPORT EvictionController : public ACE_Task_Base {
 
   int svc(void);
 
+  /**
+   * Adds the bytes to the heap LRU size, waking the controller up when it
+   * goes over the limit.
+   */
   void updateRegionHeapInfo(int64_t info);
-  void registerRegion(std::string& name);
-  void deregisterRegion(std::string& name);
-  void evict(int32_t percentage);
+
+  /**
+   * Holds a put back while the eviction threads have fallen behind, called
+   * by the maps before they take in more entries. Puts are let through if
+   * the last eviction order freed nothing, as waiting would not help.
+   */
+  inline void throttle() {
+    if (m_currentHeapSize.load(std::memory_order_relaxed) > m_throttleSize) {
+      waitForEviction();
+    }
+  }
+
+  void registerRegion(LRUEntriesMap* map);
+  void deregisterRegion(LRUEntriesMap* map);
+
+  /**
+   * Evicts the bytes from the region with the path, called by the eviction
+   * threads for each task.
+   */
+  int64_t evict(const std::string& path, int64_t bytes);
+
+  /**
+   * Seconds, set each time the controller looks at the heap LRU size; the
+   * maps note the last second they were used in with it.
+   */
+  inline const std::atomic<uint32_t>& clock() const { return m_clock; }
+
+  inline int64_t getHeapSize() const { return m_currentHeapSize; }
 
  private:
-  void orderEvictions(int32_t percentage);
-  void processHeapInfo(int64_t& readInfo, int64_t& pendingEvictions);
+  void processHeapInfo();
+  void recountHeapSize();
+  void orderEviction(int64_t bytes);
+  void waitForEviction();
+  void releaseThrottled();
+
+  // how often the heap LRU size is looked at, in microseconds
+  static const long CONTROL_INTERVAL = 100000;
+  // how often the sizes of the maps are recounted, in seconds
+  static const uint32_t RECOUNT_INTERVAL = 60;
+  // the longest a put is held back, in milliseconds
+  static const long MAX_PUT_DELAY = 100;
+  // the share of a region is not split into tasks smaller than this
+  static const int64_t MIN_TASK_BYTES = 1024 * 1024;
 
  private:
   bool m_run;
   int64_t m_maxHeapSize;
   int64_t m_heapSizeDelta;
+  int64_t m_throttleSize;
   CacheImpl* m_cacheImpl;
-  int64_t m_currentHeapSize;
+  std::atomic<int64_t> m_currentHeapSize;
+  std::atomic<uint32_t> m_clock;
+  // set from the time the controller is woken up until it runs
+  std::atomic<bool> m_wakeUp;
+  // the bytes of the tasks queued to the eviction threads and not yet
+  // carried out
+  std::atomic<int64_t> m_backlog;
+  // the bytes evicted since the controller last looked
+  std::atomic<int64_t> m_evictedBytes;
+  // the bytes evicted for the tasks of the last order so far, and whether
+  // the order before was carried out without freeing anything; puts are
+  // not held back then, as there is nothing to wait for
+  std::atomic<int64_t> m_orderEvictedBytes;
+  std::atomic<bool> m_evictionStalled;
+  // used by the controller thread only
+  int64_t m_lastHeapSize;
+  int64_t m_inflow;
+  bool m_overLimit;
+  std::chrono::steady_clock::time_point m_overLimitSince;
+  uint32_t m_lastRecount;
   HeapSizeInfoQueue m_queue;
-  VectorOfString m_regions;
+  std::vector<LRUEntriesMap*> m_regions;
   mutable ACE_RW_Thread_Mutex m_regionLock;
   EvictionThread* evictionThreadPtr;
+  // the puts held back wait on the condition
+  std::mutex m_throttleLock;
+  std::condition_variable m_throttleCond;
+  std::atomic<int32_t> m_throttled;
   static const char* NC_EC_Thread;
 };
 }  // namespace client
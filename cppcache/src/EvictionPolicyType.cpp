@@ -0,0 +1,40 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geode/EvictionPolicyType.hpp>
+#include "ace/OS.h"
+
+using namespace apache::geode::client;
+
+const char* EvictionPolicyType::names[] = {"lru", "sampled-lru", "tiny-lfu",
+                                           nullptr};
+
+const char* EvictionPolicyType::fromOrdinal(const uint8_t ordinal) {
+  if (ordinal > EvictionPolicyType::TINY_LFU) {
+    return names[EvictionPolicyType::LRU];
+  }
+  return names[ordinal];
+}
+
+EvictionPolicyType::PolicyType EvictionPolicyType::fromName(const char* name) {
+  for (uint32_t i = 0; names[i] != nullptr; ++i) {
+    if (name && ACE_OS::strcasecmp(names[i], name) == 0) {
+      return static_cast<EvictionPolicyType::PolicyType>(i);
+    }
+  }
+  return EvictionPolicyType::LRU;
+}
@@ -16,35 +16,76 @@
  */
 #include "EvictionThread.hpp"
 #include "EvictionController.hpp"
+#include "EvictionThreadStats.hpp"
 #include "DistributedSystemImpl.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
 using namespace apache::geode::client;
 
+namespace {
+thread_local bool t_evictionThread = false;
+}  // namespace
+
 const char* EvictionThread::NC_Evic_Thread = "NC Evic Thread";
-EvictionThread::EvictionThread(EvictionController* parent)
+EvictionThread::EvictionThread(EvictionController* parent, uint32_t threads,
+                               statistics::StatisticsFactory* factory)
     : m_pParent(parent),
       /* adongre
        * CID 28936: Uninitialized scalar field (UNINIT_CTOR)
        */
-      m_run(false) {}
+      m_run(false),
+      m_nextThread(0) {
+  threads = std::max(threads, 1u);
+  for (uint32_t i = 0; i < threads; i++) {
+    m_stats.push_back(new EvictionThreadStats(
+        factory, std::string(NC_Evic_Thread) + " " + std::to_string(i)));
+  }
+}
+
+EvictionThread::~EvictionThread() {
+  for (auto stats : m_stats) {
+    delete stats;
+  }
+}
+
+void EvictionThread::stop() {
+  m_run = false;
+  this->wait();
+  // the cache is going away, the regions with it
+  while (!m_queue.empty()) {
+    delete m_queue.get();
+  }
+  for (auto stats : m_stats) {
+    stats->close();
+  }
+  LOGFINE("Eviction Threads stopped");
+}
 
 int EvictionThread::svc(void) {
   DistributedSystemImpl::setThreadName(NC_Evic_Thread);
+  t_evictionThread = true;
+  EvictionThreadStats& stats = *m_stats[m_nextThread++ % m_stats.size()];
   while (m_run) {
-    processEvictions();
-  }
-  int32_t size = m_queue.size();
-  for (int i = 0; i < size; i++) {
-    processEvictions();
+    processEvictions(stats);
   }
   return 1;
 }
 
-void EvictionThread::processEvictions() {
-  int32_t percentageToEvict = 0;
-  percentageToEvict = static_cast<int32_t>(m_queue.get(1500));
-  if (percentageToEvict != 0) {
-    m_pParent->evict(percentageToEvict);
+void EvictionThread::processEvictions(EvictionThreadStats& stats) {
+  std::unique_ptr<EvictionTask> task(m_queue.get(WAIT_INTERVAL));
+  if (task != nullptr) {
+    auto start = std::chrono::steady_clock::now();
+    int64_t evicted = m_pParent->evict(task->m_path, task->m_bytes);
+    stats.incEvictions(evicted,
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count());
   }
 }
 
-void EvictionThread::putEvictionInfo(int32_t info) { m_queue.put(info); }
+void EvictionThread::putEvictionTask(const std::string& path, int64_t bytes) {
+  m_queue.put(new EvictionTask{path, bytes});
+}
+
+bool EvictionThread::isEvictionThread() { return t_evictionThread; }
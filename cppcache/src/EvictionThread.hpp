@@ -27,41 +27,68 @@
 #include <ace/Task.h>
 #include <geode/DataOutput.hpp>
 #include <geode/Log.hpp>
+#include <geode/statistics/StatisticsFactory.hpp>
+#include <atomic>
+#include <string>
+#include <vector>
 #include "IntQueue.hpp"
 /**
- * This class does the actual evictions
+ * This class does the actual evictions, of the bytes the EvictionController
+ * orders, on a small pool of threads. An order comes as tasks, each to
+ * evict some bytes from one region; the share of a large region is split
+ * so that several threads evict from it at once, locking only the segments
+ * of the entries each of them takes.
  */
 namespace apache {
 namespace geode {
 namespace client {
 class EvictionController;
-typedef IntQueue<int64_t> HeapSizeInfoQueue;
+class EvictionThreadStats;
+
+struct EvictionTask {
+  std::string m_path;
+  int64_t m_bytes;
+};
+typedef IntQueue<EvictionTask*> EvictionTaskQueue;
 
 class CPPCACHE_EXPORT EvictionThread : public ACE_Task_Base {
  public:
-  EvictionThread(EvictionController* parent);
+  EvictionThread(EvictionController* parent, uint32_t threads,
+                 statistics::StatisticsFactory* factory);
+
+  ~EvictionThread();
 
   inline void start() {
     m_run = true;
-    this->activate();
-    LOGFINE("Eviction Thread started");
+    this->activate(THR_NEW_LWP | THR_JOINABLE,
+                   static_cast<int>(m_stats.size()));
+    LOGFINE("Eviction Threads started");
   }
 
-  inline void stop() {
-    m_run = false;
-    this->wait();
-    m_queue.clear();
-    LOGFINE("Eviction Thread stopped");
-  }
+  void stop();
 
   int svc();
-  void putEvictionInfo(int32_t info);
-  void processEvictions();
+  /** has the given number of bytes evicted from the region */
+  void putEvictionTask(const std::string& path, int64_t bytes);
+  void processEvictions(EvictionThreadStats& stats);
+
+  inline uint32_t threads() const {
+    return static_cast<uint32_t>(m_stats.size());
+  }
+
+  /** whether the calling thread is one of the eviction threads */
+  static bool isEvictionThread();
 
  private:
+  // how long a thread waits for a task before it looks at m_run again, in
+  // microseconds
+  static const long WAIT_INTERVAL = 100000;
+
   EvictionController* m_pParent;
-  HeapSizeInfoQueue m_queue;
+  EvictionTaskQueue m_queue;
   bool m_run;
+  std::vector<EvictionThreadStats*> m_stats;
+  std::atomic<uint32_t> m_nextThread;
 
   static const char* NC_Evic_Thread;
 };
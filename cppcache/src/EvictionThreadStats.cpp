@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geode/geode_globals.hpp>
+#include <geode/statistics/StatisticsFactory.hpp>
+
+#include "EvictionThreadStats.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+using statistics::StatisticsFactory;
+
+constexpr const char* EvictionThreadStats::STATS_NAME;
+constexpr const char* EvictionThreadStats::STATS_DESC;
+
+EvictionThreadStats::EvictionThreadStats(StatisticsFactory* factory,
+                                         const std::string& threadName) {
+  auto statsType = factory->findType(STATS_NAME);
+  if (!statsType) {
+    const bool largerIsBetter = true;
+    auto stats = new StatisticDescriptor*[3];
+    stats[0] = factory->createIntCounter(
+        "tasks", "The total number of eviction orders carried out",
+        "operations", largerIsBetter);
+    stats[1] = factory->createLongCounter(
+        "evictedBytes", "The total number of bytes evicted", "bytes",
+        largerIsBetter);
+    stats[2] = factory->createLongCounter(
+        "evictionTime", "The total time, in nanoseconds, spent evicting",
+        "nanoseconds", !largerIsBetter);
+
+    statsType = factory->createType(STATS_NAME, STATS_DESC, stats, 3);
+  }
+
+  m_evictionThreadStats =
+      factory->createAtomicStatistics(statsType, threadName.c_str());
+
+  m_tasksId = statsType->nameToId("tasks");
+  m_evictedBytesId = statsType->nameToId("evictedBytes");
+  m_evictionTimeId = statsType->nameToId("evictionTime");
+
+  m_evictionThreadStats->setInt(m_tasksId, 0);
+  m_evictionThreadStats->setLong(m_evictedBytesId, 0);
+  m_evictionThreadStats->setLong(m_evictionTimeId, 0);
+}
+
+EvictionThreadStats::~EvictionThreadStats() {
+  if (m_evictionThreadStats != nullptr) {
+    // closed by the owner, deleted with the other statistics
+    m_evictionThreadStats = nullptr;
+  }
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_EVICTIONTHREADSTATS_H_
+#define GEODE_EVICTIONTHREADSTATS_H_
+
+#include <string>
+
+#include <geode/geode_globals.hpp>
+#include <geode/statistics/Statistics.hpp>
+#include <geode/statistics/StatisticsFactory.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+using statistics::StatisticDescriptor;
+using statistics::StatisticsType;
+using statistics::Statistics;
+
+/**
+ * The work of one heap LRU eviction thread; its throughput is evictedBytes
+ * over evictionTime.
+ */
+class CPPCACHE_EXPORT EvictionThreadStats {
+ public:
+  EvictionThreadStats(statistics::StatisticsFactory* factory,
+                      const std::string& threadName);
+
+  virtual ~EvictionThreadStats();
+
+  void close() { m_evictionThreadStats->close(); }
+
+  inline void incEvictions(int64_t bytes, int64_t nanos) {
+    m_evictionThreadStats->incInt(m_tasksId, 1);
+    m_evictionThreadStats->incLong(m_evictedBytesId, bytes);
+    m_evictionThreadStats->incLong(m_evictionTimeId, nanos);
+  }
+
+  inline int64_t getEvictedBytes() const {
+    return m_evictionThreadStats->getLong(m_evictedBytesId);
+  }
+
+ private:
+  Statistics* m_evictionThreadStats;
+
+  int32_t m_tasksId;
+  int32_t m_evictedBytesId;
+  int32_t m_evictionTimeId;
+
+  static constexpr const char* STATS_NAME = "EvictionThreadStatistics";
+  static constexpr const char* STATS_DESC =
+      "Statistics for a heap LRU eviction thread";
+};
+
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_EVICTIONTHREADSTATS_H_
@@ -33,6 +33,13 @@ void ExpEntryFactory::newMapEntry(ExpiryTaskManager* expiryTaskManager,
   }
 }
 
+size_t ExpEntryFactory::getEntrySize() const {
+  if (m_concurrencyChecksEnabled) {
+    return sizeof(MapEntryT<VersionedExpMapEntry, 0, 0>);
+  }
+  return sizeof(MapEntryT<ExpMapEntry, 0, 0>);
+}
+
 }  // namespace client
 }  // namespace geode
 }  // namespace apache
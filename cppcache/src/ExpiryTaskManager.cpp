@@ -34,7 +34,8 @@ using namespace apache::geode::client;
 
 const char* ExpiryTaskManager::NC_ETM_Thread = "NC ETM Thread";
 
-ExpiryTaskManager::ExpiryTaskManager() : m_reactorEventLoopRunning(false) {
+ExpiryTaskManager::ExpiryTaskManager(bool useTimingWheel)
+    : m_reactorEventLoopRunning(false) {
 #if defined(_WIN32)
   m_reactor = new ACE_Reactor(
       new ACE_WFMO_Reactor(nullptr, new GF_Timer_Heap_ImmediateReset()), 1);
@@ -45,6 +46,25 @@ ExpiryTaskManager::ExpiryTaskManager() : m_reactorEventLoopRunning(false) {
   m_reactor = new ACE_Reactor(
       new ACE_Dev_Poll_Reactor(nullptr, new GF_Timer_Heap_ImmediateReset()), 1);
 #endif
+
+  if (useTimingWheel) {
+    ACE_Time_Value now(ACE_OS::gettimeofday());
+    m_timingWheel = std::unique_ptr<TimingWheel>(new TimingWheel(now.sec()));
+    m_timingWheelTicker = std::unique_ptr<TimingWheelTicker>(
+        new TimingWheelTicker(*m_timingWheel));
+    // on the turn of every second, when the timers of the wheel are due
+    ACE_Time_Value firstTick(0, 1000000 - now.usec());
+    m_reactor->schedule_timer(m_timingWheelTicker.get(), 0, firstTick,
+                              ACE_Time_Value(1));
+    LOGFINE("ExpiryTaskManager: entry, region and tombstone expiry on a "
+            "timing wheel.");
+  }
+}
+
+int ExpiryTaskManager::TimingWheelTicker::handle_timeout(
+    const ACE_Time_Value& current_time, const void* arg) {
+  m_timingWheel.expire(current_time);
+  return 0;
 }
 
 long ExpiryTaskManager::scheduleExpiryTask(ACE_Event_Handler* handler,
@@ -73,12 +93,31 @@ long ExpiryTaskManager::scheduleExpiryTask(ACE_Event_Handler* handler,
   return m_reactor->schedule_timer(handler, 0, expTimeValue, intervalVal);
 }
 
+long ExpiryTaskManager::scheduleCoarseExpiryTask(ACE_Event_Handler* handler,
+                                                 uint32_t expTime,
+                                                 uint32_t interval) {
+  if (m_timingWheel == nullptr) {
+    return scheduleExpiryTask(handler, expTime, interval);
+  }
+  LOGFINER("Scheduled expiration on the timing wheel ... in %d seconds.",
+           expTime);
+  ACE_Time_Value now(ACE_OS::gettimeofday());
+  return m_timingWheel->schedule(handler, nullptr, now.sec() + expTime,
+                                 interval);
+}
+
 int ExpiryTaskManager::resetTask(ExpiryTaskManager::id_type id, uint32_t sec) {
+  if (m_timingWheel != nullptr && TimingWheel::isTimingWheelId(id)) {
+    return m_timingWheel->resetInterval(id, sec);
+  }
   ACE_Time_Value interval(sec);
   return m_reactor->reset_timer_interval(id, interval);
 }
 
 int ExpiryTaskManager::cancelTask(ExpiryTaskManager::id_type id) {
+  if (m_timingWheel != nullptr && TimingWheel::isTimingWheelId(id)) {
+    return m_timingWheel->cancel(id);
+  }
   return m_reactor->cancel_timer(id, 0, 0);
 }
 
@@ -114,4 +153,6 @@ ExpiryTaskManager::~ExpiryTaskManager() {
   stopExpiryTaskManager();
   delete m_reactor;
   m_reactor = nullptr;
+  m_timingWheel.reset();
+  m_timingWheelTicker.reset();
 }
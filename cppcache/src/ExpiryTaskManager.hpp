@@ -22,7 +22,9 @@
 #include <ace/Reactor.h>
 #include <ace/Task.h>
 #include <ace/Timer_Heap.h>
+#include <memory>
 #include "ReadWriteLock.hpp"
+#include "TimingWheel.hpp"
 
 #include <geode/geode_globals.hpp>
 #include <geode/Log.hpp>
@@ -214,9 +216,11 @@ class CPPCACHE_EXPORT ExpiryTaskManager : public ACE_Task_Base {
       GF_Timer_Heap_ImmediateReset;
 
   /**
-   * Constructor
+   * Constructor. With useTimingWheel the tasks scheduled with
+   * scheduleCoarseExpiryTask() go on a TimingWheel that the reactor expires
+   * every second.
    */
-  ExpiryTaskManager();
+  explicit ExpiryTaskManager(bool useTimingWheel = false);
   /**
    * Destructor. Stops the reactors event loop if it is not running
    * and then exits.
@@ -234,6 +238,15 @@ class CPPCACHE_EXPORT ExpiryTaskManager : public ACE_Task_Base {
                           ACE_Time_Value intervalVal,
                           bool cancelExistingTask = false);
 
+  /**
+   * For scheduling the expiry of an entry, a region or a tombstone, of which
+   * there may be millions. These go on the timing wheel when there is one,
+   * and expire within the second they are due in, on the timer heap of the
+   * reactor otherwise.
+   */
+  long scheduleCoarseExpiryTask(ACE_Event_Handler* handler, uint32_t expTime,
+                                uint32_t interval = 0);
+
   /**
    * for resetting the interval an already registered task.
    * returns '0' if successful '-1' on failure.
@@ -265,6 +278,20 @@ class CPPCACHE_EXPORT ExpiryTaskManager : public ACE_Task_Base {
  private:
   ACE_Reactor* m_reactor;
 
+  // expires the timing wheel every second
+  class TimingWheelTicker : public ACE_Event_Handler {
+   public:
+    explicit TimingWheelTicker(TimingWheel& timingWheel)
+        : m_timingWheel(timingWheel) {}
+    int handle_timeout(const ACE_Time_Value& current_time, const void* arg);
+
+   private:
+    TimingWheel& m_timingWheel;
+  };
+
+  std::unique_ptr<TimingWheel> m_timingWheel;
+  std::unique_ptr<TimingWheelTicker> m_timingWheelTicker;
+
   bool m_reactorEventLoopRunning;  // flag to indicate if the reactor event
                                    // loop is running or not.
   ACE_Recursive_Thread_Mutex m_taskLock;  // to synchronize scheduling
@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrequencySketch.hpp"
+
+#include <algorithm>
+#include <bitset>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+namespace {
+
+const uint64_t SEEDS[] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                          0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+const uint64_t RESET_MASK = 0x7777777777777777ULL;
+const uint64_t ONE_MASK = 0x1111111111111111ULL;
+const uint32_t MAX_TABLE_SIZE = 1u << 30;
+const uint64_t MAX_SAMPLE_SIZE = 0x7fffffff;
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(uint32_t maximumSize) : m_size(0) {
+  uint32_t maximum = std::min(std::max(maximumSize, 1u), MAX_TABLE_SIZE);
+  size_t tableSize = 1;
+  while (tableSize < maximum) {
+    tableSize <<= 1;
+  }
+  // value initialized, the counters start at zero
+  std::vector<std::atomic<uint64_t> >(tableSize).swap(m_table);
+  m_tableMask = tableSize - 1;
+  m_sampleSize = static_cast<uint32_t>(
+      std::min(static_cast<uint64_t>(maximum) * 10, MAX_SAMPLE_SIZE));
+}
+
+void FrequencySketch::increment(int32_t hash) {
+  uint32_t spreadHash = spread(static_cast<uint32_t>(hash));
+  // the four counters are at the same place of their words
+  uint32_t start = (spreadHash & 3) << 2;
+  bool added = false;
+  for (uint32_t i = 0; i < 4; i++) {
+    added |= incrementAt(indexOf(spreadHash, i), start + i);
+  }
+  if (added && ++m_size == m_sampleSize) {
+    reset();
+  }
+}
+
+uint32_t FrequencySketch::frequency(int32_t hash) const {
+  uint32_t spreadHash = spread(static_cast<uint32_t>(hash));
+  uint32_t start = (spreadHash & 3) << 2;
+  uint32_t frequency = 0xf;
+  for (uint32_t i = 0; i < 4; i++) {
+    uint64_t word = m_table[indexOf(spreadHash, i)].load(
+        std::memory_order_relaxed);
+    uint32_t count = static_cast<uint32_t>(word >> ((start + i) << 2)) & 0xf;
+    frequency = std::min(frequency, count);
+  }
+  return frequency;
+}
+
+uint32_t FrequencySketch::spread(uint32_t hash) {
+  hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+  hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+  return (hash >> 16) ^ hash;
+}
+
+size_t FrequencySketch::indexOf(uint32_t hash, uint32_t i) const {
+  uint64_t index = (hash + SEEDS[i]) * SEEDS[i];
+  index += index >> 32;
+  return static_cast<size_t>(index) & m_tableMask;
+}
+
+bool FrequencySketch::incrementAt(size_t index, uint32_t counter) {
+  uint32_t offset = counter << 2;
+  uint64_t mask = static_cast<uint64_t>(0xf) << offset;
+  std::atomic<uint64_t>& word = m_table[index];
+  uint64_t value = word.load(std::memory_order_relaxed);
+  while ((value & mask) != mask) {
+    if (word.compare_exchange_weak(value,
+                                   value + (static_cast<uint64_t>(1) << offset),
+                                   std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FrequencySketch::reset() {
+  uint32_t odd = 0;
+  for (auto& word : m_table) {
+    uint64_t value = word.load(std::memory_order_relaxed);
+    while (!word.compare_exchange_weak(value, (value >> 1) & RESET_MASK,
+                                       std::memory_order_relaxed)) {
+    }
+    odd += static_cast<uint32_t>(std::bitset<64>(value & ONE_MASK).count());
+  }
+  // less the counts lost to the halving of odd counters, each item has four
+  uint32_t size = m_size.load() >> 1;
+  m_size = size > (odd >> 2) ? size - (odd >> 2) : 0;
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_FREQUENCYSKETCH_H_
+#define GEODE_FREQUENCYSKETCH_H_
+
+#include <atomic>
+#include <vector>
+
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * Estimates how often each of a large number of items was used, in little
+ * memory, to tell the frequently used entries of a map from the rest.
+ *
+ * A count-min sketch of four bit counters: an item counts in four counters
+ * of four different words of the table, and its frequency is the smallest
+ * of them. The table has a word, that is sixteen counters, per item the
+ * sketch is sized for. Once ten times as many items were counted, all the
+ * counters are halved so that the estimates follow changes in the usage.
+ *
+ * The counters are updated without a lock; concurrent updates are not
+ * lost, a halving that runs concurrently with them may count them before
+ * or after it.
+ */
+class CPPCACHE_EXPORT FrequencySketch {
+ public:
+  /** sizes the sketch for about the given number of items */
+  explicit FrequencySketch(uint32_t maximumSize);
+
+  /** counts a use of the item of the given hash */
+  void increment(int32_t hash);
+
+  /** the estimated number of uses of the item of the given hash, up to 15 */
+  uint32_t frequency(int32_t hash) const;
+
+ private:
+  static uint32_t spread(uint32_t hash);
+  size_t indexOf(uint32_t hash, uint32_t i) const;
+  // increments the counter of the word unless it is at 15 already
+  bool incrementAt(size_t index, uint32_t counter);
+  // halves all the counters
+  void reset();
+
+  std::vector<std::atomic<uint64_t> > m_table;
+  size_t m_tableMask;
+  uint32_t m_sampleSize;
+  std::atomic<uint32_t> m_size;
+
+  FrequencySketch(const FrequencySketch&) = delete;
+  FrequencySketch& operator=(const FrequencySketch&) = delete;
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_FREQUENCYSKETCH_H_
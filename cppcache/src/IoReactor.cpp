@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IoReactor.hpp"
+
+#if defined(ACE_HAS_EVENT_POLL) || defined(ACE_HAS_DEV_POLL)
+#include <ace/Dev_Poll_Reactor.h>
+#else
+#include <ace/TP_Reactor.h>
+#endif
+
+#include <geode/Log.hpp>
+
+#include "DistributedSystemImpl.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+const char* IoReactor::NC_IO_Reactor = "NC IO Reactor";
+
+IoReactor::IoReactor(uint32_t threads) {
+#if defined(ACE_HAS_EVENT_POLL) || defined(ACE_HAS_DEV_POLL)
+  m_reactor = new ACE_Reactor(new ACE_Dev_Poll_Reactor(), 1);
+#else
+  m_reactor = new ACE_Reactor(new ACE_TP_Reactor(), 1);
+#endif
+  activate(THR_NEW_LWP | THR_JOINABLE, threads > 0 ? threads : 1);
+}
+
+IoReactor::~IoReactor() {
+  m_reactor->end_reactor_event_loop();
+  wait();
+  delete m_reactor;
+  m_reactor = nullptr;
+}
+
+int IoReactor::registerHandler(ACE_Event_Handler* handler) {
+  return m_reactor->register_handler(handler, ACE_Event_Handler::READ_MASK);
+}
+
+int IoReactor::removeHandler(ACE_Event_Handler* handler) {
+  return m_reactor->remove_handler(handler, ACE_Event_Handler::READ_MASK);
+}
+
+int IoReactor::suspendHandler(ACE_Event_Handler* handler) {
+  return m_reactor->suspend_handler(handler);
+}
+
+int IoReactor::resumeHandler(ACE_Event_Handler* handler) {
+  return m_reactor->resume_handler(handler);
+}
+
+int IoReactor::svc() {
+  DistributedSystemImpl::setThreadName(NC_IO_Reactor);
+  LOGFINE("IO reactor thread is running.");
+  m_reactor->run_reactor_event_loop();
+  LOGFINE("IO reactor thread has stopped.");
+  return 0;
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
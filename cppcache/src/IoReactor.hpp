@@ -0,0 +1,81 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_IOREACTOR_H_
+#define GEODE_IOREACTOR_H_
+
+#include <ace/Event_Handler.h>
+#include <ace/Reactor.h>
+#include <ace/Task.h>
+
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * A reactor shared by the connections of a cache, whose event loop is run by
+ * a small, fixed number of threads.
+ *
+ * Connections that wait for data from the server without a request of their
+ * own, the subscription channels and the readers of pipelined connections,
+ * register their socket instead of blocking a thread of their own in a
+ * receive; a thread of the reactor calls them when data arrived. On
+ * platforms with epoll the reactor is an ACE_Dev_Poll_Reactor, elsewhere an
+ * ACE_TP_Reactor. Both dispatch a handler to one thread at a time, so the
+ * messages of a connection are processed in order.
+ */
+class CPPCACHE_EXPORT IoReactor : public ACE_Task_Base {
+ public:
+  /** starts the event loop in the given number of threads */
+  explicit IoReactor(uint32_t threads);
+
+  /** stops the event loop */
+  ~IoReactor();
+
+  /**
+   * Calls the handle_input() of the handler whenever its handle has data to
+   * read, until it returns -1 or is removed. Returns -1 on failure.
+   */
+  int registerHandler(ACE_Event_Handler* handler);
+
+  /** the reactor calls handle_close() of the handler on removal */
+  int removeHandler(ACE_Event_Handler* handler);
+
+  /** stops calling the handler until it is resumed */
+  int suspendHandler(ACE_Event_Handler* handler);
+
+  int resumeHandler(ACE_Event_Handler* handler);
+
+  int svc();
+
+ private:
+  ACE_Reactor* m_reactor;
+
+  static const char* NC_IO_Reactor;
+
+  IoReactor(const IoReactor&) = delete;
+  IoReactor& operator=(const IoReactor&) = delete;
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_IOREACTOR_H_
@@ -89,12 +89,11 @@ bool LRUOverFlowToDiskAction::evict(const MapEntryImplPtr& mePtr) {
   (m_regionPtr->getRegionStats())->incOverflows();
   (m_regionPtr->getCacheImpl())->getCachePerfStats().incOverflows();
   // set value after write on disk to indicate that it is on disk.
+  lruProps.incOverflowCount();
   mePtr->setValueI(CacheableToken::overflowed());
 
   if (m_entriesMapPtr != nullptr) {
-    int64_t newSize =
-        CacheableToken::overflowed()->objectSize() - valuePtr->objectSize();
-    m_entriesMapPtr->updateMapSize(newSize);
+    m_entriesMapPtr->updateMapSize(-LRUEntriesMap::valueBytes(valuePtr));
   }
   return true;
 }
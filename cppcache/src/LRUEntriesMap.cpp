@@ -20,6 +20,9 @@
 #include "MapSegment.hpp"
 #include "CacheImpl.hpp"
 
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <exception>
 #include <mutex>
 #include "util/concurrent/spinlock_mutex.hpp"
 
@@ -58,26 +61,53 @@ LRUEntriesMap::LRUEntriesMap(ExpiryTaskManager* expiryTaskManager,
                              const LRUAction::Action& lruAction,
                              const uint32_t limit,
                              bool concurrencyChecksEnabled,
-                             const uint8_t concurrency, bool heapLRUEnabled)
+                             const uint8_t concurrency, bool heapLRUEnabled,
+                             bool concurrentReads,
+                             EvictionPolicyType::PolicyType evictionPolicy)
     : ConcurrentEntriesMap(expiryTaskManager, std::move(entryFactory),
-                           concurrencyChecksEnabled, region, concurrency),
+                           concurrencyChecksEnabled, region, concurrency,
+                           concurrentReads),
+      m_evictionPolicy(evictionPolicy),
       m_lruList(),
+      m_windowList(),
+      m_windowSize(0),
+      m_sketch(evictionPolicy == EvictionPolicyType::TINY_LFU
+                   ? new FrequencySketch(limit > 0 ? limit
+                                                   : SKETCH_SIZE_WITHOUT_LIMIT)
+                   : nullptr),
+      m_lruClock(0),
+      m_sampleSeed(0),
       m_limit(limit),
       m_pmPtr(nullptr),
+      m_currentMapSize(0),
+      m_heapLRUClock(nullptr),
+      m_lastUsed(0),
       m_validEntries(0),
       m_heapLRUEnabled(heapLRUEnabled) {
-  m_currentMapSize = 0;
   m_action = nullptr;
   m_evictionControllerPtr = nullptr;
+  // the entry and the count of its shared pointer are allocated together,
+  // the map takes a node for it and a table slot for each node of a table
+  // kept at most three quarters full
+  m_entryOverhead =
+      allocationBytes(getEntryFactory()->getEntrySize() + 2 * sizeof(void*)) +
+      allocationBytes(MapSegment::nodeSize()) +
+      static_cast<int64_t>(MapSegment::nodeSize() * 4 / 3);
+  if (evictionPolicy != EvictionPolicyType::SAMPLED_LRU) {
+    m_entryOverhead += allocationBytes(
+        LRUList<MapEntryImpl, MapEntryT<LRUMapEntry, 0, 0> >::nodeSize());
+  }
   // translate action type to an instance.
   if (region) {
     m_action = LRUAction::newLRUAction(lruAction, region, this);
-    m_name = region->getName();
+    m_name = region->getFullPath();
     CacheImpl* cImpl = region->getCacheImpl();
     if (cImpl != nullptr) {
       m_evictionControllerPtr = cImpl->getEvictionController();
       if (m_evictionControllerPtr != nullptr) {
-        m_evictionControllerPtr->registerRegion(m_name);
+        m_heapLRUClock = &m_evictionControllerPtr->clock();
+        m_lastUsed = m_heapLRUClock->load();
+        m_evictionControllerPtr->registerRegion(this);
         LOGINFO("Heap LRU eviction controller registered region %s",
                 m_name.c_str());
       }
@@ -89,14 +119,18 @@ LRUEntriesMap::LRUEntriesMap(ExpiryTaskManager* expiryTaskManager,
 
 void LRUEntriesMap::close() {
   if (m_evictionControllerPtr != nullptr) {
-    m_evictionControllerPtr->updateRegionHeapInfo((-1 * (m_currentMapSize)));
-    m_evictionControllerPtr->deregisterRegion(m_name);
+    m_evictionControllerPtr->deregisterRegion(this);
+    int64_t size = m_currentMapSize.exchange(0);
+    m_evictionControllerPtr->updateRegionHeapInfo(-size);
   }
   ConcurrentEntriesMap::close();
 }
 
 void LRUEntriesMap::clear() {
-  updateMapSize((-1 * (m_currentMapSize)));
+  if (m_evictionControllerPtr != nullptr) {
+    int64_t size = m_currentMapSize.exchange(0);
+    m_evictionControllerPtr->updateRegionHeapInfo(-size);
+  }
   ConcurrentEntriesMap::clear();
 }
 
@@ -113,8 +147,13 @@ GfErrType LRUEntriesMap::create(const CacheableKeyPtr& key,
                                 MapEntryImplPtr& me, CacheablePtr& oldValue,
                                 int updateCount, int destroyTracker,
                                 VersionTagPtr versionTag) {
+  // before the segment is locked, the eviction threads may need it
+  if (m_evictionControllerPtr != nullptr) {
+    m_evictionControllerPtr->throttle();
+  }
   MapSegment* segmentRPtr = segmentFor(key);
   GfErrType err = GF_NOERR;
+  recordUse(key);
   {  // SYNCHRONIZE_SEGMENT(segmentRPtr);
     MapEntryImplPtr mePtr;
     if ((err = segmentRPtr->create(key, newValue, me, oldValue, updateCount,
@@ -134,19 +173,16 @@ GfErrType LRUEntriesMap::create(const CacheableKeyPtr& key,
     if (mePtr == nullptr) {
       return err;
     }
-    m_lruList.appendEntry(mePtr);
+    addToLRU(mePtr);
     me = mePtr;
   }
   if (m_evictionControllerPtr != nullptr) {
-    int64_t newSize =
-        static_cast<int64_t>(Utils::checkAndGetObjectSize(newValue));
-    newSize += static_cast<int64_t>(Utils::checkAndGetObjectSize(key));
-    if (oldValue != nullptr) {
-      newSize -= static_cast<int64_t>(oldValue->objectSize());
+    // a create over an invalid entry only gives it a value
+    if (CacheableToken::isInvalid(oldValue)) {
+      updateMapSize(valueBytes(newValue));
     } else {
-      newSize -= static_cast<int64_t>(sizeof(void*));
+      updateMapSize(entryBytes(key, newValue));
     }
-    updateMapSize(newSize);
   }
   err = processLRU();
   return err;
@@ -161,54 +197,197 @@ GfErrType LRUEntriesMap::processLRU() {
 }
 
 GfErrType LRUEntriesMap::evictionHelper() {
+  int64_t evictedBytes = 0;
+  return evictionHelper(evictedBytes);
+}
+
+GfErrType LRUEntriesMap::evictionHelper(int64_t& evictedBytes) {
   GfErrType err = GF_NOERR;
   //  ACE_Guard< ACE_Recursive_Thread_Mutex > guard( m_mutex );
   MapEntryImplPtr lruEntryPtr;
-  m_lruList.getLRUEntry(lruEntryPtr);
+  if (m_evictionPolicy == EvictionPolicyType::SAMPLED_LRU) {
+    getSampledLRUEntry(lruEntryPtr);
+  } else if (m_evictionPolicy == EvictionPolicyType::TINY_LFU) {
+    getTinyLFUEntry(lruEntryPtr);
+  } else {
+    m_lruList.getLRUEntry(lruEntryPtr);
+  }
   if (lruEntryPtr == nullptr) {
     err = GF_ENOENT;
     return err;
   }
+  // overflow and invalidate free the value, the other actions the entry
+  CacheableKeyPtr key;
+  CacheablePtr value;
+  lruEntryPtr->getKeyI(key);
+  lruEntryPtr->getValueI(value);
+  int64_t entryEvictedBytes = m_action->overflows() || m_action->invalidates()
+                                  ? valueBytes(value)
+                                  : entryBytes(key, value);
   bool IsEvictDone = m_action->evict(lruEntryPtr);
   if (m_action->overflows() && IsEvictDone) {
     --m_validEntries;
     lruEntryPtr->getLRUProperties().setEvicted();
   }
   if (!IsEvictDone) {
+    if (m_evictionPolicy == EvictionPolicyType::SAMPLED_LRU) {
+      // may be sampled again
+      lruEntryPtr->getLRUProperties().clearEvicted();
+    }
     err = GF_DISKFULL;
     return err;
   }
+  evictedBytes += entryEvictedBytes;
   return err;
 }
 
-void LRUEntriesMap::processLRU(int32_t numEntriesToEvict) {
-  int32_t evicted = 0;
-  for (int32_t i = 0; i < numEntriesToEvict; i++) {
-    if (m_validEntries > 0 && size() > 0) {
-      if (evictionHelper() == GF_NOERR) {
-        evicted++;
-      }
+void LRUEntriesMap::getSampledLRUEntry(MapEntryImplPtr& result) {
+  result = nullptr;
+  std::vector<MapEntryImplPtr> samples;
+  samples.reserve(EVICTION_SAMPLES);
+  // segments may be empty or sparse, give up after a few rounds of them
+  for (uint32_t attempt = 0; attempt < 2u * m_concurrency &&
+                             samples.size() < EVICTION_SAMPLES;
+       attempt++) {
+    // splitmix64 of a counter
+    uint64_t random = (m_sampleSeed += 0x9e3779b97f4a7c15ULL);
+    random = (random ^ (random >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    random = (random ^ (random >> 27)) * 0x94d049bb133111ebULL;
+    random ^= random >> 31;
+    m_segments[random % m_concurrency].sampleEntries(
+        static_cast<size_t>(random >> 8),
+        EVICTION_SAMPLES - static_cast<uint32_t>(samples.size()), samples);
+  }
+
+  // the clock may tick while sampling, the age of a sample is taken
+  // relative to a tick read afterwards so that it does not go negative
+  uint32_t now = m_lruClock.load(std::memory_order_relaxed);
+  std::sort(samples.begin(), samples.end(),
+            [now](const MapEntryImplPtr& lhs, const MapEntryImplPtr& rhs) {
+              return now - lhs->getLRUProperties().getLastUsed() >
+                     now - rhs->getLRUProperties().getLastUsed();
+            });
+  for (const auto& sample : samples) {
+    // skips those evicted already, or being evicted by another thread
+    if (sample->getLRUProperties().trySetEvicted()) {
+      result = sample;
+      return;
+    }
+  }
+}
+
+void LRUEntriesMap::addToWindow(const MapEntryImplPtr& entry) {
+  if (entry->getLRUProperties().setInWindow()) {
+    ++m_windowSize;
+  }
+  m_windowList.appendEntry(entry);
+  // until the map is full the window spills over into the main list, after
+  // that the entries out of the window have to be admitted to it
+  if (m_windowSize > windowLimit() && !mustEvict()) {
+    MapEntryImplPtr spilled;
+    takeFromList(m_windowList, true, spilled);
+    if (spilled != nullptr) {
+      spilled->getLRUProperties().clearEvicted();
+      m_lruList.appendEntry(spilled);
+    }
+  }
+}
+
+void LRUEntriesMap::takeFromList(
+    LRUList<MapEntryImpl, MapEntryT<LRUMapEntry, 0, 0> >& list, bool window,
+    MapEntryImplPtr& result) {
+  while (true) {
+    list.getLRUEntry(result);
+    if (result == nullptr) {
+      return;
+    }
+    LRUEntryProperties& lruProps = result->getLRUProperties();
+    if (lruProps.testInWindow() == window) {
+      leaveWindow(lruProps);
+      return;
+    }
+    // the entry moved to the other list since
+    if (lruProps.testEvicted()) {
+      // the last entry of a list is marked evicted and left in it as its
+      // head; the entry is still in the other list
+      lruProps.clearEvicted();
+      result = nullptr;
+      return;
+    }
+  }
+}
+
+void LRUEntriesMap::getTinyLFUEntry(MapEntryImplPtr& result) {
+  MapEntryImplPtr candidate;
+  if (m_windowSize > windowLimit()) {
+    takeFromList(m_windowList, true, candidate);
+  }
+  MapEntryImplPtr victim;
+  takeFromList(m_lruList, false, victim);
+  if (candidate == nullptr || victim == nullptr) {
+    result = candidate != nullptr ? candidate : victim;
+    if (result == nullptr) {
+      takeFromList(m_windowList, true, result);
+    }
+    return;
+  }
+
+  // the candidate is admitted to the main list only if its key is used more
+  // often than the one of the entry it would take the place of
+  if (keyFrequency(candidate) > keyFrequency(victim)) {
+    candidate->getLRUProperties().clearEvicted();
+    m_lruList.appendEntry(candidate);
+    result = victim;
+  } else {
+    // stays the least recently used, for the next candidates to beat
+    LRUEntryProperties& lruProps = victim->getLRUProperties();
+    if (lruProps.testEvicted()) {
+      // the last entry of the list is marked evicted but is still its head
+      lruProps.clearEvicted();
     } else {
+      m_lruList.prependEntry(victim);
+    }
+    result = candidate;
+  }
+}
+
+uint32_t LRUEntriesMap::keyFrequency(const MapEntryImplPtr& entry) const {
+  CacheableKeyPtr key;
+  entry->getKeyI(key);
+  return m_sketch->frequency(key->hashcode());
+}
+
+int64_t LRUEntriesMap::evictBytes(int64_t bytes) {
+  int64_t evicted = 0;
+  // an entry that cannot be evicted now ends the round, the eviction
+  // controller orders the bytes still to be freed again
+  while (evicted < bytes && m_validEntries > 0 && size() > 0) {
+    if (evictionHelper(evicted) != GF_NOERR) {
       break;
     }
   }
+  return evicted;
 }
 
 GfErrType LRUEntriesMap::invalidate(const CacheableKeyPtr& key,
                                     MapEntryImplPtr& me, CacheablePtr& oldValue,
                                     VersionTagPtr versionTag) {
-  int64_t newSize = 0;
   MapSegment* segmentRPtr = segmentFor(key);
   bool isTokenAdded = false;
   GfErrType err =
       segmentRPtr->invalidate(key, me, oldValue, versionTag, isTokenAdded);
   if (isTokenAdded) {
     ++m_size;
+    if (m_evictionControllerPtr != nullptr) {
+      updateMapSize(entryBytes(key, nullptr));
+    }
   }
   if (err != GF_NOERR) {
     return err;
   }
   bool isOldValueToken = CacheableToken::isToken(oldValue);
+  // taken before an overflowed value is read back, it took no memory
+  int64_t oldBytes = valueBytes(oldValue);
   //  get the old value first which is required for heapLRU
   // calculation and for listeners; note even though there is a race
   // here between get and destroy, it will not harm if we get a slightly
@@ -232,16 +411,9 @@ GfErrType LRUEntriesMap::invalidate(const CacheableKeyPtr& key,
   if (!isOldValueToken) {
     --m_validEntries;
     me->getLRUProperties().setEvicted();
-    newSize = CacheableToken::invalid()->objectSize();
-    if (oldValue != nullptr) {
-      newSize -= oldValue->objectSize();
-    } else {
-      newSize -= sizeof(void*);
-    }
-    if (m_evictionControllerPtr != nullptr) {
-      if (newSize != 0) {
-        updateMapSize(newSize);
-      }
+    leaveWindow(me->getLRUProperties());
+    if (m_evictionControllerPtr != nullptr && oldBytes != 0) {
+      updateMapSize(-oldBytes);
     }
   }
   return err;
@@ -252,11 +424,16 @@ GfErrType LRUEntriesMap::put(const CacheableKeyPtr& key,
                              CacheablePtr& oldValue, int updateCount,
                              int destroyTracker, VersionTagPtr versionTag,
                              bool& isUpdate, DataInput* delta) {
+  if (m_evictionControllerPtr != nullptr) {
+    m_evictionControllerPtr->throttle();
+  }
   MapSegment* segmentRPtr = segmentFor(key);
   GF_D_ASSERT(segmentRPtr != nullptr);
+  recordUse(key);
 
   GfErrType err = GF_NOERR;
   bool segmentLocked = false;
+  int64_t oldBytes = 0;
   {
     if (m_action != nullptr &&
         m_action->getType() == LRUAction::OVERFLOW_TO_DISK) {
@@ -272,6 +449,8 @@ GfErrType LRUEntriesMap::put(const CacheableKeyPtr& key,
     }
 
     bool isOldValueToken = CacheableToken::isToken(oldValue);
+    // taken before an overflowed value is read back, it took no memory
+    oldBytes = valueBytes(oldValue);
     // TODO:  need tests for checking that oldValue is returned
     // correctly to listeners for overflow -- this is for all operations
     // put, invalidate, destroy
@@ -316,39 +495,24 @@ GfErrType LRUEntriesMap::put(const CacheableKeyPtr& key,
       // mePtr cannot be null, we just put it...
       // must convert to an LRUMapEntryImplPtr...
       GF_D_ASSERT(mePtr != nullptr);
-      m_lruList.appendEntry(mePtr);
+      addToLRU(mePtr);
       me = mePtr;
     } else {
       if (!CacheableToken::isToken(newValue) && isOldValueToken) {
         CacheablePtr tmpValue;
         segmentRPtr->getEntry(key, mePtr, tmpValue);
         mePtr->getLRUProperties().clearEvicted();
-        m_lruList.appendEntry(MapEntryImplPtr(mePtr->getImplPtr()));
+        addToLRU(MapEntryImplPtr(mePtr->getImplPtr()));
         me = mePtr;
       }
     }
   }
   if (m_evictionControllerPtr != nullptr) {
-    int64_t newSize =
-        static_cast<int64_t>(Utils::checkAndGetObjectSize(newValue));
-    /*
-    if (newSize == 0) {
-      LOGWARN("Object size for class ID %d should not be zero when HeapLRU is
-    enabled", newValue->classId());
-      LOGDEBUG("Type ID is %d for the object returning zero HeapLRU size",
-    newValue->typeId());
-    }
-    */
     if (isUpdate == false) {
-      newSize += static_cast<int64_t>(Utils::checkAndGetObjectSize(key));
+      updateMapSize(entryBytes(key, newValue));
     } else {
-      if (oldValue != nullptr) {
-        newSize -= static_cast<int64_t>(oldValue->objectSize());
-      } else {
-        newSize -= static_cast<int64_t>(sizeof(void*));
-      }
+      updateMapSize(valueBytes(newValue) - oldBytes);
     }
-    updateMapSize(newSize);
   }
 
   err = processLRU();
@@ -384,21 +548,50 @@ bool LRUEntriesMap::get(const CacheableKeyPtr& key, CacheablePtr& returnPtr,
       if (segmentLocked == true) segmentRPtr->release();
       return false;
     }
+    // a miss is not counted, the put of the value fetched for it is
+    recordUse(key);
     // segmentRPtr->get(key, returnPtr, mePtr);
     MapEntryImplPtr nodeToMark = mePtr;
-    LRUEntryProperties& lruProps = nodeToMark->getLRUProperties();
-    if (returnPtr != nullptr && CacheableToken::isOverflowed(returnPtr)) {
-      void* persistenceInfo = lruProps.getPersistenceInfo();
+    LRUEntryProperties* lruProps = &nodeToMark->getLRUProperties();
+    // the disk is read without the segment lock, other keys of the segment
+    // are not held up by it; the entry is looked up again afterwards and
+    // the value read is only put in if the entry still has that overflow
+    while (returnPtr != nullptr && CacheableToken::isOverflowed(returnPtr)) {
+      uint32_t overflowCount = lruProps->getOverflowCount();
+      void* persistenceInfo = lruProps->getPersistenceInfo();
+      segmentRPtr->release();
       CacheablePtr tmpObj;
-      try {
-        tmpObj = m_pmPtr->read(key, persistenceInfo);
-      } catch (Exception& ex) {
-        LOGERROR("read on the persistence layer failed - %s", ex.getMessage());
-        if (segmentLocked == true) segmentRPtr->release();
+      std::string error;
+      bool isRead =
+          faultIn(key, persistenceInfo, overflowCount, tmpObj, error);
+      segmentRPtr->acquire();
+
+      // a read that failed because a put or destroy of the key removed the
+      // record meanwhile is not an error, the entry is looked up again too
+      MapEntryImplPtr currentPtr;
+      if (false == segmentRPtr->getEntry(key, currentPtr, returnPtr)) {
+        segmentRPtr->release();
         return false;
       }
-      m_region->getRegionStats()->incRetrieves();
-      m_region->getCacheImpl()->getCachePerfStats().incRetrieves();
+      if (currentPtr != mePtr || !CacheableToken::isOverflowed(returnPtr) ||
+          lruProps->getOverflowCount() != overflowCount) {
+        // read again, unless some other thread has put the value in
+        mePtr = currentPtr;
+        nodeToMark = mePtr;
+        lruProps = &nodeToMark->getLRUProperties();
+        continue;
+      }
+      if (!isRead) {
+        LOGERROR("read of key %s on the persistence layer failed - %s",
+                 logkey, error.c_str());
+        segmentRPtr->release();
+        return false;
+      }
+
+      if (m_region != nullptr) {
+        m_region->getRegionStats()->incRetrieves();
+        m_region->getCacheImpl()->getCachePerfStats().incRetrieves();
+      }
 
       returnPtr = tmpObj;
 
@@ -409,24 +602,21 @@ bool LRUEntriesMap::get(const CacheableKeyPtr& key, CacheablePtr& returnPtr,
                                        isUpdate, versionTag, nullptr)) {
         // m_entriesRetrieved++;
         ++m_validEntries;
-        lruProps.clearEvicted();
-        m_lruList.appendEntry(nodeToMark);
+        lruProps->clearEvicted();
+        addToLRU(nodeToMark);
       }
       doProcessLRU = true;
       if (m_evictionControllerPtr != nullptr) {
-        int64_t newSize = 0;
-        if (tmpObj != nullptr) {
-          newSize += static_cast<int64_t>(
-              tmpObj->objectSize() - CacheableToken::invalid()->objectSize());
-        } else {
-          newSize += sizeof(void*);
-        }
-        updateMapSize(newSize);
+        updateMapSize(valueBytes(tmpObj));
       }
     }
     me = mePtr;
     // lruProps.clearEvicted();
-    lruProps.setRecentlyUsed();
+    if (m_evictionPolicy == EvictionPolicyType::SAMPLED_LRU) {
+      lruProps->setLastUsed(m_lruClock.load(std::memory_order_relaxed));
+    } else {
+      lruProps->setRecentlyUsed();
+    }
     if (doProcessLRU) {
       GfErrType IsProcessLru = processLRU();
       if ((IsProcessLru != GF_NOERR)) {
@@ -456,10 +646,13 @@ GfErrType LRUEntriesMap::remove(const CacheableKeyPtr& key,
     if (result != nullptr && me != nullptr) {
       LRUEntryProperties& lruProps = me->getLRUProperties();
       lruProps.setEvicted();
+      leaveWindow(lruProps);
       if (isEntryFound) --m_size;
       if (!CacheableToken::isToken(result)) {
         --m_validEntries;
       }
+      // taken before an overflowed value is read back, it took no memory
+      int64_t removedBytes = entryBytes(key, result);
       if (CacheableToken::isOverflowed(result)) {
         ACE_Guard<MapSegment> _guard(*segmentRPtr);
         void* persistenceInfo = lruProps.getPersistenceInfo();
@@ -475,10 +668,8 @@ GfErrType LRUEntriesMap::remove(const CacheableKeyPtr& key,
           m_pmPtr->destroy(key, persistenceInfo);
         }
       }
-      if (m_evictionControllerPtr != nullptr) {
-        int64_t sizeToRemove = static_cast<int64_t>(key->objectSize());
-        sizeToRemove += static_cast<int64_t>(result->objectSize());
-        updateMapSize((-1 * sizeToRemove));
+      if (m_evictionControllerPtr != nullptr && isEntryFound) {
+        updateMapSize(-removedBytes);
       }
     }
   }
@@ -489,14 +680,142 @@ void LRUEntriesMap::updateMapSize(int64_t size) {
   // TODO: check and remove null check since this has already been done
   // by all the callers
   if (m_evictionControllerPtr != nullptr) {
-    {
-      std::lock_guard<spinlock_mutex> __guard(m_mapInfoLock);
-      m_currentMapSize += size;
-    }
+    m_currentMapSize += size;
     m_evictionControllerPtr->updateRegionHeapInfo(size);
   }
 }
 
+int64_t LRUEntriesMap::recountMapSize() {
+  // the map may change while it is walked, so the count can only be told
+  // off when it is outside the sizes accounted during the walk; the size is
+  // then corrected by the least it is known to be off by
+  int64_t before = m_currentMapSize;
+  int64_t counted = 0;
+  for (uint8_t index = 0; index < m_concurrency; ++index) {
+    counted += m_segments[index].entryBytes(
+        [this](const CacheableKeyPtr& key, const CacheablePtr& value) {
+          return entryBytes(key, value);
+        });
+  }
+  int64_t after = m_currentMapSize;
+  int64_t error = 0;
+  if (counted < std::min(before, after)) {
+    error = std::min(before, after) - counted;
+  } else if (counted > std::max(before, after)) {
+    error = std::max(before, after) - counted;
+  }
+  if (error != 0) {
+    updateMapSize(-error);
+  }
+  return error;
+}
+
+bool LRUEntriesMap::faultIn(const CacheableKeyPtr& key, void* persistenceInfo,
+                            uint32_t overflowCount, CacheablePtr& value,
+                            std::string& error) {
+  std::shared_ptr<FaultIn> faultIn;
+  {
+    std::unique_lock<std::mutex> guard(m_faultInLock);
+    auto iter = m_faultIns.find(key);
+    if (iter != m_faultIns.end() &&
+        iter->second->m_overflowCount == overflowCount) {
+      faultIn = iter->second;
+      m_faultInCond.wait(guard, [&faultIn] { return faultIn->m_done; });
+      value = faultIn->m_value;
+      error = faultIn->m_error;
+      return !faultIn->m_failed;
+    }
+    faultIn = std::make_shared<FaultIn>();
+    faultIn->m_overflowCount = overflowCount;
+    faultIn->m_done = false;
+    faultIn->m_failed = false;
+    m_faultIns[key] = faultIn;
+  }
+
+  // whatever the read throws, the threads waiting for it are let go
+  bool failed = false;
+  try {
+    value = m_pmPtr->read(key, persistenceInfo);
+  } catch (Exception& ex) {
+    error = ex.getMessage();
+    failed = true;
+  } catch (std::exception& ex) {
+    error = ex.what();
+    failed = true;
+  } catch (...) {
+    error = "unknown exception";
+    failed = true;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_faultInLock);
+    faultIn->m_value = value;
+    faultIn->m_error = error;
+    faultIn->m_failed = failed;
+    faultIn->m_done = true;
+    auto iter = m_faultIns.find(key);
+    // a later overflow of the key may have a read of its own by now
+    if (iter != m_faultIns.end() && iter->second == faultIn) {
+      m_faultIns.erase(iter);
+    }
+  }
+  m_faultInCond.notify_all();
+  return !failed;
+}
+
+namespace {
+// gets a share of the keys, which reads the overflowed ones from disk
+class PrefetchWork : public PooledWork<GfErrType> {
+ public:
+  PrefetchWork(LRUEntriesMap* entries, const VectorOfCacheableKey& keys,
+               size_t begin, size_t end)
+      : m_entries(entries), m_keys(keys), m_begin(begin), m_end(end) {}
+
+ protected:
+  GfErrType execute() {
+    CacheablePtr value;
+    MapEntryImplPtr me;
+    for (size_t i = m_begin; i < m_end; i++) {
+      try {
+        m_entries->get(m_keys[i], value, me);
+      } catch (Exception& ex) {
+        LOGERROR("prefetch of an overflowed value failed - %s",
+                 ex.getMessage());
+      }
+    }
+    return GF_NOERR;
+  }
+
+ private:
+  LRUEntriesMap* m_entries;
+  const VectorOfCacheableKey& m_keys;
+  size_t m_begin;
+  size_t m_end;
+};
+
+// the most works a prefetch spreads its keys over
+const size_t MAX_PREFETCH_WORKS = 16;
+}  // namespace
+
+void LRUEntriesMap::prefetch(const VectorOfCacheableKey& keys,
+                             ThreadPool* threadPool) {
+  if (m_action == nullptr ||
+      m_action->getType() != LRUAction::OVERFLOW_TO_DISK || keys.empty()) {
+    return;
+  }
+  size_t count = std::min(keys.size(), MAX_PREFETCH_WORKS);
+  std::vector<PrefetchWork*> works;
+  for (size_t i = 0; i < count; i++) {
+    works.push_back(new PrefetchWork(this, keys, (keys.size() * i) / count,
+                                     (keys.size() * (i + 1)) / count));
+    threadPool->perform(works.back());
+  }
+  for (auto work : works) {
+    work->getResult();
+    delete work;
+  }
+}
+
 CacheablePtr LRUEntriesMap::getFromDisk(const CacheableKeyPtr& key,
                                         MapEntryImplPtr& me) const {
   void* persistenceInfo = me->getLRUProperties().getPersistenceInfo();
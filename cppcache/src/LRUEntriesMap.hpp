@@ -20,14 +20,24 @@
 #ifndef GEODE_LRUENTRIESMAP_H_
 #define GEODE_LRUENTRIESMAP_H_
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <geode/geode_globals.hpp>
 #include <geode/Cache.hpp>
+#include <geode/EvictionPolicyType.hpp>
+#include <geode/utils.hpp>
 #include "ConcurrentEntriesMap.hpp"
+#include "FrequencySketch.hpp"
 #include "LRUAction.hpp"
 #include "LRUList.hpp"
 #include "LRUMapEntry.hpp"
 #include "MapEntryT.hpp"
+#include "Utils.hpp"
 
 #include "util/concurrent/spinlock_mutex.hpp"
 
@@ -61,23 +71,157 @@ class CPPCACHE_EXPORT LRUEntriesMap : public ConcurrentEntriesMap,
                                       private NonCopyable,
                                       private NonAssignable {
  protected:
+  // number of entries sampled for each eviction with SAMPLED_LRU
+  static const uint32_t EVICTION_SAMPLES = 8;
+  // items the frequency sketch of TINY_LFU is sized for when the map has
+  // no entries limit, as with heap LRU
+  static const uint32_t SKETCH_SIZE_WITHOUT_LIMIT = 1u << 16;
+
   LRUAction* m_action;
+  EvictionPolicyType::PolicyType m_evictionPolicy;
+  // not used with SAMPLED_LRU; with TINY_LFU, the entries out of the window
   LRUList<MapEntryImpl, MapEntryT<LRUMapEntry, 0, 0> > m_lruList;
+  // with TINY_LFU, the entries added most recently and their number
+  LRUList<MapEntryImpl, MapEntryT<LRUMapEntry, 0, 0> > m_windowList;
+  std::atomic<uint32_t> m_windowSize;
+  // with TINY_LFU, how often the keys are used
+  std::unique_ptr<FrequencySketch> m_sketch;
+  // with SAMPLED_LRU, ticks for each entry added; entries are stamped with
+  // it when added or read
+  std::atomic<uint32_t> m_lruClock;
+  std::atomic<uint64_t> m_sampleSeed;
   uint32_t m_limit;
   PersistenceManagerPtr m_pmPtr;
   EvictionController* m_evictionControllerPtr;
-  int64_t m_currentMapSize;
-  spinlock_mutex m_mapInfoLock;
+  // with heap LRU, the bytes the entries take as accounted by entryBytes(),
+  // the bytes each entry takes besides its key and value, the second of
+  // the clock of the eviction controller the map was last used in
+  std::atomic<int64_t> m_currentMapSize;
+  int64_t m_entryOverhead;
+  const std::atomic<uint32_t>* m_heapLRUClock;
+  std::atomic<uint32_t> m_lastUsed;
   std::string m_name;
   std::atomic<uint32_t> m_validEntries;
   bool m_heapLRUEnabled;
 
+  // a read of an overflowed value, shared by the threads getting the key
+  struct FaultIn {
+    uint32_t m_overflowCount;
+    CacheablePtr m_value;
+    std::string m_error;
+    bool m_done;
+    bool m_failed;
+  };
+  std::mutex m_faultInLock;
+  std::condition_variable m_faultInCond;
+  std::unordered_map<CacheableKeyPtr, std::shared_ptr<FaultIn>,
+                     dereference_hash<CacheableKeyPtr>,
+                     dereference_equal_to<CacheableKeyPtr> >
+      m_faultIns;
+
+  /**
+   * @brief read the overflowed value of the key from disk, or wait for the
+   * thread already reading the same overflow of it; false with the reason
+   * in error if it failed
+   */
+  bool faultIn(const CacheableKeyPtr& key, void* persistenceInfo,
+               uint32_t overflowCount, CacheablePtr& value,
+               std::string& error);
+
+  /**
+   * @brief make an entry added, or with its value back in memory, the most
+   * recently used one
+   */
+  inline void addToLRU(const MapEntryImplPtr& entry) {
+    if (m_evictionPolicy == EvictionPolicyType::SAMPLED_LRU) {
+      entry->getLRUProperties().setLastUsed(++m_lruClock);
+    } else if (m_evictionPolicy == EvictionPolicyType::TINY_LFU) {
+      addToWindow(entry);
+    } else {
+      m_lruList.appendEntry(entry);
+    }
+  }
+
+  /**
+   * @brief count a use of the key for TINY_LFU, and note the second the map
+   * was last used in for heap LRU
+   */
+  inline void recordUse(const CacheableKeyPtr& key) {
+    if (m_evictionPolicy == EvictionPolicyType::TINY_LFU) {
+      m_sketch->increment(key->hashcode());
+    }
+    if (m_heapLRUClock != nullptr) {
+      // stored at most once a second, uses of the map share the line
+      uint32_t now = m_heapLRUClock->load(std::memory_order_relaxed);
+      if (m_lastUsed.load(std::memory_order_relaxed) != now) {
+        m_lastUsed.store(now, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief the bytes an entry takes for heap LRU: its key and value, the
+   * entry itself and the nodes holding it in the map and the LRU list
+   */
+  inline int64_t entryBytes(const CacheableKeyPtr& key,
+                            const CacheablePtr& value) const {
+    return static_cast<int64_t>(key->objectSize()) + valueBytes(value) +
+           m_entryOverhead;
+  }
+
+  /**
+   * @brief the bytes the allocator takes for an object of the given size:
+   * a word in front of it, rounded up to 16 bytes as glibc malloc does
+   */
+  static inline int64_t allocationBytes(size_t size) {
+    return static_cast<int64_t>(
+        std::max<size_t>(32, (size + sizeof(size_t) + 15) & ~size_t(15)));
+  }
+
+  /** @brief with TINY_LFU, note that the entry is no longer in the window */
+  inline void leaveWindow(LRUEntryProperties& lruProps) {
+    if (m_evictionPolicy == EvictionPolicyType::TINY_LFU &&
+        lruProps.clearInWindow()) {
+      --m_windowSize;
+    }
+  }
+
+  // the window of TINY_LFU holds about one percent of the entries
+  inline uint32_t windowLimit() const { return std::max(1u, m_limit / 100); }
+
+  void addToWindow(const MapEntryImplPtr& entry);
+
+  /**
+   * @brief take the least recently used entry off the window or the main
+   * list of TINY_LFU, skipping the entries that moved to the other list
+   */
+  void takeFromList(LRUList<MapEntryImpl, MapEntryT<LRUMapEntry, 0, 0> >& list,
+                    bool window, MapEntryImplPtr& result);
+
+  /**
+   * @brief pick the entry to evict with TINY_LFU and take it off its list:
+   * the entry out of the window if its key is used less often than that of
+   * the least recently used entry of the main list, else that entry
+   */
+  void getTinyLFUEntry(MapEntryImplPtr& result);
+
+  uint32_t keyFrequency(const MapEntryImplPtr& entry) const;
+
+  /**
+   * @brief sample entries of random segments and return the least recently
+   * used of them marked evicted, or null if none could be found
+   */
+  void getSampledLRUEntry(MapEntryImplPtr& result);
+
  public:
   LRUEntriesMap(ExpiryTaskManager* expiryTaskManager,
                 std::unique_ptr<EntryFactory> entryFactory,
                 RegionInternal* region, const LRUAction::Action& lruAction,
                 const uint32_t limit, bool concurrencyChecksEnabled,
-                const uint8_t concurrency = 16, bool heapLRUEnabled = false);
+                const uint8_t concurrency = 16, bool heapLRUEnabled = false,
+                bool concurrentReads = false,
+                EvictionPolicyType::PolicyType evictionPolicy =
+                    EvictionPolicyType::LRU);
 
   virtual ~LRUEntriesMap();
 
@@ -98,10 +242,56 @@ class CPPCACHE_EXPORT LRUEntriesMap : public ConcurrentEntriesMap,
                    MapEntryImplPtr& me);
   virtual CacheablePtr getFromDisk(const CacheableKeyPtr& key,
                                    MapEntryImplPtr& me) const;
+  virtual void prefetch(const VectorOfCacheableKey& keys,
+                        ThreadPool* threadPool);
   GfErrType processLRU();
-  void processLRU(int32_t numEntriesToEvict);
   GfErrType evictionHelper();
+  /**
+   * @brief evict the entry the eviction policy picks, adding the bytes
+   * freed to evictedBytes
+   */
+  GfErrType evictionHelper(int64_t& evictedBytes);
+
+  /**
+   * @brief evict entries in the order of the eviction policy until the
+   * given number of bytes have been freed; returns the bytes freed
+   */
+  int64_t evictBytes(int64_t bytes);
+
+  /**
+   * @brief add the bytes to the heap LRU size of the map and to that of the
+   * cache
+   */
   void updateMapSize(int64_t size);
+
+  /**
+   * @brief add up the bytes of the entries afresh, and correct the heap LRU
+   * size by the difference; returns the bytes the size was off by, leaving
+   * out what the entries changed by while they were added up
+   */
+  int64_t recountMapSize();
+
+  inline int64_t getMapSize() const { return m_currentMapSize; }
+
+  /** @brief the second of the heap LRU clock the map was last used in */
+  inline uint32_t getLastUsed() const {
+    return m_lastUsed.load(std::memory_order_relaxed);
+  }
+
+  inline const std::string& getName() const { return m_name; }
+
+  /**
+   * @brief the bytes the value takes for heap LRU; none for a token, the
+   * tokens are shared by all the entries
+   */
+  static inline int64_t valueBytes(const CacheablePtr& value) {
+    if (value == nullptr || CacheableToken::isToken(value)) {
+      return 0;
+    }
+    uint32_t bytes = Utils::checkAndGetObjectSize(value);
+    return bytes == static_cast<uint32_t>(-1) ? 0 : bytes;
+  }
+
   inline void setPersistenceManager(PersistenceManagerPtr& pmPtr) {
     m_pmPtr = pmPtr;
   }
@@ -33,6 +33,13 @@ void LRUExpEntryFactory::newMapEntry(ExpiryTaskManager* expiryTaskManager,
   }
 }
 
+size_t LRUExpEntryFactory::getEntrySize() const {
+  if (m_concurrencyChecksEnabled) {
+    return sizeof(MapEntryT<VersionedLRUExpMapEntry, 0, 0>);
+  }
+  return sizeof(MapEntryT<LRUExpMapEntry, 0, 0>);
+}
+
 }  // namespace client
 }  // namespace geode
 }  // namespace apache
@@ -53,6 +53,16 @@ void LRUList<TEntry, TCreateEntry>::appendEntry(const LRUListEntryPtr& entry) {
   m_tailNode = aNode;
 }
 
+template <typename TEntry, typename TCreateEntry>
+void LRUList<TEntry, TCreateEntry>::prependEntry(const LRUListEntryPtr& entry) {
+  std::lock_guard<spinlock_mutex> lk(m_headLock);
+
+  // the tail is never the new node, appends do not have to be held up
+  LRUListNode* aNode = new LRUListNode(entry);
+  aNode->setNextLRUListNode(m_headNode);
+  m_headNode = aNode;
+}
+
 template <typename TEntry, typename TCreateEntry>
 void LRUList<TEntry, TCreateEntry>::appendNode(LRUListNode* aNode) {
   std::lock_guard<spinlock_mutex> lk(m_tailLock);
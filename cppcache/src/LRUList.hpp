@@ -35,13 +35,18 @@ namespace client {
 #define RECENTLY_USED_BITS 1u
 // Bit mask for evicted
 #define EVICTED_BITS 2u
+// Bit mask for in the window of a TinyLFU map
+#define IN_WINDOW_BITS 4u
+// The bits above count how often the entry was overflowed to disk
+#define OVERFLOW_COUNT_SHIFT 3u
 
 /**
  * @brief This class encapsulates LRU specific properties for a LRUList node.
  */
 class CPPCACHE_EXPORT LRUEntryProperties {
  public:
-  inline LRUEntryProperties() : m_bits(0), m_persistenceInfo(nullptr) {}
+  inline LRUEntryProperties()
+      : m_bits(0), m_lastUsed(0), m_persistenceInfo(nullptr) {}
 
   inline void setRecentlyUsed() { m_bits |= RECENTLY_USED_BITS; }
 
@@ -59,6 +64,50 @@ class CPPCACHE_EXPORT LRUEntryProperties {
 
   inline void clearEvicted() { m_bits &= ~EVICTED_BITS; }
 
+  /** Sets the evicted bit, returning false if it was set already. */
+  inline bool trySetEvicted() {
+    return (m_bits.fetch_or(EVICTED_BITS) & EVICTED_BITS) == 0;
+  }
+
+  /** Sets the in window bit, returning false if it was set already. */
+  inline bool setInWindow() {
+    return (m_bits.fetch_or(IN_WINDOW_BITS) & IN_WINDOW_BITS) == 0;
+  }
+
+  /** Clears the in window bit, returning false if it was clear already. */
+  inline bool clearInWindow() {
+    return (m_bits.fetch_and(~IN_WINDOW_BITS) & IN_WINDOW_BITS) != 0;
+  }
+
+  inline bool testInWindow() const {
+    return (m_bits.load() & IN_WINDOW_BITS) == IN_WINDOW_BITS;
+  }
+
+  /**
+   * The tick of the eviction clock of the map the entry was last used at,
+   * for policies that keep no list of the entries.
+   */
+  inline uint32_t getLastUsed() const {
+    return m_lastUsed.load(std::memory_order_relaxed);
+  }
+
+  inline void setLastUsed(uint32_t tick) {
+    // most reads come in the same tick, do not dirty the line for them
+    if (m_lastUsed.load(std::memory_order_relaxed) != tick) {
+      m_lastUsed.store(tick, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Changes each time the value is overflowed to disk, so a value read from
+   * disk can be told apart from one overflowed since.
+   */
+  inline uint32_t getOverflowCount() const {
+    return m_bits.load() >> OVERFLOW_COUNT_SHIFT;
+  }
+
+  inline void incOverflowCount() { m_bits += 1u << OVERFLOW_COUNT_SHIFT; }
+
   inline void* getPersistenceInfo() const { return m_persistenceInfo; }
 
   inline void setPersistenceInfo(void* persistenceInfo) {
@@ -71,6 +120,8 @@ class CPPCACHE_EXPORT LRUEntryProperties {
 
  private:
   std::atomic<uint32_t> m_bits;
+  // fills the padding before the pointer, the properties stay the same size
+  std::atomic<uint32_t> m_lastUsed;
   void* m_persistenceInfo;
 };
 
@@ -126,12 +177,22 @@ class LRUList {
    */
   void appendEntry(const LRUListEntryPtr& entry);
 
+  /**
+   * @brief put an entry just taken off the list back at its head.
+   */
+  void prependEntry(const LRUListEntryPtr& entry);
+
   /**
    * @brief return the least recently used node from the list,
    * and removing it from the list.
    */
   void getLRUEntry(LRUListEntryPtr& result);
 
+  /**
+   * @brief the bytes of the node holding an entry in the list.
+   */
+  static inline size_t nodeSize() { return sizeof(LRUListNode); }
+
  private:
   /**
    * @brief add a node to the tail of the list.
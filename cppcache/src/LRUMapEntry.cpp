@@ -32,6 +32,13 @@ void LRUEntryFactory::newMapEntry(ExpiryTaskManager* expiryTaskManager,
   }
 }
 
+size_t LRUEntryFactory::getEntrySize() const {
+  if (m_concurrencyChecksEnabled) {
+    return sizeof(MapEntryT<VersionedLRUMapEntry, 0, 0>);
+  }
+  return sizeof(MapEntryT<LRUMapEntry, 0, 0>);
+}
+
 }  // namespace client
 }  // namespace geode
 }  // namespace apache
@@ -117,6 +117,8 @@ class CPPCACHE_EXPORT LRUEntryFactory : public EntryFactory {
   virtual void newMapEntry(ExpiryTaskManager* expiryTaskManager,
                            const CacheableKeyPtr& key,
                            MapEntryImplPtr& result) const;
+
+  virtual size_t getEntrySize() const;
 };
 }  // namespace client
 }  // namespace geode
@@ -571,6 +571,13 @@ uint32_t LocalRegion::size() {
   return LocalRegion::size_remote();
 }
 
+void LocalRegion::reserve(uint32_t expectedEntries) {
+  CHECK_DESTROY_PENDING(TryReadGuard, LocalRegion::reserve);
+  if (m_regionAttributes->getCachingEnabled()) {
+    m_entries->reserve(expectedEntries);
+  }
+}
+
 RegionServicePtr LocalRegion::getRegionService() const {
   CHECK_DESTROY_PENDING(TryReadGuard, LocalRegion::getRegionService);
   return m_cacheImpl->getCache()->shared_from_this();
@@ -634,6 +641,14 @@ bool LocalRegion::containsKey(const CacheableKeyPtr& keyPtr) const {
   return containsKey_internal(keyPtr);
 }
 
+void LocalRegion::prefetch(const VectorOfCacheableKey& keys) {
+  CHECK_DESTROY_PENDING(TryReadGuard, LocalRegion::prefetch);
+  if (!m_regionAttributes->getCachingEnabled()) {
+    return;
+  }
+  m_entries->prefetch(keys, m_cacheImpl->getThreadPool());
+}
+
 void LocalRegion::setPersistenceManager(PersistenceManagerPtr& pmPtr) {
   m_persistenceManager = pmPtr;
   // set the memberVariable of LRUEntriesMap too.
@@ -651,7 +666,7 @@ void LocalRegion::setRegionExpiryTask() {
     RegionExpiryHandler* handler =
         new RegionExpiryHandler(rptr, getRegionExpiryAction(), duration);
     long expiryTaskId =
-        rptr->getCacheImpl()->getExpiryTaskManager().scheduleExpiryTask(
+        rptr->getCacheImpl()->getExpiryTaskManager().scheduleCoarseExpiryTask(
             handler, duration, 0);
     handler->setExpiryTaskId(expiryTaskId);
     LOGFINE(
@@ -671,8 +686,9 @@ void LocalRegion::registerEntryExpiryTask(MapEntryImplPtr& entry) {
   uint32_t duration = getEntryExpiryDuration();
   EntryExpiryHandler* handler =
       new EntryExpiryHandler(rptr, entry, getEntryExpirationAction(), duration);
-  long id = rptr->getCacheImpl()->getExpiryTaskManager().scheduleExpiryTask(
-      handler, duration, 0);
+  long id =
+      rptr->getCacheImpl()->getExpiryTaskManager().scheduleCoarseExpiryTask(
+          handler, duration, 0);
   if (Log::finestEnabled()) {
     CacheableKeyPtr key;
     entry->getKeyI(key);
@@ -3106,18 +3122,16 @@ void LocalRegion::adjustCacheWriter(const char* lib, const char* func) {
   m_writer = m_regionAttributes->getCacheWriter();
 }
 
-void LocalRegion::evict(int32_t percentage) {
+int64_t LocalRegion::evict(int64_t bytes) {
   TryReadGuard guard(m_rwLock, m_destroyPending);
-  if (m_released || m_destroyPending) return;
-  if (m_entries != nullptr) {
-    int32_t size = m_entries->size();
-    int32_t entriesToEvict = (percentage * size) / 100;
-    // only invoked from EvictionController so static_cast is always safe
-    LRUEntriesMap* lruMap = static_cast<LRUEntriesMap*>(m_entries);
-    LOGINFO("Evicting %d entries. Current entry count is %d", entriesToEvict,
-            size);
-    lruMap->processLRU(entriesToEvict);
-  }
+  if (m_released || m_destroyPending) return 0;
+  if (m_entries == nullptr) return 0;
+  // only invoked from EvictionController so static_cast is always safe
+  LRUEntriesMap* lruMap = static_cast<LRUEntriesMap*>(m_entries);
+  int64_t evicted = lruMap->evictBytes(bytes);
+  LOGFINE("Evicted %lld of %lld bytes from region %s, %d entries left",
+          evicted, bytes, m_fullPath.c_str(), m_entries->size());
+  return evicted;
 }
 void LocalRegion::invokeAfterAllEndPointDisconnected() {
   if (m_listener != nullptr) {
@@ -198,7 +198,9 @@ class CPPCACHE_EXPORT LocalRegion : public RegionInternal {
               const SerializablePtr& aCallbackArgument = nullptr);
   void removeAll(const VectorOfCacheableKey& keys,
                  const SerializablePtr& aCallbackArgument = nullptr);
+  void prefetch(const VectorOfCacheableKey& keys);
   uint32_t size();
+  void reserve(uint32_t expectedEntries);
   virtual uint32_t size_remote();
   RegionServicePtr getRegionService() const;
   virtual bool containsValueForKey_remote(const CacheableKeyPtr& keyPtr) const;
@@ -334,7 +336,7 @@ class CPPCACHE_EXPORT LocalRegion : public RegionInternal {
   virtual void adjustCacheWriter(const char* libpath,
                                  const char* factoryFuncName);
   virtual CacheImpl* getCacheImpl() const;
-  virtual void evict(int32_t percentage);
+  virtual int64_t evict(int64_t bytes);
 
   virtual void acquireGlobals(bool isFailover){};
   virtual void releaseGlobals(bool isFailover){};
@@ -34,6 +34,13 @@ void EntryFactory::newMapEntry(ExpiryTaskManager* expiryTaskManager,
   }
 }
 
+size_t EntryFactory::getEntrySize() const {
+  if (m_concurrencyChecksEnabled) {
+    return sizeof(MapEntryT<VersionedMapEntryImpl, 0, 0>);
+  }
+  return sizeof(MapEntryT<MapEntryImpl, 0, 0>);
+}
+
 }  // namespace client
 }  // namespace geode
 }  // namespace apache
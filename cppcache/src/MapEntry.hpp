@@ -73,8 +73,13 @@ class CPPCACHE_EXPORT ExpEntryProperties {
     m_lastAccessTime = currTime;
   }
 
+  // reads of the entry only load the access time, at most one of them a
+  // second stores it; the expiry task looks at it when it comes due and
+  // reschedules itself if the entry has been read since
   inline void updateLastAccessTime(uint32_t currTime) {
-    m_lastAccessTime = currTime;
+    if (m_lastAccessTime.load(std::memory_order_relaxed) != currTime) {
+      m_lastAccessTime.store(currTime, std::memory_order_relaxed);
+    }
   }
 
   inline void updateLastModifiedTime(uint32_t currTime) {
@@ -282,6 +287,9 @@ class CPPCACHE_EXPORT EntryFactory {
                            const CacheableKeyPtr& key,
                            MapEntryImplPtr& result) const;
 
+  /** the bytes each entry made by the factory takes */
+  virtual size_t getEntrySize() const;
+
  protected:
   bool m_concurrencyChecksEnabled;
 };
@@ -17,6 +17,7 @@
 
 #include "MapSegment.hpp"
 #include "MapEntry.hpp"
+#include "CacheImpl.hpp"
 #include "TrackedMapEntry.hpp"
 #include "RegionInternal.hpp"
 #include "TableOfPrimes.hpp"
@@ -27,6 +28,8 @@
 #include <ace/OS.h>
 #include "ace/Time_Value.h"
 
+#include <algorithm>
+#include <chrono>
 #include <mutex>
 #include "util/concurrent/spinlock_mutex.hpp"
 
@@ -38,6 +41,8 @@ namespace client {
   (versionTag != nullptr && versionTag.get() != nullptr)
 bool MapSegment::boolVal = false;
 MapSegment::~MapSegment() {
+  delete m_rehashIter;
+  delete m_oldMap;
   delete m_map;
   // m_entryFactory will be disposed by the containing EntriesMap impl.
 }
@@ -45,7 +50,7 @@ MapSegment::~MapSegment() {
 void MapSegment::open(RegionInternal* region, const EntryFactory* entryFactory,
                       ExpiryTaskManager* expiryTaskManager, uint32_t size,
                       std::atomic<int32_t>* destroyTrackers,
-                      bool concurrencyChecksEnabled) {
+                      bool concurrencyChecksEnabled, bool concurrentReads) {
   m_map = new CacheableKeyHashMap();
   uint32_t mapSize = TableOfPrimes::nextLargerPrime(size, m_primeIndex);
   LOGFINER("Initializing MapSegment with size %d (given size %d).", mapSize,
@@ -53,17 +58,28 @@ void MapSegment::open(RegionInternal* region, const EntryFactory* entryFactory,
   m_map->open(mapSize);
   m_entryFactory = entryFactory;
   m_region = region;
-  m_tombstoneList =
-      std::make_shared<TombstoneList>(this, m_region->getCacheImpl());
+  // a map outside of a region, as in tests, has no cache
+  m_tombstoneList = std::make_shared<TombstoneList>(
+      this, m_region != nullptr ? m_region->getCacheImpl() : nullptr);
   m_expiryTaskManager = expiryTaskManager;
   m_numDestroyTrackers = destroyTrackers;
   m_concurrencyChecksEnabled = concurrencyChecksEnabled;
+  if (concurrentReads) {
+    m_spinlock.enable_shared_readers();
+  }
 }
 
-void MapSegment::close() { m_map->close(); }
+void MapSegment::close() {
+  if (m_oldMap != nullptr) finishRehash();
+  m_map->close();
+}
 
 void MapSegment::clear() {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  if (m_oldMap != nullptr) {
+    m_oldMap->unbind_all();
+    finishRehash();
+  }
   m_map->unbind_all();
 }
 
@@ -79,12 +95,20 @@ GfErrType MapSegment::create(const CacheableKeyPtr& key,
   TombstoneExpiryHandler* handler = nullptr;
   GfErrType err = GF_NOERR;
   {
-    std::lock_guard<spinlock_mutex> lk(m_spinlock);
-    // if size is greater than 75 percent of prime, rehash
-    uint32_t mapSize = TableOfPrimes::getPrime(m_primeIndex);
-    if (((m_map->current_size() * 75) / 100) > mapSize) {
-      rehash();
+    std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+    if (m_oldMap != nullptr) {
+      migrateEntries();
+    } else if (m_reservedPrimeIndex > m_primeIndex) {
+      // reserved while the last rehash was in progress
+      rehash(m_reservedPrimeIndex);
+    } else {
+      // if size is greater than 75 percent of prime, rehash
+      uint32_t mapSize = TableOfPrimes::getPrime(m_primeIndex);
+      if (((m_map->current_size() * 75) / 100) > mapSize) {
+        rehash(m_primeIndex + 1);
+      }
     }
+    migrateEntry(key);
     MapEntryPtr entry;
     int status;
     if ((status = m_map->find(key, entry)) == -1) {
@@ -146,12 +170,20 @@ GfErrType MapSegment::put(const CacheableKeyPtr& key,
   TombstoneExpiryHandler* handler = nullptr;
   GfErrType err = GF_NOERR;
   {
-    std::lock_guard<spinlock_mutex> lk(m_spinlock);
-    // if size is greater than 75 percent of prime, rehash
-    uint32_t mapSize = TableOfPrimes::getPrime(m_primeIndex);
-    if (((m_map->current_size() * 75) / 100) > mapSize) {
-      rehash();
+    std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+    if (m_oldMap != nullptr) {
+      migrateEntries();
+    } else if (m_reservedPrimeIndex > m_primeIndex) {
+      // reserved while the last rehash was in progress
+      rehash(m_reservedPrimeIndex);
+    } else {
+      // if size is greater than 75 percent of prime, rehash
+      uint32_t mapSize = TableOfPrimes::getPrime(m_primeIndex);
+      if (((m_map->current_size() * 75) / 100) > mapSize) {
+        rehash(m_primeIndex + 1);
+      }
     }
+    migrateEntry(key);
     MapEntryPtr entry;
     int status;
     if ((status = m_map->find(key, entry)) == -1) {
@@ -208,7 +240,8 @@ GfErrType MapSegment::put(const CacheableKeyPtr& key,
 GfErrType MapSegment::invalidate(const CacheableKeyPtr& key,
                                  MapEntryImplPtr& me, CacheablePtr& oldValue,
                                  VersionTagPtr versionTag, bool& isTokenAdded) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  migrateEntry(key);
   int status;
   isTokenAdded = false;
   GfErrType err = GF_NOERR;
@@ -260,6 +293,7 @@ GfErrType MapSegment::removeWhenConcurrencyEnabled(
   int status;
   MapEntryPtr entry;
   VersionStamp versionStamp;
+  migrateEntry(key);
   // If entry found, else return no entry
   if ((status = m_map->find(key, entry)) != -1) {
     isEntryFound = true;
@@ -332,7 +366,7 @@ GfErrType MapSegment::remove(const CacheableKeyPtr& key, CacheablePtr& oldValue,
     bool expTaskSet = false;
     GfErrType err;
     {
-      std::lock_guard<spinlock_mutex> lk(m_spinlock);
+      std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
       err = removeWhenConcurrencyEnabled(key, oldValue, me, updateCount,
                                          versionTag, afterRemote, isEntryFound,
                                          id, handler, expTaskSet);
@@ -345,7 +379,8 @@ GfErrType MapSegment::remove(const CacheableKeyPtr& key, CacheablePtr& oldValue,
     return err;
   }
 
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  migrateEntry(key);
   CacheablePtr value;
   if ((status = m_map->unbind(key, entry)) == -1) {
     // didn't unbind, probably no entry...
@@ -373,6 +408,7 @@ GfErrType MapSegment::remove(const CacheableKeyPtr& key, CacheablePtr& oldValue,
 bool MapSegment::unguardedRemoveActualEntry(const CacheableKeyPtr& key,
                                             bool cancelTask) {
   MapEntryPtr entry;
+  migrateEntry(key);
   m_tombstoneList->eraseEntryFromTombstoneList(key, cancelTask);
   if (m_map->unbind(key, entry) == -1) {
     return false;
@@ -384,6 +420,7 @@ bool MapSegment::unguardedRemoveActualEntryWithoutCancelTask(
     const CacheableKeyPtr& key, TombstoneExpiryHandler*& handler,
     int64_t& taskid) {
   MapEntryPtr entry;
+  migrateEntry(key);
   taskid = m_tombstoneList->eraseEntryFromTombstoneListWithoutCancelTask(
       key, handler);
   if (m_map->unbind(key, entry) == -1) {
@@ -394,7 +431,7 @@ bool MapSegment::unguardedRemoveActualEntryWithoutCancelTask(
 
 bool MapSegment::removeActualEntry(const CacheableKeyPtr& key,
                                    bool cancelTask) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
   return unguardedRemoveActualEntry(key, cancelTask);
 }
 /**
@@ -402,10 +439,10 @@ bool MapSegment::removeActualEntry(const CacheableKeyPtr& key,
  */
 bool MapSegment::getEntry(const CacheableKeyPtr& key, MapEntryImplPtr& result,
                           CacheablePtr& value) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  shared_lock_guard<shared_spinlock_mutex> lk(m_spinlock);
   int status;
   MapEntryPtr entry;
-  if ((status = m_map->find(key, entry)) == -1) {
+  if ((status = findEntry(key, entry)) == -1) {
     result = nullptr;
     value = nullptr;
     return false;
@@ -427,10 +464,10 @@ bool MapSegment::getEntry(const CacheableKeyPtr& key, MapEntryImplPtr& result,
  * @brief return true if there exists an entry for the key.
  */
 bool MapSegment::containsKey(const CacheableKeyPtr& key) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  shared_lock_guard<shared_spinlock_mutex> lk(m_spinlock);
   MapEntryPtr mePtr;
   int status;
-  if ((status = m_map->find(key, mePtr)) == -1) {
+  if ((status = findEntry(key, mePtr)) == -1) {
     return false;
   }
   // If the value is a tombstone return not found
@@ -446,13 +483,16 @@ bool MapSegment::containsKey(const CacheableKeyPtr& key) {
  * @brief return the all the keys in the provided list.
  */
 void MapSegment::keys(VectorOfCacheableKey& result) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
-  for (CacheableKeyHashMap::iterator iter = m_map->begin();
-       iter != m_map->end(); iter++) {
-    CacheablePtr valuePtr;
-    (*iter).int_id_->getImplPtr()->getValueI(valuePtr);
-    if (!CacheableToken::isTombstone(valuePtr)) {
-      result.push_back((*iter).ext_id_);
+  shared_lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  for (CacheableKeyHashMap* map : {m_map, m_oldMap}) {
+    if (map == nullptr) continue;
+    for (CacheableKeyHashMap::iterator iter = map->begin(); iter != map->end();
+         iter++) {
+      CacheablePtr valuePtr;
+      (*iter).int_id_->getImplPtr()->getValueI(valuePtr);
+      if (!CacheableToken::isTombstone(valuePtr)) {
+        result.push_back((*iter).ext_id_);
+      }
     }
   }
 }
@@ -461,20 +501,23 @@ void MapSegment::keys(VectorOfCacheableKey& result) {
  * @brief return all the entries in the provided list.
  */
 void MapSegment::entries(VectorOfRegionEntry& result) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
-  for (CacheableKeyHashMap::iterator iter = m_map->begin();
-       iter != m_map->end(); iter++) {
-    CacheableKeyPtr keyPtr;
-    CacheablePtr valuePtr;
-    MapEntryImplPtr me = ((*iter).int_id_)->getImplPtr();
-    me->getValueI(valuePtr);
-    if (valuePtr != nullptr && !CacheableToken::isTombstone(valuePtr)) {
-      if (CacheableToken::isInvalid(valuePtr)) {
-        valuePtr = nullptr;
+  shared_lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  for (CacheableKeyHashMap* map : {m_map, m_oldMap}) {
+    if (map == nullptr) continue;
+    for (CacheableKeyHashMap::iterator iter = map->begin(); iter != map->end();
+         iter++) {
+      CacheableKeyPtr keyPtr;
+      CacheablePtr valuePtr;
+      MapEntryImplPtr me = ((*iter).int_id_)->getImplPtr();
+      me->getValueI(valuePtr);
+      if (valuePtr != nullptr && !CacheableToken::isTombstone(valuePtr)) {
+        if (CacheableToken::isInvalid(valuePtr)) {
+          valuePtr = nullptr;
+        }
+        me->getKeyI(keyPtr);
+        RegionEntryPtr rePtr = m_region->createRegionEntry(keyPtr, valuePtr);
+        result.push_back(rePtr);
       }
-      me->getKeyI(keyPtr);
-      RegionEntryPtr rePtr = m_region->createRegionEntry(keyPtr, valuePtr);
-      result.push_back(rePtr);
     }
   }
 }
@@ -483,33 +526,80 @@ void MapSegment::entries(VectorOfRegionEntry& result) {
  * @brief return all values in the provided list.
  */
 void MapSegment::values(VectorOfCacheable& result) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
-  for (CacheableKeyHashMap::iterator iter = m_map->begin();
-       iter != m_map->end(); iter++) {
-    CacheablePtr valuePtr;
-    CacheableKeyPtr keyPtr;
-    MapEntryPtr entry;
-    int status;
-
-    keyPtr = (*iter).ext_id_;
-    (*iter).int_id_->getValue(valuePtr);
-    status = m_map->find(keyPtr, entry);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  for (CacheableKeyHashMap* map : {m_map, m_oldMap}) {
+    if (map == nullptr) continue;
+    for (CacheableKeyHashMap::iterator iter = map->begin(); iter != map->end();
+         iter++) {
+      CacheablePtr valuePtr;
+      CacheableKeyPtr keyPtr;
+      MapEntryPtr entry;
+      int status;
+
+      keyPtr = (*iter).ext_id_;
+      (*iter).int_id_->getValue(valuePtr);
+      status = map->find(keyPtr, entry);
+
+      if (status != -1) {
+        MapEntryImplPtr entryImpl = entry->getImplPtr();
+        if (valuePtr != nullptr && !CacheableToken::isInvalid(valuePtr) &&
+            !CacheableToken::isDestroyed(valuePtr) &&
+            !CacheableToken::isTombstone(valuePtr)) {
+          if (CacheableToken::isOverflowed(valuePtr)) {  // get Value from disc.
+            valuePtr = getFromDisc(keyPtr, entryImpl);
+            entryImpl->setValueI(valuePtr);
+          }
+          result.push_back(valuePtr);
+        }
+      }
+    }
+  }
+}
 
-    if (status != -1) {
+void MapSegment::sampleEntries(size_t position, uint32_t count,
+                               std::vector<MapEntryImplPtr>& result) {
+  std::vector<MapEntryPtr> entries;
+  shared_lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  for (CacheableKeyHashMap* map : {m_map, m_oldMap}) {
+    if (map == nullptr || count == 0) continue;
+    entries.clear();
+    map->bucketEntries(position, count, count * SAMPLE_BUCKETS_PER_ENTRY,
+                       entries);
+    for (const auto& entry : entries) {
       MapEntryImplPtr entryImpl = entry->getImplPtr();
-      if (valuePtr != nullptr && !CacheableToken::isInvalid(valuePtr) &&
-          !CacheableToken::isDestroyed(valuePtr) &&
-          !CacheableToken::isTombstone(valuePtr)) {
-        if (CacheableToken::isOverflowed(valuePtr)) {  // get Value from disc.
-          valuePtr = getFromDisc(keyPtr, entryImpl);
-          entryImpl->setValueI(valuePtr);
-        }
-        result.push_back(valuePtr);
+      CacheablePtr valuePtr;
+      entryImpl->getValueI(valuePtr);
+      // invalid, destroyed, overflowed or tombstone entries hold no value
+      if (valuePtr != nullptr && !CacheableToken::isToken(valuePtr)) {
+        result.push_back(entryImpl);
+        count--;
       }
     }
   }
 }
 
+int64_t MapSegment::entryBytes(
+    const std::function<int64_t(const CacheableKeyPtr&, const CacheablePtr&)>&
+        bytes) {
+  int64_t result = 0;
+  shared_lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  for (CacheableKeyHashMap* map : {m_map, m_oldMap}) {
+    if (map == nullptr) continue;
+    for (CacheableKeyHashMap::iterator iter = map->begin(); iter != map->end();
+         iter++) {
+      MapEntryImplPtr me = ((*iter).int_id_)->getImplPtr();
+      CacheablePtr valuePtr;
+      me->getValueI(valuePtr);
+      if (valuePtr != nullptr && !CacheableToken::isTombstone(valuePtr)) {
+        CacheableKeyPtr keyPtr;
+        me->getKeyI(keyPtr);
+        result += bytes(keyPtr, valuePtr);
+      }
+    }
+  }
+  return result;
+}
+
 // This function will not get called if concurrency checks are enabled. The
 // versioning
 // changes takes care of the version and no need for tracking the entry
@@ -517,7 +607,8 @@ int MapSegment::addTrackerForEntry(const CacheableKeyPtr& key,
                                    CacheablePtr& oldValue, bool addIfAbsent,
                                    bool failIfPresent, bool incUpdateCount) {
   if (m_concurrencyChecksEnabled) return -1;
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  migrateEntry(key);
   MapEntryPtr entry;
   MapEntryPtr newEntry;
   int status;
@@ -564,7 +655,8 @@ int MapSegment::addTrackerForEntry(const CacheableKeyPtr& key,
 // changes takes care of the version and no need for tracking the entry
 void MapSegment::removeTrackerForEntry(const CacheableKeyPtr& key) {
   if (m_concurrencyChecksEnabled) return;
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  migrateEntry(key);
   MapEntryPtr entry;
   int status;
   if ((status = m_map->find(key, entry)) != -1) {
@@ -579,17 +671,20 @@ void MapSegment::removeTrackerForEntry(const CacheableKeyPtr& key) {
 void MapSegment::addTrackerForAllEntries(
     MapOfUpdateCounters& updateCounterMap) {
   if (m_concurrencyChecksEnabled) return;
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
   MapEntryPtr newEntry;
   CacheableKeyPtr key;
-  for (CacheableKeyHashMap::iterator iter = m_map->begin();
-       iter != m_map->end(); ++iter) {
-    (*iter).int_id_->getKey(key);
-    int updateCount = (*iter).int_id_->addTracker(newEntry);
-    if (newEntry != nullptr) {
-      m_map->rebind(key, newEntry);
+  for (CacheableKeyHashMap* map : {m_map, m_oldMap}) {
+    if (map == nullptr) continue;
+    for (CacheableKeyHashMap::iterator iter = map->begin(); iter != map->end();
+         ++iter) {
+      (*iter).int_id_->getKey(key);
+      int updateCount = (*iter).int_id_->addTracker(newEntry);
+      if (newEntry != nullptr) {
+        map->rebind(key, newEntry);
+      }
+      updateCounterMap.insert(std::make_pair(key, updateCount));
     }
-    updateCounterMap.insert(std::make_pair(key, updateCount));
   }
 }
 
@@ -598,34 +693,124 @@ void MapSegment::addTrackerForAllEntries(
 // changes takes care of the version and no need for tracking the entry
 void MapSegment::removeDestroyTracking() {
   if (m_concurrencyChecksEnabled) return;
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
   m_destroyedKeys.clear();
 }
 
 /**
  * @brief replace the existing hash map with one that is wider
- *   to reduce collision chains.
+ *   to reduce collision chains. The entries of the old map are moved over
+ *   a few at a time by subsequent writes, see migrateEntries().
  */
-void MapSegment::rehash() {  // Only called from put, segment must already be
-                             // locked...
+void MapSegment::rehash(uint32_t primeIndex) {  // segment must already be
+                                                // locked...
+  auto start = std::chrono::steady_clock::now();
 
-  uint32_t newMapSize = TableOfPrimes::getPrime(++m_primeIndex);
+  m_primeIndex = primeIndex;
+  uint32_t newMapSize = TableOfPrimes::getPrime(m_primeIndex);
   LOGFINER("Rehashing MapSegment to size %d.", newMapSize);
   CacheableKeyHashMap* newMap = new CacheableKeyHashMap();
   newMap->open(newMapSize);
 
-  // copy all entries into newMap..
-  for (CacheableKeyHashMap::iterator iter = m_map->begin();
-       iter != m_map->end(); ++iter) {
-    newMap->bind((*iter).ext_id_, (*iter).int_id_);
-  }
-
-  // plug newMap into real member.
-  CacheableKeyHashMap* oldMap = m_map;
+  // plug newMap into real member; the old map is drained incrementally.
+  m_oldMap = m_map;
+  m_rehashIter = new CacheableKeyHashMap::iterator(m_oldMap->begin());
   m_map = newMap;
-  // clean up the old map.
-  delete oldMap;
   m_rehashCount++;
+  if (m_oldMap->current_size() == 0) {
+    finishRehash();
+  }
+
+  recordRehashPause(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count());
+}
+
+/**
+ * @brief move the next REHASH_ENTRIES_PER_OP entries of the old map into
+ *   the new one, dropping the old map once it is empty. Segment must
+ *   already be locked.
+ */
+void MapSegment::migrateEntries() {
+  auto start = std::chrono::steady_clock::now();
+
+  for (uint32_t moved = 0;
+       moved < REHASH_ENTRIES_PER_OP && *m_rehashIter != m_oldMap->end();
+       moved++) {
+    CacheableKeyHashMap::ENTRY* oldEntry = &(**m_rehashIter);
+    ++(*m_rehashIter);
+    m_map->bind(oldEntry->ext_id_, oldEntry->int_id_);
+    m_oldMap->unbind(oldEntry);
+  }
+  if (m_oldMap->current_size() == 0) {
+    finishRehash();
+  }
+
+  recordRehashPause(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count());
+}
+
+/**
+ * @brief make sure that the entry for key, if any, is in the new map so
+ *   that writes only ever have to look at m_map. Segment must already be
+ *   locked.
+ */
+void MapSegment::migrateEntry(const CacheableKeyPtr& key) {
+  if (m_oldMap == nullptr) return;
+  CacheableKeyHashMap::ENTRY* oldEntry;
+  if (m_oldMap->find(key, oldEntry) == -1) return;
+  // never leave the iterator on an entry that is going away
+  if (*m_rehashIter != m_oldMap->end() && &(**m_rehashIter) == oldEntry) {
+    ++(*m_rehashIter);
+  }
+  m_map->bind(oldEntry->ext_id_, oldEntry->int_id_);
+  m_oldMap->unbind(oldEntry);
+  if (m_oldMap->current_size() == 0) {
+    finishRehash();
+  }
+}
+
+/**
+ * @brief move whatever is left in the old map and drop it.
+ */
+void MapSegment::finishRehash() {
+  for (CacheableKeyHashMap::iterator iter = m_oldMap->begin();
+       iter != m_oldMap->end(); ++iter) {
+    m_map->bind((*iter).ext_id_, (*iter).int_id_);
+  }
+  delete m_rehashIter;
+  m_rehashIter = nullptr;
+  delete m_oldMap;
+  m_oldMap = nullptr;
+}
+
+/**
+ * @brief widen the map up front so that it holds size entries without
+ *   rehashing; never shrinks it. While a rehash is in progress the map is
+ *   widened by the first write after it is done, rather than moving the
+ *   rest of the old map here at once.
+ */
+void MapSegment::reserve(uint32_t size) {
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
+  uint32_t primeIndex;
+  TableOfPrimes::nextLargerPrime(size, primeIndex);
+  if (primeIndex <= std::max(m_primeIndex, m_reservedPrimeIndex)) return;
+  if (m_oldMap != nullptr) {
+    m_reservedPrimeIndex = primeIndex;
+    return;
+  }
+  rehash(primeIndex);
+}
+
+void MapSegment::recordRehashPause(int64_t pause) {
+  if (pause > m_maxRehashPause) {
+    m_maxRehashPause = pause;
+    if (m_region != nullptr) {
+      m_region->getCacheImpl()->getCachePerfStats().setMaxRehashPauseTime(
+          pause);
+    }
+  }
 }
 
 CacheablePtr MapSegment::getFromDisc(CacheableKeyPtr key,
@@ -715,11 +900,11 @@ GfErrType MapSegment::putForTrackedEntry(
   }
 }
 void MapSegment::reapTombstones(std::map<uint16_t, int64_t>& gcVersions) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
   m_tombstoneList->reapTombstones(gcVersions);
 }
 void MapSegment::reapTombstones(CacheableHashSetPtr removedKeys) {
-  std::lock_guard<spinlock_mutex> lk(m_spinlock);
+  std::lock_guard<shared_spinlock_mutex> lk(m_spinlock);
   m_tombstoneList->reapTombstones(removedKeys);
 }
 
@@ -728,7 +913,7 @@ GfErrType MapSegment::isTombstone(CacheableKeyPtr key, MapEntryImplPtr& me,
   CacheablePtr value;
   MapEntryPtr entry;
   MapEntryImplPtr mePtr;
-  if (m_map->find(key, entry) == -1) {
+  if (findEntry(key, entry) == -1) {
     result = false;
     return GF_NOERR;
   }
@@ -748,7 +933,7 @@ GfErrType MapSegment::isTombstone(CacheableKeyPtr key, MapEntryImplPtr& me,
   if (CacheableToken::isTombstone(value)) {
     if (m_tombstoneList->exists(key)) {
       MapEntryPtr entry;
-      if (m_map->find(key, entry) != -1) {
+      if (findEntry(key, entry) != -1) {
         auto mePtr = entry->getImplPtr();
         me = mePtr;
       }
@@ -35,6 +35,7 @@
 #include <ace/Null_Mutex.h>
 #include <ace/Thread_Mutex.h>
 #include <ace/Recursive_Thread_Mutex.h>
+#include <functional>
 #include <vector>
 #include <ace/config-lite.h>
 #include <ace/Versioned_Namespace.h>
@@ -42,6 +43,7 @@
 #include <unordered_map>
 
 #include "util/concurrent/spinlock_mutex.hpp"
+#include "util/concurrent/shared_spinlock_mutex.hpp"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -67,17 +69,55 @@ namespace apache {
 namespace geode {
 namespace client {
 
+using util::concurrent::shared_spinlock_mutex;
+using util::concurrent::shared_lock_guard;
+
 class RegionInternal;
-typedef ::ACE_Hash_Map_Manager_Ex<
-    CacheableKeyPtr, MapEntryPtr, ::ACE_Hash<CacheableKeyPtr>,
-    ::ACE_Equal_To<CacheableKeyPtr>, ::ACE_Null_Mutex>
-    CacheableKeyHashMap;
+
+/** @brief the ACE map of a segment, with access to its buckets. */
+class CacheableKeyHashMap
+    : public ::ACE_Hash_Map_Manager_Ex<
+          CacheableKeyPtr, MapEntryPtr, ::ACE_Hash<CacheableKeyPtr>,
+          ::ACE_Equal_To<CacheableKeyPtr>, ::ACE_Null_Mutex> {
+ public:
+  /**
+   * @brief add the entries of the buckets from the given one on to the
+   * result, until count entries were added or maxBuckets buckets were
+   * looked at; wraps around at the last bucket.
+   */
+  inline void bucketEntries(size_t bucket, size_t count, size_t maxBuckets,
+                            std::vector<MapEntryPtr>& result) const {
+    if (this->total_size_ == 0) return;
+    bucket %= this->total_size_;
+    for (size_t i = 0; i < maxBuckets && count > 0; i++) {
+      // each bucket is a circular list with the table slot as its sentinel
+      ENTRY* sentinel = &this->table_[bucket];
+      for (ENTRY* entry = sentinel->next_; entry != sentinel && count > 0;
+           entry = entry->next_) {
+        result.push_back(entry->int_id_);
+        count--;
+      }
+      if (++bucket == this->total_size_) bucket = 0;
+    }
+  }
+};
 
 /** @brief type wrapper around the ACE map implementation. */
 class CPPCACHE_EXPORT MapSegment {
  private:
+  // number of entries moved from m_oldMap to m_map by each write while a
+  // rehash is in progress
+  static const uint32_t REHASH_ENTRIES_PER_OP = 8;
+  // buckets looked at for each entry asked for by sampleEntries, so that a
+  // sparse map costs a bounded scan
+  static const uint32_t SAMPLE_BUCKETS_PER_ENTRY = 4;
+
   // contain
   CacheableKeyHashMap* m_map;
+  // entries not yet moved to m_map while a rehash is in progress, else null
+  CacheableKeyHashMap* m_oldMap;
+  // next entry of m_oldMap to be moved to m_map
+  CacheableKeyHashMap::iterator* m_rehashIter;
   // refers to object managed by the entries map...
   // does not need deletion here.
   const EntryFactory* m_entryFactory;
@@ -86,7 +126,11 @@ class CPPCACHE_EXPORT MapSegment {
 
   // index of the current prime in the primes table
   uint32_t m_primeIndex;
-  spinlock_mutex m_spinlock;
+  // index of the prime reserve() asked for during a rehash, applied once
+  // the rehash is done
+  uint32_t m_reservedPrimeIndex;
+  // shared by lookups when the segment is opened with concurrent reads
+  shared_spinlock_mutex m_spinlock;
   ACE_Recursive_Thread_Mutex m_segmentMutex;
 
   bool m_concurrencyChecksEnabled;
@@ -97,7 +141,20 @@ class CPPCACHE_EXPORT MapSegment {
   MapOfUpdateCounters m_destroyedKeys;
 
   uint32_t m_rehashCount;
-  void rehash();
+  // longest time, in nanoseconds, a single operation spent rehashing
+  int64_t m_maxRehashPause;
+  void rehash(uint32_t primeIndex);
+  void migrateEntries();
+  void migrateEntry(const CacheableKeyPtr& key);
+  void finishRehash();
+  void recordRehashPause(int64_t pause);
+
+  // look up key in m_map and, while a rehash is in progress, in m_oldMap
+  inline int findEntry(const CacheableKeyPtr& key, MapEntryPtr& entry) {
+    if (m_map->find(key, entry) != -1) return 0;
+    return m_oldMap == nullptr ? -1 : m_oldMap->find(key, entry);
+  }
+
   TombstoneListPtr m_tombstoneList;
 
   // increment update counter of the given entry and return true if entry
@@ -194,15 +251,19 @@ class CPPCACHE_EXPORT MapSegment {
  public:
   MapSegment()
       : m_map(nullptr),
+        m_oldMap(nullptr),
+        m_rehashIter(nullptr),
         m_entryFactory(nullptr),
         m_region(nullptr),
         m_expiryTaskManager(nullptr),
         m_primeIndex(0),
+        m_reservedPrimeIndex(0),
         m_spinlock(),
         m_segmentMutex(),
         m_concurrencyChecksEnabled(false),
         m_numDestroyTrackers(nullptr),
         m_rehashCount(0),
+        m_maxRehashPause(0),
         m_tombstoneList(nullptr) {}
 
   ~MapSegment();
@@ -215,10 +276,13 @@ class CPPCACHE_EXPORT MapSegment {
   /**
    * @brief initialize underlying map structures. Not called by constructor.
    * Used when allocated in arrays by EntriesMap implementations.
+   * When concurrentReads is true, lookups (getEntry, containsKey, keys and
+   * entries) only exclude writers instead of each other.
    */
   void open(RegionInternal* region, const EntryFactory* entryFactory,
             ExpiryTaskManager* expiryTaskManager, uint32_t size,
-            std::atomic<int32_t>* destroyTrackers, bool concurrencyChecksEnabled);
+            std::atomic<int32_t>* destroyTrackers, bool concurrencyChecksEnabled,
+            bool concurrentReads = false);
 
   void close();
   void clear();
@@ -279,8 +343,37 @@ class CPPCACHE_EXPORT MapSegment {
    */
   void values(VectorOfCacheable& result);
 
+  /**
+   * @brief add up to count entries holding a value in memory to the
+   * provided list, from the buckets at the given position on; used to
+   * sample entries for eviction.
+   */
+  void sampleEntries(size_t position, uint32_t count,
+                     std::vector<MapEntryImplPtr>& result);
+
+  /**
+   * @brief add up the bytes of the entries as given by the function of a
+   * key and value, leaving out tombstones and entries that only track
+   * updates; used to recount the heap LRU size of a map.
+   */
+  int64_t entryBytes(const std::function<int64_t(
+                         const CacheableKeyPtr&, const CacheablePtr&)>& bytes);
+
+  /** @brief the bytes of the node of the map holding an entry */
+  static inline size_t nodeSize() {
+    return sizeof(CacheableKeyHashMap::ENTRY);
+  }
+
+  /**
+   * @brief widen the map, if needed, to hold the given number of entries
+   * without rehashing; during a rehash, once that is done.
+   */
+  void reserve(uint32_t size);
+
   inline uint32_t rehashCount() { return m_rehashCount; }
 
+  inline int64_t maxRehashPause() { return m_maxRehashPause; }
+
   int addTrackerForEntry(const CacheableKeyPtr& key, CacheablePtr& oldValue,
                          bool addIfAbsent, bool failIfPresent,
                          bool incUpdateCount);
@@ -0,0 +1,514 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ModifiedUtf8.hpp"
+
+#include <atomic>
+
+// the vector kernels need per function target attributes, which GCC only
+// supports together with the intrinsics from 4.9 on
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (__GNUC__ > 4) ||      \
+     (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define GEODE_MODIFIEDUTF8_X86
+#include <immintrin.h>
+#define GEODE_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace apache {
+namespace geode {
+namespace client {
+
+static_assert(sizeof(wchar_t) == 2 || sizeof(wchar_t) == 4,
+              "wchar_t must be UTF-16 or UTF-32");
+
+namespace {
+
+struct Kernels {
+  ModifiedUtf8::Implementation implementation;
+  size_t (*asciiBytes)(const uint8_t*, size_t);
+  size_t (*asciiChars)(const char*, size_t);
+  size_t (*asciiWide)(const wchar_t*, size_t);
+  void (*widen)(const uint8_t*, size_t, wchar_t*);
+  void (*narrow)(const wchar_t*, size_t, uint8_t*);
+  void (*charsToUtf16)(const char*, size_t, uint8_t*);
+  void (*wideToUtf16)(const wchar_t*, size_t, uint8_t*);
+  void (*utf16ToChars)(const uint8_t*, size_t, char*);
+  void (*utf16ToWide)(const uint8_t*, size_t, wchar_t*);
+};
+
+// scalar versions, also used for the tails of the vector ones
+
+inline bool isAscii(wchar_t c) { return c > 0 && c < 0x80; }
+
+size_t asciiBytesScalar(const uint8_t* bytes, size_t length) {
+  size_t i = 0;
+  while (i < length && bytes[i] < 0x80) i++;
+  return i;
+}
+
+size_t asciiCharsScalar(const char* value, size_t length) {
+  size_t i = 0;
+  while (i < length && static_cast<int8_t>(value[i]) > 0) i++;
+  return i;
+}
+
+size_t asciiWideScalar(const wchar_t* value, size_t length) {
+  size_t i = 0;
+  while (i < length && isAscii(value[i])) i++;
+  return i;
+}
+
+void widenScalar(const uint8_t* bytes, size_t length, wchar_t* value) {
+  for (size_t i = 0; i < length; i++) {
+    value[i] = static_cast<wchar_t>(bytes[i]);
+  }
+}
+
+void narrowScalar(const wchar_t* value, size_t length, uint8_t* bytes) {
+  for (size_t i = 0; i < length; i++) {
+    bytes[i] = static_cast<uint8_t>(value[i]);
+  }
+}
+
+void charsToUtf16Scalar(const char* value, size_t length, uint8_t* bytes) {
+  for (size_t i = 0; i < length; i++) {
+    bytes[2 * i] = 0;
+    bytes[2 * i + 1] = static_cast<uint8_t>(value[i]);
+  }
+}
+
+void wideToUtf16Scalar(const wchar_t* value, size_t length, uint8_t* bytes) {
+  for (size_t i = 0; i < length; i++) {
+    uint16_t c = static_cast<uint16_t>(value[i]);
+    bytes[2 * i] = static_cast<uint8_t>(c >> 8);
+    bytes[2 * i + 1] = static_cast<uint8_t>(c & 0xFF);
+  }
+}
+
+void utf16ToCharsScalar(const uint8_t* bytes, size_t length, char* value) {
+  for (size_t i = 0; i < length; i++) {
+    value[i] = static_cast<char>(bytes[2 * i + 1]);
+  }
+}
+
+void utf16ToWideScalar(const uint8_t* bytes, size_t length, wchar_t* value) {
+  for (size_t i = 0; i < length; i++) {
+    value[i] = static_cast<wchar_t>((static_cast<uint16_t>(bytes[2 * i]) << 8) |
+                                    bytes[2 * i + 1]);
+  }
+}
+
+const Kernels SCALAR_KERNELS = {
+    ModifiedUtf8::SCALAR, asciiBytesScalar,  asciiCharsScalar,
+    asciiWideScalar,      widenScalar,       narrowScalar,
+    charsToUtf16Scalar,   wideToUtf16Scalar, utf16ToCharsScalar,
+    utf16ToWideScalar};
+
+#ifdef GEODE_MODIFIEDUTF8_X86
+
+GEODE_TARGET("sse4.2")
+inline __m128i load128(const void* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+GEODE_TARGET("sse4.2")
+inline void store128(void* p, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+inline size_t firstSet(uint32_t mask) {
+  return static_cast<size_t>(__builtin_ctz(mask));
+}
+
+GEODE_TARGET("sse4.2")
+size_t asciiBytesSse42(const uint8_t* bytes, size_t length) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    uint32_t mask =
+        static_cast<uint32_t>(_mm_movemask_epi8(load128(bytes + i)));
+    if (mask != 0) return i + firstSet(mask);
+  }
+  return i + asciiBytesScalar(bytes + i, length - i);
+}
+
+GEODE_TARGET("sse4.2")
+size_t asciiCharsSse42(const char* value, size_t length) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i ascii = _mm_cmpgt_epi8(load128(value + i), zero);
+    uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(ascii)) & 0xFFFF;
+    if (mask != 0) return i + firstSet(mask);
+  }
+  return i + asciiCharsScalar(value + i, length - i);
+}
+
+GEODE_TARGET("sse4.2")
+size_t asciiWideSse42(const wchar_t* value, size_t length) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  if (sizeof(wchar_t) == 4) {
+    const __m128i limit = _mm_set1_epi32(0x80);
+    for (; i + 4 <= length; i += 4) {
+      __m128i v = load128(value + i);
+      __m128i ascii = _mm_and_si128(_mm_cmpgt_epi32(v, zero),
+                                    _mm_cmplt_epi32(v, limit));
+      uint32_t mask =
+          ~static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(ascii))) &
+          0xF;
+      if (mask != 0) return i + firstSet(mask);
+    }
+  } else {
+    const __m128i limit = _mm_set1_epi16(0x80);
+    for (; i + 8 <= length; i += 8) {
+      __m128i v = load128(value + i);
+      __m128i ascii = _mm_and_si128(_mm_cmpgt_epi16(v, zero),
+                                    _mm_cmplt_epi16(v, limit));
+      uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(ascii)) & 0xFFFF;
+      if (mask != 0) return i + firstSet(mask) / 2;
+    }
+  }
+  return i + asciiWideScalar(value + i, length - i);
+}
+
+GEODE_TARGET("sse4.2")
+void widenSse42(const uint8_t* bytes, size_t length, wchar_t* value) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = load128(bytes + i);
+    if (sizeof(wchar_t) == 4) {
+      store128(value + i, _mm_cvtepu8_epi32(v));
+      store128(value + i + 4, _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+      store128(value + i + 8, _mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+      store128(value + i + 12, _mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+    } else {
+      store128(value + i, _mm_cvtepu8_epi16(v));
+      store128(value + i + 8, _mm_cvtepu8_epi16(_mm_srli_si128(v, 8)));
+    }
+  }
+  widenScalar(bytes + i, length - i, value + i);
+}
+
+GEODE_TARGET("sse4.2")
+void narrowSse42(const wchar_t* value, size_t length, uint8_t* bytes) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i packed;
+    if (sizeof(wchar_t) == 4) {
+      // the characters are known to be below 0x80 so saturation is a no-op
+      __m128i low = _mm_packs_epi32(load128(value + i), load128(value + i + 4));
+      __m128i high =
+          _mm_packs_epi32(load128(value + i + 8), load128(value + i + 12));
+      packed = _mm_packus_epi16(low, high);
+    } else {
+      packed = _mm_packus_epi16(load128(value + i), load128(value + i + 8));
+    }
+    store128(bytes + i, packed);
+  }
+  narrowScalar(value + i, length - i, bytes + i);
+}
+
+GEODE_TARGET("sse4.2")
+void charsToUtf16Sse42(const char* value, size_t length, uint8_t* bytes) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = load128(value + i);
+    store128(bytes + 2 * i, _mm_unpacklo_epi8(zero, v));
+    store128(bytes + 2 * i + 16, _mm_unpackhi_epi8(zero, v));
+  }
+  charsToUtf16Scalar(value + i, length - i, bytes + i * 2);
+}
+
+GEODE_TARGET("sse4.2")
+void wideToUtf16Sse42(const wchar_t* value, size_t length, uint8_t* bytes) {
+  size_t i = 0;
+  if (sizeof(wchar_t) == 4) {
+    // the low two bytes of each character, swapped
+    const __m128i select = _mm_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1,
+                                         -1, -1, -1, -1, -1);
+    for (; i + 8 <= length; i += 8) {
+      __m128i low = _mm_shuffle_epi8(load128(value + i), select);
+      __m128i high = _mm_shuffle_epi8(load128(value + i + 4), select);
+      store128(bytes + 2 * i, _mm_unpacklo_epi64(low, high));
+    }
+  } else {
+    const __m128i swap =
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; i + 8 <= length; i += 8) {
+      store128(bytes + 2 * i, _mm_shuffle_epi8(load128(value + i), swap));
+    }
+  }
+  wideToUtf16Scalar(value + i, length - i, bytes + i * 2);
+}
+
+GEODE_TARGET("sse4.2")
+void utf16ToCharsSse42(const uint8_t* bytes, size_t length, char* value) {
+  const __m128i select = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1,
+                                       -1, -1, -1, -1, -1);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i low = _mm_shuffle_epi8(load128(bytes + 2 * i), select);
+    __m128i high = _mm_shuffle_epi8(load128(bytes + 2 * i + 16), select);
+    store128(value + i, _mm_unpacklo_epi64(low, high));
+  }
+  utf16ToCharsScalar(bytes + i * 2, length - i, value + i);
+}
+
+GEODE_TARGET("sse4.2")
+void utf16ToWideSse42(const uint8_t* bytes, size_t length, wchar_t* value) {
+  const __m128i swap =
+      _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    __m128i v = _mm_shuffle_epi8(load128(bytes + 2 * i), swap);
+    if (sizeof(wchar_t) == 4) {
+      store128(value + i, _mm_cvtepu16_epi32(v));
+      store128(value + i + 4, _mm_cvtepu16_epi32(_mm_srli_si128(v, 8)));
+    } else {
+      store128(value + i, v);
+    }
+  }
+  utf16ToWideScalar(bytes + i * 2, length - i, value + i);
+}
+
+const Kernels SSE42_KERNELS = {
+    ModifiedUtf8::SSE42, asciiBytesSse42,  asciiCharsSse42,
+    asciiWideSse42,      widenSse42,       narrowSse42,
+    charsToUtf16Sse42,   wideToUtf16Sse42, utf16ToCharsSse42,
+    utf16ToWideSse42};
+
+GEODE_TARGET("avx2")
+inline __m256i load256(const void* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+GEODE_TARGET("avx2")
+inline void store256(void* p, __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+GEODE_TARGET("avx2")
+size_t asciiBytesAvx2(const uint8_t* bytes, size_t length) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    uint32_t mask =
+        static_cast<uint32_t>(_mm256_movemask_epi8(load256(bytes + i)));
+    if (mask != 0) return i + firstSet(mask);
+  }
+  return i + asciiBytesSse42(bytes + i, length - i);
+}
+
+GEODE_TARGET("avx2")
+size_t asciiCharsAvx2(const char* value, size_t length) {
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i ascii = _mm256_cmpgt_epi8(load256(value + i), zero);
+    uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(ascii));
+    if (mask != 0) return i + firstSet(mask);
+  }
+  return i + asciiCharsSse42(value + i, length - i);
+}
+
+GEODE_TARGET("avx2")
+size_t asciiWideAvx2(const wchar_t* value, size_t length) {
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  if (sizeof(wchar_t) == 4) {
+    const __m256i max = _mm256_set1_epi32(0x7F);
+    for (; i + 8 <= length; i += 8) {
+      __m256i v = load256(value + i);
+      __m256i ascii = _mm256_andnot_si256(_mm256_cmpgt_epi32(v, max),
+                                          _mm256_cmpgt_epi32(v, zero));
+      uint32_t mask = ~static_cast<uint32_t>(
+                          _mm256_movemask_ps(_mm256_castsi256_ps(ascii))) &
+                      0xFF;
+      if (mask != 0) return i + firstSet(mask);
+    }
+  } else {
+    const __m256i max = _mm256_set1_epi16(0x7F);
+    for (; i + 16 <= length; i += 16) {
+      __m256i v = load256(value + i);
+      __m256i ascii = _mm256_andnot_si256(_mm256_cmpgt_epi16(v, max),
+                                          _mm256_cmpgt_epi16(v, zero));
+      uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(ascii));
+      if (mask != 0) return i + firstSet(mask) / 2;
+    }
+  }
+  return i + asciiWideSse42(value + i, length - i);
+}
+
+GEODE_TARGET("avx2")
+void widenAvx2(const uint8_t* bytes, size_t length, wchar_t* value) {
+  size_t i = 0;
+  if (sizeof(wchar_t) == 4) {
+    for (; i + 8 <= length; i += 8) {
+      __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(bytes + i));
+      store256(value + i, _mm256_cvtepu8_epi32(v));
+    }
+  } else {
+    for (; i + 16 <= length; i += 16) {
+      store256(value + i, _mm256_cvtepu8_epi16(load128(bytes + i)));
+    }
+  }
+  widenScalar(bytes + i, length - i, value + i);
+}
+
+GEODE_TARGET("avx2")
+void charsToUtf16Avx2(const char* value, size_t length, uint8_t* bytes) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    // shifting each zero extended byte into the high half of its little
+    // endian 16-bit lane leaves it in big-endian order
+    __m256i wide = _mm256_cvtepu8_epi16(load128(value + i));
+    store256(bytes + 2 * i, _mm256_slli_epi16(wide, 8));
+  }
+  charsToUtf16Scalar(value + i, length - i, bytes + i * 2);
+}
+
+GEODE_TARGET("avx2")
+void utf16ToWideAvx2(const uint8_t* bytes, size_t length, wchar_t* value) {
+  if (sizeof(wchar_t) != 4) {
+    utf16ToWideSse42(bytes, length, value);
+    return;
+  }
+  const __m128i swap =
+      _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    __m128i v = _mm_shuffle_epi8(load128(bytes + 2 * i), swap);
+    store256(value + i, _mm256_cvtepu16_epi32(v));
+  }
+  utf16ToWideScalar(bytes + i * 2, length - i, value + i);
+}
+
+// the narrowing and byte selecting kernels do not gain from the wider
+// registers since AVX2 shuffles and packs stay within 128-bit lanes
+const Kernels AVX2_KERNELS = {
+    ModifiedUtf8::AVX2, asciiBytesAvx2,   asciiCharsAvx2,
+    asciiWideAvx2,      widenAvx2,        narrowSse42,
+    charsToUtf16Avx2,   wideToUtf16Sse42, utf16ToCharsSse42,
+    utf16ToWideAvx2};
+
+#endif  // GEODE_MODIFIEDUTF8_X86
+
+const Kernels* kernelsFor(ModifiedUtf8::Implementation implementation) {
+  switch (implementation) {
+#ifdef GEODE_MODIFIEDUTF8_X86
+    case ModifiedUtf8::AVX2:
+      return &AVX2_KERNELS;
+    case ModifiedUtf8::SSE42:
+      return &SSE42_KERNELS;
+#endif
+    default:
+      return &SCALAR_KERNELS;
+  }
+}
+
+ModifiedUtf8::Implementation bestImplementation() {
+  if (ModifiedUtf8::isSupported(ModifiedUtf8::AVX2)) {
+    return ModifiedUtf8::AVX2;
+  } else if (ModifiedUtf8::isSupported(ModifiedUtf8::SSE42)) {
+    return ModifiedUtf8::SSE42;
+  }
+  return ModifiedUtf8::SCALAR;
+}
+
+std::atomic<const Kernels*>& currentKernels() {
+  static std::atomic<const Kernels*> kernels(
+      kernelsFor(bestImplementation()));
+  return kernels;
+}
+
+inline const Kernels& kernels() {
+  return *currentKernels().load(std::memory_order_relaxed);
+}
+}  // namespace
+
+ModifiedUtf8::Implementation ModifiedUtf8::getImplementation() {
+  return kernels().implementation;
+}
+
+bool ModifiedUtf8::isSupported(Implementation implementation) {
+  switch (implementation) {
+    case SCALAR:
+      return true;
+#ifdef GEODE_MODIFIEDUTF8_X86
+    case SSE42:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse4.2");
+    case AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+bool ModifiedUtf8::setImplementation(Implementation implementation) {
+  if (!isSupported(implementation)) {
+    return false;
+  }
+  currentKernels().store(kernelsFor(implementation), std::memory_order_relaxed);
+  return true;
+}
+
+size_t ModifiedUtf8::asciiLength(const uint8_t* bytes, size_t length) {
+  return kernels().asciiBytes(bytes, length);
+}
+
+size_t ModifiedUtf8::asciiLength(const char* value, size_t length) {
+  return kernels().asciiChars(value, length);
+}
+
+size_t ModifiedUtf8::asciiLength(const wchar_t* value, size_t length) {
+  return kernels().asciiWide(value, length);
+}
+
+void ModifiedUtf8::widen(const uint8_t* bytes, size_t length, wchar_t* value) {
+  kernels().widen(bytes, length, value);
+}
+
+void ModifiedUtf8::narrow(const wchar_t* value, size_t length,
+                          uint8_t* bytes) {
+  kernels().narrow(value, length, bytes);
+}
+
+void ModifiedUtf8::toUtf16(const char* value, size_t length, uint8_t* bytes) {
+  kernels().charsToUtf16(value, length, bytes);
+}
+
+void ModifiedUtf8::toUtf16(const wchar_t* value, size_t length,
+                           uint8_t* bytes) {
+  kernels().wideToUtf16(value, length, bytes);
+}
+
+void ModifiedUtf8::fromUtf16(const uint8_t* bytes, size_t length,
+                             char* value) {
+  kernels().utf16ToChars(bytes, length, value);
+}
+
+void ModifiedUtf8::fromUtf16(const uint8_t* bytes, size_t length,
+                             wchar_t* value) {
+  kernels().utf16ToWide(bytes, length, value);
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_MODIFIEDUTF8_H_
+#define GEODE_MODIFIEDUTF8_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * Vectorized kernels for the bulk of java modified UTF-8 and UTF-16
+ * encoding, used by DataOutput and DataInput.
+ *
+ * Only the runs that map one character to one code unit are handled here:
+ * the caller encodes or decodes any other character with its own scalar code
+ * and then resumes the run. None of the kernels reads or writes past the
+ * given length.
+ *
+ * The implementation is picked once from what the CPU supports; SSE4.2 and
+ * AVX2 versions exist for x86 builds with GCC or Clang, everything else uses
+ * the scalar one.
+ */
+class CPPCACHE_EXPORT ModifiedUtf8 {
+ public:
+  enum Implementation { SCALAR, SSE42, AVX2 };
+
+  static Implementation getImplementation();
+
+  /** Whether the given implementation can be used on this CPU. */
+  static bool isSupported(Implementation implementation);
+
+  /**
+   * Switch to the given implementation, returning false if it is not
+   * supported. This is meant for tests and benchmarks.
+   */
+  static bool setImplementation(Implementation implementation);
+
+  /** Number of leading encoded bytes below 0x80, each a character. */
+  static size_t asciiLength(const uint8_t* bytes, size_t length);
+
+  /**
+   * Number of leading characters in 0x01-0x7F, which encode as a single
+   * byte; NUL and the upper half are encoded as two bytes.
+   */
+  static size_t asciiLength(const char* value, size_t length);
+
+  /** Number of leading wide characters in 0x01-0x7F. */
+  static size_t asciiLength(const wchar_t* value, size_t length);
+
+  /** Widen bytes below 0x80 to wide characters. */
+  static void widen(const uint8_t* bytes, size_t length, wchar_t* value);
+
+  /** Narrow wide characters below 0x80 to bytes. */
+  static void narrow(const wchar_t* value, size_t length, uint8_t* bytes);
+
+  /** Write each character as a big-endian UTF-16 code unit. */
+  static void toUtf16(const char* value, size_t length, uint8_t* bytes);
+
+  /**
+   * Write each wide character as a big-endian UTF-16 code unit; anything
+   * beyond 16 bits is truncated.
+   */
+  static void toUtf16(const wchar_t* value, size_t length, uint8_t* bytes);
+
+  /** Read big-endian UTF-16 code units keeping only their low byte. */
+  static void fromUtf16(const uint8_t* bytes, size_t length, char* value);
+
+  /** Read big-endian UTF-16 code units into wide characters. */
+  static void fromUtf16(const uint8_t* bytes, size_t length, wchar_t* value);
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_MODIFIEDUTF8_H_
@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NotificationDispatcher.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <geode/ExceptionTypes.hpp>
+#include <geode/Log.hpp>
+
+#include "DistributedSystemImpl.hpp"
+#include "TcrMessage.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+const size_t NotificationDispatcher::MAX_QUEUED;
+const char* NotificationDispatcher::NC_Dispatcher = "NC Dispatcher";
+
+NotificationDispatcher::NotificationDispatcher(uint32_t threads,
+                                               size_t maxQueued)
+    : m_maxQueued(std::max(maxQueued, static_cast<size_t>(1))),
+      m_nextWorker(0) {
+  threads = std::max(threads, 1u);
+  for (uint32_t i = 0; i < threads; i++) {
+    m_workers.emplace_back(new Worker());
+  }
+}
+
+NotificationDispatcher::~NotificationDispatcher() { stop(); }
+
+void NotificationDispatcher::start() {
+  for (auto& worker : m_workers) {
+    std::lock_guard<std::mutex> guard(worker->m_lock);
+    worker->m_run = true;
+  }
+  this->activate(THR_NEW_LWP | THR_JOINABLE, static_cast<int>(threads()));
+  LOGFINE("Started %u subscription event dispatcher threads", threads());
+}
+
+void NotificationDispatcher::stop() {
+  bool running = false;
+  for (auto& worker : m_workers) {
+    std::lock_guard<std::mutex> guard(worker->m_lock);
+    running = running || worker->m_run;
+    worker->m_run = false;
+    worker->m_queuedCond.notify_all();
+    // a caller waiting for room carries its event out itself
+    worker->m_doneCond.notify_all();
+  }
+  this->wait();
+  if (running) {
+    LOGFINE("Stopped subscription event dispatcher threads");
+  }
+}
+
+int NotificationDispatcher::svc() {
+  DistributedSystemImpl::setThreadName(NC_Dispatcher);
+  Worker& worker = *m_workers[m_nextWorker++ % m_workers.size()];
+  std::unique_lock<std::mutex> lock(worker.m_lock);
+  while (true) {
+    worker.m_queuedCond.wait(
+        lock, [&worker] { return !worker.m_queue.empty() || !worker.m_run; });
+    // what was queued before the stop is still carried out
+    if (worker.m_queue.empty()) {
+      break;
+    }
+    Operation op = std::move(worker.m_queue.front());
+    worker.m_queue.pop_front();
+    lock.unlock();
+    try {
+      op();
+    } catch (const Exception& ex) {
+      LOGERROR("Exception while dispatching subscription event: %s: %s",
+               ex.getName(), ex.getMessage());
+    } catch (...) {
+      LOGERROR("Unexpected exception while dispatching subscription event");
+    }
+    lock.lock();
+    ++worker.m_done;
+    worker.m_doneCond.notify_all();
+  }
+  return 0;
+}
+
+void NotificationDispatcher::dispatch(const TcrMessage& msg, Operation op) {
+  size_t shard;
+  if (shardOf(msg, shard) && dispatch(shard, op)) {
+    return;
+  }
+  barrier();
+  op();
+}
+
+bool NotificationDispatcher::dispatch(size_t shard, Operation op) {
+  Worker& worker = *m_workers[shard % m_workers.size()];
+  std::unique_lock<std::mutex> lock(worker.m_lock);
+  worker.m_doneCond.wait(lock, [this, &worker] {
+    return worker.m_queue.size() < m_maxQueued || !worker.m_run;
+  });
+  if (!worker.m_run) {
+    return false;
+  }
+  worker.m_queue.push_back(std::move(op));
+  ++worker.m_queued;
+  worker.m_queuedCond.notify_one();
+  return true;
+}
+
+void NotificationDispatcher::barrier() {
+  for (auto& worker : m_workers) {
+    Worker& w = *worker;
+    std::unique_lock<std::mutex> lock(w.m_lock);
+    // operations queued from now on are not waited for
+    uint64_t queued = w.m_queued;
+    w.m_doneCond.wait(lock, [&w, queued] { return w.m_done >= queued; });
+  }
+}
+
+bool NotificationDispatcher::shardOf(const TcrMessage& msg,
+                                     size_t& shard) const {
+  if (msg.hasCqPart()) {
+    const std::map<std::string, int>* cqs = msg.getCqs();
+    if (cqs == nullptr || cqs->empty()) {
+      return false;
+    }
+    // the events of a CQ are kept in order by its name
+    bool first = true;
+    for (const auto& cq : *cqs) {
+      size_t cqShard = std::hash<std::string>()(cq.first) % m_workers.size();
+      if (first) {
+        shard = cqShard;
+        first = false;
+      } else if (cqShard != shard) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  switch (msg.getMessageType()) {
+    case TcrMessage::LOCAL_CREATE:
+    case TcrMessage::LOCAL_UPDATE:
+    case TcrMessage::LOCAL_INVALIDATE:
+    case TcrMessage::LOCAL_DESTROY: {
+      CacheableKeyPtr key = msg.getKey();
+      if (key == nullptr) {
+        return false;
+      }
+      shard = (std::hash<std::string>()(msg.getRegionName()) * 31 +
+               static_cast<uint32_t>(key->hashcode())) %
+              m_workers.size();
+      return true;
+    }
+    default:
+      // clears, region destroys and tombstone operations take in all keys
+      return false;
+  }
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
@@ -0,0 +1,134 @@
+#pragma once
+
+#ifndef GEODE_NOTIFICATIONDISPATCHER_H_
+#define GEODE_NOTIFICATIONDISPATCHER_H_
+
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ace/Task.h>
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+class TcrMessage;
+
+/**
+ * Applies the events of the subscription channels to the regions and calls
+ * the CacheListeners and CqListeners for them on a pool of threads, instead
+ * of on the threads reading the channels.
+ *
+ * Each thread has a queue of its own. The events for a key of a region all
+ * go to the same thread, as do those for a CQ, so each key and each CQ sees
+ * its events in the order they were received. An event for a whole region,
+ * a marker, or one for CQs of more than one thread, waits until the threads
+ * are done with the events received before it and is dispatched by the
+ * caller itself.
+ *
+ * The caller is the thread of the NotificationProcessor, never a thread of
+ * the IoReactor: it waits while the queue of the thread an event goes to is
+ * full, its own queue fills up and the readers stop reading their channels,
+ * so that slow listeners hold the server back rather than fill the client
+ * up.
+ */
+class CPPCACHE_EXPORT NotificationDispatcher : public ACE_Task_Base {
+ public:
+  typedef std::function<void()> Operation;
+
+  explicit NotificationDispatcher(uint32_t threads,
+                                  size_t maxQueued = MAX_QUEUED);
+
+  ~NotificationDispatcher();
+
+  void start();
+
+  /**
+   * Stops the threads once they have dispatched the events queued; the
+   * events dispatched from then on are carried out by the caller.
+   */
+  void stop();
+
+  int svc();
+
+  /**
+   * Carries out the operation for the event, on the thread for its key or
+   * its CQs, or on the calling thread once the events before it are done.
+   */
+  void dispatch(const TcrMessage& msg, Operation op);
+
+  /**
+   * Has the thread for the shard carry out the operation, after those
+   * queued to it before. Returns false, without carrying it out, once
+   * stopped.
+   */
+  bool dispatch(size_t shard, Operation op);
+
+  /** Waits until the threads have carried out the operations queued. */
+  void barrier();
+
+  inline uint32_t threads() const {
+    return static_cast<uint32_t>(m_workers.size());
+  }
+
+  /**
+   * Sets the shard of the thread that must dispatch the event, or returns
+   * false if it must wait for all of them.
+   */
+  bool shardOf(const TcrMessage& msg, size_t& shard) const;
+
+ private:
+  // the operations queued to a thread at most before the caller waits
+  static const size_t MAX_QUEUED = 4096;
+
+  struct Worker {
+    std::mutex m_lock;
+    // signalled when an operation is queued, or the worker is stopped
+    std::condition_variable m_queuedCond;
+    // signalled when an operation is done
+    std::condition_variable m_doneCond;
+    std::deque<Operation> m_queue;
+    uint64_t m_queued;
+    uint64_t m_done;
+    bool m_run;
+
+    Worker() : m_queued(0), m_done(0), m_run(false) {}
+  };
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  size_t m_maxQueued;
+  std::atomic<uint32_t> m_nextWorker;
+
+  static const char* NC_Dispatcher;
+
+  NotificationDispatcher(const NotificationDispatcher&) = delete;
+  NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_NOTIFICATIONDISPATCHER_H_
@@ -0,0 +1,159 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NotificationProcessor.hpp"
+
+#include <algorithm>
+
+#include <geode/ExceptionTypes.hpp>
+#include <geode/Log.hpp>
+
+#include "DistributedSystemImpl.hpp"
+#include "TcrEndpoint.hpp"
+#include "TcrMessage.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+namespace {
+thread_local bool t_processorThread = false;
+}  // namespace
+
+const size_t NotificationProcessor::MAX_QUEUED;
+const char* NotificationProcessor::NC_Notification_Processor =
+    "NC Notification";
+
+NotificationProcessor::NotificationProcessor(size_t maxQueued)
+    : m_current(nullptr),
+      m_maxQueued(std::max(maxQueued, static_cast<size_t>(2))),
+      m_queued(0),
+      m_done(0),
+      m_started(false),
+      m_run(false) {}
+
+NotificationProcessor::~NotificationProcessor() { stop(); }
+
+void NotificationProcessor::stop() {
+  bool running;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    running = m_run;
+    m_started = true;
+    m_run = false;
+    m_queuedCond.notify_all();
+  }
+  this->wait();
+  if (running) {
+    LOGFINE("Stopped subscription message processing thread");
+  }
+}
+
+int NotificationProcessor::svc() {
+  DistributedSystemImpl::setThreadName(NC_Notification_Processor);
+  t_processorThread = true;
+  std::unique_lock<std::mutex> lock(m_lock);
+  while (true) {
+    m_queuedCond.wait(lock, [this] { return !m_queue.empty() || !m_run; });
+    // what was queued before the stop is still processed
+    if (m_queue.empty()) {
+      break;
+    }
+    Notification notification = m_queue.front();
+    m_queue.pop_front();
+    m_current = notification.first;
+    lock.unlock();
+    try {
+      notification.first->processNotification(notification.second);
+    } catch (const Exception& ex) {
+      LOGERROR("Exception while processing subscription event: %s: %s",
+               ex.getName(), ex.getMessage());
+    } catch (...) {
+      LOGERROR("Unexpected exception while processing subscription event");
+    }
+    lock.lock();
+    ++m_done;
+    // the readers held back read again once there is room
+    while (!m_held.empty() && m_queue.size() <= m_maxQueued / 2) {
+      TcrEndpoint* endpoint = *m_held.begin();
+      m_held.erase(m_held.begin());
+      m_current = endpoint;
+      lock.unlock();
+      endpoint->resumeNotification();
+      lock.lock();
+    }
+    m_current = nullptr;
+    m_doneCond.notify_all();
+  }
+  return 0;
+}
+
+bool NotificationProcessor::put(TcrEndpoint* endpoint, TcrMessageReply* msg) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  if (!m_run) {
+    if (m_started) {
+      // the cache is closing
+      delete msg;
+      return true;
+    }
+    m_started = true;
+    m_run = true;
+    this->activate(THR_NEW_LWP | THR_JOINABLE, 1);
+    LOGFINE("Started subscription message processing thread");
+  }
+  m_queue.push_back(Notification(endpoint, msg));
+  ++m_queued;
+  m_queuedCond.notify_one();
+  if (m_queue.size() < m_maxQueued) {
+    return true;
+  }
+  m_held.insert(endpoint);
+  return false;
+}
+
+void NotificationProcessor::removeEndpoint(TcrEndpoint* endpoint) {
+  std::unique_lock<std::mutex> lock(m_lock);
+  for (auto it = m_queue.begin(); it != m_queue.end();) {
+    if (it->first == endpoint) {
+      delete it->second;
+      it = m_queue.erase(it);
+      ++m_done;
+    } else {
+      ++it;
+    }
+  }
+  m_held.erase(endpoint);
+  m_doneCond.notify_all();
+  if (!t_processorThread) {
+    m_doneCond.wait(lock, [this, endpoint] { return m_current != endpoint; });
+  }
+}
+
+void NotificationProcessor::barrier() {
+  if (t_processorThread) {
+    // the messages before the one processed are done
+    return;
+  }
+  std::unique_lock<std::mutex> lock(m_lock);
+  uint64_t queued = m_queued;
+  m_doneCond.wait(lock, [this, queued] { return m_done >= queued; });
+}
+
+bool NotificationProcessor::isProcessorThread() { return t_processorThread; }
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
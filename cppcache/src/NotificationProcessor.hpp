@@ -0,0 +1,111 @@
+#pragma once
+
+#ifndef GEODE_NOTIFICATIONPROCESSOR_H_
+#define GEODE_NOTIFICATIONPROCESSOR_H_
+
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <utility>
+
+#include <ace/Task.h>
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+class TcrEndpoint;
+class TcrMessageReply;
+
+/**
+ * The thread that processes the messages of the subscription channels of a
+ * cache, applying the events to the regions and calling the listeners.
+ *
+ * The channels are read on the threads of the IoReactor, which serve the
+ * replies of the pipelined connections too and so must not wait on anything
+ * a listener does. Their readers only decode the messages and queue them
+ * here. When the queue is full a reader stops reading its channel; it is
+ * resumed once the queue has drained to half.
+ */
+class CPPCACHE_EXPORT NotificationProcessor : public ACE_Task_Base {
+ public:
+  explicit NotificationProcessor(size_t maxQueued = MAX_QUEUED);
+
+  ~NotificationProcessor();
+
+  /** Processes the messages queued, then stops the thread. */
+  void stop();
+
+  int svc();
+
+  /**
+   * Queues the message of the endpoint, starting the thread on first use.
+   * Returns false when the queue is full, and the endpoint must stop reading
+   * until resumeNotification() is called on it. Deletes the message once
+   * stopped.
+   */
+  bool put(TcrEndpoint* endpoint, TcrMessageReply* msg);
+
+  /**
+   * Drops the messages queued for the endpoint and waits until the thread
+   * is done with it, before the endpoint is deleted.
+   */
+  void removeEndpoint(TcrEndpoint* endpoint);
+
+  /** Waits until the messages queued before the call are processed. */
+  void barrier();
+
+  /** whether the calling thread is the one processing the messages */
+  static bool isProcessorThread();
+
+ private:
+  // the messages queued at most before readers stop reading
+  static const size_t MAX_QUEUED = 8192;
+
+  typedef std::pair<TcrEndpoint*, TcrMessageReply*> Notification;
+
+  std::mutex m_lock;
+  // signalled when a message is queued, or the thread is stopped
+  std::condition_variable m_queuedCond;
+  // signalled when the thread is done with a message or an endpoint
+  std::condition_variable m_doneCond;
+  std::deque<Notification> m_queue;
+  // the endpoints that stopped reading
+  std::set<TcrEndpoint*> m_held;
+  // the endpoint the thread works for outside of the lock
+  TcrEndpoint* m_current;
+  size_t m_maxQueued;
+  uint64_t m_queued;
+  uint64_t m_done;
+  bool m_started;
+  bool m_run;
+
+  static const char* NC_Notification_Processor;
+
+  NotificationProcessor(const NotificationProcessor&) = delete;
+  NotificationProcessor& operator=(const NotificationProcessor&) = delete;
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_NOTIFICATIONPROCESSOR_H_
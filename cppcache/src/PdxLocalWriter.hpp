@@ -25,6 +25,7 @@
 #include <geode/PdxWriter.hpp>
 #include <geode/DataOutput.hpp>
 #include <geode/CacheableObjectArray.hpp>
+#include <geode/Serializer.hpp>
 
 #include "PdxType.hpp"
 #include "PdxRemotePreservedData.hpp"
@@ -113,6 +114,27 @@ class PdxLocalWriter : public PdxWriter,
 
   inline void writeObject(double value) { m_dataOutput->writeDouble(value); }
 
+  // arrays of fixed size numbers are written in bulk
+  inline void writeObject(int16_t* objArray, int arrayLen) {
+    serializer::writeObject(*m_dataOutput, objArray, arrayLen);
+  }
+
+  inline void writeObject(int32_t* objArray, int arrayLen) {
+    serializer::writeObject(*m_dataOutput, objArray, arrayLen);
+  }
+
+  inline void writeObject(int64_t* objArray, int arrayLen) {
+    serializer::writeObject(*m_dataOutput, objArray, arrayLen);
+  }
+
+  inline void writeObject(float* objArray, int arrayLen) {
+    serializer::writeObject(*m_dataOutput, objArray, arrayLen);
+  }
+
+  inline void writeObject(double* objArray, int arrayLen) {
+    serializer::writeObject(*m_dataOutput, objArray, arrayLen);
+  }
+
   template <typename mType>
   void writeObject(mType* objArray, int arrayLen) {
     if (objArray != nullptr) {
@@ -40,6 +40,9 @@ int Pool::getSocketBufferSize() const { return m_attrs->getSocketBufferSize(); }
 int Pool::getReadTimeout() const { return m_attrs->getReadTimeout(); }
 int Pool::getMinConnections() const { return m_attrs->getMinConnections(); }
 int Pool::getMaxConnections() const { return m_attrs->getMaxConnections(); }
+int Pool::getMaxRequestsPerConnection() const {
+  return m_attrs->getMaxRequestsPerConnection();
+}
 long Pool::getIdleTimeout() const { return m_attrs->getIdleTimeout(); }
 long Pool::getPingInterval() const { return m_attrs->getPingInterval(); }
 long Pool::getUpdateLocatorListInterval() const {
@@ -28,6 +28,7 @@ PoolAttributes::PoolAttributes()
       m_readTimeout(PoolFactory::DEFAULT_READ_TIMEOUT),
       m_minConns(PoolFactory::DEFAULT_MIN_CONNECTIONS),
       m_maxConns(PoolFactory::DEFAULT_MAX_CONNECTIONS),
+      m_maxRequestsPerConn(PoolFactory::DEFAULT_MAX_REQUESTS_PER_CONNECTION),
       m_retryAttempts(PoolFactory::DEFAULT_RETRY_ATTEMPTS),
       m_statsInterval(PoolFactory::DEFAULT_STATISTIC_INTERVAL),
       m_redundancy(PoolFactory::DEFAULT_SUBSCRIPTION_REDUNDANCY),
@@ -56,6 +57,7 @@ bool PoolAttributes::operator==(const PoolAttributes& other) const {
   if (m_readTimeout != other.m_readTimeout) return false;
   if (m_minConns != other.m_minConns) return false;
   if (m_maxConns != other.m_maxConns) return false;
+  if (m_maxRequestsPerConn != other.m_maxRequestsPerConn) return false;
   if (m_retryAttempts != other.m_retryAttempts) return false;
   if (m_statsInterval != other.m_statsInterval) return false;
   if (m_redundancy != other.m_redundancy) return false;
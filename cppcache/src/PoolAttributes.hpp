@@ -62,6 +62,11 @@ class PoolAttributes {
   int getMaxConnections() const { return m_maxConns; }
   void setMaxConnections(int maxConnections) { m_maxConns = maxConnections; }
 
+  int getMaxRequestsPerConnection() const { return m_maxRequestsPerConn; }
+  void setMaxRequestsPerConnection(int maxRequests) {
+    m_maxRequestsPerConn = maxRequests;
+  }
+
   long getIdleTimeout() const { return m_idleTimeout; }
   void setIdleTimeout(long idleTimeout) { m_idleTimeout = idleTimeout; }
 
@@ -132,6 +137,7 @@ class PoolAttributes {
   int m_readTimeout;
   int m_minConns;
   int m_maxConns;
+  int m_maxRequestsPerConn;
   int m_retryAttempts;
   int m_statsInterval;
   int m_redundancy;
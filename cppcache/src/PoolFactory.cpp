@@ -63,6 +63,9 @@ void PoolFactory::setMinConnections(int minConnections) {
 void PoolFactory::setMaxConnections(int maxConnections) {
   m_attrs->setMaxConnections(maxConnections);
 }
+void PoolFactory::setMaxRequestsPerConnection(int maxRequests) {
+  m_attrs->setMaxRequestsPerConnection(maxRequests);
+}
 void PoolFactory::setIdleTimeout(long idleTimeout) {
   m_attrs->setIdleTimeout(idleTimeout);
 }
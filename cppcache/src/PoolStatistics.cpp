@@ -38,12 +38,13 @@ using util::concurrent::spinlock_mutex;
 
 constexpr const char* PoolStats::STATS_NAME;
 constexpr const char* PoolStats::STATS_DESC;
+constexpr int PoolStats::CHECKOUT_BUCKETS;
 
 PoolStats::PoolStats(StatisticsFactory* factory, const std::string& poolName) {
   auto statsType = factory->findType(STATS_NAME);
 
   if (statsType == nullptr) {
-    auto stats = new StatisticDescriptor*[27];
+    auto stats = new StatisticDescriptor*[33];
 
     stats[0] = factory->createIntGauge(
         "locators", "Current number of locators discovered", "locators");
@@ -132,8 +133,37 @@ PoolStats::PoolStats(StatisticsFactory* factory, const std::string& poolName) {
     stats[26] = factory->createLongCounter(
         "queryExecutionTime",
         "Total time spent while processing queryExecution", "nanoseconds");
-
-    statsType = factory->createType(STATS_NAME, STATS_DESC, stats, 27);
+    stats[27] = factory->createIntCounter(
+        "connectionCheckoutsUnder100us",
+        "Total number of times getting a connection took less than 100 "
+        "microseconds.",
+        "checkouts");
+    stats[28] = factory->createIntCounter(
+        "connectionCheckoutsUnder1ms",
+        "Total number of times getting a connection took from 100 microseconds "
+        "to 1 millisecond.",
+        "checkouts");
+    stats[29] = factory->createIntCounter(
+        "connectionCheckoutsUnder10ms",
+        "Total number of times getting a connection took from 1 to 10 "
+        "milliseconds.",
+        "checkouts");
+    stats[30] = factory->createIntCounter(
+        "connectionCheckoutsUnder100ms",
+        "Total number of times getting a connection took from 10 to 100 "
+        "milliseconds.",
+        "checkouts");
+    stats[31] = factory->createIntCounter(
+        "connectionCheckoutsUnder1s",
+        "Total number of times getting a connection took from 100 "
+        "milliseconds to 1 second.",
+        "checkouts");
+    stats[32] = factory->createIntCounter(
+        "connectionCheckoutsOver1s",
+        "Total number of times getting a connection took 1 second or more.",
+        "checkouts");
+
+    statsType = factory->createType(STATS_NAME, STATS_DESC, stats, 33);
   }
   m_locatorsId = statsType->nameToId("locators");
   m_serversId = statsType->nameToId("servers");
@@ -163,6 +193,18 @@ PoolStats::PoolStats(StatisticsFactory* factory, const std::string& poolName) {
       statsType->nameToId("processedDeltaMessagesTime");
   m_queryExecutionsId = statsType->nameToId("queryExecutions");
   m_queryExecutionTimeId = statsType->nameToId("queryExecutionTime");
+  m_connectionCheckoutsIds[0] =
+      statsType->nameToId("connectionCheckoutsUnder100us");
+  m_connectionCheckoutsIds[1] =
+      statsType->nameToId("connectionCheckoutsUnder1ms");
+  m_connectionCheckoutsIds[2] =
+      statsType->nameToId("connectionCheckoutsUnder10ms");
+  m_connectionCheckoutsIds[3] =
+      statsType->nameToId("connectionCheckoutsUnder100ms");
+  m_connectionCheckoutsIds[4] =
+      statsType->nameToId("connectionCheckoutsUnder1s");
+  m_connectionCheckoutsIds[5] =
+      statsType->nameToId("connectionCheckoutsOver1s");
 
   m_poolStats = factory->createAtomicStatistics(statsType, poolName.c_str());
 
@@ -193,6 +235,9 @@ PoolStats::PoolStats(StatisticsFactory* factory, const std::string& poolName) {
   getStats()->setInt(m_processedDeltaMessagesTimeId, 0);
   getStats()->setInt(m_queryExecutionsId, 0);
   getStats()->setLong(m_queryExecutionTimeId, 0);
+  for (auto id : m_connectionCheckoutsIds) {
+    getStats()->setInt(id, 0);
+  }
 }
 
 PoolStats::~PoolStats() {
@@ -126,6 +126,15 @@ class PoolStats {
   void incQueryExecutionTimeId(int64_t value) {  // counter
     getStats()->incLong(m_queryExecutionTimeId, value);
   }
+  /** counts a connection checkout in the bucket of its duration */
+  void incConnectionCheckouts(int64_t nanos) {  // histogram
+    int bucket = 0;
+    for (int64_t limit = 100000;
+         bucket < CHECKOUT_BUCKETS - 1 && nanos >= limit; limit *= 10) {
+      bucket++;
+    }
+    getStats()->incInt(m_connectionCheckoutsIds[bucket], 1);
+  }
   inline apache::geode::statistics::Statistics* getStats() {
     return m_poolStats;
   }
@@ -166,6 +175,9 @@ class PoolStats {
   int32_t m_processedDeltaMessagesTimeId;
   int32_t m_queryExecutionsId;
   int32_t m_queryExecutionTimeId;
+  // checkouts under 100us, 1ms, 10ms, 100ms, 1s and the rest
+  static constexpr int CHECKOUT_BUCKETS = 6;
+  int32_t m_connectionCheckoutsIds[CHECKOUT_BUCKETS];
 
   static constexpr const char* STATS_NAME = "PoolStatistics";
   static constexpr const char* STATS_DESC = "Statistics for this pool";
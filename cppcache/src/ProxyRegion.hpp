@@ -1073,6 +1073,10 @@ class CPPCACHE_EXPORT ProxyRegion : public Region {
     return false;
   }
 
+  virtual void prefetch(const VectorOfCacheableKey& keys) {
+    unSupportedOperation("Region.prefetch()");
+  }
+
   /**
    * The cache of the server, to which it is connected with, is searched
    * for the key to see if the key is present.
@@ -1492,6 +1496,10 @@ class CPPCACHE_EXPORT ProxyRegion : public Region {
    */
   virtual uint32_t size() { return m_realRegion->size(); }
 
+  virtual void reserve(uint32_t expectedEntries) {
+    unSupportedOperation("Region.reserve()");
+  }
+
   virtual const PoolPtr& getPool() { return m_realRegion->getPool(); }
 
   ProxyRegion(const ProxyCachePtr& proxyCache, const RegionPtr& realRegion)
@@ -0,0 +1,249 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_REACTORTASK_H_
+#define GEODE_REACTORTASK_H_
+
+#include <ace/Condition_T.h>
+#include <ace/Event_Handler.h>
+#include <ace/Guard_T.h>
+#include <ace/OS.h>
+#include <ace/Thread_Mutex.h>
+
+#include "IoReactor.hpp"
+#include "Task.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * Reads a connection with the same interface as Task, but on the threads of
+ * an IoReactor instead of a thread of its own.
+ *
+ * The operation reads what the connection has, it returns -1 to stop
+ * reading and HOLD to stop until resume() is called. It is called by the
+ * reactor whenever the connection has data, one call at a time, and must not
+ * wait for anything but the data at hand. When there is no reactor or the
+ * connection has no handle the reactor can wait on, an SSL connection
+ * buffers data the socket no longer shows, the task falls back to a thread
+ * that calls the operation in a loop, like Task does.
+ */
+template <class T>
+class ReactorTask {
+ public:
+  typedef int (T::*OPERATION)(volatile bool& isRunning);
+
+  static const int HOLD = 1;
+
+  ReactorTask(T* op_handler, OPERATION op, IoReactor* reactor,
+              ACE_HANDLE handle, const char* tn)
+      : m_handler(new Handler(op_handler, op, reactor, handle)),
+        m_thread(nullptr),
+        m_threadName(tn) {}
+
+  ~ReactorTask() {
+    stop();
+    delete m_thread;
+    // the reactor may still hold a reference, see Handler
+    m_handler->remove_reference();
+  }
+
+  void start() {
+    if (!m_handler->start()) {
+      m_thread = new Task<Handler>(m_handler, &Handler::loop, m_threadName);
+      m_thread->start();
+    }
+  }
+
+  void stop() {
+    stopNoblock();
+    wait();
+  }
+
+  void stopNoblock() { m_handler->stopNoblock(); }
+
+  /** reads the connection again after the operation returned HOLD */
+  void resume() { m_handler->resume(); }
+
+  /** waits until the operation no longer runs, after stopNoblock() */
+  int wait() {
+    if (m_thread != nullptr) {
+      return m_thread->wait();
+    }
+    m_handler->waitIdle();
+    return 0;
+  }
+
+ private:
+  /**
+   * Reference counted, so the reactor keeps it alive while it dispatches to
+   * it; once stopped it no longer calls the operation.
+   */
+  class Handler : public ACE_Event_Handler {
+   public:
+    Handler(T* op_handler, OPERATION op, IoReactor* reactor, ACE_HANDLE handle)
+        : m_opHandler(op_handler),
+          m_op(op),
+          m_reactor(reactor),
+          m_handle(handle),
+          m_run(false),
+          m_registered(false),
+          m_inUpcall(false),
+          m_held(false),
+          m_resumed(false),
+          m_idle(m_lock),
+          m_resumedCond(m_lock) {
+      reference_counting_policy().value(
+          ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
+    }
+
+    /** returns false when the reactor cannot be used */
+    bool start() {
+      m_run = true;
+      if (m_reactor == nullptr || m_handle == ACE_INVALID_HANDLE) {
+        return false;
+      }
+      ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+      m_registered = m_reactor->registerHandler(this) == 0;
+      return m_registered;
+    }
+
+    void stopNoblock() {
+      bool registered;
+      {
+        ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+        m_run = false;
+        registered = m_registered;
+        m_resumedCond.broadcast();
+      }
+      if (registered) {
+        m_reactor->removeHandler(this);
+      }
+    }
+
+    void resume() {
+      ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+      if (!m_held) {
+        // the operation has yet to return HOLD
+        m_resumed = true;
+        return;
+      }
+      m_held = false;
+      if (m_registered && m_run) {
+        m_reactor->resumeHandler(this);
+      }
+      m_resumedCond.broadcast();
+    }
+
+    void waitIdle() {
+      ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+      // the operation may stop its own task
+      while (m_inUpcall &&
+             !ACE_OS::thr_equal(m_upcallThread, ACE_OS::thr_self())) {
+        m_idle.wait();
+      }
+    }
+
+    int loop(volatile bool& isRunning) {
+      while (isRunning && m_run) {
+        int result = (m_opHandler->*m_op)(m_run);
+        if (result == -1) {
+          break;
+        }
+        if (result == HOLD) {
+          ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+          if (hold()) {
+            while (m_held && m_run) {
+              m_resumedCond.wait();
+            }
+          }
+        }
+      }
+      return 0;
+    }
+
+    ACE_HANDLE get_handle() const { return m_handle; }
+
+    int handle_input(ACE_HANDLE) {
+      {
+        ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+        if (!m_run) {
+          return -1;
+        }
+        m_inUpcall = true;
+        m_upcallThread = ACE_OS::thr_self();
+      }
+      int result = (m_opHandler->*m_op)(m_run);
+      ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+      m_inUpcall = false;
+      m_idle.broadcast();
+      if (result == HOLD && m_run && hold()) {
+        m_reactor->suspendHandler(this);
+      }
+      return result == -1 || !m_run ? -1 : 0;
+    }
+
+    int handle_close(ACE_HANDLE, ACE_Reactor_Mask) {
+      ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+      m_registered = false;
+      m_run = false;
+      return 0;
+    }
+
+   private:
+    // called with m_lock held, returns false when already resumed
+    bool hold() {
+      if (m_resumed) {
+        m_resumed = false;
+        return false;
+      }
+      m_held = true;
+      return true;
+    }
+
+    T* m_opHandler;
+    OPERATION m_op;
+    IoReactor* m_reactor;
+    ACE_HANDLE m_handle;
+    volatile bool m_run;
+    bool m_registered;
+    bool m_inUpcall;
+    // the operation returned HOLD and resume() has not been called since
+    bool m_held;
+    // resume() was called before the operation returned HOLD
+    bool m_resumed;
+    ACE_thread_t m_upcallThread;
+    ACE_Thread_Mutex m_lock;
+    ACE_Condition<ACE_Thread_Mutex> m_idle;
+    ACE_Condition<ACE_Thread_Mutex> m_resumedCond;
+  };
+
+  Handler* m_handler;
+  Task<Handler>* m_thread;
+  const char* m_threadName;
+
+  ReactorTask(const ReactorTask&) = delete;
+  ReactorTask& operator=(const ReactorTask&) = delete;
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_REACTORTASK_H_
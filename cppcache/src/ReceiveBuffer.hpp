@@ -0,0 +1,93 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_RECEIVEBUFFER_H_
+#define GEODE_RECEIVEBUFFER_H_
+
+#include <cstdint>
+#include <memory>
+
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * A message or chunk received from a server, shared by everything that is
+ * deserialized from it.
+ *
+ * Large byte arrays read out of the buffer are handed out as slices: a
+ * pointer into the buffer that keeps the whole buffer alive, so the array
+ * does not have to be copied. Since a slice pins the entire buffer only
+ * arrays of at least MIN_SLICE_LENGTH bytes that also make up a fair share
+ * of the buffer are sliced, which bounds the memory a retained value can
+ * hold on to.
+ */
+class ReceiveBuffer : public std::enable_shared_from_this<ReceiveBuffer> {
+ public:
+  static const int32_t MIN_SLICE_LENGTH = 4096;
+  // a slice holds on to at most this many times its own length
+  static const int32_t MAX_SLICE_OVERHEAD = 8;
+
+  /**
+   * Take ownership of a buffer of length bytes allocated with new[].
+   */
+  inline static std::shared_ptr<ReceiveBuffer> create(const uint8_t* bytes,
+                                                      int32_t length) {
+    return std::shared_ptr<ReceiveBuffer>(new ReceiveBuffer(bytes, length));
+  }
+
+  inline ~ReceiveBuffer() { delete[] m_bytes; }
+
+  inline const uint8_t* getBytes() const { return m_bytes; }
+
+  inline int32_t getLength() const { return m_length; }
+
+  /** Whether an array of the given length should be sliced. */
+  inline bool isSliceable(int32_t length) const {
+    return length >= MIN_SLICE_LENGTH &&
+           static_cast<int64_t>(length) * MAX_SLICE_OVERHEAD >= m_length;
+  }
+
+  /**
+   * Get a pointer to the given position in this buffer that keeps the
+   * buffer alive for as long as it is held.
+   */
+  inline std::shared_ptr<const uint8_t> slice(const uint8_t* position) {
+    return std::shared_ptr<const uint8_t>(shared_from_this(), position);
+  }
+
+ private:
+  const uint8_t* m_bytes;
+  int32_t m_length;
+
+  inline ReceiveBuffer(const uint8_t* bytes, int32_t length)
+      : m_bytes(bytes), m_length(length) {}
+
+  ReceiveBuffer(const ReceiveBuffer&) = delete;
+  ReceiveBuffer& operator=(const ReceiveBuffer&) = delete;
+};
+
+typedef std::shared_ptr<ReceiveBuffer> ReceiveBufferPtr;
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_RECEIVEBUFFER_H_
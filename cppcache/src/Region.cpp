@@ -17,11 +17,74 @@
 
 #include <geode/Region.hpp>
 
+#include <exception>
+#include <functional>
+
+#include <geode/ExceptionTypes.hpp>
+
+#include "CacheImpl.hpp"
+#include "CacheRegionHelper.hpp"
+#include "ThreadPool.hpp"
+
 namespace apache {
 namespace geode {
 namespace client {
 Region::Region(const CachePtr& cache) : m_cache(cache) {}
 Region::~Region() {}
+
+namespace {
+
+// runs the operation on the asynchronous thread pool of the cache, the
+// future fails with CacheClosedException if the cache is closing before the
+// operation starts
+template <class R>
+std::future<R> performAsync(CacheImpl* cacheImpl,
+                            std::function<R()> operation) {
+  auto task = new PooledTask<R>([cacheImpl, operation]() -> R {
+    // the cache is told the work ran however the operation ends
+    struct WorkDone {
+      CacheImpl* m_cacheImpl;
+      ~WorkDone() { m_cacheImpl->asyncWorkDone(); }
+    } workDone = {cacheImpl};
+    if (cacheImpl->isCacheDestroyPending()) {
+      throw CacheClosedException("Region: cache closed");
+    }
+    return operation();
+  });
+  auto future = task->getFuture();
+  if (!cacheImpl->performAsync(task)) {
+    delete task;
+    std::promise<R> closed;
+    closed.set_exception(
+        std::make_exception_ptr(CacheClosedException("Region: cache closed")));
+    return closed.get_future();
+  }
+  return future;
+}
+
+}  // namespace
+
+std::future<CacheablePtr> Region::getAsync(
+    const CacheableKeyPtr& key, const SerializablePtr& aCallbackArgument) {
+  // the region is kept alive by the work until it ran
+  auto region = shared_from_this();
+  return performAsync<CacheablePtr>(
+      CacheRegionHelper::getCacheImpl(m_cache.get()),
+      [region, key, aCallbackArgument] {
+        return region->get(key, aCallbackArgument);
+      });
+}
+
+std::future<void> Region::putAsync(const CacheableKeyPtr& key,
+                                   const CacheablePtr& value,
+                                   const SerializablePtr& aCallbackArgument) {
+  auto region = shared_from_this();
+  return performAsync<void>(
+      CacheRegionHelper::getCacheImpl(m_cache.get()),
+      [region, key, value, aCallbackArgument] {
+        region->put(key, value, aCallbackArgument);
+      });
+}
 }  // namespace client
 }  // namespace geode
 }  // namespace apache
@@ -47,6 +47,7 @@ RegionAttributes::RegionAttributes()
       m_regionIdleTimeout(0),
       m_regionTimeToLive(0),
       m_initialCapacity(10000),
+      m_expectedEntries(0),
       m_loadFactor(0.75),
       m_concurrencyLevel(16),
       m_cacheLoaderLibrary(nullptr),
@@ -58,6 +59,7 @@ RegionAttributes::RegionAttributes()
       m_cacheListenerFactory(nullptr),
       m_partitionResolverFactory(nullptr),
       m_diskPolicy(DiskPolicyType::NONE),
+      m_evictionPolicy(EvictionPolicyType::LRU),
       m_endpoints(nullptr),
       m_clientNotificationEnabled(false),
       m_persistenceLibrary(nullptr),
@@ -66,7 +68,8 @@ RegionAttributes::RegionAttributes()
       m_persistenceManager(nullptr),
       m_poolName(nullptr),
       m_isClonable(false),
-      m_isConcurrencyChecksEnabled(true) {}
+      m_isConcurrencyChecksEnabled(true),
+      m_isConcurrentReadsEnabled(false) {}
 
 RegionAttributes::RegionAttributes(const RegionAttributes& rhs)
     : m_regionTimeToLiveExpirationAction(
@@ -89,14 +92,17 @@ RegionAttributes::RegionAttributes(const RegionAttributes& rhs)
       m_regionIdleTimeout(rhs.m_regionIdleTimeout),
       m_regionTimeToLive(rhs.m_regionTimeToLive),
       m_initialCapacity(rhs.m_initialCapacity),
+      m_expectedEntries(rhs.m_expectedEntries),
       m_loadFactor(rhs.m_loadFactor),
       m_concurrencyLevel(rhs.m_concurrencyLevel),
       m_diskPolicy(rhs.m_diskPolicy),
+      m_evictionPolicy(rhs.m_evictionPolicy),
       m_clientNotificationEnabled(rhs.m_clientNotificationEnabled),
       m_persistenceProperties(rhs.m_persistenceProperties),
       m_persistenceManager(rhs.m_persistenceManager),
       m_isClonable(rhs.m_isClonable),
-      m_isConcurrencyChecksEnabled(rhs.m_isConcurrencyChecksEnabled) {
+      m_isConcurrencyChecksEnabled(rhs.m_isConcurrencyChecksEnabled),
+      m_isConcurrentReadsEnabled(rhs.m_isConcurrentReadsEnabled) {
   if (rhs.m_cacheLoaderLibrary != nullptr) {
     size_t len = strlen(rhs.m_cacheLoaderLibrary) + 1;
     m_cacheLoaderLibrary = new char[len];
@@ -409,6 +415,8 @@ ExpirationAction::Action RegionAttributes::getEntryIdleTimeoutAction() {
 
 int RegionAttributes::getInitialCapacity() const { return m_initialCapacity; }
 
+int RegionAttributes::getExpectedEntries() const { return m_expectedEntries; }
+
 float RegionAttributes::getLoadFactor() const { return m_loadFactor; }
 
 uint8_t RegionAttributes::getConcurrencyLevel() const {
@@ -426,6 +434,10 @@ uint32_t RegionAttributes::getLruEntriesLimit() const {
 DiskPolicyType::PolicyType RegionAttributes::getDiskPolicy() const {
   return m_diskPolicy;
 }
+
+EvictionPolicyType::PolicyType RegionAttributes::getEvictionPolicy() const {
+  return m_evictionPolicy;
+}
 const char* RegionAttributes::getPoolName() const { return m_poolName; }
 Serializable* RegionAttributes::createDeserializable() {
   return new RegionAttributes();
@@ -487,11 +499,13 @@ void RegionAttributes::toData(DataOutput& out) const {
   out.writeInt(static_cast<int32_t>(m_entryIdleTimeout));
   out.writeInt(static_cast<int32_t>(m_entryIdleTimeoutExpirationAction));
   out.writeInt(static_cast<int32_t>(m_initialCapacity));
+  out.writeInt(static_cast<int32_t>(m_expectedEntries));
   out.writeFloat(m_loadFactor);
   out.writeInt(static_cast<int32_t>(m_maxValueDistLimit));
   out.writeInt(static_cast<int32_t>(m_concurrencyLevel));
   out.writeInt(static_cast<int32_t>(m_lruEntriesLimit));
   out.writeInt(static_cast<int32_t>(m_lruEvictionAction));
+  out.writeInt(static_cast<int32_t>(m_evictionPolicy));
 
   apache::geode::client::impl::writeBool(out, m_caching);
   apache::geode::client::impl::writeBool(out, m_clientNotificationEnabled);
@@ -511,6 +525,7 @@ void RegionAttributes::toData(DataOutput& out) const {
   out.writeObject(m_persistenceProperties);
   apache::geode::client::impl::writeCharStar(out, m_poolName);
   apache::geode::client::impl::writeBool(out, m_isConcurrencyChecksEnabled);
+  apache::geode::client::impl::writeBool(out, m_isConcurrentReadsEnabled);
 }
 
 void RegionAttributes::fromData(DataInput& in) {
@@ -523,11 +538,13 @@ void RegionAttributes::fromData(DataInput& in) {
   in.readInt(reinterpret_cast<int32_t*>(&m_entryIdleTimeout));
   in.readInt(reinterpret_cast<int32_t*>(&m_entryIdleTimeoutExpirationAction));
   in.readInt(reinterpret_cast<int32_t*>(&m_initialCapacity));
+  in.readInt(reinterpret_cast<int32_t*>(&m_expectedEntries));
   in.readFloat(&m_loadFactor);
   in.readInt(reinterpret_cast<int32_t*>(&m_maxValueDistLimit));
   in.readInt(reinterpret_cast<int32_t*>(&m_concurrencyLevel));
   in.readInt(reinterpret_cast<int32_t*>(&m_lruEntriesLimit));
   in.readInt(reinterpret_cast<int32_t*>(&m_lruEvictionAction));
+  in.readInt(reinterpret_cast<int32_t*>(&m_evictionPolicy));
 
   apache::geode::client::impl::readBool(in, &m_caching);
   apache::geode::client::impl::readBool(in, &m_clientNotificationEnabled);
@@ -547,6 +564,7 @@ void RegionAttributes::fromData(DataInput& in) {
   in.readObject(m_persistenceProperties, true);
   apache::geode::client::impl::readCharStar(in, &m_poolName);
   apache::geode::client::impl::readBool(in, &m_isConcurrencyChecksEnabled);
+  apache::geode::client::impl::readBool(in, &m_isConcurrentReadsEnabled);
 }
 
 /** Return true if all the attributes are equal to those of other. */
@@ -572,11 +590,13 @@ bool RegionAttributes::operator==(const RegionAttributes& other) const {
     return false;
   }
   if (m_initialCapacity != other.m_initialCapacity) return false;
+  if (m_expectedEntries != other.m_expectedEntries) return false;
   if (m_loadFactor != other.m_loadFactor) return false;
   if (m_maxValueDistLimit != other.m_maxValueDistLimit) return false;
   if (m_concurrencyLevel != other.m_concurrencyLevel) return false;
   if (m_lruEntriesLimit != other.m_lruEntriesLimit) return false;
   if (m_lruEvictionAction != other.m_lruEvictionAction) return false;
+  if (m_evictionPolicy != other.m_evictionPolicy) return false;
   if (m_caching != other.m_caching) return false;
   if (m_clientNotificationEnabled != other.m_clientNotificationEnabled) {
     return false;
@@ -627,6 +647,9 @@ bool RegionAttributes::operator==(const RegionAttributes& other) const {
   if (m_isConcurrencyChecksEnabled != other.m_isConcurrencyChecksEnabled) {
     return false;
   }
+  if (m_isConcurrentReadsEnabled != other.m_isConcurrentReadsEnabled) {
+    return false;
+  }
 
   return true;
 }
@@ -731,6 +754,10 @@ void RegionAttributes::setLruEntriesLimit(int limit) {
 void RegionAttributes::setDiskPolicy(DiskPolicyType::PolicyType diskPolicy) {
   m_diskPolicy = diskPolicy;
 }
+void RegionAttributes::setEvictionPolicy(
+    EvictionPolicyType::PolicyType evictionPolicy) {
+  m_evictionPolicy = evictionPolicy;
+}
 
 void RegionAttributes::copyStringAttribute(char*& lhs, const char* rhs) {
   if (lhs != nullptr) {
@@ -746,3 +773,7 @@ void RegionAttributes::setCloningEnabled(bool isClonable) {
 void RegionAttributes::setConcurrencyChecksEnabled(bool enable) {
   m_isConcurrencyChecksEnabled = enable;
 }
+
+void RegionAttributes::setConcurrentReadsEnabled(bool enable) {
+  m_isConcurrentReadsEnabled = enable;
+}
@@ -159,6 +159,16 @@ RegionFactory& RegionFactory::setInitialCapacity(int initialCapacity) {
   return *this;
 }
 
+RegionFactory& RegionFactory::setExpectedEntries(int expectedEntries) {
+  char excpStr[256] = {0};
+  if (expectedEntries < 0) {
+    ACE_OS::snprintf(excpStr, 256, "expectedEntries must be >= 0 ");
+    throw IllegalArgumentException(excpStr);
+  }
+  m_attributeFactory->setExpectedEntries(expectedEntries);
+  return *this;
+}
+
 RegionFactory& RegionFactory::setLoadFactor(float loadFactor) {
   m_attributeFactory->setLoadFactor(loadFactor);
   return *this;
@@ -172,6 +182,10 @@ RegionFactory& RegionFactory::setConcurrencyChecksEnabled(bool enable) {
   m_attributeFactory->setConcurrencyChecksEnabled(enable);
   return *this;
 }
+RegionFactory& RegionFactory::setConcurrentReadsEnabled(bool enable) {
+  m_attributeFactory->setConcurrentReadsEnabled(enable);
+  return *this;
+}
 RegionFactory& RegionFactory::setLruEntriesLimit(const uint32_t entriesLimit) {
   m_attributeFactory->setLruEntriesLimit(entriesLimit);
   return *this;
@@ -183,6 +197,12 @@ RegionFactory& RegionFactory::setDiskPolicy(
   return *this;
 }
 
+RegionFactory& RegionFactory::setEvictionPolicy(
+    const EvictionPolicyType::PolicyType evictionPolicy) {
+  m_attributeFactory->setEvictionPolicy(evictionPolicy);
+  return *this;
+}
+
 RegionFactory& RegionFactory::setCachingEnabled(bool cachingEnabled) {
   m_attributeFactory->setCachingEnabled(cachingEnabled);
   return *this;
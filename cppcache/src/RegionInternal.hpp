@@ -240,7 +240,11 @@ class RegionInternal : public Region {
   virtual RegionStats* getRegionStats() = 0;
   virtual bool cacheEnabled() = 0;
   virtual bool isDestroyed() const = 0;
-  virtual void evict(int32_t percentage) = 0;
+  /**
+   * evict entries of a region with heap LRU until the given number of bytes
+   * have been freed, returns the bytes freed
+   */
+  virtual int64_t evict(int64_t bytes) = 0;
   virtual CacheImpl* getCacheImpl() const = 0;
   virtual TombstoneListPtr getTombstoneList();
 
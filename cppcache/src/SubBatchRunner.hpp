@@ -0,0 +1,196 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_SUBBATCHRUNNER_H_
+#define GEODE_SUBBATCHRUNNER_H_
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <geode/geode_globals.hpp>
+#include <geode/VectorT.hpp>
+
+#include "BucketServerLocation.hpp"
+#include "NonCopyable.hpp"
+#include "ThreadPool.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * Runs the per server parts of a single hop bulk operation, getAll or putAll,
+ * on the thread pool in sub-batches.
+ *
+ * The keys of each server are split into batches of at most MAX_BATCH_KEYS
+ * keys, and at most WINDOW batches of a server are in flight at once, each on
+ * a pool connection of its own. Serializing, sending, the server's work and
+ * processing the replies of the batches overlap, and the size of the
+ * messages stays bounded however many keys the operation has. Key sets small
+ * enough to gain nothing from it go out as a single batch, like they did
+ * before.
+ *
+ * The works are created by the given factory on the calling thread, when
+ * their batch is due, so a work may capture thread local state of the caller
+ * and the serialization buffer of a batch does not exist before it is sent.
+ */
+template <class WORK>
+class SubBatchRunner : private NonCopyable, private NonAssignable {
+ public:
+  typedef std::function<WORK*(const BucketServerLocationPtr&,
+                              const VectorOfCacheableKeyPtr&)>
+      WorkFactory;
+
+  /** the largest number of keys in a batch */
+  static const size_t MAX_BATCH_KEYS = 5000;
+  /** key sets are not split into batches smaller than this */
+  static const size_t MIN_BATCH_KEYS = 250;
+  /** the largest number of batches of a server in flight */
+  static const size_t WINDOW = 4;
+
+  /**
+   * maxConnections is that of the pool, the servers of the operation share
+   * it for their batches in flight
+   */
+  SubBatchRunner(ThreadPool* threadPool, int maxConnections,
+                 const WorkFactory& factory)
+      : m_threadPool(threadPool),
+        m_maxConnections(maxConnections),
+        m_factory(factory),
+        m_started(false) {}
+
+  /** waits for and deletes the works not taken with next() */
+  ~SubBatchRunner() {
+    for (auto& inFlight : m_inFlight) {
+      inFlight.second->getResult();
+      delete inFlight.second;
+    }
+  }
+
+  void add(const BucketServerLocationPtr& serverLocation,
+           const VectorOfCacheableKeyPtr& keys) {
+    m_servers.push_back(Server(serverLocation, keys));
+  }
+
+  /**
+   * Waits for the oldest work in flight and returns it, after starting the
+   * next batch of its server. Returns nullptr once all batches are done.
+   * The caller owns the work returned.
+   */
+  WORK* next() {
+    if (!m_started) {
+      start();
+    }
+    if (m_inFlight.empty()) {
+      return nullptr;
+    }
+    std::pair<size_t, WORK*> inFlight = m_inFlight.front();
+    m_inFlight.pop_front();
+    inFlight.second->getResult();
+    submit(inFlight.first);
+    return inFlight.second;
+  }
+
+  /**
+   * Splits keys into batches of equal size, WINDOW of them or more when
+   * that would exceed MAX_BATCH_KEYS, none smaller than MIN_BATCH_KEYS.
+   */
+  static std::deque<VectorOfCacheableKeyPtr> split(
+      const VectorOfCacheableKeyPtr& keys, size_t window) {
+    std::deque<VectorOfCacheableKeyPtr> batches;
+    size_t size = keys == nullptr ? 0 : keys->size();
+    size_t batchSize = (size + window - 1) / std::max<size_t>(window, 1);
+    batchSize = std::min(std::max(batchSize, MIN_BATCH_KEYS), MAX_BATCH_KEYS);
+    if (size <= batchSize) {
+      batches.push_back(keys);
+      return batches;
+    }
+    size_t count = (size + batchSize - 1) / batchSize;
+    for (size_t i = 0; i < count; i++) {
+      // spread the remainder, so the batches differ by one key at most
+      auto begin = keys->begin() + (size * i) / count;
+      auto end = keys->begin() + (size * (i + 1)) / count;
+      batches.push_back(std::make_shared<VectorOfCacheableKey>(begin, end));
+    }
+    return batches;
+  }
+
+ private:
+  struct Server {
+    BucketServerLocationPtr m_serverLocation;
+    VectorOfCacheableKeyPtr m_keys;
+    std::deque<VectorOfCacheableKeyPtr> m_batches;
+
+    Server(const BucketServerLocationPtr& serverLocation,
+           const VectorOfCacheableKeyPtr& keys)
+        : m_serverLocation(serverLocation), m_keys(keys) {}
+  };
+
+  ThreadPool* m_threadPool;
+  int m_maxConnections;
+  WorkFactory m_factory;
+  bool m_started;
+  std::vector<Server> m_servers;
+  // in the order of submission, with the index of their server
+  std::deque<std::pair<size_t, WORK*>> m_inFlight;
+
+  void start() {
+    m_started = true;
+    size_t window = WINDOW;
+    if (m_maxConnections > 0 && !m_servers.empty()) {
+      window = std::max<size_t>(
+          1, std::min(window, m_maxConnections / m_servers.size()));
+    }
+    for (auto& server : m_servers) {
+      server.m_batches = split(server.m_keys, window);
+    }
+    for (size_t i = 0; i < window; i++) {
+      for (size_t server = 0; server < m_servers.size(); server++) {
+        submit(server);
+      }
+    }
+  }
+
+  void submit(size_t server) {
+    auto& batches = m_servers[server].m_batches;
+    if (batches.empty()) {
+      return;
+    }
+    WORK* work = m_factory(m_servers[server].m_serverLocation, batches.front());
+    batches.pop_front();
+    m_threadPool->perform(work);
+    m_inFlight.push_back(std::make_pair(server, work));
+  }
+};
+
+template <class WORK>
+const size_t SubBatchRunner<WORK>::MAX_BATCH_KEYS;
+template <class WORK>
+const size_t SubBatchRunner<WORK>::MIN_BATCH_KEYS;
+template <class WORK>
+const size_t SubBatchRunner<WORK>::WINDOW;
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_SUBBATCHRUNNER_H_
@@ -82,6 +82,7 @@ const char StatsFileSizeLimit[] = "archive-file-size-limit";
 const char StatsDiskSpaceLimit[] = "archive-disk-space-limit";
 const char HeapLRULimit[] = "heap-lru-limit";
 const char HeapLRUDelta[] = "heap-lru-delta";
+const char HeapLRUEvictionThreads[] = "heap-lru-eviction-threads";
 const char MaxSocketBufferSize[] = "max-socket-buffer-size";
 const char PingInterval[] = "ping-interval";
 const char RedundancyMonitorInterval[] = "redundancy-monitor-interval";
@@ -105,11 +106,16 @@ const char SslTrustStore[] = "ssl-truststore";
 const char SslKeystorePassword[] =
     "ssl-keystore-password";  // adongre: Added for Ticket #758
 const char ThreadPoolSize[] = "max-fe-threads";
+const char AsyncThreadPoolSize[] = "max-async-threads";
+const char IoThreads[] = "io-threads";
+const char NotificationDispatchThreads[] = "notification-dispatch-threads";
 const char SuspendedTxTimeout[] = "suspended-tx-timeout";
 const char DisableChunkHandlerThread[] = "disable-chunk-handler-thread";
+const char ChunkHandlerThreads[] = "chunk-handler-threads";
 const char OnClientDisconnectClearPdxTypeIds[] =
     "on-client-disconnect-clear-pdxType-Ids";
 const char TombstoneTimeoutInMSec[] = "tombstone-timeout";
+const char ExpiryTimingWheel[] = "expiry-timing-wheel";
 const char DefaultConflateEvents[] = "server";
 const char ReadTimeoutUnitInMillis[] = "read-timeout-unit-in-millis";
 
@@ -153,6 +159,7 @@ const uint32_t DefaultStatsDiskSpaceLimit = 0;  // = unlimited
 const uint32_t DefaultMaxQueueSize = 80000;
 const uint32_t DefaultHeapLRULimit = 0;  // = unlimited, disabled when it is 0
 const int32_t DefaultHeapLRUDelta = 10;  // = unlimited, disabled when it is 0
+const uint32_t DefaultHeapLRUEvictionThreads = 2;
 
 const int32_t DefaultMaxSocketBufferSize = 65 * 1024;
 const int32_t DefaultPingInterval = 10;
@@ -165,10 +172,17 @@ const char DefaultAuthIniLoaderLibrary[] = "security-client-auth-library";
 const char DefaultSecurityClientDhAlgo[] ATTR_UNUSED = "";
 const char DefaultSecurityClientKsPath[] ATTR_UNUSED = "";
 const uint32_t DefaultThreadPoolSize = ACE_OS::num_processors() * 2;
+const uint32_t DefaultAsyncThreadPoolSize = ACE_OS::num_processors() * 4;
+const uint32_t DefaultIoThreads = 4;
+// subscription events are dispatched by the threads reading them
+const uint32_t DefaultNotificationDispatchThreads = 0;
 const uint32_t DefaultSuspendedTxTimeout = 30;
 const uint32_t DefaultTombstoneTimeout = 480000;
+// entry, region and tombstone expiry on the timer heap of the reactor
+const bool DefaultExpiryTimingWheel = false;
 // not disable; all region api will use chunk handler thread
 const bool DefaultDisableChunkHandlerThread = false;
+const uint32_t DefaultChunkHandlerThreads = 4;
 const bool DefaultReadTimeoutUnitInMillis = false;
 const bool DefaultOnClientDisconnectClearPdxTypeIds = false;
 }  // namespace
@@ -197,6 +211,7 @@ SystemProperties::SystemProperties(const PropertiesPtr& propertiesPtr,
       m_javaConnectionPoolSize(DefaultJavaConnectionPoolSize),
       m_heapLRULimit(DefaultHeapLRULimit),
       m_heapLRUDelta(DefaultHeapLRUDelta),
+      m_heapLRUEvictionThreads(DefaultHeapLRUEvictionThreads),
       m_maxSocketBufferSize(DefaultMaxSocketBufferSize),
       m_pingInterval(DefaultPingInterval),
       m_redundancyMonitorInterval(DefaultRedundancyMonitorInterval),
@@ -221,9 +236,14 @@ SystemProperties::SystemProperties(const PropertiesPtr& propertiesPtr,
       m_sslKeystorePassword(nullptr),  // adongre: Added for Ticket #758
       m_conflateEvents(nullptr),
       m_threadPoolSize(DefaultThreadPoolSize),
+      m_asyncThreadPoolSize(DefaultAsyncThreadPoolSize),
+      m_ioThreads(DefaultIoThreads),
+      m_notificationDispatchThreads(DefaultNotificationDispatchThreads),
       m_suspendedTxTimeout(DefaultSuspendedTxTimeout),
       m_tombstoneTimeoutInMSec(DefaultTombstoneTimeout),
+      m_expiryTimingWheel(DefaultExpiryTimingWheel),
       m_disableChunkHandlerThread(DefaultDisableChunkHandlerThread),
+      m_chunkHandlerThreads(DefaultChunkHandlerThreads),
       m_readTimeoutUnitInMillis(DefaultReadTimeoutUnitInMillis),
       m_onClientDisconnectClearPdxTypeIds(
           DefaultOnClientDisconnectClearPdxTypeIds) {
@@ -329,6 +349,42 @@ void SystemProperties::processProperty(const char* property,
       throwError(
           ("SystemProperties: non-integer " + prop + "=" + value).c_str());
     }
+  } else if (prop == AsyncThreadPoolSize) {
+    char* end;
+    uint32_t si = strtoul(value, &end, 10);
+    if (!*end) {
+      m_asyncThreadPoolSize = si;
+    } else {
+      throwError(
+          ("SystemProperties: non-integer " + prop + "=" + value).c_str());
+    }
+  } else if (prop == ChunkHandlerThreads) {
+    char* end;
+    uint32_t si = strtoul(value, &end, 10);
+    if (!*end) {
+      m_chunkHandlerThreads = si;
+    } else {
+      throwError(
+          ("SystemProperties: non-integer " + prop + "=" + value).c_str());
+    }
+  } else if (prop == IoThreads) {
+    char* end;
+    uint32_t si = strtoul(value, &end, 10);
+    if (!*end) {
+      m_ioThreads = si;
+    } else {
+      throwError(
+          ("SystemProperties: non-integer " + prop + "=" + value).c_str());
+    }
+  } else if (prop == NotificationDispatchThreads) {
+    char* end;
+    uint32_t si = strtoul(value, &end, 10);
+    if (!*end) {
+      m_notificationDispatchThreads = si;
+    } else {
+      throwError(
+          ("SystemProperties: non-integer " + prop + "=" + value).c_str());
+    }
   } else if (prop == MaxSocketBufferSize) {
     char* end;
     long si = strtol(value, &end, 10);
@@ -685,6 +741,15 @@ void SystemProperties::processProperty(const char* property,
       throwError(
           ("SystemProperties: non-integer " + prop + "=" + value).c_str());
     }
+  } else if (prop == HeapLRUEvictionThreads) {
+    char* end;
+    uint32_t si = strtoul(value, &end, 10);
+    if (!*end) {
+      m_heapLRUEvictionThreads = si;
+    } else {
+      throwError(
+          ("SystemProperties: non-integer " + prop + "=" + value).c_str());
+    }
   } else if (prop == SuspendedTxTimeout) {
     char* end;
     uint32_t si = strtoul(value, &end, 10);
@@ -706,6 +771,15 @@ void SystemProperties::processProperty(const char* property,
       throwError(
           ("SystemProperties: non-integer " + prop + "=" + value).c_str());
     }
+  } else if (prop == ExpiryTimingWheel) {
+    std::string val = value;
+    if (val == "false") {
+      m_expiryTimingWheel = false;
+    } else if (val == "true") {
+      m_expiryTimingWheel = true;
+    } else {
+      throwError(("SystemProperties: non-boolean " + prop + "=" + val).c_str());
+    }
   } else if (strncmp(property, DefaultSecurityPrefix,
                      sizeof(DefaultSecurityPrefix) - 1) == 0) {
     m_securityPropertiesPtr->insert(property, value);
@@ -793,6 +867,10 @@ void SystemProperties::logSettings() {
   settings += "\n  disable-chunk-handler-thread = ";
   settings += disableChunkHandlerThread() ? "true" : "false";
 
+  ACE_OS::snprintf(buf, 2048, "%" PRIu32, chunkHandlerThreads());
+  settings += "\n  chunk-handler-threads = ";
+  settings += buf;
+
   settings += "\n  disable-shuffling-of-endpoints = ";
   settings += isEndpointShufflingDisabled() ? "true" : "false";
 
@@ -808,12 +886,19 @@ void SystemProperties::logSettings() {
   settings += "\n  enable-time-statistics = ";
   settings += getEnableTimeStatistics() ? "true" : "false";
 
+  settings += "\n  expiry-timing-wheel = ";
+  settings += expiryTimingWheel() ? "true" : "false";
+
   settings += "\n  grid-client = ";
   settings += isGridClient() ? "true" : "false";
 
   ACE_OS::snprintf(buf, 2048, "%" PRIu32, heapLRUDelta());
   settings += "\n  heap-lru-delta = ";
   settings += buf;
+
+  ACE_OS::snprintf(buf, 2048, "%" PRIu32, heapLRUEvictionThreads());
+  settings += "\n  heap-lru-eviction-threads = ";
+  settings += buf;
   /* adongre  - Coverity II
    * CID 29195: Printf arg type mismatch (PW.PRINTF_ARG_MISMATCH)
    */
@@ -845,10 +930,22 @@ void SystemProperties::logSettings() {
   settings += "\n  max-fe-threads = ";
   settings += buf;
 
+  ACE_OS::snprintf(buf, 2048, "%" PRIu32, asyncThreadPoolSize());
+  settings += "\n  max-async-threads = ";
+  settings += buf;
+
+  ACE_OS::snprintf(buf, 2048, "%" PRIu32, ioThreads());
+  settings += "\n  io-threads = ";
+  settings += buf;
+
   ACE_OS::snprintf(buf, 2048, "%" PRIu32, maxSocketBufferSize());
   settings += "\n  max-socket-buffer-size = ";
   settings += buf;
 
+  ACE_OS::snprintf(buf, 2048, "%" PRIu32, notificationDispatchThreads());
+  settings += "\n  notification-dispatch-threads = ";
+  settings += buf;
+
   ACE_OS::snprintf(buf, 2048, "%" PRIi32, notifyAckInterval());
   settings += "\n  notify-ack-interval = ";
   settings += buf;
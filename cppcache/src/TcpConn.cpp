@@ -22,6 +22,9 @@
 
 #include <memory.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <ace/INET_Addr.h>
 #include <ace/SOCK_IO.h>
 #include <ace/SOCK_Connector.h>
@@ -272,6 +275,83 @@ int32_t TcpConn::send(const char *buff, int32_t len, uint32_t waitSeconds,
   return socketOp(SOCK_WRITE, const_cast<char *>(buff), len, waitSeconds);
 }
 
+int32_t TcpConn::sendv(const iovec *segments, int32_t count,
+                       uint32_t waitSeconds, uint32_t waitMicroSeconds) {
+  GF_DEV_ASSERT(m_io != nullptr);
+  GF_DEV_ASSERT(segments != nullptr);
+
+  // a writev per ACE_IOV_MAX segments, more fail with EINVAL, and per
+  // m_chunkSize bytes like send(); all of them within the one wait, the
+  // caller resumes partial writes
+  ACE_Time_Value waitTime(0, waitSeconds /*now its in microSeconds*/);
+  ACE_Time_Value endTime(ACE_OS::gettimeofday() + waitTime);
+  const size_t chunkSize = static_cast<size_t>(m_chunkSize);
+  std::vector<iovec> slice;
+  // bytes of the first segment sent already
+  size_t offset = 0;
+  int32_t totalsend = 0;
+  while (count > 0) {
+    slice.clear();
+    size_t sliceLen = 0;
+    for (int32_t i = 0; i < count &&
+                        slice.size() < static_cast<size_t>(ACE_IOV_MAX) &&
+                        sliceLen < chunkSize;
+         i++) {
+      size_t skip = i == 0 ? offset : 0;
+      iovec segment;
+      segment.iov_base = static_cast<char *>(segments[i].iov_base) + skip;
+      segment.iov_len =
+          std::min(segments[i].iov_len - skip, chunkSize - sliceLen);
+      slice.push_back(segment);
+      sliceLen += segment.iov_len;
+    }
+    size_t sentLen = 0;
+    ssize_t retVal = m_io->sendv_n(slice.data(),
+                                   static_cast<int>(slice.size()), &waitTime,
+                                   &sentLen);
+    totalsend += static_cast<int32_t>(sentLen);
+    if (sentLen < sliceLen) {
+      if (retVal == 0 && sentLen == 0) {
+        ACE_OS::last_error(EPIPE);
+      }
+      break;
+    }
+    while (count > 0 && sentLen >= segments->iov_len - offset) {
+      sentLen -= segments->iov_len - offset;
+      offset = 0;
+      segments++;
+      count--;
+    }
+    offset += sentLen;
+    waitTime = endTime - ACE_OS::gettimeofday();
+    if (count > 0 && waitTime <= ACE_Time_Value::zero) {
+      ACE_OS::last_error(ETIME);
+      break;
+    }
+  }
+  return totalsend;
+}
+
+int32_t TcpConn::receiveAvailable(char *buff, int32_t len) {
+  GF_DEV_ASSERT(m_io != nullptr);
+  GF_DEV_ASSERT(buff != nullptr);
+
+  // the socket is non blocking, see connect()
+  ssize_t retVal = m_io->recv(buff, len);
+  if (retVal > 0) {
+    return static_cast<int32_t>(retVal);
+  }
+  if (retVal < 0) {
+    int32_t lastError = ACE_OS::last_error();
+    if (lastError == EAGAIN || lastError == EWOULDBLOCK || lastError == EINTR) {
+      return 0;
+    }
+  } else {
+    ACE_OS::last_error(EPIPE);
+  }
+  return -1;
+}
+
 int32_t TcpConn::socketOp(TcpConn::SockOp op, char *buff, int32_t len,
                           uint32_t waitSeconds) {
   {
@@ -367,3 +447,7 @@ uint16_t TcpConn::getPort() {
   m_io->get_local_addr(*(ACE_Addr *)&localAddr);
   return localAddr.get_port_number();
 }
+
+ACE_HANDLE TcpConn::getHandle() {
+  return m_io == nullptr ? ACE_INVALID_HANDLE : m_io->get_handle();
+}
@@ -112,6 +112,14 @@ class CPPCACHE_EXPORT TcpConn : public Connector {
                   uint32_t waitMicroSeconds);
   int32_t send(const char* buff, int32_t len, uint32_t waitSeconds,
                uint32_t waitMicroSeconds);
+  int32_t sendv(const iovec* segments, int32_t count, uint32_t waitSeconds,
+                uint32_t waitMicroSeconds);
+
+  /**
+   * Reads what the socket has, up to len bytes, without waiting. Returns 0
+   * when there is nothing to read and -1 once the connection is closed.
+   */
+  int32_t receiveAvailable(char* buff, int32_t len);
 
   virtual void setOption(int32_t level, int32_t option, void* val,
                          int32_t len) {
@@ -133,6 +141,12 @@ class CPPCACHE_EXPORT TcpConn : public Connector {
   }
 
   virtual uint16_t getPort();
+
+  /**
+   * Returns the socket to wait on for data to read, or ACE_INVALID_HANDLE
+   * when the socket does not show all data there is to read.
+   */
+  virtual ACE_HANDLE getHandle();
 };
 }  // namespace client
 }  // namespace geode
@@ -82,6 +82,12 @@ class TcpSslConn : public TcpConn {
   // connect
   void connect();
 
+  // the SSL stream has no gathering write, send the segments one by one
+  int32_t sendv(const iovec* segments, int32_t count, uint32_t waitSeconds,
+                uint32_t waitMicroSeconds) {
+    return Connector::sendv(segments, count, waitSeconds, waitMicroSeconds);
+  }
+
   void setOption(int32_t level, int32_t option, void* val, int32_t len) {
     GF_DEV_ASSERT(m_ssl != nullptr);
 
@@ -93,6 +99,9 @@ class TcpSslConn : public TcpConn {
   }
 
   uint16_t getPort();
+
+  // decrypted data the SSL layer buffered is not seen on the socket
+  ACE_HANDLE getHandle() { return ACE_INVALID_HANDLE; }
 };
 }  // namespace client
 }  // namespace geode
@@ -25,21 +25,43 @@
  *
  */
 
+#include <map>
 #include <memory>
 
 #include <ace/Semaphore.h>
+#include <ace/Thread_Mutex.h>
 #include <string>
 #include <geode/geode_types.hpp>
 #include "Utils.hpp"
 #include "AppDomainContext.hpp"
+#include "ReceiveBuffer.hpp"
 
 namespace apache {
 namespace geode {
 namespace client {
 
+class TcrChunkedContext;
+
+/**
+ * A chunk deserialized by TcrChunkedResult::decodeChunk() ahead of its turn,
+ * to be merged into the result in the order of the chunks.
+ */
+class TcrDecodedChunk {
+ public:
+  virtual ~TcrDecodedChunk() {}
+};
+
+typedef std::unique_ptr<TcrDecodedChunk> TcrDecodedChunkPtr;
+
 /**
  * Base class for holding chunked results, processing a chunk
  * and signalling end of chunks using semaphore.
+ *
+ * The chunks of a result may be processed by several threads at once. Each
+ * chunk is first decoded, which results that support it do with
+ * decodeChunk() concurrently with other chunks, and then merged into the
+ * result with handleChunk() or mergeChunk(), one chunk at a time and in the
+ * order the chunks were received.
  */
 class TcrChunkedResult {
  private:
@@ -47,23 +69,62 @@ class TcrChunkedResult {
   ExceptionPtr m_ex;
   bool m_inSameThread;
   std::unique_ptr<AppDomainContext> appDomainContext;
+  ReceiveBufferPtr m_chunkBuffer;
+
+  // sequence numbers of the chunks, assigned by the receiving thread
+  uint32_t m_receivedChunks;
+  ACE_Thread_Mutex m_mergeLock;
+  uint32_t m_mergedChunks;
+  // a thread is merging chunks
+  bool m_merging;
+  // decoded chunks waiting for earlier ones to be merged
+  std::map<uint32_t, TcrChunkedContext*> m_decodedChunks;
+
+  friend class TcrChunkedContext;
 
  protected:
   uint16_t m_dsmemId;
 
+  /**
+   * The buffer of the chunk being handled; a DataInput reading the chunk can
+   * share it so that large values need not be copied out of the chunk.
+   */
+  inline const ReceiveBufferPtr& getChunkBuffer() const {
+    return m_chunkBuffer;
+  }
+
   /** handle a chunk of response message from server */
   virtual void handleChunk(const uint8_t* bytes, int32_t len,
                            uint8_t isLastChunkWithSecurity,
                            const Cache* cache) = 0;
 
+  /**
+   * Deserializes a chunk without touching the state of this result, so it
+   * can run for several chunks at once; the chunk is then merged with
+   * mergeChunk(). Returns nullptr to have the chunk handled in order with
+   * handleChunk() instead, which is what results do by default.
+   */
+  virtual TcrDecodedChunkPtr decodeChunk(const ReceiveBufferPtr& buffer,
+                                         uint8_t isLastChunkWithSecurity,
+                                         const Cache* cache) {
+    return nullptr;
+  }
+
+  /** merge a chunk returned by decodeChunk() into this result */
+  virtual void mergeChunk(TcrDecodedChunk& chunk,
+                          uint8_t isLastChunkWithSecurity) {}
+
  public:
   inline TcrChunkedResult()
       : m_finalizeSema(nullptr),
         m_ex(nullptr),
         m_inSameThread(false),
         appDomainContext(createAppDomainContext()),
+        m_receivedChunks(0),
+        m_mergedChunks(0),
+        m_merging(false),
         m_dsmemId(0) {}
-  virtual ~TcrChunkedResult() {}
+  virtual ~TcrChunkedResult();
   void setFinalizeSemaphore(ACE_Semaphore* finalizeSema) {
     m_finalizeSema = finalizeSema;
   }
@@ -75,15 +136,61 @@ class TcrChunkedResult {
    */
   virtual void reset() = 0;
 
-  void fireHandleChunk(const uint8_t* bytes, int32_t len,
+  /**
+   * Starts the sequence of chunks of a reply, by the receiving thread once
+   * the chunks of any previous reply have been processed.
+   */
+  void startChunks() {
+    m_receivedChunks = 0;
+    m_mergedChunks = 0;
+    m_merging = false;
+    m_inSameThread = false;
+  }
+
+  void fireHandleChunk(const ReceiveBufferPtr& buffer,
                        uint8_t isLastChunkWithSecurity, const Cache* cache) {
+    const uint8_t* bytes = buffer->getBytes();
+    int32_t len = buffer->getLength();
+    m_chunkBuffer = buffer;
+    try {
+      if (appDomainContext) {
+        appDomainContext->run(
+            [this, bytes, len, isLastChunkWithSecurity, &cache]() {
+              handleChunk(bytes, len, isLastChunkWithSecurity, cache);
+            });
+      } else {
+        handleChunk(bytes, len, isLastChunkWithSecurity, cache);
+      }
+    } catch (...) {
+      m_chunkBuffer.reset();
+      throw;
+    }
+    m_chunkBuffer.reset();
+  }
+
+  TcrDecodedChunkPtr fireDecodeChunk(const ReceiveBufferPtr& buffer,
+                                     uint8_t isLastChunkWithSecurity,
+                                     const Cache* cache) {
+    TcrDecodedChunkPtr decoded;
     if (appDomainContext) {
       appDomainContext->run(
-          [this, bytes, len, isLastChunkWithSecurity, &cache]() {
-            handleChunk(bytes, len, isLastChunkWithSecurity, cache);
+          [this, &decoded, &buffer, isLastChunkWithSecurity, &cache]() {
+            decoded = decodeChunk(buffer, isLastChunkWithSecurity, cache);
           });
     } else {
-      handleChunk(bytes, len, isLastChunkWithSecurity, cache);
+      decoded = decodeChunk(buffer, isLastChunkWithSecurity, cache);
+    }
+    return decoded;
+  }
+
+  void fireMergeChunk(TcrDecodedChunk& chunk,
+                      uint8_t isLastChunkWithSecurity) {
+    if (appDomainContext) {
+      appDomainContext->run([this, &chunk, isLastChunkWithSecurity]() {
+        mergeChunk(chunk, isLastChunkWithSecurity);
+      });
+    } else {
+      mergeChunk(chunk, isLastChunkWithSecurity);
     }
   }
 
@@ -134,59 +241,141 @@ typedef std::shared_ptr<TcrChunkedResult> TcrChunkedResultPtr;
  */
 class TcrChunkedContext {
  private:
-  const uint8_t* m_bytes;
-  const int32_t m_len;
+  ReceiveBufferPtr m_buffer;
   const uint8_t m_isLastChunkWithSecurity;
   const Cache* m_cache;
   TcrChunkedResult* m_result;
+  const uint32_t m_sequence;
+  TcrDecodedChunkPtr m_decoded;
+  ExceptionPtr m_decodeError;
+
+  // runs a step of the processing, returns the exception it failed with
+  template <class F>
+  ExceptionPtr process(F step) {
+    try {
+      step();
+    } catch (Exception& ex) {
+      LOGERROR("HandleChunk error message %s, name = %s", ex.getMessage(),
+               ex.getName());
+      return ExceptionPtr(ex.clone());
+    } catch (std::exception& stdEx) {
+      std::string exMsg("HandleChunk exception:: ");
+      exMsg += stdEx.what();
+      LOGERROR("HandleChunk exception: %s", stdEx.what());
+      return std::make_shared<UnknownException>(exMsg.c_str());
+    } catch (...) {
+      std::string exMsg("Unknown exception in ");
+      exMsg += Utils::demangleTypeName(typeid(*m_result).name())->asChar();
+      exMsg +=
+          "::handleChunk while processing response, possible serialization "
+          "mismatch";
+      LOGERROR(exMsg.c_str());
+      return std::make_shared<UnknownException>(exMsg.c_str());
+    }
+    return nullptr;
+  }
+
+  // merges the chunk into the result, in the order of the chunks
+  void merge(bool inSameThread) {
+    if (m_buffer == nullptr) {
+      // this is the last chunk for some set of chunks
+      m_result->finalize(inSameThread);
+      return;
+    }
+    if (m_result->exceptionOccurred()) {
+      return;
+    }
+    ExceptionPtr error = m_decodeError;
+    if (error == nullptr) {
+      error = process([this]() {
+        if (m_decoded != nullptr) {
+          m_result->fireMergeChunk(*m_decoded, m_isLastChunkWithSecurity);
+        } else {
+          m_result->fireHandleChunk(m_buffer, m_isLastChunkWithSecurity,
+                                    m_cache);
+        }
+      });
+    }
+    if (error != nullptr) {
+      m_result->setException(*error);
+    }
+  }
 
  public:
+  /** created by the receiving thread, in the order of the chunks */
   inline TcrChunkedContext(const uint8_t* bytes, int32_t len,
                            TcrChunkedResult* result,
                            uint8_t isLastChunkWithSecurity, const Cache* cache)
-      : m_bytes(bytes),
-        m_len(len),
+      : m_buffer(bytes == nullptr ? nullptr
+                                  : ReceiveBuffer::create(bytes, len)),
         m_isLastChunkWithSecurity(isLastChunkWithSecurity),
         m_cache(cache),
-        m_result(result) {}
+        m_result(result),
+        m_sequence(result->m_receivedChunks++) {}
 
-  inline ~TcrChunkedContext() { GF_SAFE_DELETE_ARRAY(m_bytes); }
-
-  inline const uint8_t* getBytes() const { return m_bytes; }
+  inline const uint8_t* getBytes() const {
+    return m_buffer == nullptr ? nullptr : m_buffer->getBytes();
+  }
 
-  inline int32_t getLen() const { return m_len; }
+  inline int32_t getLen() const {
+    return m_buffer == nullptr ? 0 : m_buffer->getLength();
+  }
 
+  /**
+   * Decodes the chunk and merges it, along with any later chunks decoded
+   * already, once the chunks before it have been merged. Takes ownership of
+   * this context, which is deleted by the thread that merges it.
+   */
   void handleChunk(bool inSameThread) {
-    if (m_bytes == nullptr) {
-      // this is the last chunk for some set of chunks
-      m_result->finalize(inSameThread);
-    } else if (!m_result->exceptionOccurred()) {
-      try {
-        m_result->fireHandleChunk(m_bytes, m_len, m_isLastChunkWithSecurity,
-                                  m_cache);
-      } catch (Exception& ex) {
-        LOGERROR("HandleChunk error message %s, name = %s", ex.getMessage(),
-                 ex.getName());
-        m_result->setException(ex);
-      } catch (std::exception& stdEx) {
-        std::string exMsg("HandleChunk exception:: ");
-        exMsg += stdEx.what();
-        LOGERROR("HandleChunk exception: %s", stdEx.what());
-        UnknownException ex(exMsg.c_str());
-        m_result->setException(ex);
-      } catch (...) {
-        std::string exMsg("Unknown exception in ");
-        exMsg += Utils::demangleTypeName(typeid(*m_result).name())->asChar();
-        exMsg +=
-            "::handleChunk while processing response, possible serialization "
-            "mismatch";
-        LOGERROR(exMsg.c_str());
-        UnknownException ex(exMsg.c_str());
-        m_result->setException(ex);
+    if (m_buffer != nullptr) {
+      m_decodeError = process([this]() {
+        m_decoded = m_result->fireDecodeChunk(
+            m_buffer, m_isLastChunkWithSecurity, m_cache);
+      });
+    }
+
+    TcrChunkedResult* result = m_result;
+    result->m_mergeLock.acquire();
+    result->m_decodedChunks.emplace(m_sequence, this);
+    if (result->m_merging) {
+      result->m_mergeLock.release();
+      return;
+    }
+    result->m_merging = true;
+    while (true) {
+      auto next = result->m_decodedChunks.begin();
+      if (next == result->m_decodedChunks.end() ||
+          next->first != result->m_mergedChunks) {
+        result->m_merging = false;
+        result->m_mergeLock.release();
+        return;
+      }
+      TcrChunkedContext* chunk = next->second;
+      result->m_decodedChunks.erase(next);
+      result->m_mergedChunks++;
+      bool last = chunk->m_buffer == nullptr;
+      if (last) {
+        // the result may be gone once the waiting thread is signalled
+        result->m_merging = false;
       }
+      result->m_mergeLock.release();
+      chunk->merge(inSameThread);
+      delete chunk;
+      if (last) {
+        return;
+      }
+      result->m_mergeLock.acquire();
     }
   }
 };
+
+// chunks left waiting for earlier ones that were dropped, as when the chunk
+// processors stop in the middle of a reply
+inline TcrChunkedResult::~TcrChunkedResult() {
+  for (const auto& chunk : m_decodedChunks) {
+    delete chunk.second;
+  }
+}
 }  // namespace client
 }  // namespace geode
 }  // namespace apache
@@ -564,6 +564,12 @@ bool TcrConnection::InitTcrConnection(
   return false;
 }
 
+ACE_HANDLE TcrConnection::getHandle() {
+  // m_conn is created by createConnection() below
+  return m_conn == nullptr ? ACE_INVALID_HANDLE
+                           : static_cast<TcpConn*>(m_conn)->getHandle();
+}
+
 Connector* TcrConnection::createConnection(const char* endpoint,
                                            uint32_t connectTimeout,
                                            int32_t maxBuffSizePool) {
@@ -683,12 +689,13 @@ inline ConnErrType TcrConnection::sendData(const char* buffer, int32_t length,
   return sendData(dummy, buffer, length, sendTimeoutSec, checkConnected);
 }
 
-inline ConnErrType TcrConnection::sendData(uint32_t& timeSpent,
-                                           const char* buffer, int32_t length,
-                                           uint32_t sendTimeoutSec,
-                                           bool checkConnected,
-                                           int32_t notPublicApiWithTimeout) {
-  GF_DEV_ASSERT(buffer != nullptr);
+ConnErrType TcrConnection::sendData(uint32_t& timeSpent, iovec* segments,
+                                    int32_t count, int32_t length,
+                                    uint32_t sendTimeoutSec,
+                                    bool checkConnected,
+                                    int32_t notPublicApiWithTimeout,
+                                    int32_t* writes) {
+  GF_DEV_ASSERT(segments != nullptr);
   GF_DEV_ASSERT(m_conn != nullptr);
   bool isPublicApiTimeout = false;
   // if gfcpp property unit set then sendTimeoutSec will be in millisecond
@@ -734,10 +741,26 @@ inline ConnErrType TcrConnection::sendData(uint32_t& timeSpent,
     if (sendTimeoutSec < defaultWaitSecs) {
       defaultWaitSecs = sendTimeoutSec;
     }
-    int32_t sentBytes = m_conn->send(buffer, length, defaultWaitSecs, 0);
+    int32_t sentBytes =
+        count == 1
+            ? m_conn->send(static_cast<const char*>(segments->iov_base),
+                           length, defaultWaitSecs, 0)
+            : m_conn->sendv(segments, count, defaultWaitSecs, 0);
+    if (writes != nullptr) {
+      ++*writes;
+    }
 
     length -= sentBytes;
-    buffer += sentBytes;
+    // drop the segments that went out and trim the one sent partially
+    while (count > 0 && static_cast<size_t>(sentBytes) >= segments->iov_len) {
+      sentBytes -= static_cast<int32_t>(segments->iov_len);
+      segments++;
+      count--;
+    }
+    if (count > 0) {
+      segments->iov_base = static_cast<char*>(segments->iov_base) + sentBytes;
+      segments->iov_len -= sentBytes;
+    }
     // we don't want to decrement the remaining time for the last iteration
     if (length == 0) {
       break;
@@ -758,6 +781,19 @@ inline ConnErrType TcrConnection::sendData(uint32_t& timeSpent,
   return (length == 0 ? CONN_NOERR : CONN_TIMEOUT);
 }
 
+inline ConnErrType TcrConnection::sendData(uint32_t& timeSpent,
+                                           const char* buffer, int32_t length,
+                                           uint32_t sendTimeoutSec,
+                                           bool checkConnected,
+                                           int32_t notPublicApiWithTimeout) {
+  GF_DEV_ASSERT(buffer != nullptr);
+  iovec segment;
+  segment.iov_base = const_cast<char*>(buffer);
+  segment.iov_len = length;
+  return sendData(timeSpent, &segment, 1, length, sendTimeoutSec,
+                  checkConnected, notPublicApiWithTimeout);
+}
+
 char* TcrConnection::sendRequest(const char* buffer, int32_t len,
                                  size_t* recvLen, uint32_t sendTimeoutSec,
                                  uint32_t receiveTimeoutSec, int32_t request) {
@@ -775,8 +811,25 @@ char* TcrConnection::sendRequest(const char* buffer, int32_t len,
   return readMessage(recvLen, receiveTimeoutSec, true, &opErr, false, request);
 }
 
+char* TcrConnection::sendRequest(const TcrMessage& request, size_t* recvLen,
+                                 uint32_t sendTimeoutSec,
+                                 uint32_t receiveTimeoutSec) {
+  LOGDEBUG("TcrConnection::sendRequest");
+  uint32_t timeSpent = 0;
+
+  send(timeSpent, request, sendTimeoutSec);
+
+  if (timeSpent >= receiveTimeoutSec)
+    throwException(
+        TimeoutException("TcrConnection::send: connection timed out"));
+
+  receiveTimeoutSec -= timeSpent;
+  ConnErrType opErr = CONN_NOERR;
+  return readMessage(recvLen, receiveTimeoutSec, true, &opErr, false,
+                     request.getMessageType());
+}
+
 void TcrConnection::sendRequestForChunkedResponse(const TcrMessage& request,
-                                                  int32_t len,
                                                   TcrMessageReply& reply,
                                                   uint32_t sendTimeoutSec,
                                                   uint32_t receiveTimeoutSec) {
@@ -831,7 +884,7 @@ void TcrConnection::sendRequestForChunkedResponse(const TcrMessage& request,
 
   // send(buffer, len, sendTimeoutSec);
   uint32_t timeSpent = 0;
-  send(timeSpent, request.getMsgData(), len, sendTimeoutSec, true, msgType);
+  send(timeSpent, request, sendTimeoutSec, true, msgType);
 
   if (timeSpent >= receiveTimeoutSec)
     throwException(
@@ -882,6 +935,80 @@ void TcrConnection::send(uint32_t& timeSpent, const char* buffer, int len,
       "with error: %d",
       m_endpoint, error);
 
+  checkSendError(error);
+}
+
+void TcrConnection::send(uint32_t& timeSpent, const TcrMessage& request,
+                         uint32_t sendTimeoutSec, bool checkConnected,
+                         int32_t notPublicApiWithTimeout) {
+  GF_DEV_ASSERT(m_conn != nullptr);
+
+  int32_t len = static_cast<int32_t>(request.getMsgLength());
+  std::vector<iovec> segments;
+  request.getMsgSegments(segments);
+  if (segments.size() <= 1) {
+    // nothing referenced, the request is one contiguous buffer
+    send(timeSpent, request.getMsgData(), len, sendTimeoutSec, checkConnected,
+         notPublicApiWithTimeout);
+    return;
+  }
+
+  LOGDEBUG(
+      "TcrConnection::send: [%p] sending request to endpoint %s; %d bytes "
+      "in %d segments",
+      this, m_endpoint, len, static_cast<int32_t>(segments.size()));
+
+  ConnErrType error = sendData(
+      timeSpent, segments.data(), static_cast<int32_t>(segments.size()), len,
+      sendTimeoutSec, checkConnected, notPublicApiWithTimeout);
+
+  LOGFINER(
+      "TcrConnection::send: completed send request to endpoint %s "
+      "with error: %d",
+      m_endpoint, error);
+
+  checkSendError(error);
+}
+
+void TcrConnection::send(uint32_t& timeSpent,
+                         const std::vector<const TcrMessage*>& requests,
+                         uint32_t sendTimeoutSec) {
+  GF_DEV_ASSERT(m_conn != nullptr);
+  GF_DEV_ASSERT(!requests.empty());
+
+  int32_t len = 0;
+  std::vector<iovec> segments;
+  std::vector<iovec> requestSegments;
+  for (const auto request : requests) {
+    request->getMsgSegments(requestSegments);
+    segments.insert(segments.end(), requestSegments.begin(),
+                    requestSegments.end());
+    len += static_cast<int32_t>(request->getMsgLength());
+  }
+
+  LOGDEBUG(
+      "TcrConnection::send: [%p] sending %d requests to endpoint %s; %d "
+      "bytes in %d segments",
+      this, static_cast<int32_t>(requests.size()), m_endpoint, len,
+      static_cast<int32_t>(segments.size()));
+
+  int32_t writes = 0;
+  ConnErrType error =
+      sendData(timeSpent, segments.data(),
+               static_cast<int32_t>(segments.size()), len, sendTimeoutSec,
+               true, -2 /*NOT_PUBLIC_API_WITH_TIMEOUT*/, &writes);
+  m_connectionManager->getCacheImpl()->getCachePerfStats().incPipelinedWrites(
+      static_cast<int64_t>(requests.size()), writes);
+
+  LOGFINER(
+      "TcrConnection::send: completed send of %d requests to endpoint %s "
+      "with error: %d",
+      static_cast<int32_t>(requests.size()), m_endpoint, error);
+
+  checkSendError(error);
+}
+
+void TcrConnection::checkSendError(ConnErrType error) {
   if (error != CONN_NOERR) {
     if (error == CONN_TIMEOUT) {
       throwException(
@@ -894,16 +1021,81 @@ void TcrConnection::send(uint32_t& timeSpent, const char* buffer, int len,
 }
 
 char* TcrConnection::receive(size_t* recvLen, ConnErrType* opErr,
-                             uint32_t receiveTimeoutSec) {
+                             uint32_t receiveTimeoutSec,
+                             uint32_t bodyTimeoutSec) {
   GF_DEV_ASSERT(m_conn != nullptr);
 
-  return readMessage(recvLen, receiveTimeoutSec, false, opErr, true);
+  return readMessage(recvLen, receiveTimeoutSec, false, opErr, true, -1,
+                     bodyTimeoutSec);
+}
+
+char* TcrConnection::receiveNoWait(size_t* recvLen, ConnErrType* opErr) {
+  GF_DEV_ASSERT(m_conn != nullptr);
+  TcpConn* conn = static_cast<TcpConn*>(m_conn);
+
+  while (true) {
+    char* buffer;
+    int32_t wanted;
+    if (m_partialMessage == nullptr) {
+      buffer = m_partialHeader + m_partialRead;
+      wanted = HEADER_LENGTH - m_partialRead;
+    } else {
+      buffer = m_partialMessage + m_partialRead;
+      wanted = m_partialLength - m_partialRead;
+    }
+    if (wanted > 0) {
+      int32_t read = conn->receiveAvailable(buffer, wanted);
+      if (read < 0) {
+        delete[] m_partialMessage;
+        m_partialMessage = nullptr;
+        m_partialRead = 0;
+        *opErr = CONN_IOERR;
+        return nullptr;
+      }
+      if (read == 0) {
+        return nullptr;
+      }
+      m_partialRead += read;
+      if (read < wanted) {
+        continue;
+      }
+    }
+
+    if (m_partialMessage == nullptr) {
+      int32_t msgType, msgLen;
+      auto input =
+          m_connectionManager->getCacheImpl()->getCache()->createDataInput(
+              reinterpret_cast<uint8_t*>(m_partialHeader), HEADER_LENGTH);
+      input->readInt(&msgType);
+      input->readInt(&msgLen);
+      if (msgLen < 0) {
+        LOGERROR(
+            "TcrConnection::receiveNoWait: invalid message length %d from "
+            "endpoint %s",
+            msgLen, m_endpoint);
+        m_partialRead = 0;
+        *opErr = CONN_IOERR;
+        return nullptr;
+      }
+      m_partialLength = HEADER_LENGTH + msgLen;
+      GF_NEW(m_partialMessage, char[m_partialLength]);
+      ACE_OS::memcpy(m_partialMessage, m_partialHeader, HEADER_LENGTH);
+    }
+    if (m_partialRead == m_partialLength) {
+      // user has to delete this pointer
+      char* fullMessage = m_partialMessage;
+      *recvLen = m_partialLength;
+      m_partialMessage = nullptr;
+      m_partialRead = 0;
+      return fullMessage;
+    }
+  }
 }
 
 char* TcrConnection::readMessage(size_t* recvLen, uint32_t receiveTimeoutSec,
                                  bool doHeaderTimeoutRetries,
                                  ConnErrType* opErr, bool isNotificationMessage,
-                                 int32_t request) {
+                                 int32_t request, uint32_t bodyTimeoutSec) {
   char msg_header[HEADER_LENGTH];
   int32_t msgType, msgLen;
   ConnErrType error;
@@ -975,7 +1167,9 @@ char* TcrConnection::readMessage(size_t* recvLen, uint32_t receiveTimeoutSec,
   ACE_OS::memcpy(fullMessage, msg_header, HEADER_LENGTH);
 
   uint32_t mesgBodyTimeout = receiveTimeoutSec;
-  if (isNotificationMessage) {
+  if (bodyTimeoutSec > 0) {
+    mesgBodyTimeout = bodyTimeoutSec;
+  } else if (isNotificationMessage) {
     mesgBodyTimeout = receiveTimeoutSec * DEFAULT_TIMEOUT_RETRIES;
   }
   error = receiveData(fullMessage + HEADER_LENGTH, msgLen, mesgBodyTimeout,
@@ -1162,8 +1356,8 @@ void TcrConnection::readMessageChunked(TcrMessageReply& reply,
         "from endpoint %s; bytes: %s",
         chunkNum, m_endpoint,
         Utils::convertBytesToString(chunk_body, chunkLen)->asChar());
-    // Process the chunk; the actual processing is done by a separate thread
-    // ThinClientBaseDM::m_chunkProcessor.
+    // Process the chunk; the actual processing is done by the threads
+    // ThinClientBaseDM::m_chunkProcessors, while this one reads on.
 
     reply.processChunk(chunk_body, chunkLen,
                        m_endpointObj->getDistributedMemberID(), isLastChunk);
@@ -1554,6 +1748,7 @@ TcrConnection::~TcrConnection() {
     m_dh->clearDhKeys();
     GF_SAFE_DELETE(m_dh);
   }
+  delete[] m_partialMessage;
 }
 
 bool TcrConnection::setAndGetBeingUsed(volatile bool isBeingUsed,
@@ -21,6 +21,7 @@
  */
 
 #include <atomic>
+#include <vector>
 #include <ace/Semaphore.h>
 #include <geode/geode_globals.hpp>
 #include <geode/ExceptionTypes.hpp>
@@ -127,7 +128,10 @@ class CPPCACHE_EXPORT TcrConnection {
         m_chunksProcessSema(0),
         m_isBeingUsed(false),
         m_isUsed(0),
-        m_poolDM(nullptr) {}
+        m_poolDM(nullptr),
+        m_partialRead(0),
+        m_partialLength(0),
+        m_partialMessage(nullptr) {}
 
   /* destroy the connection */
   ~TcrConnection();
@@ -165,11 +169,19 @@ class CPPCACHE_EXPORT TcrConnection {
                     uint32_t receiveTimeoutSec = DEFAULT_READ_TIMEOUT_SECS,
                     int32_t request = -1);
 
+  /**
+   * send a synchronized request message to server, as above. Large values
+   * referenced by the message are written straight from the application's
+   * buffers with a gathering write.
+   */
+  char* sendRequest(const TcrMessage& request, size_t* recvLen,
+                    uint32_t sendTimeoutSec = DEFAULT_WRITE_TIMEOUT,
+                    uint32_t receiveTimeoutSec = DEFAULT_READ_TIMEOUT_SECS);
+
   /**
    * send a synchronized request to server for REGISTER_INTEREST_LIST.
    *
-   * @param      buffer the buffer to send
-   *             len length of the data to send
+   * @param      request the request message to send
    *             message vector, which will return chunked TcrMessage.
    *             sendTimeoutSec write timeout in sec
    *             receiveTimeoutSec read timeout in sec
@@ -178,7 +190,7 @@ class CPPCACHE_EXPORT TcrConnection {
    * operation: 1 write, 2 read
    */
   void sendRequestForChunkedResponse(
-      const TcrMessage& request, int32_t len, TcrMessageReply& message,
+      const TcrMessage& request, TcrMessageReply& message,
       uint32_t sendTimeoutSec = DEFAULT_WRITE_TIMEOUT,
       uint32_t receiveTimeoutSec = DEFAULT_READ_TIMEOUT_SECS);
 
@@ -204,19 +216,43 @@ class CPPCACHE_EXPORT TcrConnection {
       bool checkConnected = true,
       int32_t notPublicApiWithTimeout = -2 /*NOT_PUBLIC_API_WITH_TIMEOUT*/);
 
+  void send(
+      uint32_t& timeSpent, const TcrMessage& request,
+      uint32_t sendTimeoutSec = DEFAULT_WRITE_TIMEOUT,
+      bool checkConnected = true,
+      int32_t notPublicApiWithTimeout = -2 /*NOT_PUBLIC_API_WITH_TIMEOUT*/);
+
+  /**
+   * Sends the requests back to back with a single gathering write, as far as
+   * the socket takes them at once.
+   */
+  void send(uint32_t& timeSpent, const std::vector<const TcrMessage*>& requests,
+            uint32_t sendTimeoutSec = DEFAULT_WRITE_TIMEOUT);
+
   /**
    * This method is for receiving client notification. It will read 2 times as
    * reading reply in sendRequest()
    *
    * @param      recvLen output parameter for length of the received message
    * @param      receiveTimeoutSec read timeout in sec
+   * @param      bodyTimeoutSec read timeout of the message body once its
+   *             header came, 0 for several times receiveTimeoutSec
    * @return     byte arrary of response. '0' ended.
    * @exception  GeodeIOException  if an I/O error occurs (socket failure).
    * @exception  TimeoutException  if timeout happens at any of the 3 socket
    * operation: 1 write, 2 read
    */
   char* receive(size_t* recvLen, ConnErrType* opErr,
-                uint32_t receiveTimeoutSec = DEFAULT_READ_TIMEOUT_SECS);
+                uint32_t receiveTimeoutSec = DEFAULT_READ_TIMEOUT_SECS,
+                uint32_t bodyTimeoutSec = 0);
+
+  /**
+   * Reads what the subscription channel has without waiting, for a reader
+   * called whenever the connection has data; see getHandle(). Returns the
+   * message once it is read in full, nullptr before that; sets opErr to
+   * CONN_IOERR once the connection is closed.
+   */
+  char* receiveNoWait(size_t* recvLen, ConnErrType* opErr);
 
   //  readMessage is now public
   /**
@@ -225,13 +261,16 @@ class CPPCACHE_EXPORT TcrConnection {
    * @param      recvLen output parameter for length of the received message
    * @param      receiveTimeoutSec read timeout in seconds
    * @param      doHeaderTimeoutRetries retry when header receive times out
+   * @param      bodyTimeoutSec read timeout of the message body, 0 to derive
+   *             it from receiveTimeoutSec
    * @return     byte array of response. '0' ended.
    * @exception  GeodeIOException  if an I/O error occurs (socket failure).
    * @exception  TimeoutException  if timeout happens during read
    */
   char* readMessage(size_t* recvLen, uint32_t receiveTimeoutSec,
                     bool doHeaderTimeoutRetries, ConnErrType* opErr,
-                    bool isNotificationMessage = false, int32_t request = -1);
+                    bool isNotificationMessage = false, int32_t request = -1,
+                    uint32_t bodyTimeoutSec = 0);
 
   /**
    * This method reads an interest list response  message from the socket
@@ -259,6 +298,9 @@ class CPPCACHE_EXPORT TcrConnection {
 
   uint16_t inline getPort() { return m_port; }
 
+  /** the socket for an IoReactor to wait on, see TcpConn::getHandle() */
+  ACE_HANDLE getHandle();
+
   TcrEndpoint* getEndpointObject() const { return m_endpointObj; }
   bool isBeingUsed() { return m_isBeingUsed; }
   bool setAndGetBeingUsed(
@@ -385,6 +427,22 @@ class CPPCACHE_EXPORT TcrConnection {
       uint32_t sendTimeoutSec, bool checkConnected = true,
       int32_t notPublicApiWithTimeout = -2 /*NOT_PUBLIC_API_WITH_TIMEOUT*/);
 
+  /**
+   * Send length bytes gathered from count segments; the segments are
+   * consumed as they are written. Adds the socket writes it took to writes,
+   * if given.
+   */
+  ConnErrType sendData(
+      uint32_t& timeSpent, iovec* segments, int32_t count, int32_t length,
+      uint32_t sendTimeoutSec, bool checkConnected = true,
+      int32_t notPublicApiWithTimeout = -2 /*NOT_PUBLIC_API_WITH_TIMEOUT*/,
+      int32_t* writes = nullptr);
+
+  /**
+   * Throw the exception for a failed send, if any.
+   */
+  void checkSendError(ConnErrType error);
+
   /**
    * Read data from the connection till receiveTimeoutSec
    */
@@ -411,6 +469,14 @@ class CPPCACHE_EXPORT TcrConnection {
   volatile bool m_isBeingUsed;
   std::atomic<uint32_t> m_isUsed;
   ThinClientPoolDM* m_poolDM;
+
+  // the message receiveNoWait() has read in part: the header, then the
+  // message with its header once the length is known
+  static const int32_t PARTIAL_HEADER_LENGTH = 17;
+  char m_partialHeader[PARTIAL_HEADER_LENGTH];
+  int32_t m_partialRead;
+  int32_t m_partialLength;
+  char* m_partialMessage;
 };
 }  // namespace client
 }  // namespace geode
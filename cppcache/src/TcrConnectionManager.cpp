@@ -31,6 +31,8 @@
 #include "RemoteQueryService.hpp"
 #include "ThinClientLocatorHelper.hpp"
 #include "ServerLocation.hpp"
+#include "NotificationDispatcher.hpp"
+#include "NotificationProcessor.hpp"
 #include <ace/INET_Addr.h>
 #include <set>
 #include <thread>
@@ -59,7 +61,10 @@ TcrConnectionManager::TcrConnectionManager(CacheImpl *cache)
       m_redundancySema(0),
       m_redundancyTask(nullptr),
       m_isDurable(false),
-      m_isNetDown(false) {
+      m_isNetDown(false),
+      m_ioReactor(nullptr),
+      m_notificationProcessor(new NotificationProcessor()),
+      m_notificationDispatcher(nullptr) {
   m_redundancyManager = new ThinClientRedundancyManager(this);
 }
 
@@ -183,6 +188,14 @@ void TcrConnectionManager::close() {
 
     removeHAEndpoints();
   }
+
+  m_notificationProcessor->stop();
+  // events queued are dispatched before the regions go, the processor is
+  // stopped already; none is started after this
+  std::call_once(m_notificationDispatcherOnce, [] {});
+  if (m_notificationDispatcher != nullptr) {
+    m_notificationDispatcher->stop();
+  }
   LOGFINE("TcrConnectionManager is closed");
 }
 
@@ -219,9 +232,34 @@ TcrConnectionManager::~TcrConnectionManager() {
       }
     }
   }
+  // the endpoints and pools have stopped reading their connections by now
+  delete m_ioReactor;
+  delete m_notificationProcessor;
+  delete m_notificationDispatcher;
   TcrConnectionManager::TEST_DURABLE_CLIENT_CRASH = false;
 }
 
+IoReactor *TcrConnectionManager::getIoReactor() {
+  std::call_once(m_ioReactorOnce, [this] {
+    m_ioReactor = new IoReactor(
+        m_cache->getDistributedSystem().getSystemProperties().ioThreads());
+  });
+  return m_ioReactor;
+}
+
+NotificationDispatcher *TcrConnectionManager::getNotificationDispatcher() {
+  std::call_once(m_notificationDispatcherOnce, [this] {
+    uint32_t threads = m_cache->getDistributedSystem()
+                           .getSystemProperties()
+                           .notificationDispatchThreads();
+    if (threads > 0) {
+      m_notificationDispatcher = new NotificationDispatcher(threads);
+      m_notificationDispatcher->start();
+    }
+  });
+  return m_notificationDispatcher;
+}
+
 void TcrConnectionManager::connect(
     ThinClientBaseDM *distMng, std::vector<TcrEndpoint *> &endpoints,
     const std::unordered_set<std::string> &endpointStrs) {
@@ -522,7 +560,7 @@ int TcrConnectionManager::redundancy(volatile bool &isRunning) {
 }
 
 void TcrConnectionManager::addNotificationForDeletion(
-    Task<TcrEndpoint> *notifyReceiver, TcrConnection *notifyConnection,
+    ReactorTask<TcrEndpoint> *notifyReceiver, TcrConnection *notifyConnection,
     ACE_Semaphore &notifyCleanupSema) {
   ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_notificationLock);
   m_connectionReleaseList.put(notifyConnection);
@@ -556,7 +594,7 @@ int TcrConnectionManager::cleanup(volatile bool &isRunning) {
 }
 
 void TcrConnectionManager::cleanNotificationLists() {
-  Task<TcrEndpoint> *notifyReceiver;
+  ReactorTask<TcrEndpoint> *notifyReceiver;
   TcrConnection *notifyConnection;
   ACE_Semaphore *notifyCleanupSema;
 
@@ -29,11 +29,13 @@
 #include <vector>
 #include <unordered_map>
 #include <list>
+#include <mutex>
 #include "ace/config-lite.h"
 #include "ace/Versioned_Namespace.h"
 #include "Queue.hpp"
 #include "EventIdMap.hpp"
 #include "ThinClientRedundancyManager.hpp"
+#include "ReactorTask.hpp"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Task_Base;
@@ -46,6 +48,8 @@ class TcrConnection;
 class TcrEndpoint;
 class TcrMessage;
 class CacheImpl;
+class NotificationDispatcher;
+class NotificationProcessor;
 class ThinClientBaseDM;
 class ThinClientRegion;
 
@@ -91,7 +95,7 @@ class CPPCACHE_EXPORT TcrConnectionManager {
                                        TcrMessageReply* reply);
   GfErrType sendSyncRequestCq(TcrMessage& request, TcrMessageReply& reply);
 
-  void addNotificationForDeletion(Task<TcrEndpoint>* notifyReceiver,
+  void addNotificationForDeletion(ReactorTask<TcrEndpoint>* notifyReceiver,
                                   TcrConnection* notifyConnection,
                                   ACE_Semaphore& notifyCleanupSema);
 
@@ -141,6 +145,26 @@ class CPPCACHE_EXPORT TcrConnectionManager {
 
   bool isNetDown() const { return m_isNetDown; }
 
+  /**
+   * The reactor that reads the subscription channels and pipelined
+   * connections of the cache, started on first use.
+   */
+  IoReactor* getIoReactor();
+
+  /**
+   * The thread that processes the messages the subscription channels read,
+   * started on first use.
+   */
+  NotificationProcessor& getNotificationProcessor() {
+    return *m_notificationProcessor;
+  }
+
+  /**
+   * The pool that dispatches the events of the subscription channels, started
+   * on first use; nullptr if the events are dispatched as they are read.
+   */
+  NotificationDispatcher* getNotificationDispatcher();
+
  private:
   CacheImpl* m_cache;
   volatile bool m_initGuard;
@@ -167,7 +191,7 @@ class CPPCACHE_EXPORT TcrConnectionManager {
 
   long m_pingTaskId;
   long m_servermonitorTaskId;
-  Queue<Task<TcrEndpoint> > m_receiverReleaseList;
+  Queue<ReactorTask<TcrEndpoint> > m_receiverReleaseList;
   Queue<TcrConnection> m_connectionReleaseList;
   Queue<ACE_Semaphore> m_notifyCleanupSemaList;
 
@@ -180,6 +204,14 @@ class CPPCACHE_EXPORT TcrConnectionManager {
 
   ThinClientRedundancyManager* m_redundancyManager;
 
+  IoReactor* m_ioReactor;
+  std::once_flag m_ioReactorOnce;
+
+  NotificationProcessor* m_notificationProcessor;
+
+  NotificationDispatcher* m_notificationDispatcher;
+  std::once_flag m_notificationDispatcherOnce;
+
   int failover(volatile bool& isRunning);
   int redundancy(volatile bool& isRunning);
 
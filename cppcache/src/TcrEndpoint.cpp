@@ -23,6 +23,8 @@
 #include "CacheImpl.hpp"
 #include "Utils.hpp"
 #include "DistributedSystemImpl.hpp"
+#include "NotificationDispatcher.hpp"
+#include "NotificationProcessor.hpp"
 
 #include <thread>
 #include <chrono>
@@ -111,6 +113,9 @@ TcrEndpoint::~TcrEndpoint() {
     m_notificationCleanupSema.acquire();
     m_notifyCount--;
   }
+  // the readers are gone, the messages they read must not outlive this
+  m_cacheImpl->tcrConnectionManager().getNotificationProcessor().removeEndpoint(
+      this);
   LOGFINE("Connection to %s deleted", m_name.c_str());
 }
 
@@ -487,9 +492,13 @@ GfErrType TcrEndpoint::registerDM(bool clientNotification, bool isSecondary,
                   m_name.c_str());
           return err;
         }
-        m_notifyReceiver = new Task<TcrEndpoint>(
-            this, &TcrEndpoint::receiveNotification, NC_Notification);
+        m_notifyReceiver = new ReactorTask<TcrEndpoint>(
+            this, &TcrEndpoint::receiveNotification,
+            m_cacheImpl->tcrConnectionManager().getIoReactor(),
+            m_notifyConnection->getHandle(), NC_Notification);
         m_notifyReceiver->start();
+        LOGFINE("Started subscription channel for endpoint %s",
+                m_name.c_str());
       }
       ++m_numRegionListener;
       LOGFINEST("Incremented notification region count for endpoint %s to %d",
@@ -594,13 +603,18 @@ bool TcrEndpoint::checkDupAndAdd(EventIdPtr eventid) {
 }
 
 int TcrEndpoint::receiveNotification(volatile bool& isRunning) {
-  LOGFINE("Started subscription channel for endpoint %s", m_name.c_str());
-  while (isRunning) {
-    TcrMessageReply* msg = nullptr;
-    try {
+  // on the threads of the IoReactor the channel is read without waiting; an
+  // SSL channel has no handle to wait on and is read on a thread of its own
+  bool noWait = m_notifyConnection->getHandle() != ACE_INVALID_HANDLE;
+  NotificationProcessor& processor =
+      m_cacheImpl->tcrConnectionManager().getNotificationProcessor();
+  TcrMessageReply* msg = nullptr;
+  try {
+    for (int i = 0; i < MAX_NOTIFICATIONS_PER_READ && isRunning; i++) {
       size_t dataLen;
       ConnErrType opErr = CONN_NOERR;
-      auto data = m_notifyConnection->receive(&dataLen, &opErr, 5);
+      char* data = noWait ? m_notifyConnection->receiveNoWait(&dataLen, &opErr)
+                          : m_notifyConnection->receive(&dataLen, &opErr, 5);
 
       if (opErr == CONN_IOERR) {
         // Endpoint is disconnected, this exception is expected
@@ -616,133 +630,172 @@ int TcrEndpoint::receiveNotification(volatile bool& isRunning) {
             closeNotification();
           }
         }
-        break;
+        return -1;
       }
 
-      if (data) {
-        msg = new TcrMessageReply(true, m_baseDM);
-        msg->initCqMap();
-        msg->setData(data, static_cast<int32_t>(dataLen),
-                     this->getDistributedMemberID(),
-                     *(m_cacheImpl->getSerializationRegistry()),
-                     *(m_cacheImpl->getMemberListForVersionStamp()));
-        handleNotificationStats(static_cast<int64_t>(dataLen));
-        LOGDEBUG("receive notification %d", msg->getMessageType());
-
-        if (!isRunning) {
-          GF_SAFE_DELETE(msg);
-          break;
-        }
+      if (data == nullptr) {
+        // all there is has been read
+        return 0;
+      }
 
-        if (msg->getMessageType() == TcrMessage::SERVER_TO_CLIENT_PING) {
-          LOGFINE("Received ping from server subscription channel.");
-        }
+      msg = new TcrMessageReply(true, m_baseDM);
+      msg->initCqMap();
+      msg->setData(data, static_cast<int32_t>(dataLen),
+                   this->getDistributedMemberID(),
+                   *(m_cacheImpl->getSerializationRegistry()),
+                   *(m_cacheImpl->getMemberListForVersionStamp()));
+      handleNotificationStats(static_cast<int64_t>(dataLen));
+      LOGDEBUG("receive notification %d", msg->getMessageType());
+
+      if (!isRunning) {
+        GF_SAFE_DELETE(msg);
+        return -1;
+      }
 
-        // ignore some message types like REGISTER_INSTANTIATORS
-        if (msg->shouldIgnore()) {
-          GF_SAFE_DELETE(msg);
-          continue;
-        }
+      if (msg->getMessageType() == TcrMessage::SERVER_TO_CLIENT_PING) {
+        LOGFINE("Received ping from server subscription channel.");
+      }
 
-        bool isMarker = (msg->getMessageType() == TcrMessage::CLIENT_MARKER);
-        if (!msg->hasCqPart()) {
-          if (msg->getMessageType() != TcrMessage::CLIENT_MARKER) {
-            const std::string& regionFullPath1 = msg->getRegionName();
-            RegionPtr region1;
-            m_cacheImpl->getRegion(regionFullPath1.c_str(), region1);
-            if (region1 != nullptr &&
-                !static_cast<ThinClientRegion*>(region1.get())
-                     ->getDistMgr()
-                     ->isEndpointAttached(this)) {
-              // drop event before even processing the eventid for duplicate
-              // checking
-              LOGFINER("Endpoint %s dropping event for region %s",
-                       m_name.c_str(), regionFullPath1.c_str());
-              GF_SAFE_DELETE(msg);
-              continue;
-            }
-          }
-        }
+      // ignore some message types like REGISTER_INSTANTIATORS
+      if (msg->shouldIgnore()) {
+        GF_SAFE_DELETE(msg);
+        continue;
+      }
 
-        if (!checkDupAndAdd(msg->getEventId())) {
-          m_dupCount++;
-          if (m_dupCount % 100 == 1) {
-            LOGFINE("Dropped %dst duplicate notification message", m_dupCount);
-          }
-          GF_SAFE_DELETE(msg);
-          continue;
-        }
+      // processed by the processor thread, which deletes it
+      bool room = processor.put(this, msg);
+      msg = nullptr;
+      if (!room) {
+        return ReactorTask<TcrEndpoint>::HOLD;
+      }
+    }
+  } catch (const TimeoutException&) {
+    // If there is no notification, this exception is expected
+    // But this is valid only when *no* data has been received
+    // otherwise if data has been read then TcrConnection will throw
+    // a GeodeIOException which will cause the channel to close.
+    LOGDEBUG(
+        "receiveNotification timed out: no data received from "
+        "endpoint %s",
+        m_name.c_str());
+  } catch (const GeodeIOException& e) {
+    // Endpoint is disconnected, this exception is expected
+    LOGFINER(
+        "IO exception while receiving subscription event for endpoint %s: %s",
+        m_name.c_str(), e.getMessage());
+    if (m_connected) {
+      setConnectionStatus(false);
+      // close notification channel
+      ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_notifyReceiverLock);
+      if (m_numRegionListener > 0) {
+        m_numRegionListener = 0;
+        closeNotification();
+      }
+    }
+    return -1;
+  } catch (const Exception& ex) {
+    GF_SAFE_DELETE(msg);
+    LOGERROR(
+        "Exception while receiving subscription event for endpoint %s:: %s: "
+        "%s",
+        m_name.c_str(), ex.getName(), ex.getMessage());
+  } catch (...) {
+    GF_SAFE_DELETE(msg);
+    LOGERROR(
+        "Unexpected exception while "
+        "receiving subscription event from endpoint %s",
+        m_name.c_str());
+  }
+  return 0;
+}
 
-        if (isMarker) {
-          LOGFINE("Got a marker message on endpont %s", m_name.c_str());
-          m_cacheImpl->processMarker();
-          processMarker();
-          GF_SAFE_DELETE(msg);
+void TcrEndpoint::processNotification(TcrMessageReply* msg) {
+  bool isMarker = (msg->getMessageType() == TcrMessage::CLIENT_MARKER);
+  if (!msg->hasCqPart()) {
+    if (msg->getMessageType() != TcrMessage::CLIENT_MARKER) {
+      const std::string& regionFullPath1 = msg->getRegionName();
+      RegionPtr region1;
+      m_cacheImpl->getRegion(regionFullPath1.c_str(), region1);
+      if (region1 != nullptr &&
+          !static_cast<ThinClientRegion*>(region1.get())
+               ->getDistMgr()
+               ->isEndpointAttached(this)) {
+        // drop event before even processing the eventid for duplicate
+        // checking
+        LOGFINER("Endpoint %s dropping event for region %s",
+                 m_name.c_str(), regionFullPath1.c_str());
+        GF_SAFE_DELETE(msg);
+        return;
+      }
+    }
+  }
+
+  if (!checkDupAndAdd(msg->getEventId())) {
+    m_dupCount++;
+    if (m_dupCount % 100 == 1) {
+      LOGFINE("Dropped %dst duplicate notification message", m_dupCount);
+    }
+    GF_SAFE_DELETE(msg);
+    return;
+  }
+
+  NotificationDispatcher* dispatcher =
+      m_cacheImpl->tcrConnectionManager().getNotificationDispatcher();
+  if (isMarker) {
+    LOGFINE("Got a marker message on endpont %s", m_name.c_str());
+    // the events before the marker are applied before it is processed
+    if (dispatcher != nullptr) {
+      dispatcher->barrier();
+    }
+    m_cacheImpl->processMarker();
+    processMarker();
+    GF_SAFE_DELETE(msg);
+  } else {
+    if (!msg->hasCqPart())  // || msg->isInterestListPassed())
+    {
+      const std::string& regionFullPath = msg->getRegionName();
+      RegionPtr region;
+      m_cacheImpl->getRegion(regionFullPath.c_str(), region);
+      if (region != nullptr) {
+        auto op = [region, msg] {
+          static_cast<ThinClientRegion*>(region.get())
+              ->receiveNotification(msg);
+        };
+        if (dispatcher != nullptr) {
+          dispatcher->dispatch(*msg, op);
         } else {
-          if (!msg->hasCqPart())  // || msg->isInterestListPassed())
-          {
-            const std::string& regionFullPath = msg->getRegionName();
-            RegionPtr region;
-            m_cacheImpl->getRegion(regionFullPath.c_str(), region);
-            if (region != nullptr) {
-              static_cast<ThinClientRegion*>(region.get())
-                  ->receiveNotification(msg);
-            } else {
-              LOGWARN(
-                  "Notification for region %s that does not exist in "
-                  "client cacheImpl.",
-                  regionFullPath.c_str());
-            }
-          } else {
-            LOGDEBUG("receive cq notification %d", msg->getMessageType());
-            QueryServicePtr queryService = getQueryService();
-            if (queryService != nullptr) {
-              static_cast<RemoteQueryService*>(queryService.get())
-                  ->receiveNotification(msg);
-            }
-          }
+          op();
         }
+      } else {
+        LOGWARN(
+            "Notification for region %s that does not exist in "
+            "client cacheImpl.",
+            regionFullPath.c_str());
       }
-    } catch (const TimeoutException&) {
-      // If there is no notification, this exception is expected
-      // But this is valid only when *no* data has been received
-      // otherwise if data has been read then TcrConnection will throw
-      // a GeodeIOException which will cause the channel to close.
-      LOGDEBUG(
-          "receiveNotification timed out: no data received from "
-          "endpoint %s",
-          m_name.c_str());
-    } catch (const GeodeIOException& e) {
-      // Endpoint is disconnected, this exception is expected
-      LOGFINER(
-          "IO exception while receiving subscription event for endpoint %s: %s",
-          m_name.c_str(), e.getMessage());
-      if (m_connected) {
-        setConnectionStatus(false);
-        // close notification channel
-        ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_notifyReceiverLock);
-        if (m_numRegionListener > 0) {
-          m_numRegionListener = 0;
-          closeNotification();
+    } else {
+      LOGDEBUG("receive cq notification %d", msg->getMessageType());
+      QueryServicePtr queryService = getQueryService();
+      if (queryService != nullptr) {
+        auto op = [queryService, msg] {
+          static_cast<RemoteQueryService*>(queryService.get())
+              ->receiveNotification(msg);
+        };
+        if (dispatcher != nullptr) {
+          dispatcher->dispatch(*msg, op);
+        } else {
+          op();
         }
       }
-      break;
-    } catch (const Exception& ex) {
-      GF_SAFE_DELETE(msg);
-      LOGERROR(
-          "Exception while receiving subscription event for endpoint %s:: %s: "
-          "%s",
-          m_name.c_str(), ex.getName(), ex.getMessage());
-    } catch (...) {
-      GF_SAFE_DELETE(msg);
-      LOGERROR(
-          "Unexpected exception while "
-          "receiving subscription event from endpoint %s",
-          m_name.c_str());
     }
   }
-  LOGFINE("Ended subscription channel for endpoint %s", m_name.c_str());
-  return 0;
+}
+
+void TcrEndpoint::resumeNotification() {
+  ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_notifyReceiverLock);
+  // a closed channel has no reader to resume
+  if (m_numRegionListener > 0 && m_notifyReceiver != nullptr) {
+    m_notifyReceiver->resume();
+  }
 }
 
 inline bool TcrEndpoint::compareTransactionIds(int32_t reqTransId,
@@ -847,9 +900,8 @@ GfErrType TcrEndpoint::sendRequestConn(const TcrMessage& request,
     }
     size_t dataLen;
     LOGDEBUG("sendRequestConn: calling sendRequest");
-    auto data = conn->sendRequest(request.getMsgData(), request.getMsgLength(),
-                                  &dataLen, request.getTimeout(),
-                                  reply.getTimeout(), request.getMessageType());
+    auto data = conn->sendRequest(request, &dataLen, request.getTimeout(),
+                                  reply.getTimeout());
     reply.setMessageTypeRequest(type);
     reply.setData(
         data, static_cast<int32_t>(dataLen), this->getDistributedMemberID(),
@@ -1254,8 +1306,9 @@ void TcrEndpoint::sendNotificationCloseMsg()
 
 void TcrEndpoint::closeNotification() {
   LOGFINEST("Closing subscription channel for endpoint %s", m_name.c_str());
-  m_notifyConnection->close();
+  // leave the reactor before the socket goes away
   m_notifyReceiver->stopNoblock();
+  m_notifyConnection->close();
   TcrConnectionManager& tccm = m_cacheImpl->tcrConnectionManager();
   tccm.addNotificationForDeletion(m_notifyReceiver, m_notifyConnection,
                                   m_notificationCleanupSema);
@@ -1270,8 +1323,8 @@ void TcrEndpoint::closeNotification() {
 
 void TcrEndpoint::stopNoBlock() {
   if (m_notifyReceiver != nullptr) {
-    m_notifyConnection->close();
     m_notifyReceiver->stopNoblock();
+    m_notifyConnection->close();
   }
 }
 
@@ -1284,7 +1337,7 @@ void TcrEndpoint::stopNotifyReceiverAndCleanup() {
     // m_notifyReceiver->stopNoblock();
     m_notifyReceiver->wait();
     bool found = false;
-    for (std::list<Task<TcrEndpoint>*>::iterator it =
+    for (std::list<ReactorTask<TcrEndpoint>*>::iterator it =
              m_notifyReceiverList.begin();
          it != m_notifyReceiverList.end(); it++) {
       if (*it == m_notifyReceiver) {
@@ -1304,7 +1357,7 @@ void TcrEndpoint::stopNotifyReceiverAndCleanup() {
   if (m_notifyReceiverList.size() > 0) {
     LOGFINER("TcrEndpoint::stopNotifyReceiverAndCleanup: notifylist size = %d",
              m_notifyReceiverList.size());
-    for (std::list<Task<TcrEndpoint>*>::iterator it =
+    for (std::list<ReactorTask<TcrEndpoint>*>::iterator it =
              m_notifyReceiverList.begin();
          it != m_notifyReceiverList.end(); it++) {
       LOGFINER(
@@ -1348,7 +1401,7 @@ QueryServicePtr TcrEndpoint::getQueryService() {
 void TcrEndpoint::sendRequestForChunkedResponse(const TcrMessage& request,
                                                 TcrMessageReply& reply,
                                                 TcrConnection* conn) {
-  conn->sendRequestForChunkedResponse(request, request.getMsgLength(), reply);
+  conn->sendRequestForChunkedResponse(request, reply);
 }
 void TcrEndpoint::closeFailedConnection(TcrConnection*& conn) {
   closeConnection(conn);
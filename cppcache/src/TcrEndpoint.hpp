@@ -30,7 +30,7 @@
 #include "FairQueue.hpp"
 #include "Set.hpp"
 #include "TcrConnection.hpp"
-#include "Task.hpp"
+#include "ReactorTask.hpp"
 
 namespace apache {
 namespace geode {
@@ -66,7 +66,15 @@ class CPPCACHE_EXPORT TcrEndpoint {
   // void unregisterPoolDM(  );
 
   void pingServer(ThinClientPoolDM* poolDM = nullptr);
+  // reads the messages the subscription channel has and queues them to the
+  // NotificationProcessor, returns -1 once the channel is closed
   int receiveNotification(volatile bool& isRunning);
+  // applies a message of the subscription channel, on the thread of the
+  // NotificationProcessor
+  void processNotification(TcrMessageReply* msg);
+  // reads the subscription channel again once the NotificationProcessor has
+  // room
+  void resumeNotification();
   GfErrType send(const TcrMessage& request, TcrMessageReply& reply);
   GfErrType sendRequestConn(const TcrMessage& request, TcrMessageReply& reply,
                             TcrConnection* conn, std::string& failReason);
@@ -197,10 +205,10 @@ class CPPCACHE_EXPORT TcrEndpoint {
   void closeConnection(TcrConnection*& conn);
   virtual void handleNotificationStats(int64_t byteLength){};
   virtual void closeNotification();
-  std::list<Task<TcrEndpoint>*> m_notifyReceiverList;
+  std::list<ReactorTask<TcrEndpoint>*> m_notifyReceiverList;
   std::list<TcrConnection*> m_notifyConnectionList;
   TcrConnection* m_notifyConnection;
-  Task<TcrEndpoint>* m_notifyReceiver;
+  ReactorTask<TcrEndpoint>* m_notifyReceiver;
   int m_numRegionListener;
   bool m_isQueueHosted;
   ACE_Recursive_Thread_Mutex m_notifyReceiverLock;
@@ -209,6 +217,10 @@ class CPPCACHE_EXPORT TcrEndpoint {
   CacheImpl* m_cacheImpl;
 
  private:
+  // the messages read from the subscription channel at most before the
+  // reader lets the IoReactor serve other connections
+  static const int MAX_NOTIFICATIONS_PER_READ = 64;
+
   int64_t m_uniqueId;
   bool m_isAuthenticated;
   ACE_Recursive_Thread_Mutex m_endpointAuthenticationLock;
@@ -40,6 +40,9 @@ static const uint32_t REGULAR_EXPRESSION =
 
 namespace {
 uint32_t g_headerLen = 17;
+// byte array values at least this large are sent from the application's
+// buffer instead of being copied into the request
+int32_t g_minReferencedBytes = 64 * 1024;
 }  // namespace
 
 // AtomicInc TcrMessage::m_transactionId = 0;
@@ -586,6 +589,7 @@ void TcrMessage::writeObjectPart(const SerializablePtr& se, bool isDelta,
   }
 
   uint32_t sizeBeforeWritingObj = m_request->getBufferLength();
+  uint32_t referencedBeforeWritingObj = m_request->getReferencedLength();
   if (isDelta) {
     auto deltaPtr = std::dynamic_pointer_cast<Delta>(se);
     deltaPtr->toDelta(*m_request);
@@ -609,15 +613,23 @@ void TcrMessage::writeObjectPart(const SerializablePtr& se, bool isDelta,
       se->toData(*m_request);
     }
   } else {
-    // TODO::
-    // CacheableBytes* rawByteArray = static_cast<CacheableBytes*>(se.get());
-    // m_request->writeBytesOnly(rawByteArray->value(), rawByteArray->length());
-    writeBytesOnly(se);
+    auto rawByteArray = std::dynamic_pointer_cast<CacheableBytes>(se);
+    if (rawByteArray != nullptr &&
+        rawByteArray->length() >= g_minReferencedBytes) {
+      m_request->writeBytesReference(
+          rawByteArray->value(),
+          static_cast<uint32_t>(rawByteArray->length()), rawByteArray);
+    } else {
+      writeBytesOnly(se);
+    }
   }
   uint32_t sizeAfterWritingObj = m_request->getBufferLength();
   uint32_t sizeOfSerializedObj = sizeAfterWritingObj - sizeBeforeWritingObj;
+  uint32_t referencedSize =
+      m_request->getReferencedLength() - referencedBeforeWritingObj;
   m_request->rewindCursor(sizeOfSerializedObj + 1 + 4);  //
-  m_request->writeInt(static_cast<int32_t>(sizeOfSerializedObj));
+  m_request->writeInt(
+      static_cast<int32_t>(sizeOfSerializedObj + referencedSize));
   m_request->advanceCursor(sizeOfSerializedObj + 1);
 }
 
@@ -741,7 +753,8 @@ void TcrMessage::writeEventIdPart(int reserveSize,
 
 void TcrMessage::writeMessageLength() {
   uint32_t totalLen = m_request->getBufferLength();
-  uint32_t msgLen = totalLen - g_headerLen;
+  uint32_t msgLen =
+      totalLen + m_request->getReferencedLength() - g_headerLen;
   m_request->rewindCursor(
       totalLen -
       4);  // msg len is written after the msg type which is of 4 bytes ...
@@ -793,6 +806,7 @@ void TcrMessage::startProcessChunk(ACE_Semaphore& finalizeSema) {
           "Got unexpected request msg type while starting to process response");
     }
   }
+  m_chunkedResult->startChunks();
   m_chunkedResult->setFinalizeSemaphore(&finalizeSema);
 }
 
@@ -992,15 +1006,17 @@ void TcrMessage::chunkSecurityHeader(int skipPart, const uint8_t* bytes,
 }
 
 void TcrMessage::handleByteArrayResponse(
-    const char* bytearray, int32_t len, uint16_t endpointMemId,
+    const ReceiveBufferPtr& buffer, uint16_t endpointMemId,
     const SerializationRegistry& serializationRegistry,
     MemberListForVersionStamp& memberListForVersionStamp) {
+  int32_t len = buffer->getLength();
   auto input = m_tcdm->getConnectionManager().getCacheImpl()->getCache()->createDataInput(
-                  (uint8_t*)bytearray, len);
+                  buffer->getBytes(), len);
   // TODO:: this need to make sure that pool is there
   //  if(m_tcdm == nullptr)
   //  throw IllegalArgumentException("Pool is nullptr in TcrMessage");
   input->setPoolName(getPoolName());
+  input->setReceiveBuffer(buffer);
   input->readInt(&m_msgType);
   int32_t msglen;
   input->readInt(&msglen);
@@ -2877,8 +2893,10 @@ void TcrMessage::setData(const char* bytearray, int32_t len, uint16_t memId,
     m_request = m_tcdm->getConnectionManager().getCacheImpl()->getCache()->createDataOutput();
   }
   if (bytearray) {
-    DeleteArray<const char> delByteArr(bytearray);
-    handleByteArrayResponse(bytearray, len, memId, serializationRegistry,
+    // values read from the response may keep the buffer alive
+    auto buffer = ReceiveBuffer::create(
+        reinterpret_cast<const uint8_t*>(bytearray), len);
+    handleByteArrayResponse(buffer, memId, serializationRegistry,
                             memberListForVersionStamp);
   }
 }
@@ -2925,6 +2943,8 @@ const CacheablePtr& TcrMessage::getCallbackArgumentRef() const {
 }
 
 const char* TcrMessage::getMsgData() const {
+  // callers that need one contiguous buffer pay for the copy here
+  m_request->flatten();
   return (char*)m_request->getBuffer();
 }
 
@@ -2933,15 +2953,31 @@ const char* TcrMessage::getMsgHeader() const {
 }
 
 const char* TcrMessage::getMsgBody() const {
+  m_request->flatten();
   return (char*)m_request->getBuffer() + g_headerLen;
 }
 
 uint32_t TcrMessage::getMsgLength() const {
-  return m_request->getBufferLength();
+  return m_request->getBufferLength() + m_request->getReferencedLength();
 }
 
 uint32_t TcrMessage::getMsgBodyLength() const {
-  return m_request->getBufferLength() - g_headerLen;
+  return getMsgLength() - g_headerLen;
+}
+
+void TcrMessage::getMsgSegments(std::vector<iovec>& segments) const {
+  segments.clear();
+  uint32_t count = m_request->getSegmentCount();
+  for (uint32_t index = 0; index < count; index++) {
+    uint32_t length;
+    const uint8_t* data = m_request->getSegment(index, &length);
+    if (length > 0) {
+      iovec segment;
+      segment.iov_base = (char*)data;
+      segment.iov_len = length;
+      segments.push_back(segment);
+    }
+  }
 }
 
 EventIdPtr TcrMessage::getEventId() const { return m_eventid; }
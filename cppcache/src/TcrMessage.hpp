@@ -35,6 +35,7 @@
 #include "EventIdMap.hpp"
 #include <geode/CacheableBuiltins.hpp>
 #include "TcrChunkedContext.hpp"
+#include "ReceiveBuffer.hpp"
 #include <geode/VectorT.hpp>
 #include "GeodeTypeIdsImpl.hpp"
 #include "BucketServerLocation.hpp"
@@ -329,6 +330,11 @@ class CPPCACHE_EXPORT TcrMessage {
   const char* getMsgBody() const;
   uint32_t getMsgLength() const;
   uint32_t getMsgBodyLength() const;
+  /**
+   * Fill segments with the non-empty pieces of the request in wire order;
+   * large byte array values are referenced from the application's buffer.
+   */
+  void getMsgSegments(std::vector<iovec>& segments) const;
   EventIdPtr getEventId() const;
 
   int32_t getTransId() const;
@@ -536,7 +542,7 @@ class CPPCACHE_EXPORT TcrMessage {
 
   // some private methods to handle things internally.
   void handleByteArrayResponse(
-      const char* bytearray, int32_t len, uint16_t endpointMemId,
+      const ReceiveBufferPtr& buffer, uint16_t endpointMemId,
       const SerializationRegistry& serializationRegistry,
       MemberListForVersionStamp& memberListForVersionStamp);
   void readObjectPart(DataInput& input, bool defaultString = false);
@@ -1323,6 +1329,25 @@ class TcrMessageHelper {
     }
     return OBJECT;
   }
+
+  /**
+   * Whether a chunk starts with an object part of the given fixed id type,
+   * so that readChunkPartHeader() with a FixedIDByte first type returns
+   * OBJECT for it without touching the message. Only looks at the bytes,
+   * so it may be called from any thread.
+   */
+  inline static bool isFixedIdObjectPart(const uint8_t* bytes, int32_t len,
+                                         int32_t expectedPartType) {
+    // part length, object flag, fixed id byte and part type
+    if (len < 7) {
+      return false;
+    }
+    bool emptyPart =
+        bytes[0] == 0 && bytes[1] == 0 && bytes[2] == 0 && bytes[3] == 0;
+    return !emptyPart && bytes[4] == 1 &&
+           bytes[5] == GeodeTypeIdsImpl::FixedIDByte &&
+           bytes[6] == expectedPartType;
+  }
   inline static int8_t readChunkPartHeader(TcrMessage& msg, DataInput& input,
                                            const char* methodName,
                                            uint32_t& partLen,
@@ -0,0 +1,418 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TcrPipelinedConnection.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <ace/Guard_T.h>
+#include <ace/OS.h>
+
+#include "CacheImpl.hpp"
+#include "TcrConnection.hpp"
+#include "TcrEndpoint.hpp"
+#include "TcrMessage.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+const char* TcrPipelinedConnection::NC_Pipeline_Reader = "NC Pipeline Reader";
+const size_t TcrPipelinedConnection::MAX_WRITE_BATCH;
+
+namespace {
+// offset of the transaction id in a message header, after the message type,
+// the length and the number of parts
+const size_t TRANSACTION_ID_OFFSET = 12;
+
+int32_t readTransId(const char* data) {
+  const uint8_t* bytes =
+      reinterpret_cast<const uint8_t*>(data) + TRANSACTION_ID_OFFSET;
+  return static_cast<int32_t>(
+      (static_cast<uint32_t>(bytes[0]) << 24) |
+      (static_cast<uint32_t>(bytes[1]) << 16) |
+      (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]));
+}
+}  // namespace
+
+TcrPipelinedConnection::TcrPipelinedConnection(TcrConnection* conn,
+                                               CacheImpl* cacheImpl,
+                                               int maxRequests)
+    : m_conn(conn),
+      m_cacheImpl(cacheImpl),
+      m_endpoint(conn->getEndpointObject()),
+      m_name(m_endpoint->name()),
+      m_maxRequests(maxRequests),
+      m_inFlight(0),
+      m_broken(false),
+      m_writing(false) {
+  m_reader = new ReactorTask<TcrPipelinedConnection>(
+      this, &TcrPipelinedConnection::readReply,
+      cacheImpl->tcrConnectionManager().getIoReactor(), conn->getHandle(),
+      NC_Pipeline_Reader);
+  m_reader->start();
+}
+
+TcrPipelinedConnection::TcrPipelinedConnection(TcrEndpoint* endpoint,
+                                               const std::string& name,
+                                               int maxRequests)
+    : m_conn(nullptr),
+      m_cacheImpl(nullptr),
+      m_endpoint(endpoint),
+      m_name(name),
+      m_maxRequests(maxRequests),
+      m_inFlight(0),
+      m_broken(false),
+      m_writing(false),
+      m_reader(nullptr) {}
+
+TcrPipelinedConnection::~TcrPipelinedConnection() {
+  if (m_reader != nullptr) {
+    m_reader->stop();
+    delete m_reader;
+  }
+
+  GF_SAFE_DELETE_CON(m_conn);
+}
+
+TcrPipelinedConnection::PendingReply::PendingReply(const TcrMessage& request,
+                                                   ACE_Thread_Mutex& lock)
+    : m_request(&request),
+      m_transId(request.getTransId()),
+      m_timeout(request.getTimeout()),
+      m_data(nullptr),
+      m_length(0),
+      m_error(GF_NOERR),
+      m_done(false),
+      m_abandoned(false),
+      m_sent(false),
+      m_write(false),
+      m_cond(lock) {}
+
+bool TcrPipelinedConnection::canPipeline(const TcrMessage& request) {
+  if (request.forTransaction()) {
+    return false;
+  }
+  switch (request.getMessageType()) {
+    case TcrMessage::REQUEST:
+    case TcrMessage::PUT:
+    case TcrMessage::DESTROY:
+    case TcrMessage::INVALIDATE:
+    case TcrMessage::CONTAINS_KEY:
+    case TcrMessage::SIZE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool TcrPipelinedConnection::reserve() {
+  int inFlight = m_inFlight;
+  do {
+    if (m_broken || inFlight >= m_maxRequests) {
+      return false;
+    }
+  } while (!m_inFlight.compare_exchange_weak(inFlight, inFlight + 1));
+  return true;
+}
+
+GfErrType TcrPipelinedConnection::sendRequest(const TcrMessage& request,
+                                              TcrMessageReply& reply) {
+  PendingReplyPtr pending = std::make_shared<PendingReply>(request, m_lock);
+  GfErrType error = GF_NOERR;
+  char* data = nullptr;
+  size_t length = 0;
+  {
+    ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+    if (m_broken) {
+      m_inFlight--;
+      return GF_NOTCON;
+    }
+    m_pending.push_back(pending);
+    m_unsent.push_back(pending);
+    if (!m_writing) {
+      m_writing = true;
+      pending->m_write = true;
+    }
+
+    ACE_Time_Value stopAt(ACE_OS::gettimeofday());
+    stopAt += reply.getTimeout();
+    // the writer may still use the request until it is sent
+    while (!(pending->m_done || pending->m_abandoned) || !pending->m_sent) {
+      if (pending->m_write) {
+        pending->m_write = false;
+        _guard.release();
+        writeRequests(pending);
+        _guard.acquire();
+      } else if (pending->m_done || pending->m_abandoned) {
+        pending->m_cond.wait();
+      } else if (pending->m_cond.wait(&stopAt) == -1 &&
+                 ACE_OS::gettimeofday() >= stopAt && !pending->m_done) {
+        // the reader drops the reply when it comes, the order of the
+        // remaining replies is kept
+        pending->m_abandoned = true;
+        pending->m_error = GF_TIMOUT;
+      }
+    }
+    error = pending->m_error;
+    data = pending->m_data;
+    length = pending->m_length;
+    pending->m_data = nullptr;
+  }
+  m_inFlight--;
+
+  if (error != GF_NOERR) {
+    return error;
+  }
+  return setReply(request, reply, data, length);
+}
+
+void TcrPipelinedConnection::send(
+    const std::vector<const TcrMessage*>& requests, uint32_t timeout) {
+  uint32_t timeSpent = 0;
+  m_conn->send(timeSpent, requests, timeout);
+}
+
+char* TcrPipelinedConnection::receive(size_t* length, ConnErrType* opErr) {
+  // on the threads of the IoReactor the connection is read without waiting,
+  // the connection keeps a partly read reply until the rest comes
+  if (m_conn->getHandle() != ACE_INVALID_HANDLE) {
+    return m_conn->receiveNoWait(length, opErr);
+  }
+  // an SSL connection is read by a thread of its own, which looks at
+  // isRunning every second until a reply starts to come; the rest of the
+  // reply may then take as long as its request allows
+  uint32_t bodyTimeout = DEFAULT_READ_TIMEOUT_SECS;
+  {
+    ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+    if (!m_pending.empty()) {
+      bodyTimeout = std::max(bodyTimeout, m_pending.front()->m_timeout);
+    }
+  }
+  return m_conn->receive(length, opErr, 1, bodyTimeout);
+}
+
+GfErrType TcrPipelinedConnection::setReply(const TcrMessage& request,
+                                           TcrMessageReply& reply, char* data,
+                                           size_t length) {
+  int32_t type = request.getMessageType();
+  if (type == TcrMessage::REQUEST && request.isCallBackArguement()) {
+    reply.setCallBackArguement(true);
+  }
+  reply.setMessageTypeRequest(type);
+  // memory is released by TcrMessage setData()
+  reply.setData(data, static_cast<int32_t>(length),
+                getEndpointObject()->getDistributedMemberID(),
+                *(m_cacheImpl->getSerializationRegistry()),
+                *(m_cacheImpl->getMemberListForVersionStamp()));
+  m_conn->touch();
+
+  if (reply.getMessageType() == TcrMessage::INVALID) {
+    return GF_IOERR;
+  }
+  return GF_NOERR;
+}
+
+int TcrPipelinedConnection::readReply(volatile bool& isRunning) {
+  if (m_broken) {
+    return -1;
+  }
+
+  size_t length = 0;
+  ConnErrType opErr = CONN_NOERR;
+  char* data = nullptr;
+  try {
+    data = receive(&length, &opErr);
+  } catch (const Exception& ex) {
+    LOGFINE("Failed to read reply on pipelined connection: %s",
+            ex.getMessage());
+    opErr = CONN_IOERR;
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+  if (opErr == CONN_IOERR) {
+    breakConnection(GF_IOERR);
+    return -1;
+  }
+  if (data == nullptr) {
+    return 0;
+  }
+
+  // a request is queued before it is written, so a reply without one is not
+  // for this client
+  if (m_pending.empty() || m_pending.front()->m_transId != readTransId(data)) {
+    LOGWARN("Unexpected reply on pipelined connection to %s, closing it",
+            m_name.c_str());
+    delete[] data;
+    breakConnection(GF_NOTCON);
+    return -1;
+  }
+  PendingReplyPtr pending = m_pending.front();
+  m_pending.pop_front();
+  if (pending->m_abandoned) {
+    delete[] data;
+  } else {
+    pending->m_data = data;
+    pending->m_length = length;
+    pending->m_done = true;
+    pending->m_cond.signal();
+  }
+  return 0;
+}
+
+void TcrPipelinedConnection::writeRequests(const PendingReplyPtr& own) {
+  std::vector<PendingReplyPtr> batch;
+  std::vector<const TcrMessage*> requests;
+  while (true) {
+    uint32_t timeout = 0;
+    {
+      ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+      if (m_unsent.empty()) {
+        m_writing = false;
+        return;
+      }
+      if (own->m_sent) {
+        // the thread of the next request waits for it to be written anyway,
+        // it writes the rest so that this one returns with its reply
+        PendingReplyPtr& next = m_unsent.front();
+        next->m_write = true;
+        next->m_cond.signal();
+        return;
+      }
+      batch.clear();
+      requests.clear();
+      while (!m_unsent.empty() && batch.size() < MAX_WRITE_BATCH) {
+        batch.push_back(m_unsent.front());
+        m_unsent.pop_front();
+        requests.push_back(batch.back()->m_request);
+        timeout = std::max(timeout, batch.back()->m_request->getTimeout());
+      }
+    }
+
+    GfErrType error = GF_NOERR;
+    try {
+      send(requests, timeout);
+    } catch (const TimeoutException&) {
+      error = GF_TIMOUT;
+    } catch (const Exception& ex) {
+      LOGFINE("Failed to send %d requests on pipelined connection: %s",
+              static_cast<int32_t>(requests.size()), ex.getMessage());
+      error = GF_IOERR;
+    }
+
+    ACE_Guard<ACE_Thread_Mutex> _guard(m_lock);
+    for (auto& sent : batch) {
+      sent->m_sent = true;
+      sent->m_cond.signal();
+    }
+    if (error != GF_NOERR) {
+      // a partly written request leaves the connection unusable
+      breakConnection(error);
+      m_writing = false;
+      return;
+    }
+  }
+}
+
+void TcrPipelinedConnection::breakConnection(GfErrType error) {
+  m_broken = true;
+  for (auto& pending : m_pending) {
+    pending->m_error = error;
+    pending->m_done = true;
+    pending->m_cond.signal();
+  }
+  m_pending.clear();
+  // these will not be written
+  for (auto& unsent : m_unsent) {
+    unsent->m_sent = true;
+  }
+  m_unsent.clear();
+}
+
+TcrPipelinedConnections::Ptr TcrPipelinedConnections::find(
+    TcrEndpoint* endpoint) {
+  std::vector<Ptr> removed;
+  std::lock_guard<spinlock_mutex> guard(m_lock);
+  // a connection that broke without a request on it is only found here
+  take([](const Ptr& connection) { return connection->isBroken(); },
+       removed);
+  for (auto& connection : m_connections) {
+    if (connection->getEndpointObject() == endpoint) {
+      return connection;
+    }
+  }
+  return nullptr;
+}
+
+TcrPipelinedConnections::Ptr TcrPipelinedConnections::add(
+    const Ptr& connection) {
+  std::vector<Ptr> removed;
+  std::lock_guard<spinlock_mutex> guard(m_lock);
+  take([](const Ptr& existing) { return existing->isBroken(); }, removed);
+  for (auto& existing : m_connections) {
+    if (existing->getEndpointObject() == connection->getEndpointObject()) {
+      return existing;
+    }
+  }
+  m_connections.push_back(connection);
+  return connection;
+}
+
+TcrPipelinedConnections::Ptr TcrPipelinedConnections::reserveAny(
+    const std::function<bool(TcrEndpoint*)>& excluded) {
+  std::lock_guard<spinlock_mutex> guard(m_lock);
+  size_t count = m_connections.size();
+  uint32_t first = m_next++;
+  for (size_t i = 0; i < count; i++) {
+    auto& connection = m_connections[(first + i) % count];
+    if (!excluded(connection->getEndpointObject()) && connection->reserve()) {
+      return connection;
+    }
+  }
+  return nullptr;
+}
+
+void TcrPipelinedConnections::remove(TcrEndpoint* endpoint) {
+  std::vector<Ptr> removed;
+  std::lock_guard<spinlock_mutex> guard(m_lock);
+  take(
+      [endpoint](const Ptr& connection) {
+        return endpoint == nullptr ||
+               connection->getEndpointObject() == endpoint;
+      },
+      removed);
+}
+
+size_t TcrPipelinedConnections::size() {
+  std::lock_guard<spinlock_mutex> guard(m_lock);
+  return m_connections.size();
+}
+
+void TcrPipelinedConnections::take(
+    const std::function<bool(const Ptr&)>& matches,
+    std::vector<Ptr>& removed) {
+  auto end = std::partition(
+      m_connections.begin(), m_connections.end(),
+      [&matches](const Ptr& connection) { return !matches(connection); });
+  removed.assign(end, m_connections.end());
+  m_connections.erase(end, m_connections.end());
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
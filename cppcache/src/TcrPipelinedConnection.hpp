@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_TCRPIPELINEDCONNECTION_H_
+#define GEODE_TCRPIPELINEDCONNECTION_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ace/Condition_T.h>
+#include <ace/Thread_Mutex.h>
+
+#include <geode/geode_globals.hpp>
+
+#include "ReactorTask.hpp"
+#include "TcrConnection.hpp"
+#include "util/concurrent/spinlock_mutex.hpp"
+
+namespace apache {
+namespace geode {
+namespace client {
+
+class CacheImpl;
+class TcrEndpoint;
+class TcrMessage;
+class TcrMessageReply;
+
+/**
+ * A pool connection that keeps several requests in flight at once.
+ *
+ * Requesting threads queue their message and wait for the reply. One of them
+ * at a time writes the queue: the messages that queued up while it wrote the
+ * previous ones go out together, with one gathering write. Once its own
+ * message is out it hands the writing over to the thread of the next one
+ * queued, so that no thread keeps writing for the others. The IoReactor of
+ * the cache reads the replies as they come in, without waiting for the rest
+ * of one, and hands each to the thread that waits for it. The server
+ * answers the requests of a connection in the order it read them, so
+ * replies are matched to requests by that order; the transaction id the
+ * server echoes in the header is checked against the request as well, any
+ * mismatch or I/O failure breaks the connection and fails all its
+ * outstanding requests.
+ *
+ * Only requests answered by a single, unchunked reply can share the
+ * connection, see canPipeline().
+ */
+class TcrPipelinedConnection {
+ public:
+  /**
+   * Takes ownership of the connection, which has to be connected already,
+   * and starts reading it. The connection is closed on destruction, so it is
+   * shared with the threads that have requests on it.
+   */
+  TcrPipelinedConnection(TcrConnection* conn, CacheImpl* cacheImpl,
+                         int maxRequests);
+  virtual ~TcrPipelinedConnection();
+
+  /** whether the request can be sent over a pipelined connection */
+  static bool canPipeline(const TcrMessage& request);
+
+  /**
+   * Reserves a slot for one more request in flight; returns false when the
+   * connection is broken or already has the maximum number of requests.
+   * sendRequest() gives the slot back.
+   */
+  bool reserve();
+
+  /**
+   * Sends the request and waits for its reply, up to the timeout of the
+   * reply. Must be preceded by a successful reserve().
+   */
+  GfErrType sendRequest(const TcrMessage& request, TcrMessageReply& reply);
+
+  bool isBroken() const { return m_broken; }
+
+  TcrEndpoint* getEndpointObject() const { return m_endpoint; }
+
+ protected:
+  /**
+   * For a connection to the named endpoint that does its I/O with the
+   * methods below instead of a TcrConnection; nothing reads it until
+   * readReply() is called.
+   */
+  TcrPipelinedConnection(TcrEndpoint* endpoint, const std::string& name,
+                         int maxRequests);
+
+  /** writes the requests back to back, throws on failure */
+  virtual void send(const std::vector<const TcrMessage*>& requests,
+                    uint32_t timeout);
+
+  /**
+   * Reads what has come of a reply, keeping a partly read one for the next
+   * call; null with opErr unchanged until a whole reply is read.
+   */
+  virtual char* receive(size_t* length, ConnErrType* opErr);
+
+  /** decodes the reply to the request, taking over its data */
+  virtual GfErrType setReply(const TcrMessage& request, TcrMessageReply& reply,
+                             char* data, size_t length);
+
+  // reads one reply, returns -1 once the connection is broken
+  int readReply(volatile bool& isRunning);
+
+ private:
+  struct PendingReply {
+    const TcrMessage* m_request;
+    int32_t m_transId;
+    // of the request, in seconds; the request may be gone before its reply
+    uint32_t m_timeout;
+    char* m_data;
+    size_t m_length;
+    GfErrType m_error;
+    bool m_done;
+    // the requesting thread timed out and no longer waits for the reply
+    bool m_abandoned;
+    // the request is no longer written, the requesting thread may return
+    bool m_sent;
+    // the requesting thread is to write the requests not sent yet
+    bool m_write;
+    ACE_Condition<ACE_Thread_Mutex> m_cond;
+
+    PendingReply(const TcrMessage& request, ACE_Thread_Mutex& lock);
+  };
+
+  typedef std::shared_ptr<PendingReply> PendingReplyPtr;
+
+  // writes the queued requests until the own one is sent, then hands the
+  // rest over to the thread of the next one
+  void writeRequests(const PendingReplyPtr& own);
+
+  // fails every outstanding request, the caller holds m_lock
+  void breakConnection(GfErrType error);
+
+  TcrConnection* m_conn;
+  CacheImpl* m_cacheImpl;
+  TcrEndpoint* m_endpoint;
+  std::string m_name;
+  const int m_maxRequests;
+  std::atomic<int> m_inFlight;
+  std::atomic<bool> m_broken;
+
+  ACE_Thread_Mutex m_lock;
+  // in the order of the requests on the wire
+  std::deque<PendingReplyPtr> m_pending;
+  // the tail of m_pending not written yet
+  std::deque<PendingReplyPtr> m_unsent;
+  // a thread writes m_unsent
+  bool m_writing;
+
+  // the most requests written at once
+  static const size_t MAX_WRITE_BATCH = 64;
+
+  ReactorTask<TcrPipelinedConnection>* m_reader;
+
+  static const char* NC_Pipeline_Reader;
+
+  TcrPipelinedConnection(const TcrPipelinedConnection&) = delete;
+  TcrPipelinedConnection& operator=(const TcrPipelinedConnection&) = delete;
+};
+
+/**
+ * The pipelined connections of a pool, at most one per endpoint. A broken
+ * connection is dropped when it is come across; the requests still on it
+ * close it once done.
+ */
+class TcrPipelinedConnections {
+ public:
+  typedef std::shared_ptr<TcrPipelinedConnection> Ptr;
+
+  TcrPipelinedConnections() : m_next(0) {}
+
+  /** the connection to the endpoint, unless there is none or it broke */
+  Ptr find(TcrEndpoint* endpoint);
+
+  /**
+   * Adds the connection, unless its endpoint got another one meanwhile;
+   * returns the connection kept.
+   */
+  Ptr add(const Ptr& connection);
+
+  /**
+   * Reserves a request slot on one of the connections, taking them in turn
+   * and skipping those to the excluded endpoints; nullptr if none has one.
+   */
+  Ptr reserveAny(const std::function<bool(TcrEndpoint*)>& excluded);
+
+  /** drops the connection to the endpoint, or all when it is null */
+  void remove(TcrEndpoint* endpoint);
+
+  size_t size();
+
+ private:
+  // moves the connections to removed that match, the caller holds m_lock
+  // and lets go of them once it released it
+  void take(const std::function<bool(const Ptr&)>& matches,
+            std::vector<Ptr>& removed);
+
+  std::vector<Ptr> m_connections;
+  spinlock_mutex m_lock;
+  std::atomic<uint32_t> m_next;
+
+  TcrPipelinedConnections(const TcrPipelinedConnections&) = delete;
+  TcrPipelinedConnections& operator=(const TcrPipelinedConnections&) = delete;
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_TCRPIPELINEDCONNECTION_H_
@@ -37,8 +37,8 @@ QueryServicePtr TcrPoolEndPoint::getQueryService() {
 void TcrPoolEndPoint::sendRequestForChunkedResponse(const TcrMessage& request,
                                                     TcrMessageReply& reply,
                                                     TcrConnection* conn) {
-  conn->sendRequestForChunkedResponse(request, request.getMsgLength(), reply,
-                                      request.getTimeout(), reply.getTimeout());
+  conn->sendRequestForChunkedResponse(request, reply, request.getTimeout(),
+                                      reply.getTimeout());
 }
 ThinClientPoolDM* TcrPoolEndPoint::getPoolHADM() { return m_dm; }
 void TcrPoolEndPoint::triggerRedundancyThread() {
@@ -92,9 +92,12 @@ GfErrType TcrPoolEndPoint::registerDM(bool clientNotification, bool isSecondary,
               name().c_str());
       return err;
     }
-    m_notifyReceiver = new Task<TcrEndpoint>(
-        this, &TcrEndpoint::receiveNotification, NC_Notification);
+    m_notifyReceiver = new ReactorTask<TcrEndpoint>(
+        this, &TcrEndpoint::receiveNotification,
+        m_cacheImpl->tcrConnectionManager().getIoReactor(),
+        m_notifyConnection->getHandle(), NC_Notification);
     m_notifyReceiver->start();
+    LOGFINE("Started subscription channel for endpoint %s", name().c_str());
   }
   ++m_numRegionListener;
   LOGFINEST("Incremented notification count for endpoint %s to %d",
@@ -14,6 +14,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+
 #include <geode/geode_globals.hpp>
 #include "ThinClientBaseDM.hpp"
 #include "ThinClientRegion.hpp"
@@ -37,8 +39,7 @@ ThinClientBaseDM::ThinClientBaseDM(TcrConnectionManager& connManager,
       m_connManager(connManager),
       m_initDone(false),
       m_clientNotification(false),
-      m_chunks(true),
-      m_chunkProcessor(nullptr) {}
+      m_chunks(true) {}
 
 ThinClientBaseDM::~ThinClientBaseDM() {}
 
@@ -208,11 +209,10 @@ void ThinClientBaseDM::failover() {
 void ThinClientBaseDM::queueChunk(TcrChunkedContext* chunk) {
   LOGDEBUG("ThinClientBaseDM::queueChunk");
   const uint32_t timeout = 1;
-  if (m_chunkProcessor == nullptr) {
+  if (m_chunkProcessors.empty()) {
     LOGDEBUG("ThinClientBaseDM::queueChunk2");
     // process in same thread if no chunk processor thread
     chunk->handleChunk(true);
-    GF_SAFE_DELETE(chunk);
   } else if (!m_chunks.putUntil(chunk, timeout, 0)) {
     LOGDEBUG("ThinClientBaseDM::queueChunk3");
     // if put in queue fails due to whatever reason then process in same thread
@@ -221,13 +221,13 @@ void ThinClientBaseDM::queueChunk(TcrChunkedContext* chunk) {
         "unbounded size after waiting for %d secs",
         timeout);
     chunk->handleChunk(true);
-    GF_SAFE_DELETE(chunk);
   } else {
     LOGDEBUG("Adding message to ThinClientBaseDM::queueChunk");
   }
 }
 
-// the chunk processing thread
+// a chunk processing thread; the chunks of a reply are decoded by all the
+// threads at once and merged into its result in order, see TcrChunkedContext
 int ThinClientBaseDM::processChunks(volatile bool& isRunning) {
   TcrChunkedContext* chunk;
   LOGFINE("Starting chunk process thread for region %s",
@@ -236,31 +236,47 @@ int ThinClientBaseDM::processChunks(volatile bool& isRunning) {
     chunk = m_chunks.getUntil(0, 100000);
     if (chunk) {
       chunk->handleChunk(false);
-      GF_SAFE_DELETE(chunk);
     }
   }
   LOGFINE("Ending chunk process thread for region %s",
           (m_region != nullptr ? m_region->getFullPath() : "(null)"));
-  GF_DEV_ASSERT(m_chunks.size() == 0);
   return 0;
 }
 
-// start the chunk processing thread
+// start the chunk processing threads
 void ThinClientBaseDM::startChunkProcessor() {
-  if (m_chunkProcessor == nullptr) {
+  if (m_chunkProcessors.empty()) {
     m_chunks.open();
-    m_chunkProcessor = new Task<ThinClientBaseDM>(
-        this, &ThinClientBaseDM::processChunks, NC_ProcessChunk);
-    m_chunkProcessor->start();
+    uint32_t threads = m_connManager.getCacheImpl()
+                           ->getDistributedSystem()
+                           .getSystemProperties()
+                           .chunkHandlerThreads();
+    for (uint32_t i = 0; i < std::max<uint32_t>(threads, 1); i++) {
+      auto processor = new Task<ThinClientBaseDM>(
+          this, &ThinClientBaseDM::processChunks, NC_ProcessChunk);
+      processor->start();
+      m_chunkProcessors.push_back(processor);
+    }
   }
 }
 
-// stop the chunk processing thread
+// stop the chunk processing threads
 void ThinClientBaseDM::stopChunkProcessor() {
-  if (m_chunkProcessor != nullptr) {
-    m_chunkProcessor->stop();
+  if (!m_chunkProcessors.empty()) {
+    for (auto processor : m_chunkProcessors) {
+      processor->stopNoblock();
+    }
+    for (auto processor : m_chunkProcessors) {
+      processor->wait();
+      delete processor;
+    }
+    m_chunkProcessors.clear();
+    // the chunks still queued are not processed any more
+    while (TcrChunkedContext* chunk = m_chunks.get()) {
+      delete chunk;
+    }
+    GF_DEV_ASSERT(m_chunks.size() == 0);
     m_chunks.close();
-    GF_SAFE_DELETE(m_chunkProcessor);
   }
 }
 
@@ -172,7 +172,7 @@ class ThinClientBaseDM {
 
   ThinClientRegion* m_region;
 
-  // methods for the chunk processing thread
+  // methods for the chunk processing threads
   int processChunks(volatile bool& isRunning);
   void startChunkProcessor();
   void stopChunkProcessor();
@@ -194,7 +194,7 @@ class ThinClientBaseDM {
   bool m_clientNotification;
 
   Queue<TcrChunkedContext> m_chunks;
-  Task<ThinClientBaseDM>* m_chunkProcessor;
+  std::vector<Task<ThinClientBaseDM>*> m_chunkProcessors;
 
  private:
   static volatile bool s_isDeltaEnabledOnServer;
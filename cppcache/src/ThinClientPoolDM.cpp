@@ -31,6 +31,7 @@
 #include <geode/PoolManager.hpp>
 
 #include "NonCopyable.hpp"
+#include "SubBatchRunner.hpp"
 
 using namespace apache::geode::client;
 using namespace apache::geode::statistics;
@@ -507,7 +508,6 @@ void ThinClientPoolDM::restoreMinConnections(volatile bool& isRunning) {
   int restored = 0;
 
   if (m_poolSize < min) {
-    ACE_Guard<ACE_Recursive_Thread_Mutex> poolguard(m_queueLock);
     while (m_poolSize < min && limit-- && isRunning) {
       TcrConnection* conn = nullptr;
       bool maxConnLimit = false;
@@ -822,6 +822,7 @@ void ThinClientPoolDM::destroy(bool keepAlive) {
     if (m_clientMetadataService != nullptr) {
       m_clientMetadataService->stop();
     }
+    removePipelinedConnections(nullptr);
     // closing all the thread local connections ( sticky).
     LOGDEBUG("ThinClientPoolDM::destroy( ): closing FairQueue, pool size = %d",
              m_poolSize.load());
@@ -1295,28 +1296,26 @@ GfErrType ThinClientPoolDM::sendSyncRequest(TcrMessage& request,
       return sendSyncRequest(request, reply, attemptFailover, isBGThread,
                              nullptr);
     }
-    std::vector<GetAllWork*> getAllWorkers;
-    auto* threadPool = m_connManager.getCacheImpl()->getThreadPool();
     ChunkedGetAllResponse* responseHandler =
         static_cast<ChunkedGetAllResponse*>(reply.getChunkedResultHandler());
+    // the batches of all servers add their results to responseHandler
+    SubBatchRunner<GetAllWork> getAllWorkers(
+        m_connManager.getCacheImpl()->getThreadPool(),
+        m_attrs->getMaxConnections(),
+        [&](const BucketServerLocationPtr& serverLocation,
+            const VectorOfCacheableKeyPtr& keys) {
+          return new GetAllWork(this, region, serverLocation, keys,
+                                attemptFailover, isBGThread,
+                                responseHandler->getAddToLocalCache(),
+                                responseHandler, request.getCallbackArgument());
+        });
 
     for (const auto& locationIter : *locationMap) {
-      const auto& serverLocation = locationIter.first;
-      if (serverLocation == nullptr) {
-      }
-      const auto& keys = locationIter.second;
-      auto worker =
-          new GetAllWork(this, region, serverLocation, keys, attemptFailover,
-                         isBGThread, responseHandler->getAddToLocalCache(),
-                         responseHandler, request.getCallbackArgument());
-      threadPool->perform(worker);
-      getAllWorkers.push_back(worker);
+      getAllWorkers.add(locationIter.first, locationIter.second);
     }
     reply.setMessageType(TcrMessage::RESPONSE);
 
-    for (std::vector<GetAllWork*>::iterator iter = getAllWorkers.begin();
-         iter != getAllWorkers.end(); iter++) {
-      GetAllWork* worker = *iter;
+    while (GetAllWork* worker = getAllWorkers.next()) {
       GfErrType err = worker->getResult();
 
       if (err != GF_NOERR) {
@@ -1408,8 +1407,16 @@ GfErrType ThinClientPoolDM::sendSyncRequest(
     bool isUserNeedToReAuthenticate = false;
     bool singleHopConnFound = false;
     bool connFound = false;
-    if (!this->m_isMultiUserMode ||
-        (!TcrMessage::isUserInitiativeOps(request))) {
+    std::shared_ptr<TcrPipelinedConnection> pipelined;
+    if (m_attrs->getMaxRequestsPerConnection() > 1 && !m_isSecurityOn &&
+        !m_isMultiUserMode && TcrPipelinedConnection::canPipeline(request)) {
+      pipelined = getPipelinedConnection(request, version, excludeServers,
+                                         serverLocation);
+    }
+    if (pipelined != nullptr) {
+      LOGDEBUG("ThinClientPoolDM::sendSyncRequest: using pipelined connection");
+    } else if (!this->m_isMultiUserMode ||
+               (!TcrMessage::isUserInitiativeOps(request))) {
       conn = getConnectionFromQueueW(&queueErr, excludeServers, isBGThread,
                                      request, version, singleHopConnFound,
                                      connFound, serverLocation);
@@ -1467,7 +1474,7 @@ GfErrType ThinClientPoolDM::sendSyncRequest(
         "type = %d",
         m_isMultiUserMode, conn, type);
 
-    if (!conn) {
+    if (!conn && pipelined == nullptr) {
       // lets assume all connection are in use will happen
       if (queueErr == GF_NOERR) {
         queueErr = GF_ALL_CONNECTIONS_IN_USE_EXCEPTION;
@@ -1480,6 +1487,19 @@ GfErrType ThinClientPoolDM::sendSyncRequest(
         error = queueErr;
       }
     }
+    if (pipelined != nullptr) {
+      TcrEndpoint* ep = pipelined->getEndpointObject();
+      error = pipelined->sendRequest(request, reply);
+      error = handleEPError(ep, reply, error);
+      if (error != GF_NOERR) {
+        if (error != GF_TIMOUT) {
+          removeEPConnections(ep);
+        } else if (pipelined->isBroken()) {
+          removePipelinedConnections(ep);
+        }
+        excludeServers.insert(ServerLocation(ep->name()));
+      }
+    }
     if (conn) {
       TcrEndpoint* ep = conn->getEndpointObject();
       LOGDEBUG(
@@ -1729,10 +1749,10 @@ GfErrType ThinClientPoolDM::getConnectionToAnEndPoint(std::string epNameStr,
 GfErrType ThinClientPoolDM::createPoolConnectionToAEndPoint(
     TcrConnection*& conn, TcrEndpoint* theEP, bool& maxConnLimit,
     bool appThreadrequest) {
-  ACE_Guard<ACE_Recursive_Thread_Mutex> _guard(m_queueLock);
   GfErrType error = GF_NOERR;
   conn = nullptr;
   int min = 0;
+  int32_t poolSize = 0;
   {
     // Check if the pool size has exceeded maximum allowed.
 
@@ -1743,7 +1763,7 @@ GfErrType ThinClientPoolDM::createPoolConnectionToAEndPoint(
     min = m_attrs->getMinConnections();
     max = max > min ? max : min;
 
-    if (m_poolSize >= max) {
+    if (!reservePoolConnection(max, poolSize)) {
       maxConnLimit = true;
       LOGFINER(
           "ThinClientPoolDM::createPoolConnectionToAEndPoint( ): current pool "
@@ -1767,10 +1787,10 @@ GfErrType ThinClientPoolDM::createPoolConnectionToAEndPoint(
   if (conn == nullptr || error != GF_NOERR) {
     LOGFINE("2Failed to connect to %s", theEP->name().c_str());
     if (conn != nullptr) GF_SAFE_DELETE(conn);
+    --m_poolSize;
   } else {
     theEP->setConnected();
-    ++m_poolSize;
-    if (m_poolSize > min) {
+    if (poolSize > min) {
       getStats().incLoadCondConnects();
     }
     // Update Stats
@@ -1782,6 +1802,20 @@ GfErrType ThinClientPoolDM::createPoolConnectionToAEndPoint(
   return error;
 }
 
+// Counts a connection about to be created in the pool size, unless the pool
+// is full, so that it can be created without holding the pool lock. The
+// creator gives the place back if the connection fails.
+bool ThinClientPoolDM::reservePoolConnection(int max, int32_t& poolSize) {
+  poolSize = m_poolSize;
+  do {
+    if (poolSize >= max) {
+      return false;
+    }
+  } while (!m_poolSize.compare_exchange_weak(poolSize, poolSize + 1));
+  poolSize++;
+  return true;
+}
+
 void ThinClientPoolDM::reducePoolSize(int num) {
   LOGFINE("removing connection %d ,  pool-size =%d", num, m_poolSize.load());
   m_poolSize -= num;
@@ -1792,7 +1826,6 @@ void ThinClientPoolDM::reducePoolSize(int num) {
 GfErrType ThinClientPoolDM::createPoolConnection(
     TcrConnection*& conn, std::set<ServerLocation>& excludeServers,
     bool& maxConnLimit, const TcrConnection* currentserver) {
-  ACE_Guard<ACE_Recursive_Thread_Mutex> _guard(m_queueLock);
   GfErrType error = GF_NOERR;
   int max = m_attrs->getMaxConnections();
   if (max == -1) {
@@ -1806,8 +1839,9 @@ GfErrType ThinClientPoolDM::createPoolConnection(
       m_poolSize.load(), max, min);
 
   conn = nullptr;
+  int32_t poolSize = 0;
   {
-    if (m_poolSize >= max) {
+    if (!reservePoolConnection(max, poolSize)) {
       LOGDEBUG(
           "ThinClientPoolDM::createPoolConnection( ): current pool size has "
           "reached limit %d, %d",
@@ -1826,9 +1860,11 @@ GfErrType ThinClientPoolDM::createPoolConnection(
       epNameStr = selectEndpoint(excludeServers, currentserver);
     } catch (const NoAvailableLocatorsException&) {
       LOGFINE("Locator query failed");
+      --m_poolSize;
       return GF_CACHE_LOCATOR_EXCEPTION;
     } catch (const Exception&) {
       LOGFINE("Endpoint selection failed");
+      --m_poolSize;
       return GF_NOTCON;
     }
     LOGFINE("Connecting to %s", epNameStr.c_str());
@@ -1840,6 +1876,8 @@ GfErrType ThinClientPoolDM::createPoolConnection(
       LOGDEBUG("Updating existing connection: ", epNameStr.c_str());
       conn = const_cast<TcrConnection*>(currentserver);
       conn->updateCreationTime();
+      // the existing connection is already counted
+      --m_poolSize;
       break;
     } else {
       error = ep->createNewConnection(conn, false, false,
@@ -1865,11 +1903,12 @@ GfErrType ThinClientPoolDM::createPoolConnection(
       if (ThinClientBaseDM::isFatalClientError(error)) {
         //  log the error string instead of error number.
         LOGFINE("Connection failed due to fatal client error %d", error);
+        --m_poolSize;
         return error;
       }
     } else {
       ep->setConnected();
-      if (++m_poolSize > min) {
+      if (poolSize > min) {
         getStats().incLoadCondConnects();
       }
       // Update Stats
@@ -1908,9 +1947,9 @@ TcrConnection* ThinClientPoolDM::getConnectionFromQueue(
       getUntil(timeoutTime, error, excludeServers, maxConnLimit);
   /*Update the time stat for clientOpsTime */
   if (enableTimeStatistics) {
-    Utils::updateStatOpTime(getStats().getStats(),
-                            getStats().getTotalWaitingConnTimeId(),
-                            sampleStartNanos);
+    int64_t checkoutNanos = Utils::startStatOpTime() - sampleStartNanos;
+    getStats().incTotalWaitingConnTime(checkoutNanos);
+    getStats().incConnectionCheckouts(checkoutNanos);
   }
   return mp;
 }
@@ -2265,62 +2304,113 @@ bool ThinClientPoolDM::excludeConnection(
 }
 
 TcrConnection* ThinClientPoolDM::getFromEP(TcrEndpoint* theEP) {
-  ACE_Guard<ACE_Recursive_Thread_Mutex> _guard(m_queueLock);
-  for (std::deque<TcrConnection*>::iterator itr = m_queue.begin();
-       itr != m_queue.end(); itr++) {
-    if ((*itr)->getEndpointObject() == theEP) {
-      LOGDEBUG("ThinClientPoolDM::getFromEP got connection");
-      TcrConnection* retVal = *itr;
-      m_queue.erase(itr);
-      return retVal;
-    }
+  TcrConnection* retVal = getNoWait(theEP);
+  if (retVal != nullptr) {
+    LOGDEBUG("ThinClientPoolDM::getFromEP got connection");
   }
 
-  return nullptr;
+  return retVal;
 }
 
 void ThinClientPoolDM::removeEPConnections(TcrEndpoint* theEP) {
-  ACE_Guard<ACE_Recursive_Thread_Mutex> _guard(m_queueLock);
-  int32_t size = static_cast<int32_t>(m_queue.size());
-  int numConn = 0;
-
-  while (size--) {
-    TcrConnection* curConn = m_queue.back();
-    m_queue.pop_back();
-    if (curConn->getEndpointObject() != theEP) {
-      m_queue.push_front(curConn);
-    } else {
-      curConn->close();
-      GF_SAFE_DELETE(curConn);
-      numConn++;
-    }
+  std::vector<TcrConnection*> removed = removeFromQueue(theEP);
+  int numConn = static_cast<int>(removed.size());
+
+  for (auto curConn : removed) {
+    curConn->close();
+    GF_SAFE_DELETE(curConn);
   }
 
   removeEPConnections(numConn);
+  removePipelinedConnections(theEP);
+}
+
+std::shared_ptr<TcrPipelinedConnection>
+ThinClientPoolDM::getPipelinedConnection(
+    TcrMessage& request, int8_t& version,
+    std::set<ServerLocation>& excludeServers,
+    const BucketServerLocationPtr& serverLocation) {
+  TcrEndpoint* theEP = nullptr;
+  if (serverLocation != nullptr) {
+    theEP = getEndPoint(serverLocation, version, excludeServers);
+  } else if (m_attrs->getPRSingleHopEnabled() && request.forSingleHop()) {
+    BucketServerLocationPtr slTmp = nullptr;
+    theEP = getSingleHopServer(request, version, slTmp, excludeServers);
+  }
+  if (theEP != nullptr) {
+    return reservePipelinedConnection(theEP);
+  }
+
+  auto pipelined = m_pipelinedConns.reserveAny(
+      [this, &excludeServers](TcrEndpoint* ep) {
+        return excludeServer(ep->name(), excludeServers);
+      });
+  if (pipelined != nullptr) {
+    return pipelined;
+  }
+
+  std::string epNameStr;
+  try {
+    epNameStr = selectEndpoint(excludeServers);
+  } catch (const Exception&) {
+    // the pool connection will report it
+    return nullptr;
+  }
+  return reservePipelinedConnection(addEP(epNameStr.c_str()));
+}
+
+std::shared_ptr<TcrPipelinedConnection>
+ThinClientPoolDM::reservePipelinedConnection(TcrEndpoint* theEP) {
+  auto pipelined = m_pipelinedConns.find(theEP);
+  if (pipelined == nullptr) {
+    // connect outside the lock, another thread may be doing the same
+    TcrConnection* conn = nullptr;
+    GfErrType error = theEP->createNewConnection(
+        conn, false, false, m_connManager.getCacheImpl()
+                                ->getDistributedSystem()
+                                .getSystemProperties()
+                                .connectTimeout(),
+        false);
+    if (conn == nullptr || error != GF_NOERR) {
+      LOGFINE("Failed to create pipelined connection to %s",
+              theEP->name().c_str());
+      GF_SAFE_DELETE(conn);
+      return nullptr;
+    }
+    pipelined = m_pipelinedConns.add(std::make_shared<TcrPipelinedConnection>(
+        conn, m_connManager.getCacheImpl(),
+        m_attrs->getMaxRequestsPerConnection()));
+  }
+
+  if (!pipelined->reserve()) {
+    return nullptr;
+  }
+  return pipelined;
+}
+
+void ThinClientPoolDM::removePipelinedConnections(TcrEndpoint* theEP) {
+  // the connections are closed here, or by the last request still using them
+  m_pipelinedConns.remove(theEP);
 }
 
 TcrConnection* ThinClientPoolDM::getNoGetLock(
     bool& isClosed, GfErrType* error, std::set<ServerLocation>& excludeServers,
     bool& maxConnLimit) {
   TcrConnection* returnT = nullptr;
-  {
-    ACE_Guard<ACE_Recursive_Thread_Mutex> _guard(m_queueLock);
-
-    do {
-      returnT = popFromQueue(isClosed);
-      if (returnT) {
-        if (excludeConnection(returnT, excludeServers)) {
-          returnT->close();
-          GF_SAFE_DELETE(returnT);
-          removeEPConnections(1, false);
-        } else {
-          break;
-        }
+  do {
+    returnT = popFromQueue(isClosed);
+    if (returnT) {
+      if (excludeConnection(returnT, excludeServers)) {
+        returnT->close();
+        GF_SAFE_DELETE(returnT);
+        removeEPConnections(1, false);
       } else {
         break;
       }
-    } while (!returnT);
-  }
+    } else {
+      break;
+    }
+  } while (!returnT);
 
   if (!returnT) {
     *error = createPoolConnection(returnT, excludeServers, maxConnLimit);
@@ -32,7 +32,8 @@
 #include "Task.hpp"
 #include <ace/Semaphore.h>
 #include "PoolStatistics.hpp"
-#include "FairQueue.hpp"
+#include "EndpointFairQueue.hpp"
+#include "TcrPipelinedConnection.hpp"
 #include "TcrPoolEndPoint.hpp"
 #include "ThinClientRegion.hpp"
 #include <geode/ResultCollector.hpp>
@@ -74,7 +75,7 @@ class FunctionExecution;
 class ThinClientPoolDM
     : public ThinClientBaseDM,
       public Pool,
-      public FairQueue<TcrConnection, ACE_Recursive_Thread_Mutex>,
+      public EndpointFairQueue<TcrConnection, ACE_Recursive_Thread_Mutex>,
       private NonCopyable,
       private NonAssignable {
  public:
@@ -395,9 +396,23 @@ class ThinClientPoolDM
 
   bool excludeServer(std::string, std::set<ServerLocation>&);
 
+  // a pipelined connection with a request slot reserved, when the pool has
+  // more than one request per connection, nullptr if none is available
+  std::shared_ptr<TcrPipelinedConnection> getPipelinedConnection(
+      TcrMessage& request, int8_t& version,
+      std::set<ServerLocation>& excludeServers,
+      const BucketServerLocationPtr& serverLocation);
+  std::shared_ptr<TcrPipelinedConnection> reservePipelinedConnection(
+      TcrEndpoint* theEP);
+  // of the given endpoint, or all when it is null
+  void removePipelinedConnections(TcrEndpoint* theEP);
+
   volatile ThinClientLocatorHelper* m_locHelper;
 
+  bool reservePoolConnection(int max, int32_t& poolSize);
   std::atomic<int32_t> m_poolSize;  // Actual Size of Pool
+  // not counted in m_poolSize
+  TcrPipelinedConnections m_pipelinedConns;
   int m_numRegions;
 
   // for selectEndpoint
@@ -16,6 +16,7 @@
  */
 #include "ThinClientPoolHADM.hpp"
 #include "ExpiryHandler_T.hpp"
+#include "NotificationDispatcher.hpp"
 #include <geode/SystemProperties.hpp>
 
 using namespace apache::geode::client;
@@ -279,6 +280,12 @@ void ThinClientPoolHADM::removeCallbackConnection(TcrEndpoint* ep) {
 }
 
 void ThinClientPoolHADM::sendNotConMesToAllregions() {
+  // the regions hear of the disconnect after the events read before it
+  NotificationDispatcher* dispatcher =
+      m_connManager.getNotificationDispatcher();
+  if (dispatcher != nullptr) {
+    dispatcher->barrier();
+  }
   ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_regionsLock);
   for (std::list<ThinClientRegion*>::iterator it = m_regions.begin();
        it != m_regions.end(); it++) {
@@ -37,6 +37,7 @@
 #include "UserAttributes.hpp"
 #include "PutAllPartialResultServerException.hpp"
 #include "VersionedCacheableObjectPartList.hpp"
+#include "SubBatchRunner.hpp"
 //#include "PutAllPartialResult.hpp"
 
 using namespace apache::geode::client;
@@ -122,6 +123,8 @@ class PutAllWork : public PooledWork<GfErrType>,
 
   HashMapOfCacheablePtr getPutAllMap() { return m_map; }
 
+  VectorOfCacheableKeyPtr getKeys() { return m_keys; }
+
   VersionedCacheableObjectPartListPtr getVerObjPartList() {
     return m_verObjPartListPtr;
   }
@@ -338,7 +341,6 @@ ThinClientRegion::ThinClientRegion(const std::string& name,
     : LocalRegion(name, cacheImpl, rPtr, attributes, stats, shared),
       m_tcrdm((ThinClientBaseDM*)0),
       m_notifyRelease(false),
-      m_notificationSema(1),
       m_isMetaDataRefreshed(false) {
   m_transactionEnabled = true;
   m_isDurableClnt = strlen(cacheImpl->getDistributedSystem()
@@ -1362,99 +1364,85 @@ GfErrType ThinClientRegion::singleHopPutAllNoThrow_remote(
   // LOGDEBUG("locationMap.size() = %d ", locationMap->size());
 
   /*Step-2
-   *  a. create vector of PutAllWork
+   *  a. create a SubBatchRunner of PutAllWork
    *  b. locationMap<BucketServerLocationPtr, VectorOfCacheableKeyPtr>.
-   *     Create server specific filteredMap/subMap by populating all keys
-   * (locationIter.second()) and its corr. values from the user Map.
-   *  c. create new instance of PutAllWork, i.e worker with required params.
-   *     //TODO:: Add details of each parameter later
-   *  d. enqueue the worker for thread from threadPool to perform/run execute
-   * method.
-   *  e. insert the worker into the vector.
+   *     Add the keys of every server (locationIter.second()) to the runner,
+   * which splits them into batches.
+   *  c. the runner creates a new instance of PutAllWork for each batch, i.e
+   * worker with required params, when the batch is due. The worker gets a
+   * batch specific filteredMap/subMap populated with the keys of its batch
+   * and their corr. values from the user Map.
+   *  d. the runner enqueues the worker for thread from threadPool to
+   * perform/run execute method, with a bounded number of batches per server
+   * in flight.
    */
-  std::vector<PutAllWork*> putAllWorkers;
-  auto* threadPool =
-      CacheRegionHelper::getCacheImpl(getCache().get())->getThreadPool();
-  int locationMapIndex = 0;
+  SubBatchRunner<PutAllWork> putAllWorkers(
+      CacheRegionHelper::getCacheImpl(getCache().get())->getThreadPool(),
+      tcrdm->getMaxConnections(),
+      [&](const BucketServerLocationPtr& serverLocation,
+          const VectorOfCacheableKeyPtr& keys) {
+        // Create batch specific Sub-Map by iterating over keys.
+        auto filteredMap = std::make_shared<HashMapOfCacheable>();
+        if (keys != nullptr && keys->size() > 0) {
+          for (const auto& key : *keys) {
+            const auto& iter = map.find(key);
+            if (iter != map.end()) {
+              filteredMap->emplace(iter->first, iter->second);
+            }
+          }
+        }
+        return new PutAllWork(tcrdm, serverLocation, region,
+                              true /*attemptFailover*/, false /*isBGThread*/,
+                              filteredMap, keys, timeout, aCallbackArgument);
+      });
   for (const auto& locationIter : *locationMap) {
-    const auto& serverLocation = locationIter.first;
-    if (serverLocation == nullptr) {
+    if (locationIter.first == nullptr) {
       LOGDEBUG("serverLocation is nullptr");
     }
-    const auto& keys = locationIter.second;
-
-    // Create server specific Sub-Map by iterating over keys.
-    auto filteredMap = std::make_shared<HashMapOfCacheable>();
-    if (keys != nullptr && keys->size() > 0) {
-      for (const auto& key : *keys) {
-        const auto& iter = map.find(key);
-        if (iter != map.end()) {
-          filteredMap->emplace(iter->first, iter->second);
-        }
-      }
-    }
-
-    // TEST-CODE :: PRINT each sub-Map entries
-    /*
-    LOGDEBUG("Printing map at %d locationMapindex ", locationMapIndex);
-    for (const auto& filteredMapIter : *filteredMap){
-      auto kPtr =
-    std::dynamic_pointer_cast<CacheableInt32>(filteredMapIter.first()) ;
-      auto vPtr =
-    std::dynamic_pointer_cast<CacheableInt32>(filteredMapIter.second());
-      LOGDEBUG("Key = %d  Value = %d ", kPtr->value(), vPtr->value() );
-    }
-    */
-
-    PutAllWork* worker = new PutAllWork(
-        tcrdm, serverLocation, region, true /*attemptFailover*/,
-        false /*isBGThread*/, filteredMap, keys, timeout, aCallbackArgument);
-    threadPool->perform(worker);
-    putAllWorkers.push_back(worker);
-    locationMapIndex++;
+    putAllWorkers.add(locationIter.first, locationIter.second);
   }
 
-  // TODO::CHECK, do we need to set following ..??
-  // reply.setMessageType(TcrMessage::RESPONSE);
-
-  int cnt = 1;
-
   /**
    * Step::3
-   * a. Iterate over all vector of putAllWorkers and populate worker specific
-   * information into the HashMap
-   *    resultMap<BucketServerLocationPtr, SerializablePtr>, 2nd part, Value can
-   * be a VersionedCacheableObjectPartListPtr or
-   * PutAllPartialResultServerExceptionPtr.
-   *    failedServers<BucketServerLocationPtr, CacheableInt32Ptr>, 2nd part,
-   * Value is a ErrorCode.
-   * b. delete the worker
+   * a. create instance of PutAllPartialResultPtr with total size= map.size()
+   * b. Take the workers from the runner as they finish and merge worker
+   * specific information into the result right away: for a worker without
+   * error add keys and versions of its VersionedCacheableObjectPartList, for
+   * a PutAllPartialResultServerException consolidate its result.
+   *    failedBatches<VectorOfCacheableKeyPtr, GfErrType>, the keys of the
+   * batches that failed and their ErrorCode.
+   * c. delete the worker
    */
-  auto resultMap = ResultMap();
-  auto failedServers = FailedServersMap();
+  ACE_Recursive_Thread_Mutex responseLock;
+  auto result = std::make_shared<PutAllPartialResult>(
+      static_cast<int>(map.size()), responseLock);
+  std::vector<std::pair<VectorOfCacheableKeyPtr, GfErrType>> failedBatches;
 
-  for (const auto& worker : putAllWorkers) {
+  while (PutAllWork* worker = putAllWorkers.next()) {
     auto err =
         worker->getResult();  // wait() or blocking call for worker thread.
     LOGDEBUG("Error code :: %s:%d err = %d ", __FILE__, __LINE__, err);
 
     if (GF_NOERR == err) {
       // No Exception from server
-      resultMap.emplace(worker->getServerLocation(),
-                        worker->getResultCollector()->getList());
+      result->addKeysAndVersions(worker->getResultCollector()->getList());
     } else {
       error = err;
 
       if (error == GF_PUTALL_PARTIAL_RESULT_EXCEPTION) {
-        resultMap.emplace(worker->getServerLocation(),
-                          worker->getPaPResultException());
+        if (const auto papException = worker->getPaPResultException()) {
+          result->consolidate(papException->getResult());
+        } else {
+          LOGERROR(
+              "ERROR:: ThinClientRegion::singleHopPutAllNoThrow_remote "
+              "PutAllPartialResultServerException is nullptr");
+        }
       } else if (error == GF_NOTCON) {
         // Refresh the metadata in case of GF_NOTCON.
         tcrdm->getClientMetaDataService()->enqueueForMetadataRefresh(
             region->getFullPath(), 0);
       }
-      failedServers.emplace(worker->getServerLocation(),
-                            CacheableInt32::create(error));
+      failedBatches.push_back(std::make_pair(worker->getKeys(), error));
     }
 
     LOGDEBUG("worker->getPutAllMap()->size() = %d ",
@@ -1463,91 +1451,34 @@ GfErrType ThinClientRegion::singleHopPutAllNoThrow_remote(
         "worker->getResultCollector()->getList()->getVersionedTagsize() = %d ",
         worker->getResultCollector()->getList()->getVersionedTagsize());
 
-    // TODO::CHECK, why do we need following code... ??
-    // TcrMessage* currentReply = worker->getReply();
-    /*
-    if(currentReply->getMessageType() != TcrMessage::REPLY)
-    {
-      reply.setMessageType(currentReply->getMessageType());
-    }
-    */
-
     delete worker;
-    cnt++;
   }
-  /**
-   * Step:4
-   * a. create instance of PutAllPartialResultPtr with total size= map.size()
-   * b. Iterate over the resultMap and value for the particular serverlocation
-   * is of type VersionedCacheableObjectPartList add keys and versions.
-   * C. ToDO:: what if the value in the resultMap is of type
-   * PutAllPartialResultServerException
-   */
-  ACE_Recursive_Thread_Mutex responseLock;
-  auto result = std::make_shared<PutAllPartialResult>(
-      static_cast<int>(map.size()), responseLock);
   LOGDEBUG(
       " TCRegion:: %s:%d  "
       "result->getSucceededKeysAndVersions()->getVersionedTagsize() = %d ",
       __FILE__, __LINE__,
       result->getSucceededKeysAndVersions()->getVersionedTagsize());
-  LOGDEBUG(" TCRegion:: %s:%d resultMap->size() ", __FILE__, __LINE__,
-           resultMap.size());
-  for (const auto& resultMapIter : resultMap) {
-    const auto& value = resultMapIter.second;
-
-    if (const auto papException =
-            std::dynamic_pointer_cast<PutAllPartialResultServerException>(
-                value)) {
-      // PutAllPartialResultServerException CASE:: value in resultMap is of type
-      // PutAllPartialResultServerException.
-      // TODO:: Add failedservers.keySet= all fialed servers, i.e list out all
-      // keys in map failedServers,
-      //       that is set view of the keys contained in failedservers map.
-      // TODO:: need to read  papException and populate PutAllPartialResult.
-      result->consolidate(papException->getResult());
-    } else if (const auto list =
-                   std::dynamic_pointer_cast<VersionedCacheableObjectPartList>(
-                       value)) {
-      // value in resultMap is of type VCOPL.
-      result->addKeysAndVersions(list);
-    } else {
-      // ERROR CASE
-      if (value) {
-        LOGERROR(
-            "ERROR:: ThinClientRegion::singleHopPutAllNoThrow_remote value "
-            "could not Cast to either VCOPL or "
-            "PutAllPartialResultServerException:%s",
-            value->toString()->asChar());
-      } else {
-        LOGERROR(
-            "ERROR:: ThinClientRegion::singleHopPutAllNoThrow_remote value is "
-            "nullptr");
-      }
-    }
-  }
 
   /**
    * a. if PutAllPartialResult result does not contains any entry,  Iterate over
-   * locationMap.
+   * failedBatches.
    * b. Create VectorOfCacheableKey succeedKeySet, and keep adding set of keys
-   * (locationIter.second()) in locationMap for which
-   * failedServers->contains(locationIter.first()is false.
+   * of the failed batches.
    */
 
-  LOGDEBUG("ThinClientRegion:: %s:%d failedServers->size() = %d", __FILE__,
-           __LINE__, failedServers.size());
+  LOGDEBUG("ThinClientRegion:: %s:%d failedBatches.size() = %d", __FILE__,
+           __LINE__, failedBatches.size());
 
   // if the partial result set doesn't already have keys (for tracking version
   // tags)
   // then we need to gather up the keys that we know have succeeded so far and
   // add them to the partial result set (See bug Id #955)
-  if (!failedServers.empty()) {
+  if (!failedBatches.empty()) {
     auto succeedKeySet = std::make_shared<VectorOfCacheableKey>();
     if (result->getSucceededKeysAndVersions()->size() == 0) {
-      for (const auto& locationIter : *locationMap) {
-        if (failedServers.find(locationIter.first) != failedServers.end()) {
-          for (const auto& i : *(locationIter.second)) {
+      for (const auto& failedBatch : failedBatches) {
+        if (failedBatch.first != nullptr) {
+          for (const auto& i : *(failedBatch.first)) {
             succeedKeySet->push_back(i);
           }
         }
@@ -1557,18 +1488,17 @@ GfErrType ThinClientRegion::singleHopPutAllNoThrow_remote(
   }
 
   /**
-   * a. Iterate over the failedServers map
-   * c. if failedServer map contains "GF_PUTALL_PARTIAL_RESULT_EXCEPTION" then
+   * a. Iterate over the failedBatches
+   * c. if the batch failed with "GF_PUTALL_PARTIAL_RESULT_EXCEPTION" then
    * continue, Do not retry putAll for corr. keys.
-   * b. Retry for all the failed server.
-   *    Generate a newSubMap by finding Keys specific to failedServers from
-   * locationMap and finding their respective values from the usermap.
+   * b. Retry for all the other failed batches.
+   *    Generate a newSubMap by finding the values of the keys of the batch
+   * from the usermap.
    */
   error = GF_NOERR;
   bool oneSubMapRetryFailed = false;
-  for (const auto& failedServerIter : failedServers) {
-    if (failedServerIter.second->value() ==
-        GF_PUTALL_PARTIAL_RESULT_EXCEPTION) {  // serverLocation
+  for (const auto& failedBatch : failedBatches) {
+    if (failedBatch.second == GF_PUTALL_PARTIAL_RESULT_EXCEPTION) {
       // will not retry for PutAllPartialResultException
       // but it means at least one sub map ever failed
       oneSubMapRetryFailed = true;
@@ -1576,13 +1506,7 @@ GfErrType ThinClientRegion::singleHopPutAllNoThrow_remote(
       continue;
     }
 
-    VectorOfCacheableKeyPtr failedKeys = nullptr;
-    const auto& failedSerInLocMapIter =
-        locationMap->find(failedServerIter.first);
-    if (failedSerInLocMapIter != locationMap->end()) {
-      failedKeys = failedSerInLocMapIter->second;
-    }
-
+    const auto& failedKeys = failedBatch.first;
     if (failedKeys == nullptr) {
       LOGERROR(
           "TCRegion::singleHopPutAllNoThrow_remote :: failedKeys are nullptr "
@@ -2834,7 +2758,7 @@ void ThinClientRegion::receiveNotification(TcrMessage* msg) {
       }
       return;
     }
-    m_notificationSema.acquire();
+    m_notificationLock.acquire_read();
   }
 
   if (msg->getMessageType() == TcrMessage::CLIENT_MARKER) {
@@ -2843,7 +2767,7 @@ void ThinClientRegion::receiveNotification(TcrMessage* msg) {
     clientNotificationHandler(*msg);
   }
 
-  m_notificationSema.release();
+  m_notificationLock.release();
   if (TcrMessage::getAllEPDisMess() != msg) GF_SAFE_DELETE(msg);
 }
 
@@ -2954,7 +2878,7 @@ void ThinClientRegion::release(bool invokeCallbacks) {
     return;
   }
   if (!m_notifyRelease) {
-    m_notificationSema.acquire();
+    m_notificationLock.acquire_write();
   }
 
   destroyDM(invokeCallbacks);
@@ -3490,7 +3414,8 @@ void ChunkedQueryResponse::reset() {
 }
 
 void ChunkedQueryResponse::readObjectPartList(DataInput& input,
-                                              bool isResultSet) {
+                                              bool isResultSet,
+                                              CacheableVector& queryResults) {
   bool hasKeys;
   input.readBoolean(&hasKeys);
 
@@ -3517,7 +3442,7 @@ void ChunkedQueryResponse::readObjectPartList(DataInput& input,
       if (isResultSet) {
         CacheablePtr value;
         input.readObject(value);
-        m_queryResults->push_back(value);
+        queryResults.push_back(value);
       } else {
         int8_t arrayType;
         input.read(&arrayType);
@@ -3533,7 +3458,7 @@ void ChunkedQueryResponse::readObjectPartList(DataInput& input,
                 "Query response got unhandled message format while expecting "
                 "struct set object part list; possible serialization mismatch");
           }
-          readObjectPartList(input, true);
+          readObjectPartList(input, true, queryResults);
         } else {
           LOGERROR(
               "Query response got unhandled message format %d while expecting "
@@ -3554,6 +3479,7 @@ void ChunkedQueryResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
   LOGDEBUG("ChunkedQueryResponse::handleChunk..");
   auto input = cache->createDataInput(chunk, chunkLen);
   input->setPoolName(m_msg.getPoolName());
+  input->setReceiveBuffer(getChunkBuffer());
   uint32_t partLen;
   int8_t isObj;
   TcrMessageHelper::ChunkObjectType objType;
@@ -3579,6 +3505,55 @@ void ChunkedQueryResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
     return;
   }
 
+  readResults(*input, partLen, m_structFieldNames, *m_queryResults);
+
+  m_msg.readSecureObjectPart(*input, false, true, isLastChunkWithSecurity);
+}
+
+TcrDecodedChunkPtr ChunkedQueryResponse::decodeChunk(
+    const ReceiveBufferPtr& buffer, uint8_t isLastChunkWithSecurity,
+    const Cache* cache) {
+  const uint8_t collectionType =
+      static_cast<uint8_t>(GeodeTypeIdsImpl::CollectionTypeImpl);
+  if (!TcrMessageHelper::isFixedIdObjectPart(
+          buffer->getBytes(), buffer->getLength(), collectionType)) {
+    // exceptions and scalar results are handled in order
+    return nullptr;
+  }
+  std::unique_ptr<DecodedChunk> decoded(new DecodedChunk());
+  decoded->m_input =
+      cache->createDataInput(buffer->getBytes(), buffer->getLength());
+  DataInput& input = *decoded->m_input;
+  input.setPoolName(m_msg.getPoolName());
+  input.setReceiveBuffer(buffer);
+  uint32_t partLen;
+  TcrMessageHelper::readChunkPartHeader(
+      m_msg, input, GeodeTypeIdsImpl::FixedIDByte, collectionType,
+      "ChunkedQueryResponse", partLen, isLastChunkWithSecurity);
+  decoded->m_queryResults = CacheableVector::create();
+  readResults(input, partLen, decoded->m_structFieldNames,
+              *decoded->m_queryResults);
+  return std::move(decoded);
+}
+
+void ChunkedQueryResponse::mergeChunk(TcrDecodedChunk& chunk,
+                                      uint8_t isLastChunkWithSecurity) {
+  DecodedChunk& decoded = static_cast<DecodedChunk&>(chunk);
+  if (m_structFieldNames.empty()) {
+    m_structFieldNames.swap(decoded.m_structFieldNames);
+  }
+  m_queryResults->insert(m_queryResults->end(),
+                         decoded.m_queryResults->begin(),
+                         decoded.m_queryResults->end());
+  m_msg.readSecureObjectPart(*decoded.m_input, false, true,
+                             isLastChunkWithSecurity);
+}
+
+void ChunkedQueryResponse::readResults(
+    DataInput& input, uint32_t partLen,
+    std::vector<CacheableStringPtr>& structFieldNames,
+    CacheableVector& queryResults) {
+  int8_t isObj;
   uint8_t classByte;
   char* isStructTypeImpl = nullptr;
   uint16_t stiLen = 0;
@@ -3590,43 +3565,43 @@ void ChunkedQueryResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
   // If the results on server are in a bag, or the user need to manipulate
   // the elements, then we have to revisit this issue.
   // For now, we'll live with duplicate records, hoping they do not cost much.
-  skipClass(*input);
+  skipClass(input);
   // skipping CollectionTypeImpl
-  // skipClass(*input); // no longer, since GFE 5.7
+  // skipClass(input); // no longer, since GFE 5.7
 
   int8_t structType;
-  input->read(&structType);  // this is Fixed ID byte (1)
-  input->read(&structType);  // this is DataSerializable (45)
-  input->read(&classByte);
+  input.read(&structType);  // this is Fixed ID byte (1)
+  input.read(&structType);  // this is DataSerializable (45)
+  input.read(&classByte);
   uint8_t stringType;
-  input->read(&stringType);  // ignore string header - assume 64k string
-  input->readUTF(&isStructTypeImpl, &stiLen);
+  input.read(&stringType);  // ignore string header - assume 64k string
+  input.readUTF(&isStructTypeImpl, &stiLen);
 
   DeleteArray<char> delSTI(isStructTypeImpl);
   if (strcmp(isStructTypeImpl, "org.apache.geode.cache.query.Struct") == 0) {
     int32_t numOfFldNames;
-    input->readArrayLen(&numOfFldNames);
+    input.readArrayLen(&numOfFldNames);
     bool skip = false;
-    if (m_structFieldNames.size() != 0) {
+    if (structFieldNames.size() != 0) {
       skip = true;
     }
     for (int i = 0; i < numOfFldNames; i++) {
       CacheableStringPtr sptr;
-      // input->readObject(sptr);
-      input->readNativeString(sptr);
+      // input.readObject(sptr);
+      input.readNativeString(sptr);
       if (!skip) {
-        m_structFieldNames.push_back(sptr);
+        structFieldNames.push_back(sptr);
       }
     }
   }
 
   // skip the remaining part
-  input->reset();
+  input.reset();
   // skip the whole part including partLen and isObj (4+1)
-  input->advanceCursor(partLen + 5);
+  input.advanceCursor(partLen + 5);
 
-  input->readInt(&partLen);
-  input->read(&isObj);
+  input.readInt(&partLen);
+  input.read(&isObj);
   if (!isObj) {
     LOGERROR(
         "Query response part is not an object; possible serialization "
@@ -3636,33 +3611,33 @@ void ChunkedQueryResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
         "mismatch");
   }
 
-  bool isResultSet = (m_structFieldNames.size() == 0);
+  bool isResultSet = (structFieldNames.size() == 0);
 
   int8_t arrayType;
-  input->read(&arrayType);
+  input.read(&arrayType);
 
   if (arrayType == GeodeTypeIds::CacheableObjectArray) {
     int32_t arraySize;
-    input->readArrayLen(&arraySize);
-    skipClass(*input);
+    input.readArrayLen(&arraySize);
+    skipClass(input);
     for (int32_t arrayItem = 0; arrayItem < arraySize; ++arrayItem) {
       SerializablePtr value;
       if (isResultSet) {
-        input->readObject(value);
-        m_queryResults->push_back(value);
+        input.readObject(value);
+        queryResults.push_back(value);
       } else {
-        input->read(&isObj);
+        input.read(&isObj);
         int32_t arraySize2;
-        input->readArrayLen(&arraySize2);
-        skipClass(*input);
+        input.readArrayLen(&arraySize2);
+        skipClass(input);
         for (int32_t index = 0; index < arraySize2; ++index) {
-          input->readObject(value);
-          m_queryResults->push_back(value);
+          input.readObject(value);
+          queryResults.push_back(value);
         }
       }
     }
   } else if (arrayType == GeodeTypeIdsImpl::FixedIDByte) {
-    input->read(&arrayType);
+    input.read(&arrayType);
     if (arrayType != GeodeTypeIdsImpl::CacheableObjectPartList) {
       LOGERROR(
           "Query response got unhandled message format %d while expecting "
@@ -3672,7 +3647,7 @@ void ChunkedQueryResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
           "Query response got unhandled message format while expecting object "
           "part list; possible serialization mismatch");
     }
-    readObjectPartList(*input, isResultSet);
+    readObjectPartList(input, isResultSet, queryResults);
   } else {
     LOGERROR(
         "Query response got unhandled message format %d; possible "
@@ -3682,8 +3657,6 @@ void ChunkedQueryResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
         "Query response got unhandled message format; possible serialization "
         "mismatch");
   }
-
-  m_msg.readSecureObjectPart(*input, false, true, isLastChunkWithSecurity);
 }
 
 void ChunkedQueryResponse::skipClass(DataInput& input) {
@@ -3854,6 +3827,8 @@ void ChunkedGetAllResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
                                         const Cache* cache) {
   auto input = cache->createDataInput(chunk, chunkLen);
   input->setPoolName(m_msg.getPoolName());
+  // large values are left in the chunk rather than copied out of it
+  input->setReceiveBuffer(getChunkBuffer());
   uint32_t partLen;
   if (TcrMessageHelper::readChunkPartHeader(
           m_msg, *input, GeodeTypeIdsImpl::FixedIDByte,
@@ -3874,6 +3849,42 @@ void ChunkedGetAllResponse::handleChunk(const uint8_t* chunk, int32_t chunkLen,
   m_msg.readSecureObjectPart(*input, false, true, isLastChunkWithSecurity);
 }
 
+TcrDecodedChunkPtr ChunkedGetAllResponse::decodeChunk(
+    const ReceiveBufferPtr& buffer, uint8_t isLastChunkWithSecurity,
+    const Cache* cache) {
+  if (!TcrMessageHelper::isFixedIdObjectPart(
+          buffer->getBytes(), buffer->getLength(),
+          GeodeTypeIdsImpl::VersionedObjectPartList)) {
+    // exception parts are handled in order
+    return nullptr;
+  }
+  std::unique_ptr<DecodedChunk> decoded(new DecodedChunk());
+  decoded->m_input =
+      cache->createDataInput(buffer->getBytes(), buffer->getLength());
+  DataInput& input = *decoded->m_input;
+  input.setPoolName(m_msg.getPoolName());
+  input.setReceiveBuffer(buffer);
+  uint32_t partLen;
+  TcrMessageHelper::readChunkPartHeader(
+      m_msg, input, GeodeTypeIdsImpl::FixedIDByte,
+      GeodeTypeIdsImpl::VersionedObjectPartList, "ChunkedGetAllResponse",
+      partLen, isLastChunkWithSecurity);
+  decoded->m_objectList.reset(new VersionedCacheableObjectPartList(
+      m_keys, &m_keysOffset, m_values, m_exceptions, m_resultKeys, m_region,
+      &m_trackerMap, m_destroyTracker, m_addToLocalCache, m_dsmemId,
+      m_responseLock));
+  decoded->m_objectList->decode(input);
+  return std::move(decoded);
+}
+
+void ChunkedGetAllResponse::mergeChunk(TcrDecodedChunk& chunk,
+                                       uint8_t isLastChunkWithSecurity) {
+  DecodedChunk& decoded = static_cast<DecodedChunk&>(chunk);
+  decoded.m_objectList->apply();
+  m_msg.readSecureObjectPart(*decoded.m_input, false, true,
+                             isLastChunkWithSecurity);
+}
+
 void ChunkedGetAllResponse::add(const ChunkedGetAllResponse* other) {
   if (m_values) {
     for (const auto& iter : *m_values) {
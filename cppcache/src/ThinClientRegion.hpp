@@ -22,6 +22,7 @@
 
 #include <unordered_map>
 
+#include <ace/RW_Thread_Mutex.h>
 #include <ace/Task.h>
 
 #include <geode/utils.hpp>
@@ -34,6 +35,7 @@
 #include "Queue.hpp"
 #include "TcrChunkedContext.hpp"
 #include "CacheableObjectPartList.hpp"
+#include "VersionedCacheableObjectPartList.hpp"
 #include "ClientMetadataService.hpp"
 
 /**
@@ -266,7 +268,9 @@ class CPPCACHE_EXPORT ThinClientRegion : public LocalRegion {
       m_durableInterestListRegexForUpdatesAsInvalidates;
 
   bool m_notifyRelease;
-  ACE_Semaphore m_notificationSema;
+  // held shared while an event is applied, events for different keys may be
+  // applied at once; held exclusively once the region is released
+  ACE_RW_Thread_Mutex m_notificationLock;
 
   bool m_isDurableClnt;
 
@@ -375,16 +379,31 @@ typedef std::shared_ptr<ChunkedInterestResponse> ChunkedInterestResponsePtr;
 /**
  * Handle each chunk of the chunked query response.
  *
- *
+ * The results of a chunk are deserialized by decodeChunk(), concurrently
+ * with the other chunks, and appended to the results in the order of the
+ * chunks by mergeChunk().
  */
 class ChunkedQueryResponse : public TcrChunkedResult {
  private:
+  struct DecodedChunk : public TcrDecodedChunk {
+    // positioned after the results, at the security part if any
+    std::unique_ptr<DataInput> m_input;
+    std::vector<CacheableStringPtr> m_structFieldNames;
+    CacheableVectorPtr m_queryResults;
+  };
+
   TcrMessage& m_msg;
   CacheableVectorPtr m_queryResults;
   std::vector<CacheableStringPtr> m_structFieldNames;
 
   void skipClass(DataInput& input);
 
+  // reads the results of a chunk after its part header, along with the
+  // struct field names unless structFieldNames has them already
+  void readResults(DataInput& input, uint32_t partLen,
+                   std::vector<CacheableStringPtr>& structFieldNames,
+                   CacheableVector& queryResults);
+
   // disabled
   ChunkedQueryResponse(const ChunkedQueryResponse&);
   ChunkedQueryResponse& operator=(const ChunkedQueryResponse&);
@@ -405,9 +424,15 @@ class ChunkedQueryResponse : public TcrChunkedResult {
 
   virtual void handleChunk(const uint8_t* chunk, int32_t chunkLen,
                            uint8_t isLastChunkWithSecurity, const Cache* cache);
+  virtual TcrDecodedChunkPtr decodeChunk(const ReceiveBufferPtr& buffer,
+                                         uint8_t isLastChunkWithSecurity,
+                                         const Cache* cache);
+  virtual void mergeChunk(TcrDecodedChunk& chunk,
+                          uint8_t isLastChunkWithSecurity);
   virtual void reset();
 
-  void readObjectPartList(DataInput& input, bool isResultSet);
+  void readObjectPartList(DataInput& input, bool isResultSet,
+                          CacheableVector& queryResults);
 };
 
 typedef std::shared_ptr<ChunkedQueryResponse> ChunkedQueryResponsePtr;
@@ -464,10 +489,18 @@ typedef std::shared_ptr<ChunkedFunctionExecutionResponse>
 /**
  * Handle each chunk of the chunked getAll response.
  *
- *
+ * The keys and values of a chunk are deserialized by decodeChunk(),
+ * concurrently with the other chunks, and added to the results and the
+ * region in the order of the chunks by mergeChunk().
  */
 class ChunkedGetAllResponse : public TcrChunkedResult {
  private:
+  struct DecodedChunk : public TcrDecodedChunk {
+    // positioned after the object part list, at the security part if any
+    std::unique_ptr<DataInput> m_input;
+    std::unique_ptr<VersionedCacheableObjectPartList> m_objectList;
+  };
+
   TcrMessage& m_msg;
   ThinClientRegion* m_region;
   const VectorOfCacheableKey* m_keys;
@@ -507,6 +540,11 @@ class ChunkedGetAllResponse : public TcrChunkedResult {
 
   virtual void handleChunk(const uint8_t* chunk, int32_t chunkLen,
                            uint8_t isLastChunkWithSecurity, const Cache* cache);
+  virtual TcrDecodedChunkPtr decodeChunk(const ReceiveBufferPtr& buffer,
+                                         uint8_t isLastChunkWithSecurity,
+                                         const Cache* cache);
+  virtual void mergeChunk(TcrDecodedChunk& chunk,
+                          uint8_t isLastChunkWithSecurity);
   virtual void reset();
 
   void add(const ChunkedGetAllResponse* other);
@@ -99,6 +99,15 @@ int ThreadPool::svc(void) {
     // Ask the worker to do the job.
     worker->perform(request);
   }
+  // the workers are stopped once they are back from their works
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, workerMon, this->workersLock_, -1);
+  while (this->workers_.size() < static_cast<size_t>(poolSize_)) {
+    workersCond_.wait();
+  }
+  ThreadPoolWorker* worker;
+  while (this->workers_.dequeue_head(worker) == 0) {
+    delete worker;
+  }
   return 0;
 }
 
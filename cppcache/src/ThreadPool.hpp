@@ -35,6 +35,8 @@
 #include <ace/Guard_T.h>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <future>
 namespace apache {
 namespace geode {
 namespace client {
@@ -94,6 +96,30 @@ class PooledWorkFP : public PooledWork<R> {
   OPERATION m_op;
 };
 
+/**
+ * A function run on the thread pool, its result or exception delivered
+ * through the future. Nobody waits on the work itself, so it deletes itself
+ * once run.
+ */
+template <class R>
+class PooledTask : public ACE_Method_Request {
+ public:
+  explicit PooledTask(std::function<R()> function)
+      : m_task(std::move(function)) {}
+  virtual ~PooledTask() {}
+
+  std::future<R> getFuture() { return m_task.get_future(); }
+
+  virtual int call(void) {
+    m_task();
+    delete this;
+    return 0;
+  }
+
+ private:
+  std::packaged_task<R()> m_task;
+};
+
 class ThreadPoolWorker;
 
 class IThreadPool {
@@ -0,0 +1,267 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimingWheel.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+const TimingWheel::id_type TimingWheel::ID_FLAG;
+const uint32_t TimingWheel::NIL;
+const uint32_t TimingWheel::DUE;
+const uint32_t TimingWheel::CANCELLED;
+const uint32_t TimingWheel::FREE;
+
+TimingWheel::TimingWheel(uint64_t now) : m_free(NIL), m_size(0), m_next(now) {
+  std::fill(m_buckets, m_buckets + BUCKETS, NIL);
+}
+
+TimingWheel::~TimingWheel() {
+  for (auto& timer : m_timers) {
+    if (timer.m_bucket != FREE) {
+      timer.m_handler->handle_close(ACE_INVALID_HANDLE,
+                                    ACE_Event_Handler::TIMER_MASK);
+    }
+  }
+}
+
+TimingWheel::id_type TimingWheel::schedule(ACE_Event_Handler* handler,
+                                           const void* act, uint64_t expiry,
+                                           uint32_t interval) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  uint32_t index = m_free;
+  if (index != NIL) {
+    m_free = m_timers[index].m_next;
+  } else {
+    if (m_timers.size() >= static_cast<size_t>(ID_FLAG)) {
+      return -1;
+    }
+    index = static_cast<uint32_t>(m_timers.size());
+    m_timers.emplace_back();
+  }
+  Timer& timer = m_timers[index];
+  timer.m_handler = handler;
+  timer.m_act = act;
+  timer.m_expiry = expiry;
+  timer.m_interval = interval;
+  add(index);
+  ++m_size;
+  return ID_FLAG | index;
+}
+
+int TimingWheel::resetInterval(id_type id, uint32_t interval) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  uint32_t index = lookup(id);
+  if (index == NIL) {
+    return -1;
+  }
+  m_timers[index].m_interval = interval;
+  return 0;
+}
+
+int TimingWheel::cancel(id_type id, bool dontCallHandleClose) {
+  ACE_Event_Handler* handler;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    uint32_t index = lookup(id);
+    if (index == NIL) {
+      return 0;
+    }
+    Timer& timer = m_timers[index];
+    handler = timer.m_handler;
+    if (timer.m_bucket == DUE) {
+      // released once its handler returns, or in place of calling it
+      timer.m_bucket = CANCELLED;
+    } else {
+      unlink(index);
+      release(index);
+    }
+  }
+  if (!dontCallHandleClose) {
+    handler->handle_close(ACE_INVALID_HANDLE, ACE_Event_Handler::TIMER_MASK);
+  }
+  return 1;
+}
+
+size_t TimingWheel::expire(const ACE_Time_Value& currentTime) {
+  uint64_t now = static_cast<uint64_t>(currentTime.sec());
+  std::vector<uint32_t> due;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    while (m_next <= now) {
+      if (m_size == 0) {
+        m_next = now + 1;
+        break;
+      }
+      uint32_t bucket =
+          static_cast<uint32_t>(m_next) & ((1u << FIRST_BITS) - 1);
+      if (bucket == 0) {
+        // a wheel goes on to its next bucket when the one below comes round
+        uint32_t level = 1;
+        while (level < LEVELS && cascade(level) == 0) {
+          level++;
+        }
+      }
+      for (uint32_t index = m_buckets[bucket]; index != NIL;
+           index = m_timers[index].m_next) {
+        m_timers[index].m_bucket = DUE;
+        due.push_back(index);
+      }
+      m_buckets[bucket] = NIL;
+      ++m_next;
+    }
+  }
+
+  size_t expired = 0;
+  for (auto index : due) {
+    ACE_Event_Handler* handler;
+    const void* act;
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      Timer& timer = m_timers[index];
+      if (timer.m_bucket == CANCELLED) {
+        release(index);
+        continue;
+      }
+      handler = timer.m_handler;
+      act = timer.m_act;
+    }
+
+    handler->handle_timeout(currentTime, act);
+    ++expired;
+
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      Timer& timer = m_timers[index];
+      if (timer.m_bucket == CANCELLED) {
+        release(index);
+        continue;
+      }
+      if (timer.m_interval > 0) {
+        // skip the times that have passed already
+        do {
+          timer.m_expiry += timer.m_interval;
+        } while (timer.m_expiry <= now);
+        add(index);
+        continue;
+      }
+      release(index);
+    }
+    // outside the lock, the handler may cancel timers as it goes
+    delete handler;
+  }
+  return expired;
+}
+
+size_t TimingWheel::size() const {
+  std::lock_guard<std::mutex> guard(m_lock);
+  return m_size;
+}
+
+void TimingWheel::add(uint32_t index) {
+  Timer& timer = m_timers[index];
+  uint64_t expiry = std::max(timer.m_expiry, m_next);
+  uint64_t delta = expiry - m_next;
+  uint32_t bucket;
+  if (delta < (1u << FIRST_BITS)) {
+    bucket = static_cast<uint32_t>(expiry) & ((1u << FIRST_BITS) - 1);
+  } else {
+    uint32_t level = 1;
+    uint32_t shift = FIRST_BITS;
+    while (level < LEVELS - 1 &&
+           delta >= (static_cast<uint64_t>(1) << (shift + LEVEL_BITS))) {
+      shift += LEVEL_BITS;
+      level++;
+    }
+    uint64_t span = static_cast<uint64_t>(1) << (shift + LEVEL_BITS);
+    if (delta >= span) {
+      // beyond the last wheel, comes round again to be put back
+      expiry = m_next + span - 1;
+    }
+    uint32_t position =
+        static_cast<uint32_t>(expiry >> shift) & ((1u << LEVEL_BITS) - 1);
+    bucket = (1u << FIRST_BITS) + (level - 1) * (1u << LEVEL_BITS) + position;
+  }
+
+  timer.m_bucket = bucket;
+  timer.m_prev = NIL;
+  timer.m_next = m_buckets[bucket];
+  if (timer.m_next != NIL) {
+    m_timers[timer.m_next].m_prev = index;
+  }
+  m_buckets[bucket] = index;
+}
+
+void TimingWheel::unlink(uint32_t index) {
+  Timer& timer = m_timers[index];
+  if (timer.m_prev == NIL) {
+    m_buckets[timer.m_bucket] = timer.m_next;
+  } else {
+    m_timers[timer.m_prev].m_next = timer.m_next;
+  }
+  if (timer.m_next != NIL) {
+    m_timers[timer.m_next].m_prev = timer.m_prev;
+  }
+}
+
+void TimingWheel::release(uint32_t index) {
+  Timer& timer = m_timers[index];
+  timer.m_handler = nullptr;
+  timer.m_act = nullptr;
+  timer.m_bucket = FREE;
+  timer.m_next = m_free;
+  m_free = index;
+  --m_size;
+}
+
+uint32_t TimingWheel::lookup(id_type id) const {
+  if (!isTimingWheelId(id)) {
+    return NIL;
+  }
+  size_t index = static_cast<size_t>(id & ~ID_FLAG);
+  if (index >= m_timers.size()) {
+    return NIL;
+  }
+  uint32_t bucket = m_timers[index].m_bucket;
+  if (bucket == FREE || bucket == CANCELLED) {
+    return NIL;
+  }
+  return static_cast<uint32_t>(index);
+}
+
+uint32_t TimingWheel::cascade(uint32_t level) {
+  uint32_t shift = FIRST_BITS + (level - 1) * LEVEL_BITS;
+  uint32_t position =
+      static_cast<uint32_t>(m_next >> shift) & ((1u << LEVEL_BITS) - 1);
+  uint32_t bucket =
+      (1u << FIRST_BITS) + (level - 1) * (1u << LEVEL_BITS) + position;
+  uint32_t index = m_buckets[bucket];
+  m_buckets[bucket] = NIL;
+  while (index != NIL) {
+    uint32_t next = m_timers[index].m_next;
+    add(index);
+    index = next;
+  }
+  return position;
+}
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_TIMINGWHEEL_H_
+#define GEODE_TIMINGWHEEL_H_
+
+#include <deque>
+#include <mutex>
+
+#include <ace/Event_Handler.h>
+#include <ace/Time_Value.h>
+
+#include <geode/geode_globals.hpp>
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * Timers with a resolution of one second, for the expiry of large numbers of
+ * entries.
+ *
+ * A timer goes in the bucket of the second it is due in; the buckets of the
+ * next 256 seconds make up the first wheel, the three wheels above it have
+ * 64 buckets each for ever longer spans and hand their timers down to the
+ * wheel below as the time comes closer. Scheduling and cancelling are a few
+ * list operations whatever the number of timers, and all the timers of a
+ * second are taken off the wheel together.
+ *
+ * The handlers are called the way the timer heap of the ExpiryTaskManager
+ * calls them: the interval may be reset from inside handle_timeout() to
+ * reschedule the timer, a timer without an interval after the upcall deletes
+ * its handler, and a cancelled timer calls handle_close() but leaves the
+ * handler to the caller.
+ */
+class CPPCACHE_EXPORT TimingWheel {
+ public:
+  typedef long id_type;
+
+  /**
+   * The ids of the timers have this bit set, so that they can be told from
+   * the ids of the timers of a reactor.
+   */
+  static const id_type ID_FLAG = 1L << 30;
+
+  /** starts the wheel at the given second */
+  explicit TimingWheel(uint64_t now);
+
+  /** calls handle_close() on the handlers of the remaining timers */
+  ~TimingWheel();
+
+  /**
+   * Schedules the handler for the given second, to be repeated every
+   * interval seconds if the interval is not 0. Returns the id of the timer.
+   */
+  id_type schedule(ACE_Event_Handler* handler, const void* act,
+                   uint64_t expiry, uint32_t interval);
+
+  /**
+   * Resets the interval of the timer, from inside handle_timeout() as well.
+   * Returns 0 on success, -1 if there is no such timer.
+   */
+  int resetInterval(id_type id, uint32_t interval);
+
+  /**
+   * Cancels the timer and calls handle_close() on its handler unless told
+   * not to. Returns 1 if the timer was cancelled, 0 if there is no such
+   * timer.
+   */
+  int cancel(id_type id, bool dontCallHandleClose = false);
+
+  /**
+   * Calls the handlers of all the timers due up to the second of the current
+   * time, and returns their number.
+   */
+  size_t expire(const ACE_Time_Value& currentTime);
+
+  /** the number of timers */
+  size_t size() const;
+
+  static bool isTimingWheelId(id_type id) {
+    return id >= 0 && (id & ID_FLAG) != 0;
+  }
+
+ private:
+  struct Timer {
+    ACE_Event_Handler* m_handler;
+    const void* m_act;
+    uint64_t m_expiry;
+    uint32_t m_interval;
+    // the bucket the timer is in, or one of the states below
+    uint32_t m_bucket;
+    // in the bucket, or the next free timer
+    uint32_t m_prev;
+    uint32_t m_next;
+  };
+
+  static const uint32_t NIL = 0xffffffffu;
+  // taken off the wheel for its handler to be called
+  static const uint32_t DUE = 0xfffffffeu;
+  // cancelled while due
+  static const uint32_t CANCELLED = 0xfffffffdu;
+  static const uint32_t FREE = 0xfffffffcu;
+
+  static const uint32_t FIRST_BITS = 8;
+  static const uint32_t LEVEL_BITS = 6;
+  static const uint32_t LEVELS = 4;
+  static const uint32_t BUCKETS =
+      (1u << FIRST_BITS) + (LEVELS - 1) * (1u << LEVEL_BITS);
+
+  // the caller holds m_lock for these
+  void add(uint32_t index);
+  void unlink(uint32_t index);
+  void release(uint32_t index);
+  uint32_t lookup(id_type id) const;
+  // moves the timers of the bucket of the level to the levels below,
+  // returns the index of the bucket in the level
+  uint32_t cascade(uint32_t level);
+
+  mutable std::mutex m_lock;
+  // a deque does not move the timers as it grows
+  std::deque<Timer> m_timers;
+  uint32_t m_free;
+  size_t m_size;
+  // the first timer of each bucket
+  uint32_t m_buckets[BUCKETS];
+  // the next second to expire
+  uint64_t m_next;
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_TIMINGWHEEL_H_
@@ -49,8 +49,8 @@ long TombstoneList::getExpiryTask(TombstoneExpiryHandler** handler) {
   *handler = new TombstoneExpiryHandler(tombstoneEntryPtr, this, duration,
                                         m_cacheImpl);
   tombstoneEntryPtr->setHandler(*handler);
-  long id = m_cacheImpl->getExpiryTaskManager().scheduleExpiryTask(*handler,
-                                                                   duration, 0);
+  long id = m_cacheImpl->getExpiryTaskManager().scheduleCoarseExpiryTask(
+      *handler, duration, 0);
   return id;
 }
 
@@ -166,6 +166,9 @@ long TombstoneList::eraseEntryFromTombstoneListWithoutCancelTask(
 void TombstoneList::cleanUp() {
   // This function is not guarded as all functions of this class are called from
   // MapSegment
+  if (m_cacheImpl == nullptr) {
+    return;
+  }
   auto& expiryTaskManager = m_cacheImpl->getExpiryTaskManager();
   for (const auto& queIter : m_tombstoneMap) {
     expiryTaskManager.cancelTask(queIter.second->getExpiryTaskId());
@@ -38,8 +38,7 @@ void VersionedCacheableObjectPartList::toData(DataOutput& output) const {
 }
 
 void VersionedCacheableObjectPartList::readObjectPart(int32_t index,
-                                                      DataInput& input,
-                                                      CacheableKeyPtr keyPtr) {
+                                                      DataInput& input) {
   uint8_t objType = 0;
   CacheableStringPtr exMsgPtr;
   ExceptionPtr ex;
@@ -55,69 +54,51 @@ void VersionedCacheableObjectPartList::readObjectPart(int32_t index,
     input.advanceCursor(skipLen);
 
     input.readNativeString(exMsgPtr);  ////4.1
-    if (m_exceptions != nullptr) {
-      const char* exMsg = exMsgPtr->asChar();
-      if (strstr(exMsg,
-                 "org.apache.geode.security."
-                 "NotAuthorizedException") != nullptr) {
-        ex = std::make_shared<NotAuthorizedException>(
-            "Authorization exception at server:", exMsg);
-      } else {
-        ex = std::make_shared<CacheServerException>(
-            "Exception at remote server:", exMsg);
-      }
-      m_exceptions->emplace(keyPtr, ex);
+    const char* exMsg = exMsgPtr->asChar();
+    if (strstr(exMsg,
+               "org.apache.geode.security."
+               "NotAuthorizedException") != nullptr) {
+      ex = std::make_shared<NotAuthorizedException>(
+          "Authorization exception at server:", exMsg);
+    } else {
+      ex = std::make_shared<CacheServerException>("Exception at remote server:",
+                                                  exMsg);
     }
+    m_partExceptions[index] = ex;
   } else if (m_serializeValues) {
-    // read length
-    int32_t skipLen;
-    input.readArrayLen(&skipLen);
-    uint8_t* bytes = nullptr;
-    if (skipLen > 0) {
-      // readObject
-      bytes = new uint8_t[skipLen];
-      input.readBytesOnly(bytes, skipLen);
-    }
-    m_values->emplace(keyPtr, CacheableBytes::create(bytes, skipLen));
-
-    /* adongre
-     * CID 29377: Resource leak (RESOURCE_LEAK)Calling allocation function
-     * "apache::geode::client::DataInput::readBytes(unsigned char **, int *)" on
-     * "bytes".
-     */
-    GF_SAFE_DELETE_ARRAY(bytes);
-
+    // the serialized value is a length prefixed byte array, which can be
+    // left in the received chunk
+    auto bytes = CacheableBytes::create();
+    bytes->fromData(input);
+    m_partValues[index] = bytes;
   } else {
     // set nullptr to indicate that there is no exception for the key on this
     // index
     // readObject
     input.readObject(value);
-    if (m_values) m_values->emplace(keyPtr, value);
+    m_partValues[index] = value;
   }
 }
 
 void VersionedCacheableObjectPartList::fromData(DataInput& input) {
   ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_responseLock);
-  LOGDEBUG("VersionedCacheableObjectPartList::fromData");
+  decode(input);
+  apply();
+}
+
+void VersionedCacheableObjectPartList::decode(DataInput& input) {
+  LOGDEBUG("VersionedCacheableObjectPartList::decode");
   uint8_t flags = 0;
   input.read(&flags);
   m_hasKeys = (flags & 0x01) == 0x01;
   bool hasObjects = (flags & 0x02) == 0x02;
+  m_hasObjects = hasObjects;
   m_hasTags = (flags & 0x04) == 0x04;
   m_regionIsVersioned = (flags & 0x08) == 0x08;
   m_serializeValues = (flags & 0x10) == 0x10;
   bool persistent = (flags & 0x20) == 0x20;
   CacheableKeyPtr key;
-  CacheableStringPtr exMsgPtr;
   int32_t len = 0;
-  bool valuesNULL = false;
-  int32_t keysOffset = (m_keysOffset != nullptr ? *m_keysOffset : 0);
-  // bool readObjLen = false;
-  // int32_t lenOfObjects = 0;
-  if (m_values == nullptr) {
-    m_values = std::make_shared<HashMapOfCacheable>();
-    valuesNULL = true;
-  }
 
   if (!m_hasKeys && !hasObjects && !m_hasTags) {
     LOGDEBUG(
@@ -125,7 +106,7 @@ void VersionedCacheableObjectPartList::fromData(DataInput& input) {
         "data. Returning,");
   }
 
-  auto localKeys = std::make_shared<VectorOfCacheableKey>();
+  m_localKeys = std::make_shared<VectorOfCacheableKey>();
   if (m_hasKeys) {
     int64_t tempLen;
     input.readUnsignedVL(&tempLen);
@@ -133,11 +114,7 @@ void VersionedCacheableObjectPartList::fromData(DataInput& input) {
 
     for (int32_t index = 0; index < len; ++index) {
       input.readObject(key, true);
-      if (m_resultKeys != nullptr) {
-        m_resultKeys->push_back(key);
-      }
-      m_tempKeys->push_back(key);
-      localKeys->push_back(key);
+      m_localKeys->push_back(key);
     }
   } else if (m_keys != nullptr) {
     LOGDEBUG("VersionedCacheableObjectPartList::fromData: m_keys NOT nullptr");
@@ -181,16 +158,10 @@ void VersionedCacheableObjectPartList::fromData(DataInput& input) {
     input.readUnsignedVL(&tempLen);
     len = static_cast<int32_t>(tempLen);
     m_byteArray.resize(len);
+    m_partValues.assign(len, nullptr);
+    m_partExceptions.assign(len, nullptr);
     for (int32_t index = 0; index < len; ++index) {
-      if (m_keys != nullptr && !m_hasKeys) {
-        readObjectPart(index, input, m_keys->at(index + keysOffset));
-      } else /*if (m_resultKeys != nullptr && m_resultKeys->size() > 0)*/ {
-        readObjectPart(index, input, localKeys->at(index));
-      } /*else{
-         LOGERROR("VersionedCacheableObjectPartList::fromData: hasObjects = true
-       but m_keys is nullptr and m_resultKeys== nullptr or m_resultKeys->size=0"
-       );
-       }*/
+      readObjectPart(index, input);
     }
   }  // hasObjects ends here
 
@@ -265,22 +236,46 @@ void VersionedCacheableObjectPartList::fromData(DataInput& input) {
       m_versionTags[index] = versionTag;
     }
   }
+  m_decodedLen = len;
+}
+
+void VersionedCacheableObjectPartList::apply() {
+  ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_responseLock);
+  const int32_t len = m_decodedLen;
+  bool valuesNULL = false;
+  int32_t keysOffset = (m_keysOffset != nullptr ? *m_keysOffset : 0);
+  if (m_values == nullptr) {
+    m_values = std::make_shared<HashMapOfCacheable>();
+    valuesNULL = true;
+  }
+
+  if (m_hasKeys) {
+    for (const auto& key : *m_localKeys) {
+      if (m_resultKeys != nullptr) {
+        m_resultKeys->push_back(key);
+      }
+      m_tempKeys->push_back(key);
+    }
+  }
+
+  if (m_hasObjects) {
+    for (size_t index = 0; index < m_byteArray.size(); ++index) {
+      const auto& key = partKey(static_cast<int32_t>(index), keysOffset);
+      if (m_byteArray[index] == 2) {
+        if (m_exceptions != nullptr) {
+          m_exceptions->emplace(key, m_partExceptions[index]);
+        }
+      } else {
+        m_values->emplace(key, m_partValues[index]);
+      }
+    }
 
-  if (hasObjects) {
     CacheableKeyPtr key;
     VersionTagPtr versionTag;
     CacheablePtr value;
 
     for (int32_t index = 0; index < len; ++index) {
-      if (m_keys != nullptr && !m_hasKeys) {
-        key = m_keys->at(index + keysOffset);
-      } else /*if (m_resultKeys != nullptr && m_resultKeys->size() > 0)*/ {
-        key = localKeys->at(index);
-      } /*else{
-         LOGERROR("VersionedCacheableObjectPartList::fromData: hasObjects = true
-       but m_keys is nullptr AND m_resultKeys=nullptr or m_resultKeys->size=0"
-       );
-       }*/
+      key = partKey(index, keysOffset);
 
       const auto& iter = m_values->find(key);
       value = iter == m_values->end() ? nullptr : iter->second;
@@ -318,6 +313,14 @@ void VersionedCacheableObjectPartList::fromData(DataInput& input) {
   if (valuesNULL) m_values = nullptr;
 }
 
+const CacheableKeyPtr& VersionedCacheableObjectPartList::partKey(
+    int32_t index, int32_t keysOffset) const {
+  if (m_keys != nullptr && !m_hasKeys) {
+    return m_keys->at(index + keysOffset);
+  }
+  return m_localKeys->at(index);
+}
+
 int32_t VersionedCacheableObjectPartList::classId() const { return 0; }
 
 int8_t VersionedCacheableObjectPartList::typeId() const {
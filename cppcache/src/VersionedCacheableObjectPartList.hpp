@@ -61,12 +61,20 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
   VectorOfCacheableKeyPtr m_tempKeys;
   ACE_Recursive_Thread_Mutex& m_responseLock;
 
+  // read by decode() for apply()
+  bool m_hasObjects;
+  int32_t m_decodedLen;
+  VectorOfCacheableKeyPtr m_localKeys;
+  std::vector<CacheablePtr> m_partValues;
+  std::vector<ExceptionPtr> m_partExceptions;
+
   static const uint8_t FLAG_NULL_TAG;
   static const uint8_t FLAG_FULL_TAG;
   static const uint8_t FLAG_TAG_WITH_NEW_ID;
   static const uint8_t FLAG_TAG_WITH_NUMBER_ID;
 
-  void readObjectPart(int32_t index, DataInput& input, CacheableKeyPtr keyPtr);
+  void readObjectPart(int32_t index, DataInput& input);
+  const CacheableKeyPtr& partKey(int32_t index, int32_t keysOffset) const;
   // never implemented.
   VersionedCacheableObjectPartList& operator=(
       const VersionedCacheableObjectPartList& other);
@@ -101,6 +109,8 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
     m_endpointMemId = m_dsmemId;
     m_hasTags = false;
     m_hasKeys = false;
+    m_hasObjects = false;
+    m_decodedLen = 0;
   }
 
   VersionedCacheableObjectPartList(VectorOfCacheableKey* keys,
@@ -113,6 +123,8 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
     m_endpointMemId = 0;
     m_versionTags.resize(totalMapSize);
     this->m_hasKeys = false;
+    m_hasObjects = false;
+    m_decodedLen = 0;
     ;
   }
 
@@ -125,6 +137,8 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
     m_serializeValues = false;
     m_hasTags = false;
     this->m_hasKeys = false;
+    m_hasObjects = false;
+    m_decodedLen = 0;
     ;
   }
 
@@ -136,6 +150,8 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
     m_hasTags = false;
     m_endpointMemId = 0;
     this->m_hasKeys = false;
+    m_hasObjects = false;
+    m_decodedLen = 0;
   }
 
   VersionedCacheableObjectPartList(ThinClientRegion* region,
@@ -149,6 +165,8 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
     m_hasTags = false;
     m_endpointMemId = 0;
     this->m_hasKeys = false;
+    m_hasObjects = false;
+    m_decodedLen = 0;
   }
 
   VersionedCacheableObjectPartList(ThinClientRegion* region,
@@ -159,6 +177,8 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
     m_hasTags = false;
     m_endpointMemId = 0;
     this->m_hasKeys = false;
+    m_hasObjects = false;
+    m_decodedLen = 0;
   }
 
   inline uint16_t getEndpointMemId() { return m_endpointMemId; }
@@ -185,6 +205,8 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
     m_endpointMemId = endpointMemId;
     m_hasTags = false;
     m_hasKeys = false;
+    m_hasObjects = false;
+    m_decodedLen = 0;
   }
 
   void addAll(VersionedCacheableObjectPartListPtr other) {
@@ -259,6 +281,16 @@ class VersionedCacheableObjectPartList : public CacheableObjectPartList {
    **/
   virtual void fromData(DataInput& input);
 
+  /**
+   * Deserializes the list without touching the keys, values, exceptions and
+   * region it was created for, so lists can be decoded concurrently; apply()
+   * then adds the list to those. fromData() does both.
+   */
+  void decode(DataInput& input);
+
+  /** adds a list read by decode() to the results and the region */
+  void apply();
+
   /**
    * @brief creation function for java Object[]
    */
@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifndef GEODE_UTIL_CONCURRENT_SHARED_SPINLOCK_MUTEX_H_
+#define GEODE_UTIL_CONCURRENT_SHARED_SPINLOCK_MUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace apache {
+namespace geode {
+namespace util {
+namespace concurrent {
+
+/**
+ * Reader/writer spinlock for read-mostly data.
+ *
+ * Until enable_shared_readers() is called this behaves exactly like
+ * spinlock_mutex and lock_shared() is the same as lock(). Once enabled,
+ * readers announce themselves in one of a fixed number of cache line padded
+ * slots chosen per thread, so concurrent readers never write to a shared
+ * cache line and never wait for each other. A writer raises the writer flag
+ * and then waits for every slot to drain; readers that observe the flag
+ * back off until the writer is done, so writers cannot be starved.
+ *
+ * Neither side is recursive.
+ */
+class shared_spinlock_mutex final {
+ private:
+  static const int READER_SLOTS = 16;
+
+  struct reader_slot {
+    std::atomic<int32_t> count;
+    char padding[64 - sizeof(std::atomic<int32_t>)];
+
+    reader_slot() : count(0) {}
+  };
+
+  std::atomic<bool> writer;
+  std::unique_ptr<reader_slot[]> readers;
+
+  static int slot_index() {
+    static std::atomic<uint32_t> next_index(0);
+    static thread_local int index =
+        static_cast<int>(next_index++ % READER_SLOTS);
+    return index;
+  }
+
+ public:
+  shared_spinlock_mutex() : writer(false) {}
+  shared_spinlock_mutex(const shared_spinlock_mutex &) = delete;
+  shared_spinlock_mutex &operator=(const shared_spinlock_mutex &) = delete;
+
+  /**
+   * Let readers share the lock. Must be called before the mutex is first
+   * used.
+   */
+  void enable_shared_readers() { readers.reset(new reader_slot[READER_SLOTS]); }
+
+  bool shared_readers_enabled() const { return readers != nullptr; }
+
+  void lock() {
+    while (writer.exchange(true, std::memory_order_seq_cst)) {
+      while (writer.load(std::memory_order_relaxed)) continue;
+    }
+    if (readers) {
+      for (int i = 0; i < READER_SLOTS; i++) {
+        while (readers[i].count.load(std::memory_order_seq_cst) != 0) continue;
+      }
+    }
+  }
+
+  void unlock() { writer.store(false, std::memory_order_release); }
+
+  void lock_shared() {
+    if (!readers) {
+      lock();
+      return;
+    }
+    std::atomic<int32_t> &count = readers[slot_index()].count;
+    while (true) {
+      count.fetch_add(1, std::memory_order_seq_cst);
+      if (!writer.load(std::memory_order_seq_cst)) return;
+      count.fetch_sub(1, std::memory_order_release);
+      while (writer.load(std::memory_order_relaxed)) continue;
+    }
+  }
+
+  void unlock_shared() {
+    if (!readers) {
+      unlock();
+      return;
+    }
+    readers[slot_index()].count.fetch_sub(1, std::memory_order_release);
+  }
+};
+
+/**
+ * Scoped shared ownership of a shared_spinlock_mutex, the lock_shared()
+ * counterpart of std::lock_guard.
+ */
+template <class Mutex>
+class shared_lock_guard final {
+ private:
+  Mutex &mutex;
+
+ public:
+  explicit shared_lock_guard(Mutex &m) : mutex(m) { mutex.lock_shared(); }
+  ~shared_lock_guard() { mutex.unlock_shared(); }
+
+  shared_lock_guard(const shared_lock_guard &) = delete;
+  shared_lock_guard &operator=(const shared_lock_guard &) = delete;
+};
+
+} /* namespace concurrent */
+} /* namespace util */
+} /* namespace geode */
+} /* namespace apache */
+
+#endif /* GEODE_UTIL_CONCURRENT_SHARED_SPINLOCK_MUTEX_H_ */
@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <BufferPool.hpp>
+
+using namespace apache::geode::client;
+
+TEST(BufferPoolTest, RoundsUpToSizeClass) {
+  BufferPool& pool = BufferPool::getInstance();
+  uint32_t size;
+
+  uint8_t* buffer = pool.acquire(1, &size);
+  EXPECT_EQ(BufferPool::MIN_BUFFER_SIZE, size);
+  pool.release(buffer, size);
+
+  buffer = pool.acquire(BufferPool::MIN_BUFFER_SIZE + 1, &size);
+  EXPECT_EQ(BufferPool::MIN_BUFFER_SIZE * 2, size);
+  pool.release(buffer, size);
+
+  buffer = pool.acquire(BufferPool::MAX_POOLED_SIZE + 1, &size);
+  EXPECT_EQ(BufferPool::MAX_POOLED_SIZE + 1, size);
+  pool.release(buffer, size);
+}
+
+TEST(BufferPoolTest, ReusesReleasedBuffers) {
+  BufferPool& pool = BufferPool::getInstance();
+  uint32_t size;
+  uint8_t* first = pool.acquire(BufferPool::MIN_BUFFER_SIZE, &size);
+  pool.release(first, size);
+
+  BufferPool::Stats before = pool.getStats();
+  uint8_t* second = pool.acquire(BufferPool::MIN_BUFFER_SIZE, &size);
+  BufferPool::Stats after = pool.getStats();
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(before.hits + 1, after.hits);
+  EXPECT_EQ(before.misses, after.misses);
+  EXPECT_EQ(before.bytesPooled - size, after.bytesPooled);
+  pool.release(second, size);
+}
+
+TEST(BufferPoolTest, GrowKeepsContents) {
+  BufferPool& pool = BufferPool::getInstance();
+  uint32_t size;
+  uint8_t* buffer = pool.acquire(BufferPool::MIN_BUFFER_SIZE, &size);
+  std::memset(buffer, 0x5a, size);
+
+  int64_t reallocs = pool.getStats().reallocs;
+  uint32_t used = size;
+  for (uint32_t minSize : {size * 2, BufferPool::MAX_POOLED_SIZE * 3}) {
+    buffer = pool.grow(buffer, size, used, minSize, &size);
+    EXPECT_LE(minSize, size);
+    for (uint32_t i = 0; i < used; i++) {
+      ASSERT_EQ(0x5a, buffer[i]);
+    }
+  }
+  EXPECT_EQ(reallocs + 2, pool.getStats().reallocs);
+  pool.release(buffer, size);
+}
+
+TEST(BufferPoolTest, ThreadExitReturnsBuffers) {
+  BufferPool& pool = BufferPool::getInstance();
+  pool.trim();
+  int64_t pooled = pool.getStats().bytesPooled;
+
+  std::thread thread([&pool]() {
+    uint32_t size;
+    uint8_t* buffer = pool.acquire(BufferPool::MIN_BUFFER_SIZE, &size);
+    pool.release(buffer, size);
+  });
+  thread.join();
+
+  // the thread's magazine went back to the depot, so trim frees it
+  EXPECT_EQ(pooled + BufferPool::MIN_BUFFER_SIZE, pool.getStats().bytesPooled);
+  pool.trim();
+  EXPECT_EQ(pooled, pool.getStats().bytesPooled);
+}
+
+TEST(BufferPoolTest, DepotIsBounded) {
+  BufferPool& pool = BufferPool::getInstance();
+  int64_t maxPooledBytes = pool.getMaxPooledBytes();
+  pool.trim();
+  pool.setMaxPooledBytes(0);
+
+  uint32_t size;
+  uint8_t* buffer = pool.acquire(BufferPool::MAX_POOLED_SIZE, &size);
+  int64_t pooled = pool.getStats().bytesPooled;
+  pool.release(buffer, size);
+  EXPECT_EQ(pooled, pool.getStats().bytesPooled);
+
+  pool.setMaxPooledBytes(maxPooledBytes);
+}
@@ -115,3 +115,28 @@ TEST(CacheXmlParser, CanParseRegionConfigFromAValidDtdCacheConfig) {
   std::string xml = dtd_prefix + valid_cache_config_body;
   parser.parseMemory(xml.c_str(), static_cast<int>(xml.length()));
 }
+
+std::string expected_entries_config(const std::string& expectedEntries) {
+  return xsd_prefix + R"(<root-region name='Root1'>
+        <region-attributes scope='local' expected-entries=')" +
+         expectedEntries + R"('/>
+    </root-region>
+</client-cache>)";
+}
+
+TEST(CacheXmlParser, CanParseExpectedEntries) {
+  CacheXmlParser parser(nullptr);
+  std::string xml = expected_entries_config("100000");
+  parser.parseMemory(xml.c_str(), static_cast<int>(xml.length()));
+}
+
+TEST(CacheXmlParser, RejectsInvalidExpectedEntries) {
+  for (const char* expectedEntries : {"-1", "many", "10k", "", "4294967296"}) {
+    CacheXmlParser parser(nullptr);
+    std::string xml = expected_entries_config(expectedEntries);
+    EXPECT_THROW(
+        parser.parseMemory(xml.c_str(), static_cast<int>(xml.length())),
+        CacheXmlException)
+        << "expected-entries='" << expectedEntries << "' accepted";
+  }
+}
@@ -23,12 +23,14 @@
 
 #include <gtest/gtest.h>
 
+#include <geode/CacheableBuiltins.hpp>
 #include <geode/CacheFactory.hpp>
 #include <geode/DataInput.hpp>
 #include <memory>
 #include "ByteArrayFixture.hpp"
 #include "DataInputInternal.hpp"
 #include "DataOutputInternal.hpp"
+#include "ReceiveBuffer.hpp"
 #include "SerializationRegistry.hpp"
 
 namespace {
@@ -108,6 +110,26 @@ class TestDataInput {
 
   void readDouble(double *value) { m_dataInput.readDouble(value); }
 
+  void readInts(int16_t *values, int32_t length) {
+    m_dataInput.readInts(values, length);
+  }
+
+  void readInts(int32_t *values, int32_t length) {
+    m_dataInput.readInts(values, length);
+  }
+
+  void readInts(int64_t *values, int32_t length) {
+    m_dataInput.readInts(values, length);
+  }
+
+  void readDoubles(double *values, int32_t length) {
+    m_dataInput.readDoubles(values, length);
+  }
+
+  void readIntArray(int32_t **value, int32_t &length) {
+    m_dataInput.readIntArray(value, length);
+  }
+
   void readASCII(char **value, uint16_t *len = nullptr) {
     m_dataInput.readASCII(value, len);
   }
@@ -575,6 +597,47 @@ TEST_F(DataInputTest, TestReadDouble) {
   EXPECT_DOUBLE_EQ(5.626349274901198e-221, value) << "Correct double";
 }
 
+TEST_F(DataInputTest, TestReadInts) {
+  TestDataInput dataInput("0001FFFE01020304FFFFFFFF0102030405060708", nullptr);
+  int16_t shorts[2];
+  int32_t ints[2];
+  int64_t longs[1];
+  dataInput.readInts(shorts, 2);
+  dataInput.readInts(ints, 2);
+  dataInput.readInts(longs, 1);
+  EXPECT_EQ(1, shorts[0]);
+  EXPECT_EQ(-2, shorts[1]);
+  EXPECT_EQ(0x01020304, ints[0]);
+  EXPECT_EQ(-1, ints[1]);
+  EXPECT_EQ(0x0102030405060708LL, longs[0]);
+}
+
+TEST_F(DataInputTest, TestReadDoubles) {
+  TestDataInput dataInput("123456789ABCDEF0123456789ABCDEF0", nullptr);
+  double values[2];
+  dataInput.readDoubles(values, 2);
+  EXPECT_DOUBLE_EQ(5.626349274901198e-221, values[0]);
+  EXPECT_DOUBLE_EQ(5.626349274901198e-221, values[1]);
+}
+
+TEST_F(DataInputTest, TestReadIntArray) {
+  TestDataInput dataInput("020000000100000002", nullptr);
+  int32_t *values = nullptr;
+  int32_t length = 0;
+  dataInput.readIntArray(&values, length);
+  ASSERT_EQ(2, length);
+  EXPECT_EQ(1, values[0]);
+  EXPECT_EQ(2, values[1]);
+  delete[] values;
+}
+
+TEST_F(DataInputTest, ThrowsWhenReadingMoreIntsThanInput) {
+  TestDataInput dataInput("0000000100000002", nullptr);
+  int32_t values[3];
+  EXPECT_THROW(dataInput.readInts(values, 3),
+               apache::geode::client::OutOfRangeException);
+}
+
 TEST_F(DataInputTest, TestReadASCII) {
   TestDataInput dataInput(
       "001B596F7520686164206D65206174206D65617420746F726E61646F2E", nullptr);
@@ -920,4 +983,72 @@ TEST_F(DataInputTest, TestSetPoolName) {
       << "Correct pool name after setting";
 }
 
+TEST_F(DataInputTest, CanReadLargeBytesAsSliceOfReceiveBuffer) {
+  const int32_t length = ReceiveBuffer::MIN_SLICE_LENGTH;
+  uint8_t *bytes = new uint8_t[length + 3];
+  bytes[0] = 0xFE;  // two byte array length follows
+  bytes[1] = static_cast<uint8_t>(length >> 8);
+  bytes[2] = static_cast<uint8_t>(length);
+  ::memset(bytes + 3, 0xAB, length);
+  auto buffer = ReceiveBuffer::create(bytes, length + 3);
+  std::weak_ptr<ReceiveBuffer> weakBuffer(buffer);
+
+  std::shared_ptr<const uint8_t> slice;
+  {
+    DataInputUnderTest dataInput(bytes, length + 3, nullptr);
+    dataInput.setReceiveBuffer(buffer);
+    uint8_t *value = nullptr;
+    int32_t len = 0;
+    int32_t bufferLength = 0;
+    dataInput.readBytesSlice(&value, &len, slice, &bufferLength);
+    EXPECT_EQ(length, len);
+    EXPECT_EQ(length + 3, bufferLength) << "Slice holds the whole buffer";
+    EXPECT_EQ(bytes + 3, value) << "Bytes are not copied";
+    EXPECT_EQ(value, slice.get());
+    EXPECT_EQ(0, dataInput.getBytesRemaining());
+  }
+
+  buffer.reset();
+  EXPECT_FALSE(weakBuffer.expired()) << "Slice keeps the buffer alive";
+  slice.reset();
+  EXPECT_TRUE(weakBuffer.expired());
+}
+
+TEST_F(DataInputTest, SlicedBytesReportTheBufferTheyHold) {
+  const int32_t length = ReceiveBuffer::MIN_SLICE_LENGTH;
+  const int32_t bufferLength = length * 4;
+  uint8_t *bytes = new uint8_t[bufferLength];
+  bytes[0] = 0xFE;  // two byte array length follows
+  bytes[1] = static_cast<uint8_t>(length >> 8);
+  bytes[2] = static_cast<uint8_t>(length);
+  ::memset(bytes + 3, 0xAB, bufferLength - 3);
+  auto buffer = ReceiveBuffer::create(bytes, bufferLength);
+  DataInputUnderTest dataInput(bytes, bufferLength, nullptr);
+  dataInput.setReceiveBuffer(buffer);
+
+  auto value = CacheableBytes::create();
+  value->fromData(dataInput);
+  ASSERT_EQ(bytes + 3, value->value());
+  EXPECT_LE(static_cast<uint32_t>(bufferLength), value->objectSize());
+}
+
+TEST_F(DataInputTest, CopiesSmallBytesFromReceiveBuffer) {
+  uint8_t *bytes = new uint8_t[4]{0x03, 0x01, 0x02, 0x03};
+  auto buffer = ReceiveBuffer::create(bytes, 4);
+  DataInputUnderTest dataInput(bytes, 4, nullptr);
+  dataInput.setReceiveBuffer(buffer);
+
+  uint8_t *value = nullptr;
+  int32_t len = 0;
+  std::shared_ptr<const uint8_t> slice;
+  int32_t bufferLength = -1;
+  dataInput.readBytesSlice(&value, &len, slice, &bufferLength);
+  EXPECT_EQ(3, len);
+  EXPECT_EQ(nullptr, slice);
+  EXPECT_EQ(0, bufferLength);
+  EXPECT_NE(bytes + 1, value) << "Small arrays are copied";
+  EXPECT_EQ(0x02, value[1]);
+  delete[] value;
+}
+
 }  // namespace
@@ -16,6 +16,7 @@
  */
 
 #include <stdint.h>
+#include <cstring>
 #include <limits>
 #include <random>
 
@@ -215,6 +216,38 @@ TEST_F(DataOutputTest, TestWriteDouble) {
   EXPECT_BYTEARRAY_EQ("400921FB54442EEA", dataOutput.getByteArray());
 }
 
+TEST_F(DataOutputTest, TestWriteInts) {
+  TestDataOutput dataOutput(nullptr);
+  int16_t shorts[] = {1, -2};
+  int32_t ints[] = {0x01020304, -1};
+  int64_t longs[] = {0x0102030405060708LL};
+  dataOutput.writeInts(shorts, 2);
+  dataOutput.writeInts(ints, 2);
+  dataOutput.writeInts(longs, 1);
+  EXPECT_BYTEARRAY_EQ("0001FFFE01020304FFFFFFFF0102030405060708",
+                      dataOutput.getByteArray());
+}
+
+TEST_F(DataOutputTest, TestWriteDoublesMatchesWriteDouble) {
+  // long enough for the vectorized path and a remainder
+  double values[37];
+  float floats[37];
+  for (int i = 0; i < 37; i++) {
+    values[i] = 3.14159265359 * i;
+    floats[i] = 3.14f * i;
+  }
+  TestDataOutput bulk(nullptr);
+  bulk.writeDoubles(values, 37);
+  bulk.writeFloats(floats, 37);
+  TestDataOutput single(nullptr);
+  for (double value : values) single.writeDouble(value);
+  for (float value : floats) single.writeFloat(value);
+
+  ASSERT_EQ(single.getBufferLength(), bulk.getBufferLength());
+  EXPECT_EQ(0, memcmp(single.getBuffer(), bulk.getBuffer(),
+                      single.getBufferLength()));
+}
+
 TEST_F(DataOutputTest, TestWriteASCII) {
   TestDataOutput dataOutput(nullptr);
   dataOutput.writeASCII("You had me at meat tornado.");
@@ -337,4 +370,48 @@ TEST_F(DataOutputTest, TestCursorNegativeAdvance) {
       << "Correct length after negative advance";
 }
 
+TEST_F(DataOutputTest, TestWriteBytesReferenceSegments) {
+  uint8_t first[] = {0xAA, 0xBB};
+  uint8_t second[] = {0xCC};
+
+  TestDataOutput dataOutput(nullptr);
+  dataOutput.write(static_cast<uint8_t>(1U));
+  dataOutput.writeBytesReference(first, 2, nullptr);
+  dataOutput.writeBytesReference(second, 1, nullptr);
+  dataOutput.write(static_cast<uint8_t>(2U));
+  EXPECT_EQ(2, dataOutput.getBufferLength());
+  EXPECT_EQ(3, dataOutput.getReferencedLength());
+  ASSERT_EQ(5, dataOutput.getSegmentCount());
+
+  uint32_t length;
+  EXPECT_EQ(dataOutput.getBuffer(), dataOutput.getSegment(0, &length));
+  EXPECT_EQ(1, length);
+  EXPECT_EQ(first, dataOutput.getSegment(1, &length));
+  EXPECT_EQ(2, length);
+  dataOutput.getSegment(2, &length);
+  EXPECT_EQ(0, length);
+  EXPECT_EQ(second, dataOutput.getSegment(3, &length));
+  EXPECT_EQ(1, length);
+  EXPECT_EQ(dataOutput.getBuffer() + 1, dataOutput.getSegment(4, &length));
+  EXPECT_EQ(1, length);
+}
+
+TEST_F(DataOutputTest, TestWriteBytesReferenceFlatten) {
+  uint8_t bytes[] = {0xAA, 0xBB};
+
+  TestDataOutput dataOutput(nullptr);
+  dataOutput.writeInt(static_cast<int32_t>(0));
+  dataOutput.writeBytesReference(bytes, 2, nullptr);
+  dataOutput.write(static_cast<uint8_t>(1U));
+  // patch the length in place as TcrMessage does
+  dataOutput.rewindCursor(5);
+  dataOutput.writeInt(static_cast<int32_t>(3));
+  dataOutput.advanceCursor(1);
+
+  dataOutput.flatten();
+  EXPECT_EQ(0, dataOutput.getReferencedLength());
+  EXPECT_EQ(1, dataOutput.getSegmentCount());
+  EXPECT_BYTEARRAY_EQ("00000003AABB01", dataOutput.getByteArray());
+}
+
 }  // namespace
@@ -0,0 +1,160 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <EndpointFairQueue.hpp>
+
+using apache::geode::client::EndpointFairQueue;
+
+namespace {
+
+class Endpoint {};
+
+class Connection {
+ public:
+  Connection(Endpoint* endpoint, int id) : m_endpoint(endpoint), m_id(id) {}
+  Endpoint* getEndpointObject() { return m_endpoint; }
+  int getId() { return m_id; }
+  void close() {}
+
+ private:
+  Endpoint* m_endpoint;
+  int m_id;
+};
+
+class TestQueue : public EndpointFairQueue<Connection> {
+ public:
+  int m_deleted = 0;
+
+  Connection* getUntil(int64_t sec) {
+    return EndpointFairQueue<Connection>::getUntil(sec);
+  }
+
+  std::vector<Connection*> remove(Endpoint* endpoint) {
+    return removeFromQueue(endpoint);
+  }
+
+ protected:
+  void deleteAction() override { m_deleted++; }
+};
+
+TEST(EndpointFairQueueTest, GetsConnectionOfEndpoint) {
+  Endpoint endpoints[4];
+  TestQueue queue;
+  for (int i = 0; i < 20; i++) {
+    queue.put(new Connection(&endpoints[i % 4], i), false);
+  }
+  EXPECT_EQ(20u, queue.size());
+
+  // like the deque it replaces, the most recently returned one
+  Connection* conn = queue.getNoWait(&endpoints[2]);
+  ASSERT_NE(nullptr, conn);
+  EXPECT_EQ(&endpoints[2], conn->getEndpointObject());
+  EXPECT_EQ(18, conn->getId());
+  delete conn;
+
+  std::vector<Connection*> removed = queue.remove(&endpoints[1]);
+  EXPECT_EQ(5u, removed.size());
+  for (auto c : removed) {
+    EXPECT_EQ(&endpoints[1], c->getEndpointObject());
+    delete c;
+  }
+  EXPECT_EQ(nullptr, queue.getNoWait(&endpoints[1]));
+
+  int count = 0;
+  while ((conn = queue.getNoWait()) != nullptr) {
+    count++;
+    delete conn;
+  }
+  EXPECT_EQ(14, count);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(EndpointFairQueueTest, CloseDeletesConnections) {
+  Endpoint endpoint;
+  TestQueue queue;
+  queue.put(new Connection(&endpoint, 1), false);
+  queue.put(new Connection(&endpoint, 2), false);
+  queue.close();
+  EXPECT_EQ(2, queue.m_deleted);
+  EXPECT_TRUE(queue.empty());
+
+  // a closed queue does not take connections back until reopened
+  queue.put(new Connection(&endpoint, 3), false);
+  EXPECT_TRUE(queue.empty());
+  queue.put(new Connection(&endpoint, 4), true);
+  EXPECT_EQ(1u, queue.size());
+}
+
+TEST(EndpointFairQueueTest, WaiterIsWokenByPut) {
+  Endpoint endpoint;
+  TestQueue queue;
+  Connection* conn = nullptr;
+  std::thread waiter([&] { conn = queue.getUntil(10); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto start = std::chrono::steady_clock::now();
+  queue.put(new Connection(&endpoint, 1), false);
+  waiter.join();
+
+  ASSERT_NE(nullptr, conn);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  delete conn;
+}
+
+TEST(EndpointFairQueueTest, ConcurrentPutsAndGets) {
+  const int connections = 20000;
+  const int threads = 4;
+  Endpoint endpoints[threads];
+  TestQueue queue;
+  std::atomic<int> got(0);
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < connections / threads; i++) {
+        queue.put(new Connection(&endpoints[(t + i) % threads], i), false);
+      }
+    });
+    workers.emplace_back([&, t] {
+      while (got < connections) {
+        Connection* conn = t % 2 ? queue.getNoWait(&endpoints[t])
+                                 : queue.getNoWait();
+        if (conn == nullptr) {
+          conn = queue.getUntil(0);
+        }
+        if (conn != nullptr) {
+          delete conn;
+          got++;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(connections, got);
+  EXPECT_TRUE(queue.empty());
+}
+}  // namespace
@@ -0,0 +1,68 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <FrequencySketch.hpp>
+
+using namespace apache::geode::client;
+
+TEST(FrequencySketchTest, CountsUpToFifteen) {
+  FrequencySketch sketch(512);
+  EXPECT_EQ(0u, sketch.frequency(42));
+  for (uint32_t i = 1; i <= 20; i++) {
+    sketch.increment(42);
+    EXPECT_EQ(std::min(i, 15u), sketch.frequency(42));
+  }
+}
+
+TEST(FrequencySketchTest, TellsFrequentItemsApart) {
+  FrequencySketch sketch(512);
+  for (int32_t item = 0; item < 256; item++) {
+    sketch.increment(item);
+  }
+  for (int i = 0; i < 10; i++) {
+    sketch.increment(-1);
+  }
+  EXPECT_EQ(10u, sketch.frequency(-1));
+  uint32_t overestimated = 0;
+  for (int32_t item = 0; item < 256; item++) {
+    EXPECT_GE(sketch.frequency(item), 1u);
+    if (sketch.frequency(item) > 1) {
+      overestimated++;
+    }
+  }
+  // collisions are rare in a table with room for twice as many items
+  EXPECT_LT(overestimated, 16u);
+}
+
+TEST(FrequencySketchTest, HalvesCountsOnceTheSampleIsFull) {
+  FrequencySketch sketch(64);
+  for (int i = 0; i < 8; i++) {
+    sketch.increment(7);
+  }
+  EXPECT_EQ(8u, sketch.frequency(7));
+  // the sample is ten times the size, the counts of item 7 are part of it
+  for (int32_t item = 1000; item < 1000 + 640 - 8; item++) {
+    sketch.increment(item);
+  }
+  // half of 8, and of what other items added to its counters
+  EXPECT_GE(sketch.frequency(7), 4u);
+  EXPECT_LT(sketch.frequency(7), 8u);
+}
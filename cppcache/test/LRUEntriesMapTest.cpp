@@ -0,0 +1,469 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <geode/CacheableBuiltins.hpp>
+#include <geode/CacheableString.hpp>
+#include <geode/EvictionPolicyType.hpp>
+#include <geode/ExceptionTypes.hpp>
+#include <geode/PersistenceManager.hpp>
+
+#include <CacheableToken.hpp>
+#include <LRUEntriesMap.hpp>
+#include <LRUMapEntry.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+// keeps the overflowed value of a single key; its reads can be held up
+// and made to fail
+class TestPersistenceManager : public PersistenceManager {
+ public:
+  TestPersistenceManager()
+      : m_reads(0),
+        m_blockNext(false),
+        m_blocked(false),
+        m_destroyed(false),
+        m_fail(false) {}
+
+  void write(const CacheableKeyPtr& key, const CacheablePtr& value,
+             void*& persistenceInfo) {}
+
+  bool writeAll() { return true; }
+
+  void init(const RegionPtr& region, PropertiesPtr& diskProperties) {}
+
+  CacheablePtr read(const CacheableKeyPtr& key, void*& persistenceInfo) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    ++m_reads;
+    if (m_blockNext) {
+      m_blockNext = false;
+      m_blocked = true;
+      m_cond.notify_all();
+      m_cond.wait(lock, [this] { return !m_blocked; });
+    }
+    if (m_destroyed) {
+      throw EntryNotFoundException("the record has been destroyed");
+    }
+    if (m_fail) {
+      throw std::runtime_error("the read failed");
+    }
+    return m_value;
+  }
+
+  bool readAll() { return true; }
+
+  void destroy(const CacheableKeyPtr& key, void*& persistenceInfo) {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_destroyed = true;
+  }
+
+  void close() {}
+
+  void setValue(const CacheablePtr& value) {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_value = value;
+    m_destroyed = false;
+  }
+
+  void setFail() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_fail = true;
+  }
+
+  // holds up the next read until releaseRead()
+  void blockNextRead() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_blockNext = true;
+  }
+
+  void waitForBlockedRead() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [this] { return m_blocked; });
+  }
+
+  void releaseRead() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_blocked = false;
+    m_cond.notify_all();
+  }
+
+  int reads() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_reads;
+  }
+
+ private:
+  std::mutex m_lock;
+  std::condition_variable m_cond;
+  CacheablePtr m_value;
+  int m_reads;
+  bool m_blockNext;
+  bool m_blocked;
+  bool m_destroyed;
+  bool m_fail;
+};
+
+// overflows nothing itself, the values are overflowed by the tests
+class TestOverflowAction : public virtual LRUAction {
+ public:
+  TestOverflowAction() { m_overflows = true; }
+
+  bool evict(const MapEntryImplPtr& mePtr) { return false; }
+
+  LRUAction::Action getType() { return LRUAction::OVERFLOW_TO_DISK; }
+};
+
+// an overflowing map outside of a region
+class TestOverflowMap : public LRUEntriesMap {
+ public:
+  explicit TestOverflowMap(PersistenceManagerPtr pm)
+      : LRUEntriesMap(nullptr, std::unique_ptr<EntryFactory>(
+                                   new LRUEntryFactory(false)),
+                      nullptr, LRUAction::OVERFLOW_TO_DISK, 1000, false) {
+    delete m_action;
+    m_action = new TestOverflowAction();
+    setPersistenceManager(pm);
+    open(16);
+  }
+
+  // takes the value of the key out of memory, as the overflow action does
+  void overflow(const CacheableKeyPtr& key) {
+    MapEntryImplPtr me;
+    CacheablePtr value;
+    getEntry(key, me, value);
+    LRUEntryProperties& lruProps = me->getLRUProperties();
+    lruProps.incOverflowCount();
+    me->setValueI(CacheableToken::overflowed());
+    --m_validEntries;
+    lruProps.setEvicted();
+  }
+};
+
+// a TINY_LFU map outside of a region, its evictions destroy the entries
+class TestTinyLFUMap : public LRUEntriesMap {
+ public:
+  explicit TestTinyLFUMap(uint32_t limit)
+      : LRUEntriesMap(nullptr, std::unique_ptr<EntryFactory>(
+                                   new LRUEntryFactory(false)),
+                      nullptr, LRUAction::LOCAL_DESTROY, limit, false, 16,
+                      false, false, EvictionPolicyType::TINY_LFU) {
+    open(16);
+  }
+
+  void put(int key) {
+    MapEntryImplPtr me;
+    CacheablePtr oldValue;
+    ASSERT_EQ(GF_NOERR, LRUEntriesMap::put(CacheableInt32::create(key),
+                                           CacheableInt32::create(key), me,
+                                           oldValue, -1, 0, nullptr));
+  }
+
+  bool get(int key) {
+    CacheablePtr value;
+    MapEntryImplPtr me;
+    return LRUEntriesMap::get(CacheableInt32::create(key), value, me);
+  }
+
+  bool remove(int key) {
+    CacheablePtr oldValue;
+    MapEntryImplPtr me;
+    return LRUEntriesMap::remove(CacheableInt32::create(key), oldValue, me,
+                                 -1, nullptr, false) == GF_NOERR;
+  }
+
+  bool contains(int key) const {
+    return containsKey(CacheableInt32::create(key));
+  }
+
+  // adds the entry of the key to the window again, as a put does when it
+  // gives a value back to an entry that was destroyed
+  void addAgain(int key) {
+    MapEntryImplPtr me;
+    CacheablePtr value;
+    getEntry(CacheableInt32::create(key), me, value);
+    addToLRU(me);
+  }
+
+  // the key of the entry taken off the window or the main list, -1 if none
+  int takeFromWindow() { return take(m_windowList, true); }
+
+  int takeFromMain() { return take(m_lruList, false); }
+
+  bool isEvicted(int key) {
+    MapEntryImplPtr me;
+    CacheablePtr value;
+    getEntry(CacheableInt32::create(key), me, value);
+    return me->getLRUProperties().testEvicted();
+  }
+
+  uint32_t windowSize() const { return m_windowSize; }
+
+ private:
+  int take(LRUList<MapEntryImpl, MapEntryT<LRUMapEntry, 0, 0> >& list,
+           bool window) {
+    MapEntryImplPtr entry;
+    takeFromList(list, window, entry);
+    if (entry == nullptr) {
+      return -1;
+    }
+    CacheableKeyPtr key;
+    entry->getKeyI(key);
+    return std::static_pointer_cast<CacheableInt32>(key)->value();
+  }
+};
+
+std::string asString(const CacheablePtr& value) {
+  return std::static_pointer_cast<CacheableString>(value)->asChar();
+}
+
+class LRUEntriesMapTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    m_pm = std::make_shared<TestPersistenceManager>();
+    m_map.reset(new TestOverflowMap(m_pm));
+    m_key = CacheableString::create("key");
+    CacheablePtr value = CacheableString::create("value");
+    MapEntryImplPtr me;
+    CacheablePtr oldValue;
+    ASSERT_EQ(GF_NOERR,
+              m_map->put(m_key, value, me, oldValue, -1, 0, nullptr));
+    m_pm->setValue(value);
+    m_map->overflow(m_key);
+  }
+
+  std::shared_ptr<TestPersistenceManager> m_pm;
+  std::unique_ptr<TestOverflowMap> m_map;
+  CacheableKeyPtr m_key;
+};
+
+}  // namespace
+
+TEST_F(LRUEntriesMapTest, GetReadsOverflowedValue) {
+  CacheablePtr value;
+  MapEntryImplPtr me;
+  ASSERT_TRUE(m_map->get(m_key, value, me));
+  EXPECT_EQ("value", asString(value));
+  EXPECT_EQ(1, m_pm->reads());
+  // the value is back in memory
+  ASSERT_TRUE(m_map->get(m_key, value, me));
+  EXPECT_EQ(1, m_pm->reads());
+}
+
+TEST_F(LRUEntriesMapTest, ConcurrentGetsShareOneRead) {
+  m_pm->blockNextRead();
+  CacheablePtr first;
+  CacheablePtr second;
+  bool firstFound = false;
+  bool secondFound = false;
+  std::thread firstGet([this, &first, &firstFound] {
+    MapEntryImplPtr me;
+    firstFound = m_map->get(m_key, first, me);
+  });
+  m_pm->waitForBlockedRead();
+  std::thread secondGet([this, &second, &secondFound] {
+    MapEntryImplPtr me;
+    secondFound = m_map->get(m_key, second, me);
+  });
+  // lets the second get start waiting for the read of the first
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  m_pm->releaseRead();
+  firstGet.join();
+  secondGet.join();
+
+  ASSERT_TRUE(firstFound);
+  ASSERT_TRUE(secondFound);
+  EXPECT_EQ("value", asString(first));
+  EXPECT_EQ("value", asString(second));
+  EXPECT_EQ(1, m_pm->reads());
+}
+
+TEST_F(LRUEntriesMapTest, FailedReadLetsWaitersGo) {
+  m_pm->setFail();
+  m_pm->blockNextRead();
+  bool firstFound = true;
+  bool secondFound = true;
+  std::thread firstGet([this, &firstFound] {
+    CacheablePtr value;
+    MapEntryImplPtr me;
+    firstFound = m_map->get(m_key, value, me);
+  });
+  m_pm->waitForBlockedRead();
+  std::thread secondGet([this, &secondFound] {
+    CacheablePtr value;
+    MapEntryImplPtr me;
+    secondFound = m_map->get(m_key, value, me);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  m_pm->releaseRead();
+  firstGet.join();
+  secondGet.join();
+
+  EXPECT_FALSE(firstFound);
+  EXPECT_FALSE(secondFound);
+}
+
+TEST_F(LRUEntriesMapTest, PutDuringReadIsNotAMiss) {
+  m_pm->blockNextRead();
+  CacheablePtr value;
+  bool found = false;
+  std::thread get([this, &value, &found] {
+    MapEntryImplPtr me;
+    found = m_map->get(m_key, value, me);
+  });
+  m_pm->waitForBlockedRead();
+  // destroys the record the get is reading
+  MapEntryImplPtr me;
+  CacheablePtr oldValue;
+  ASSERT_EQ(GF_NOERR, m_map->put(m_key, CacheableString::create("newValue"),
+                                 me, oldValue, -1, 0, nullptr));
+  m_pm->releaseRead();
+  get.join();
+
+  ASSERT_TRUE(found);
+  EXPECT_EQ("newValue", asString(value));
+}
+
+TEST_F(LRUEntriesMapTest, DestroyDuringReadIsAMiss) {
+  m_pm->blockNextRead();
+  CacheablePtr value;
+  bool found = true;
+  std::thread get([this, &value, &found] {
+    MapEntryImplPtr me;
+    found = m_map->get(m_key, value, me);
+  });
+  m_pm->waitForBlockedRead();
+  CacheablePtr oldValue;
+  MapEntryImplPtr me;
+  ASSERT_EQ(GF_NOERR,
+            m_map->remove(m_key, oldValue, me, -1, nullptr, false));
+  m_pm->releaseRead();
+  get.join();
+
+  EXPECT_FALSE(found);
+  EXPECT_EQ(nullptr, value);
+}
+
+TEST(TinyLFUTest, EntriesStayAtTheLimit) {
+  TestTinyLFUMap map(100);
+  for (int key = 0; key < 1000; key++) {
+    map.put(key);
+    ASSERT_GE(100u, map.size());
+  }
+  EXPECT_EQ(100u, map.size());
+  EXPECT_GE(1u, map.windowSize());
+}
+
+TEST(TinyLFUTest, ScanDoesNotEvictHotKeys) {
+  TestTinyLFUMap map(100);
+  for (int key = 0; key < 100; key++) {
+    map.put(key);
+  }
+  // fewer uses in all than the sketch counts before it halves its counters
+  for (int round = 0; round < 5; round++) {
+    for (int key = 0; key < 20; key++) {
+      ASSERT_TRUE(map.get(key));
+    }
+  }
+  for (int key = 1000; key < 1500; key++) {
+    map.put(key);
+  }
+
+  EXPECT_EQ(100u, map.size());
+  for (int key = 0; key < 20; key++) {
+    EXPECT_TRUE(map.contains(key)) << "hot key " << key << " evicted";
+  }
+}
+
+TEST(TinyLFUTest, RemovedEntriesAreNotEvicted) {
+  TestTinyLFUMap map(100);
+  for (int key = 0; key < 100; key++) {
+    map.put(key);
+  }
+  // leaves nodes of destroyed entries in the main list and the window
+  for (int key = 0; key < 50; key++) {
+    ASSERT_TRUE(map.remove(key));
+  }
+  ASSERT_TRUE(map.remove(99));
+  EXPECT_EQ(0u, map.windowSize());
+
+  for (int key = 1000; key < 1100; key++) {
+    map.put(key);
+  }
+  EXPECT_EQ(100u, map.size());
+}
+
+TEST(TinyLFUTest, StaleMainNodeIsDropped) {
+  TestTinyLFUMap map(100);
+  for (int key = 0; key < 10; key++) {
+    map.put(key);
+  }
+  // 0 goes back to the window, which spills 9 into the main list
+  map.addAgain(0);
+  EXPECT_EQ(1u, map.windowSize());
+
+  EXPECT_EQ(1, map.takeFromMain());
+  EXPECT_EQ(0, map.takeFromWindow());
+}
+
+TEST(TinyLFUTest, StaleLastMainNodeLeavesEntryInWindow) {
+  TestTinyLFUMap map(1000);
+  // the window holds ten entries, 0 spills into the main list
+  for (int key = 0; key <= 10; key++) {
+    map.put(key);
+  }
+  ASSERT_EQ(1, map.takeFromWindow());
+  map.addAgain(0);
+  ASSERT_EQ(10u, map.windowSize());
+
+  // the node of 0 is the last of the main list
+  EXPECT_EQ(-1, map.takeFromMain());
+  EXPECT_FALSE(map.isEvicted(0));
+  for (int key = 2; key <= 10; key++) {
+    ASSERT_EQ(key, map.takeFromWindow());
+  }
+  EXPECT_EQ(0, map.takeFromWindow());
+}
+
+TEST(TinyLFUTest, StaleWindowNodeIsDropped) {
+  TestTinyLFUMap map(1000);
+  for (int key = 0; key <= 10; key++) {
+    map.put(key);
+  }
+  // 1 is in the window twice, the first of its nodes spills into the main
+  // list with the next put
+  map.addAgain(1);
+  map.put(11);
+  ASSERT_EQ(10u, map.windowSize());
+
+  for (int key = 2; key <= 10; key++) {
+    ASSERT_EQ(key, map.takeFromWindow());
+  }
+  EXPECT_EQ(11, map.takeFromWindow());
+  EXPECT_EQ(0, map.takeFromMain());
+  EXPECT_EQ(1, map.takeFromMain());
+}
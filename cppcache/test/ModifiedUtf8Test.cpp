@@ -0,0 +1,288 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <DataInputInternal.hpp>
+#include <DataOutputInternal.hpp>
+#include <ModifiedUtf8.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+// Characters worth mixing into the ASCII runs: NUL, the upper half of a
+// byte, two and three byte encodings and both halves of a surrogate pair.
+const wchar_t SPECIAL_CHARS[] = {0,      0x7F,   0x80,   0xE9,  0x7FF,
+                                 0x800,  0xFFFF, 0xD83D, 0xDE00};
+
+class ModifiedUtf8Test
+    : public ::testing::TestWithParam<ModifiedUtf8::Implementation> {
+ protected:
+  std::mt19937 m_random;
+
+  void SetUp() override {
+    m_previous = ModifiedUtf8::getImplementation();
+    ASSERT_TRUE(ModifiedUtf8::setImplementation(GetParam()));
+  }
+
+  void TearDown() override { ModifiedUtf8::setImplementation(m_previous); }
+
+  // mostly ASCII with a special character at a random position, so that
+  // runs end anywhere inside and beyond a vector
+  std::wstring randomString(size_t length) {
+    std::wstring value;
+    for (size_t i = 0; i < length; i++) {
+      value += static_cast<wchar_t>('a' + m_random() % 26);
+    }
+    if (length > 0 && m_random() % 4 != 0) {
+      value[m_random() % length] =
+          SPECIAL_CHARS[m_random() % (sizeof(SPECIAL_CHARS) / sizeof(wchar_t))];
+    }
+    return value;
+  }
+
+  static std::string narrowed(const std::wstring& value) {
+    std::string result;
+    for (wchar_t c : value) result += static_cast<char>(c);
+    return result;
+  }
+
+  // the encoding as done by DataOutput before it was vectorized
+  static std::vector<uint8_t> encode(const std::wstring& value) {
+    std::vector<uint8_t> bytes;
+    for (wchar_t ch : value) {
+      uint16_t c = static_cast<uint16_t>(ch);
+      if (c == 0) {
+        bytes.push_back(0xc0);
+        bytes.push_back(0x80);
+      } else if (c < 0x80) {
+        bytes.push_back(static_cast<uint8_t>(c));
+      } else if (c < 0x800) {
+        bytes.push_back(static_cast<uint8_t>(0xC0 | c >> 6));
+        bytes.push_back(static_cast<uint8_t>(0x80 | (c & 0x3F)));
+      } else {
+        bytes.push_back(static_cast<uint8_t>(0xE0 | c >> 12));
+        bytes.push_back(static_cast<uint8_t>(0x80 | ((c >> 6) & 0x3F)));
+        bytes.push_back(static_cast<uint8_t>(0x80 | (c & 0x3F)));
+      }
+    }
+    return bytes;
+  }
+
+ private:
+  ModifiedUtf8::Implementation m_previous;
+};
+
+TEST_P(ModifiedUtf8Test, AsciiLengthStopsAtFirstSpecialChar) {
+  for (size_t length = 0; length < 100; length++) {
+    std::wstring value = randomString(length);
+    size_t expected = 0;
+    while (expected < length && value[expected] > 0 && value[expected] < 0x80) {
+      expected++;
+    }
+    EXPECT_EQ(expected, ModifiedUtf8::asciiLength(value.data(), length));
+
+    // narrowing may turn a special character into an ASCII one
+    std::string chars = narrowed(value);
+    std::vector<uint8_t> bytes(chars.begin(), chars.end());
+    size_t charsExpected = 0;
+    while (charsExpected < length && bytes[charsExpected] > 0 &&
+           bytes[charsExpected] < 0x80) {
+      charsExpected++;
+    }
+    EXPECT_EQ(charsExpected, ModifiedUtf8::asciiLength(chars.data(), length));
+    // NUL is a single byte when decoding
+    size_t bytesExpected = 0;
+    while (bytesExpected < length && bytes[bytesExpected] < 0x80) {
+      bytesExpected++;
+    }
+    EXPECT_EQ(bytesExpected, ModifiedUtf8::asciiLength(bytes.data(), length));
+  }
+}
+
+TEST_P(ModifiedUtf8Test, AsciiLengthDoesNotReadPastLength) {
+  std::string chars(64, 'a');
+  chars += '\x80';
+  for (size_t length = 0; length < 64; length++) {
+    EXPECT_EQ(length, ModifiedUtf8::asciiLength(chars.data(), length));
+  }
+}
+
+TEST_P(ModifiedUtf8Test, WidenAndNarrowRoundTrip) {
+  for (size_t length = 0; length < 100; length++) {
+    std::vector<uint8_t> bytes(length);
+    for (auto& b : bytes) b = static_cast<uint8_t>(m_random() % 0x80);
+    std::vector<wchar_t> wide(length + 1, L'x');
+    ModifiedUtf8::widen(bytes.data(), length, wide.data());
+    for (size_t i = 0; i < length; i++) {
+      ASSERT_EQ(static_cast<wchar_t>(bytes[i]), wide[i]);
+    }
+    EXPECT_EQ(L'x', wide[length]);
+
+    std::vector<uint8_t> narrow(length + 1, 0xFF);
+    ModifiedUtf8::narrow(wide.data(), length, narrow.data());
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), narrow.begin()));
+    EXPECT_EQ(0xFF, narrow[length]);
+  }
+}
+
+TEST_P(ModifiedUtf8Test, Utf16RoundTrip) {
+  for (size_t length = 0; length < 100; length++) {
+    std::wstring value = randomString(length);
+    std::vector<uint8_t> bytes(length * 2 + 1, 0xFF);
+    ModifiedUtf8::toUtf16(value.data(), length, bytes.data());
+    for (size_t i = 0; i < length; i++) {
+      ASSERT_EQ(static_cast<uint8_t>(value[i] >> 8), bytes[2 * i]);
+      ASSERT_EQ(static_cast<uint8_t>(value[i] & 0xFF), bytes[2 * i + 1]);
+    }
+    EXPECT_EQ(0xFF, bytes[length * 2]);
+    std::wstring wide(length, L'x');
+    ModifiedUtf8::fromUtf16(bytes.data(), length, &wide[0]);
+    EXPECT_EQ(value, wide);
+
+    std::string chars = narrowed(value);
+    ModifiedUtf8::toUtf16(chars.data(), length, bytes.data());
+    for (size_t i = 0; i < length; i++) {
+      ASSERT_EQ(0, bytes[2 * i]);
+      ASSERT_EQ(static_cast<uint8_t>(chars[i]), bytes[2 * i + 1]);
+    }
+    std::string narrow(length, 'x');
+    ModifiedUtf8::fromUtf16(bytes.data(), length, &narrow[0]);
+    EXPECT_EQ(chars, narrow);
+  }
+}
+
+TEST_P(ModifiedUtf8Test, WideStringsMatchScalarEncoding) {
+  for (size_t length = 1; length < 100; length++) {
+    std::wstring value = randomString(length);
+    std::vector<uint8_t> expected = encode(value);
+
+    DataOutputInternal output;
+    output.writeUTF(value.data(), static_cast<uint32_t>(length));
+    uint32_t written;
+    const uint8_t* bytes = output.getBuffer(&written);
+    ASSERT_EQ(expected.size() + 2, written);
+    EXPECT_EQ(expected.size(), static_cast<size_t>(bytes[0] << 8 | bytes[1]));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bytes + 2));
+
+    DataInputInternal input(bytes, written, nullptr);
+    wchar_t* decoded;
+    uint16_t decodedLength;
+    input.readUTF(&decoded, &decodedLength);
+    EXPECT_EQ(value, std::wstring(decoded, decodedLength));
+    DataInput::freeUTFMemory(decoded);
+  }
+}
+
+TEST_P(ModifiedUtf8Test, EmbeddedNulsRoundTrip) {
+  std::string value("abc\0def\0", 8);
+  value += std::string(40, 'g') + '\0' + "\xE9";
+
+  DataOutputInternal output;
+  output.writeUTF(value.data(), static_cast<uint32_t>(value.size()));
+  uint32_t written;
+  const uint8_t* bytes = output.getBuffer(&written);
+  // each NUL and the upper half character take two bytes
+  ASSERT_EQ(2 + value.size() + 4, written);
+  EXPECT_EQ(0xc0, bytes[2 + 3]);
+  EXPECT_EQ(0x80, bytes[2 + 4]);
+
+  DataInputInternal input(bytes, written, nullptr);
+  char* decoded;
+  uint16_t decodedLength;
+  input.readUTF(&decoded, &decodedLength);
+  EXPECT_EQ(value, std::string(decoded, decodedLength));
+  DataInput::freeUTFMemory(decoded);
+}
+
+TEST_P(ModifiedUtf8Test, SurrogatePairsAreEncodedSeparately) {
+  // U+1F600 as a UTF-16 surrogate pair between ASCII runs
+  std::wstring value(20, L'a');
+  value += static_cast<wchar_t>(0xD83D);
+  value += static_cast<wchar_t>(0xDE00);
+  value += std::wstring(20, L'b');
+
+  DataOutputInternal output;
+  output.writeUTF(value.data(), static_cast<uint32_t>(value.size()));
+  uint32_t written;
+  const uint8_t* bytes = output.getBuffer(&written);
+  const uint8_t pair[] = {0xED, 0xA0, 0xBD, 0xED, 0xB8, 0x80};
+  ASSERT_EQ(2 + 40 + sizeof(pair), written);
+  EXPECT_EQ(0, std::memcmp(pair, bytes + 2 + 20, sizeof(pair)));
+
+  DataInputInternal input(bytes, written, nullptr);
+  wchar_t* decoded;
+  uint16_t decodedLength;
+  input.readUTF(&decoded, &decodedLength);
+  EXPECT_EQ(value, std::wstring(decoded, decodedLength));
+  DataInput::freeUTFMemory(decoded);
+}
+
+TEST_P(ModifiedUtf8Test, HugeStringsRoundTrip) {
+  std::wstring value = randomString(1000);
+  value[10] = static_cast<wchar_t>(0xD83D);
+  value[11] = static_cast<wchar_t>(0xDE00);
+
+  DataOutputInternal output;
+  output.writeUTFHuge(value.data(), static_cast<uint32_t>(value.size()));
+  uint32_t written;
+  const uint8_t* bytes = output.getBuffer(&written);
+  ASSERT_EQ(4 + value.size() * 2, written);
+
+  DataInputInternal input(bytes, written, nullptr);
+  wchar_t* decoded;
+  uint32_t decodedLength;
+  input.readUTFHuge(&decoded, &decodedLength);
+  EXPECT_EQ(value, std::wstring(decoded, decodedLength));
+  DataInput::freeUTFMemory(decoded);
+}
+
+TEST_P(ModifiedUtf8Test, GetDecodedLengthMatchesEncodedLength) {
+  for (size_t length = 1; length < 100; length++) {
+    std::wstring value = randomString(length);
+    std::vector<uint8_t> bytes = encode(value);
+    EXPECT_EQ(static_cast<int32_t>(bytes.size()),
+              DataOutput::getEncodedLength(value.data(),
+                                           static_cast<int32_t>(length)));
+    EXPECT_EQ(static_cast<int32_t>(length),
+              DataInput::getDecodedLength(bytes.data(),
+                                          static_cast<int32_t>(bytes.size())));
+  }
+}
+
+// only what this CPU supports, everything is compared with the scalar code
+std::vector<ModifiedUtf8::Implementation> supportedImplementations() {
+  std::vector<ModifiedUtf8::Implementation> implementations;
+  for (auto implementation :
+       {ModifiedUtf8::SCALAR, ModifiedUtf8::SSE42, ModifiedUtf8::AVX2}) {
+    if (ModifiedUtf8::isSupported(implementation)) {
+      implementations.push_back(implementation);
+    }
+  }
+  return implementations;
+}
+
+INSTANTIATE_TEST_CASE_P(Implementations, ModifiedUtf8Test,
+                        ::testing::ValuesIn(supportedImplementations()));
+}  // namespace
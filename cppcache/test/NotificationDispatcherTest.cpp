@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <NotificationDispatcher.hpp>
+
+using namespace apache::geode::client;
+
+TEST(NotificationDispatcherTest, KeepsOrderOfShard) {
+  NotificationDispatcher dispatcher(4);
+  dispatcher.start();
+  const size_t shards = 16;
+  const int ops = 1000;
+  // only the thread of a shard writes its entry
+  std::vector<int> last(shards, -1);
+  std::atomic<int> outOfOrder(0);
+  for (int i = 0; i < ops; i++) {
+    for (size_t shard = 0; shard < shards; shard++) {
+      ASSERT_TRUE(dispatcher.dispatch(shard, [&last, &outOfOrder, shard, i] {
+        if (last[shard] != i - 1) {
+          ++outOfOrder;
+        }
+        last[shard] = i;
+      }));
+    }
+  }
+  dispatcher.barrier();
+  EXPECT_EQ(0, outOfOrder.load());
+  for (size_t shard = 0; shard < shards; shard++) {
+    EXPECT_EQ(ops - 1, last[shard]);
+  }
+  dispatcher.stop();
+}
+
+TEST(NotificationDispatcherTest, BarrierWaitsForQueued) {
+  NotificationDispatcher dispatcher(2);
+  dispatcher.start();
+  std::atomic<int> done(0);
+  for (size_t shard = 0; shard < 2; shard++) {
+    dispatcher.dispatch(shard, [&done] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      ++done;
+    });
+  }
+  dispatcher.barrier();
+  EXPECT_EQ(2, done.load());
+  dispatcher.stop();
+}
+
+TEST(NotificationDispatcherTest, StopDispatchesQueued) {
+  NotificationDispatcher dispatcher(1);
+  dispatcher.start();
+  std::atomic<int> done(0);
+  for (int i = 0; i < 100; i++) {
+    dispatcher.dispatch(0, [&done] { ++done; });
+  }
+  dispatcher.stop();
+  EXPECT_EQ(100, done.load());
+  EXPECT_FALSE(dispatcher.dispatch(0, [&done] { ++done; }));
+  EXPECT_EQ(100, done.load());
+}
+
+TEST(NotificationDispatcherTest, HoldsBackWhenFull) {
+  NotificationDispatcher dispatcher(1, 2);
+  dispatcher.start();
+  std::atomic<bool> blocked(true);
+  std::atomic<int> done(0);
+  dispatcher.dispatch(0, [&blocked, &done] {
+    while (blocked) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ++done;
+  });
+  std::atomic<int> dispatched(0);
+  std::thread reader([&dispatcher, &done, &dispatched] {
+    for (int i = 0; i < 4; i++) {
+      dispatcher.dispatch(0, [&done] { ++done; });
+      ++dispatched;
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  // the first operation may not have been taken off the queue yet
+  EXPECT_LE(dispatched.load(), 2);
+  blocked = false;
+  reader.join();
+  dispatcher.barrier();
+  EXPECT_EQ(4, dispatched.load());
+  EXPECT_EQ(5, done.load());
+  dispatcher.stop();
+}
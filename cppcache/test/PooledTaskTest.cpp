@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ThreadPool.hpp>
+
+using namespace apache::geode::client;
+
+TEST(PooledTaskTest, DeliversResult) {
+  ThreadPool threadPool(2);
+  auto task = new PooledTask<int>([] { return 42; });
+  auto future = task->getFuture();
+  threadPool.perform(task);
+  EXPECT_EQ(42, future.get());
+}
+
+TEST(PooledTaskTest, DeliversException) {
+  ThreadPool threadPool(2);
+  auto task =
+      new PooledTask<void>([] { throw std::runtime_error("pooled task"); });
+  auto future = task->getFuture();
+  threadPool.perform(task);
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(PooledTaskTest, ShutDownWaitsForRunningTask) {
+  ThreadPool threadPool(2);
+  std::promise<void> started;
+  std::atomic<bool> finished(false);
+  auto task = new PooledTask<void>([&started, &finished] {
+    started.set_value();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    finished = true;
+  });
+  threadPool.perform(task);
+  started.get_future().wait();
+  threadPool.shutDown();
+  EXPECT_TRUE(finished);
+}
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <geode/AttributesFactory.hpp>
+#include <geode/EvictionPolicyType.hpp>
+#include <geode/RegionAttributes.hpp>
+
+#include <DataInputInternal.hpp>
+#include <DataOutputInternal.hpp>
+#include <SerializationRegistry.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+class DataOutputUnderTest : public DataOutputInternal {
+ public:
+  using DataOutputInternal::DataOutputInternal;
+
+ protected:
+  virtual const SerializationRegistry& getSerializationRegistry()
+      const override {
+    return m_serializationRegistry;
+  }
+
+ private:
+  SerializationRegistry m_serializationRegistry;
+};
+
+class DataInputUnderTest : public DataInputInternal {
+ public:
+  using DataInputInternal::DataInputInternal;
+
+  virtual const SerializationRegistry& getSerializationRegistry()
+      const override {
+    return m_serializationRegistry;
+  }
+
+ private:
+  SerializationRegistry m_serializationRegistry;
+};
+
+}  // namespace
+
+TEST(RegionAttributesTest, SerializesEvictionPolicyAndExpectedEntries) {
+  AttributesFactory factory;
+  factory.setLruEntriesLimit(1000);
+  factory.setEvictionPolicy(EvictionPolicyType::TINY_LFU);
+  factory.setExpectedEntries(100000);
+  auto attributes = factory.createRegionAttributes();
+
+  DataOutputUnderTest out;
+  attributes->toData(out);
+  DataInputUnderTest in(out.getBuffer(), out.getBufferLength(), nullptr);
+  std::unique_ptr<RegionAttributes> copy(static_cast<RegionAttributes*>(
+      RegionAttributes::createDeserializable()));
+  copy->fromData(in);
+
+  EXPECT_EQ(EvictionPolicyType::TINY_LFU, copy->getEvictionPolicy());
+  EXPECT_EQ(100000, copy->getExpectedEntries());
+  EXPECT_EQ(1000u, copy->getLruEntriesLimit());
+  EXPECT_TRUE(*attributes == *copy);
+}
+
+TEST(RegionAttributesTest, SerializesConcurrentReads) {
+  AttributesFactory factory;
+  factory.setConcurrentReadsEnabled(true);
+  auto attributes = factory.createRegionAttributes();
+
+  DataOutputUnderTest out;
+  attributes->toData(out);
+  DataInputUnderTest in(out.getBuffer(), out.getBufferLength(), nullptr);
+  std::unique_ptr<RegionAttributes> copy(static_cast<RegionAttributes*>(
+      RegionAttributes::createDeserializable()));
+  copy->fromData(in);
+
+  EXPECT_TRUE(copy->getConcurrentReadsEnabled());
+  EXPECT_TRUE(*attributes == *copy);
+}
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <util/concurrent/shared_spinlock_mutex.hpp>
+
+using apache::geode::util::concurrent::shared_spinlock_mutex;
+using apache::geode::util::concurrent::shared_lock_guard;
+
+TEST(SharedSpinlockMutexTest, ExclusiveByDefault) {
+  shared_spinlock_mutex mutex;
+  EXPECT_FALSE(mutex.shared_readers_enabled());
+  { std::lock_guard<shared_spinlock_mutex> guard(mutex); }
+  { shared_lock_guard<shared_spinlock_mutex> guard(mutex); }
+}
+
+TEST(SharedSpinlockMutexTest, ReadersShareTheLock) {
+  shared_spinlock_mutex mutex;
+  mutex.enable_shared_readers();
+  EXPECT_TRUE(mutex.shared_readers_enabled());
+
+  std::atomic<int> holding(0);
+  std::atomic<bool> release(false);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; i++) {
+    readers.emplace_back([&]() {
+      shared_lock_guard<shared_spinlock_mutex> guard(mutex);
+      holding++;
+      while (!release) std::this_thread::yield();
+    });
+  }
+  // all readers must be able to hold the lock at the same time
+  while (holding < 4) std::this_thread::yield();
+  release = true;
+  for (auto& reader : readers) reader.join();
+}
+
+TEST(SharedSpinlockMutexTest, WritersExcludeReaders) {
+  shared_spinlock_mutex mutex;
+  mutex.enable_shared_readers();
+
+  // the two halves are only ever observed equal under the lock
+  int64_t first = 0;
+  int64_t second = 0;
+  std::atomic<bool> torn(false);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; t++) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 20000; i++) {
+        std::lock_guard<shared_spinlock_mutex> guard(mutex);
+        ++first;
+        ++second;
+      }
+    });
+  }
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 20000; i++) {
+        shared_lock_guard<shared_spinlock_mutex> guard(mutex);
+        if (first != second) torn = true;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_FALSE(torn);
+  EXPECT_EQ(40000, first);
+  EXPECT_EQ(40000, second);
+}
@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <geode/CacheableBuiltins.hpp>
+
+#include <SubBatchRunner.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+class CountingWork : public PooledWork<GfErrType> {
+ public:
+  CountingWork(const BucketServerLocationPtr& serverLocation,
+               const VectorOfCacheableKeyPtr& keys, std::atomic<int>& inFlight,
+               std::atomic<int>& maxInFlight)
+      : m_serverLocation(serverLocation),
+        m_keys(keys),
+        m_inFlight(inFlight),
+        m_maxInFlight(maxInFlight) {}
+
+  BucketServerLocationPtr getServerLocation() { return m_serverLocation; }
+  VectorOfCacheableKeyPtr getKeys() { return m_keys; }
+
+ protected:
+  GfErrType execute() override {
+    int inFlight = ++m_inFlight;
+    int max = m_maxInFlight;
+    while (inFlight > max &&
+           !m_maxInFlight.compare_exchange_weak(max, inFlight)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    m_inFlight--;
+    return GF_NOERR;
+  }
+
+ private:
+  BucketServerLocationPtr m_serverLocation;
+  VectorOfCacheableKeyPtr m_keys;
+  std::atomic<int>& m_inFlight;
+  std::atomic<int>& m_maxInFlight;
+};
+
+typedef SubBatchRunner<CountingWork> Runner;
+
+VectorOfCacheableKeyPtr makeKeys(int first, int count) {
+  auto keys = std::make_shared<VectorOfCacheableKey>();
+  for (int i = first; i < first + count; i++) {
+    keys->push_back(CacheableInt32::create(i));
+  }
+  return keys;
+}
+
+TEST(SubBatchRunnerTest, SmallKeySetIsOneBatch) {
+  auto keys = makeKeys(0, static_cast<int>(Runner::MIN_BATCH_KEYS));
+  auto batches = Runner::split(keys, Runner::WINDOW);
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_EQ(keys, batches.front());
+
+  batches = Runner::split(nullptr, Runner::WINDOW);
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_EQ(nullptr, batches.front());
+}
+
+TEST(SubBatchRunnerTest, SplitsIntoBoundedBatches) {
+  auto keys = makeKeys(0, 1001);
+  auto batches = Runner::split(keys, 4);
+  ASSERT_EQ(4u, batches.size());
+  size_t total = 0;
+  int next = 0;
+  for (const auto& batch : batches) {
+    EXPECT_GE(batch->size(), 250u);
+    EXPECT_LE(batch->size(), 251u);
+    for (const auto& key : *batch) {
+      EXPECT_EQ(next++,
+                std::dynamic_pointer_cast<CacheableInt32>(key)->value());
+    }
+    total += batch->size();
+  }
+  EXPECT_EQ(1001u, total);
+
+  keys = makeKeys(0, 100000);
+  batches = Runner::split(keys, 4);
+  EXPECT_EQ(20u, batches.size());
+  for (const auto& batch : batches) {
+    EXPECT_EQ(Runner::MAX_BATCH_KEYS, batch->size());
+  }
+}
+
+TEST(SubBatchRunnerTest, RunsAllBatchesWithBoundedWindow) {
+  ThreadPool threadPool(16);
+  std::atomic<int> inFlight(0);
+  std::atomic<int> maxInFlight(0);
+  // two servers sharing four connections, two batches each in flight
+  Runner runner(&threadPool, 4,
+                [&](const BucketServerLocationPtr& serverLocation,
+                    const VectorOfCacheableKeyPtr& keys) {
+                  return new CountingWork(serverLocation, keys, inFlight,
+                                          maxInFlight);
+                });
+  auto server1 = std::make_shared<BucketServerLocation>("host1:40401");
+  auto server2 = std::make_shared<BucketServerLocation>("host2:40402");
+  runner.add(server1, makeKeys(0, 12000));
+  runner.add(server2, makeKeys(12000, 3000));
+
+  int keys1 = 0;
+  int keys2 = 0;
+  int works = 0;
+  while (CountingWork* work = runner.next()) {
+    EXPECT_EQ(GF_NOERR, work->getResult());
+    if (work->getServerLocation() == server1) {
+      keys1 += static_cast<int>(work->getKeys()->size());
+    } else {
+      keys2 += static_cast<int>(work->getKeys()->size());
+    }
+    works++;
+    delete work;
+  }
+
+  EXPECT_EQ(12000, keys1);
+  EXPECT_EQ(3000, keys2);
+  EXPECT_EQ(3 + 2, works);
+  EXPECT_LE(maxInFlight, 4);
+}
+}  // namespace
@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ace/INET_Addr.h>
+#include <ace/SOCK_Acceptor.h>
+#include <ace/SOCK_Stream.h>
+
+#include <TcpConn.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+// sends the buffers with one sendv over a loopback connection, checks that
+// they all arrive in order
+void sendvOverLoopback(const std::vector<std::string>& buffers) {
+  ACE_INET_Addr any(static_cast<u_short>(0), "127.0.0.1");
+  ACE_SOCK_Acceptor acceptor(any, 1);
+  ACE_INET_Addr local;
+  ASSERT_EQ(0, acceptor.get_local_addr(local));
+
+  const int32_t count = static_cast<int32_t>(buffers.size());
+  std::vector<iovec> segments(count);
+  size_t total = 0;
+  for (int32_t i = 0; i < count; i++) {
+    segments[i].iov_base = const_cast<char*>(buffers[i].data());
+    segments[i].iov_len = buffers[i].size();
+    total += buffers[i].size();
+  }
+
+  std::string received;
+  std::thread reader([&acceptor, &received, total] {
+    ACE_SOCK_Stream stream;
+    if (acceptor.accept(stream) == -1) {
+      return;
+    }
+    received.resize(total);
+    stream.recv_n(&received[0], total);
+    stream.close();
+  });
+
+  std::string address =
+      "127.0.0.1:" + std::to_string(local.get_port_number());
+  TcpConn conn(address.c_str(), 10, 64 * 1024);
+  conn.init();
+  int32_t sent = conn.sendv(segments.data(), count, 10 * 1000 * 1000, 0);
+  reader.join();
+
+  EXPECT_EQ(static_cast<int32_t>(total), sent);
+  std::string expected;
+  for (const auto& buffer : buffers) {
+    expected += buffer;
+  }
+  EXPECT_EQ(expected, received);
+}
+}  // namespace
+
+TEST(TcpConnTest, SendvMoreSegmentsThanIovMax) {
+  const int32_t count = 3 * ACE_IOV_MAX + 7;
+  std::vector<std::string> buffers;
+  for (int32_t i = 0; i < count; i++) {
+    buffers.push_back(std::string(16, static_cast<char>('a' + i % 26)));
+  }
+  sendvOverLoopback(buffers);
+}
+
+TEST(TcpConnTest, SendvSplitsSegmentsAtChunkSize) {
+  // the writes of the chunk size end within the segments
+  const size_t segmentSize = TcpConn::getDefaultChunkSize() / 3 + 1;
+  std::vector<std::string> buffers;
+  for (int32_t i = 0; i < 5; i++) {
+    buffers.push_back(std::string(segmentSize, static_cast<char>('a' + i)));
+  }
+  sendvOverLoopback(buffers);
+}
@@ -0,0 +1,169 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <geode/ExceptionTypes.hpp>
+
+#include <Queue.hpp>
+#include <TcrChunkedContext.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+struct DecodedInt : public TcrDecodedChunk {
+  int32_t m_value;
+};
+
+// collects the int each chunk holds, decoded ahead of its turn or not
+class IntResult : public TcrChunkedResult {
+ public:
+  explicit IntResult(bool decodeAhead) : m_decodeAhead(decodeAhead) {}
+
+  std::vector<int32_t> m_values;
+
+  void reset() override { m_values.clear(); }
+
+ protected:
+  void handleChunk(const uint8_t* bytes, int32_t len,
+                   uint8_t isLastChunkWithSecurity,
+                   const Cache* cache) override {
+    int32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    if (value < 0) {
+      throw IllegalStateException("negative value");
+    }
+    m_values.push_back(value);
+  }
+
+  TcrDecodedChunkPtr decodeChunk(const ReceiveBufferPtr& buffer,
+                                 uint8_t isLastChunkWithSecurity,
+                                 const Cache* cache) override {
+    if (!m_decodeAhead) {
+      return nullptr;
+    }
+    std::unique_ptr<DecodedInt> decoded(new DecodedInt());
+    std::memcpy(&decoded->m_value, buffer->getBytes(), sizeof(int32_t));
+    return std::move(decoded);
+  }
+
+  void mergeChunk(TcrDecodedChunk& chunk,
+                  uint8_t isLastChunkWithSecurity) override {
+    m_values.push_back(static_cast<DecodedInt&>(chunk).m_value);
+  }
+
+ private:
+  bool m_decodeAhead;
+};
+
+TcrChunkedContext* makeChunk(IntResult& result, int32_t value) {
+  uint8_t* bytes = new uint8_t[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  return new TcrChunkedContext(bytes, sizeof(value), &result, 0, nullptr);
+}
+
+// processes the chunks of a reply on several threads, as the chunk
+// processors of a pool do
+void processChunks(IntResult& result, const std::vector<int32_t>& values) {
+  Queue<TcrChunkedContext> chunks(false);
+  ACE_Semaphore finalizeSema(0);
+  result.startChunks();
+  result.setFinalizeSemaphore(&finalizeSema);
+  for (auto value : values) {
+    chunks.put(makeChunk(result, value));
+  }
+  chunks.put(new TcrChunkedContext(nullptr, 0, &result, 0, nullptr));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&chunks] {
+      while (TcrChunkedContext* chunk = chunks.get()) {
+        chunk->handleChunk(false);
+      }
+    });
+  }
+  result.waitFinalize();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+std::vector<int32_t> sequence(int32_t count) {
+  std::vector<int32_t> values;
+  for (int32_t i = 0; i < count; i++) {
+    values.push_back(i);
+  }
+  return values;
+}
+
+TEST(TcrChunkedContextTest, MergesDecodedChunksInOrder) {
+  IntResult result(true);
+  auto values = sequence(1000);
+  processChunks(result, values);
+  EXPECT_EQ(values, result.m_values);
+  EXPECT_FALSE(result.exceptionOccurred());
+
+  // the next reply starts a new sequence
+  processChunks(result, values);
+  EXPECT_EQ(2000u, result.m_values.size());
+}
+
+TEST(TcrChunkedContextTest, HandlesChunksInOrder) {
+  IntResult result(false);
+  auto values = sequence(1000);
+  processChunks(result, values);
+  EXPECT_EQ(values, result.m_values);
+}
+
+TEST(TcrChunkedContextTest, StopsAtFirstException) {
+  IntResult result(false);
+  auto values = sequence(100);
+  values[50] = -1;
+  processChunks(result, values);
+  EXPECT_TRUE(result.exceptionOccurred());
+  EXPECT_EQ(sequence(50), result.m_values);
+}
+
+TEST(TcrChunkedContextTest, HandlesChunksInSameThread) {
+  IntResult result(true);
+  ACE_Semaphore finalizeSema(0);
+  result.startChunks();
+  result.setFinalizeSemaphore(&finalizeSema);
+  makeChunk(result, 1)->handleChunk(true);
+  makeChunk(result, 2)->handleChunk(true);
+  (new TcrChunkedContext(nullptr, 0, &result, 0, nullptr))->handleChunk(true);
+  result.waitFinalize();
+  EXPECT_EQ(std::vector<int32_t>({1, 2}), result.m_values);
+}
+
+TEST(TcrChunkedContextTest, DropsChunksLeftWaiting) {
+  std::unique_ptr<IntResult> result(new IntResult(true));
+  result->startChunks();
+  // the first chunk is dropped, as when the chunk processors stop
+  std::unique_ptr<TcrChunkedContext> dropped(makeChunk(*result, 1));
+  makeChunk(*result, 2)->handleChunk(false);
+  EXPECT_TRUE(result->m_values.empty());
+  // the second chunk waits for the first and goes with the result
+  result.reset();
+}
+}  // namespace
@@ -0,0 +1,422 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <geode/ExceptionTypes.hpp>
+
+#include <SerializationRegistry.hpp>
+#include <TcrMessage.hpp>
+#include <TcrPipelinedConnection.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+class DataOutputUnderTest : public DataOutput {
+ public:
+  using DataOutput::DataOutput;
+
+ protected:
+  virtual const SerializationRegistry& getSerializationRegistry()
+      const override {
+    return m_serializationRegistry;
+  }
+
+ private:
+  SerializationRegistry m_serializationRegistry;
+};
+
+// a pipelined connection whose replies are queued by the test, and read
+// when it calls readReply()
+class TestPipelinedConnection : public TcrPipelinedConnection {
+ public:
+  explicit TestPipelinedConnection(int maxRequests,
+                                   TcrEndpoint* endpoint = nullptr)
+      : TcrPipelinedConnection(endpoint, "server", maxRequests),
+        m_sent(0),
+        m_sendFails(false),
+        m_readFails(false),
+        m_blockSends(false),
+        m_sendBlocked(false) {}
+
+  int readReply() {
+    volatile bool isRunning = true;
+    return TcrPipelinedConnection::readReply(isRunning);
+  }
+
+  // queues a reply with the transaction id, its body the marker
+  void addReply(int32_t transId, char marker) {
+    std::string reply(18, '\0');
+    for (int i = 0; i < 4; i++) {
+      reply[12 + i] = static_cast<char>(transId >> (24 - 8 * i));
+    }
+    reply[17] = marker;
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_replies.push_back(reply);
+  }
+
+  void failSends() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_sendFails = true;
+  }
+
+  void failReads() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_readFails = true;
+  }
+
+  // holds up the writes until releaseSends()
+  void blockSends() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_blockSends = true;
+  }
+
+  void waitForBlockedSend() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [this] { return m_sendBlocked; });
+  }
+
+  void releaseSends() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_blockSends = false;
+    m_cond.notify_all();
+  }
+
+  // the thread of each write and the number of requests it wrote
+  std::vector<std::pair<std::thread::id, size_t>> writes() {
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_writes;
+  }
+
+  // waits until the given number of requests have been written
+  void waitForSent(size_t count) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [this, count] { return m_sent >= count; });
+  }
+
+  // the marker of the reply handed to the request
+  char replyTo(const TcrMessage& request) {
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto iter = m_received.find(&request);
+    return iter == m_received.end() ? '\0' : iter->second;
+  }
+
+ protected:
+  void send(const std::vector<const TcrMessage*>& requests,
+            uint32_t timeout) override {
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (m_blockSends) {
+      m_sendBlocked = true;
+      m_cond.notify_all();
+      m_cond.wait(lock, [this] { return !m_blockSends; });
+    }
+    if (m_sendFails) {
+      throw GeodeIOException("the write failed");
+    }
+    m_writes.push_back(
+        std::make_pair(std::this_thread::get_id(), requests.size()));
+    m_sent += requests.size();
+    m_cond.notify_all();
+  }
+
+  char* receive(size_t* length, ConnErrType* opErr) override {
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_readFails) {
+      *opErr = CONN_IOERR;
+      return nullptr;
+    }
+    if (m_replies.empty()) {
+      return nullptr;
+    }
+    std::string reply = m_replies.front();
+    m_replies.pop_front();
+    char* data = new char[reply.size()];
+    std::memcpy(data, reply.data(), reply.size());
+    *length = reply.size();
+    return data;
+  }
+
+  GfErrType setReply(const TcrMessage& request, TcrMessageReply& reply,
+                     char* data, size_t length) override {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_received[&request] = data[length - 1];
+    delete[] data;
+    return GF_NOERR;
+  }
+
+ private:
+  std::mutex m_lock;
+  std::condition_variable m_cond;
+  std::deque<std::string> m_replies;
+  std::map<const TcrMessage*, char> m_received;
+  std::vector<std::pair<std::thread::id, size_t>> m_writes;
+  size_t m_sent;
+  bool m_sendFails;
+  bool m_readFails;
+  bool m_blockSends;
+  bool m_sendBlocked;
+};
+
+// a request sent on a thread of its own
+class Request {
+ public:
+  explicit Request(uint32_t timeout = 10)
+      : m_message(std::unique_ptr<DataOutputUnderTest>(
+                      new DataOutputUnderTest()),
+                  nullptr, nullptr, -1, nullptr),
+        m_reply(true, nullptr),
+        m_error(GF_NOERR) {
+    m_reply.setTimeout(timeout);
+  }
+
+  void send(TestPipelinedConnection& connection) {
+    ASSERT_TRUE(connection.reserve());
+    m_thread = std::thread([this, &connection] {
+      m_error = connection.sendRequest(m_message, m_reply);
+    });
+  }
+
+  GfErrType join() {
+    m_thread.join();
+    return m_error;
+  }
+
+  const TcrMessage& message() const { return m_message; }
+
+  int32_t transId() const { return m_message.getTransId(); }
+
+  std::thread::id threadId() const { return m_thread.get_id(); }
+
+ private:
+  TcrMessageDestroyRegion m_message;
+  TcrMessageReply m_reply;
+  GfErrType m_error;
+  std::thread m_thread;
+};
+
+// the endpoints of the connections are only compared
+char g_endpoints[3];
+
+TcrEndpoint* endpoint(int index) {
+  return reinterpret_cast<TcrEndpoint*>(&g_endpoints[index]);
+}
+
+std::shared_ptr<TestPipelinedConnection> brokenConnection(TcrEndpoint* ep) {
+  auto connection = std::make_shared<TestPipelinedConnection>(4, ep);
+  connection->failReads();
+  connection->readReply();
+  return connection;
+}
+
+}  // namespace
+
+TEST(TcrPipelinedConnectionTest, RepliesMatchRequestsInOrder) {
+  TestPipelinedConnection connection(4);
+  Request first;
+  Request second;
+  first.send(connection);
+  connection.waitForSent(1);
+  second.send(connection);
+  connection.waitForSent(2);
+
+  connection.addReply(first.transId(), 'a');
+  connection.addReply(second.transId(), 'b');
+  EXPECT_EQ(0, connection.readReply());
+  EXPECT_EQ(0, connection.readReply());
+
+  EXPECT_EQ(GF_NOERR, first.join());
+  EXPECT_EQ(GF_NOERR, second.join());
+  EXPECT_EQ('a', connection.replyTo(first.message()));
+  EXPECT_EQ('b', connection.replyTo(second.message()));
+  EXPECT_FALSE(connection.isBroken());
+}
+
+TEST(TcrPipelinedConnectionTest, MismatchedTransactionIdBreaksConnection) {
+  TestPipelinedConnection connection(4);
+  Request first;
+  Request second;
+  first.send(connection);
+  connection.waitForSent(1);
+  second.send(connection);
+  connection.waitForSent(2);
+
+  connection.addReply(first.transId() + 1, 'a');
+  EXPECT_EQ(-1, connection.readReply());
+
+  EXPECT_EQ(GF_NOTCON, first.join());
+  EXPECT_EQ(GF_NOTCON, second.join());
+  EXPECT_TRUE(connection.isBroken());
+  EXPECT_FALSE(connection.reserve());
+}
+
+TEST(TcrPipelinedConnectionTest, ReadFailureFailsOutstandingRequests) {
+  TestPipelinedConnection connection(4);
+  Request first;
+  Request second;
+  first.send(connection);
+  second.send(connection);
+  connection.waitForSent(2);
+
+  connection.failReads();
+  EXPECT_EQ(-1, connection.readReply());
+
+  EXPECT_EQ(GF_IOERR, first.join());
+  EXPECT_EQ(GF_IOERR, second.join());
+  EXPECT_TRUE(connection.isBroken());
+  EXPECT_FALSE(connection.reserve());
+}
+
+TEST(TcrPipelinedConnectionTest, WriteFailureFailsRequest) {
+  TestPipelinedConnection connection(4);
+  connection.failSends();
+  Request request;
+  request.send(connection);
+
+  EXPECT_EQ(GF_IOERR, request.join());
+  EXPECT_TRUE(connection.isBroken());
+}
+
+TEST(TcrPipelinedConnectionTest, TimedOutRequestKeepsOrderOfReplies) {
+  TestPipelinedConnection connection(4);
+  Request abandoned(1);
+  abandoned.send(connection);
+  connection.waitForSent(1);
+  EXPECT_EQ(GF_TIMOUT, abandoned.join());
+
+  Request next;
+  next.send(connection);
+  connection.waitForSent(2);
+  // the late reply to the abandoned request is dropped
+  connection.addReply(abandoned.transId(), 'a');
+  connection.addReply(next.transId(), 'b');
+  EXPECT_EQ(0, connection.readReply());
+  EXPECT_EQ(0, connection.readReply());
+
+  EXPECT_EQ(GF_NOERR, next.join());
+  EXPECT_EQ('b', connection.replyTo(next.message()));
+  EXPECT_EQ('\0', connection.replyTo(abandoned.message()));
+  EXPECT_FALSE(connection.isBroken());
+}
+
+TEST(TcrPipelinedConnectionTest, WriterHandsOverAfterItsOwnRequest) {
+  TestPipelinedConnection connection(4);
+  connection.blockSends();
+  Request first;
+  Request second;
+  Request third;
+  first.send(connection);
+  connection.waitForBlockedSend();
+  second.send(connection);
+  third.send(connection);
+  // lets the other two queue up behind the write of the first
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  connection.releaseSends();
+  connection.waitForSent(3);
+
+  auto writes = connection.writes();
+  ASSERT_EQ(2u, writes.size());
+  EXPECT_EQ(first.threadId(), writes[0].first);
+  EXPECT_EQ(1u, writes[0].second);
+  EXPECT_NE(first.threadId(), writes[1].first);
+  EXPECT_EQ(2u, writes[1].second);
+
+  connection.addReply(first.transId(), 'a');
+  EXPECT_EQ(0, connection.readReply());
+  EXPECT_EQ(GF_NOERR, first.join());
+  connection.addReply(second.transId(), 'b');
+  connection.addReply(third.transId(), 'c');
+  EXPECT_EQ(0, connection.readReply());
+  EXPECT_EQ(0, connection.readReply());
+  EXPECT_EQ(GF_NOERR, second.join());
+  EXPECT_EQ(GF_NOERR, third.join());
+}
+
+TEST(TcrPipelinedConnectionTest, ReserveStopsAtMaxRequests) {
+  TestPipelinedConnection connection(2);
+  EXPECT_TRUE(connection.reserve());
+  EXPECT_TRUE(connection.reserve());
+  EXPECT_FALSE(connection.reserve());
+}
+
+TEST(TcrPipelinedConnectionsTest, FindDropsBrokenConnection) {
+  TcrPipelinedConnections connections;
+  auto healthy = std::make_shared<TestPipelinedConnection>(4, endpoint(0));
+  connections.add(healthy);
+  connections.add(brokenConnection(endpoint(1)));
+  EXPECT_EQ(2u, connections.size());
+
+  EXPECT_EQ(healthy, connections.find(endpoint(0)));
+  EXPECT_EQ(nullptr, connections.find(endpoint(1)));
+  EXPECT_EQ(1u, connections.size());
+}
+
+TEST(TcrPipelinedConnectionsTest, AddReplacesBrokenAndKeepsHealthy) {
+  TcrPipelinedConnections connections;
+  auto first = std::make_shared<TestPipelinedConnection>(4, endpoint(0));
+  EXPECT_EQ(first, connections.add(first));
+  // another thread connected to the same endpoint meanwhile
+  auto second = std::make_shared<TestPipelinedConnection>(4, endpoint(0));
+  EXPECT_EQ(first, connections.add(second));
+
+  auto broken = brokenConnection(endpoint(1));
+  connections.add(broken);
+  auto replacement = std::make_shared<TestPipelinedConnection>(4, endpoint(1));
+  EXPECT_EQ(replacement, connections.add(replacement));
+  EXPECT_EQ(2u, connections.size());
+}
+
+TEST(TcrPipelinedConnectionsTest, RemoveDropsConnectionsOfEndpoint) {
+  TcrPipelinedConnections connections;
+  for (int i = 0; i < 3; i++) {
+    connections.add(std::make_shared<TestPipelinedConnection>(4, endpoint(i)));
+  }
+  connections.remove(endpoint(1));
+  EXPECT_EQ(2u, connections.size());
+  EXPECT_EQ(nullptr, connections.find(endpoint(1)));
+  EXPECT_NE(nullptr, connections.find(endpoint(2)));
+
+  connections.remove(nullptr);
+  EXPECT_EQ(0u, connections.size());
+}
+
+TEST(TcrPipelinedConnectionsTest, ReserveAnySkipsExcludedAndFull) {
+  TcrPipelinedConnections connections;
+  auto excluded = std::make_shared<TestPipelinedConnection>(4, endpoint(0));
+  auto full = std::make_shared<TestPipelinedConnection>(1, endpoint(1));
+  auto free = std::make_shared<TestPipelinedConnection>(1, endpoint(2));
+  connections.add(excluded);
+  connections.add(full);
+  connections.add(free);
+  ASSERT_TRUE(full->reserve());
+
+  auto isExcluded = [](TcrEndpoint* ep) { return ep == endpoint(0); };
+  EXPECT_EQ(free, connections.reserveAny(isExcluded));
+  EXPECT_EQ(nullptr, connections.reserveAny(isExcluded));
+}
@@ -0,0 +1,193 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <TimingWheel.hpp>
+
+using namespace apache::geode::client;
+
+namespace {
+
+const uint64_t START = 1500000000;
+
+class RecordingHandler : public ACE_Event_Handler {
+ public:
+  RecordingHandler(std::vector<long>& expiries, int& deleted, int& closed)
+      : m_expiries(expiries),
+        m_deleted(deleted),
+        m_closed(closed),
+        m_timingWheel(nullptr),
+        m_id(-1),
+        m_reset(0) {}
+
+  ~RecordingHandler() { m_deleted++; }
+
+  int handle_timeout(const ACE_Time_Value& current_time, const void* arg) {
+    m_expiries.push_back(current_time.sec());
+    if (m_timingWheel != nullptr) {
+      m_timingWheel->resetInterval(m_id, m_reset);
+      m_reset = 0;
+    }
+    return 0;
+  }
+
+  int handle_close(ACE_HANDLE, ACE_Reactor_Mask) {
+    m_closed++;
+    return 0;
+  }
+
+  void resetOnTimeout(TimingWheel* timingWheel, long id, uint32_t interval) {
+    m_timingWheel = timingWheel;
+    m_id = id;
+    m_reset = interval;
+  }
+
+ private:
+  std::vector<long>& m_expiries;
+  int& m_deleted;
+  int& m_closed;
+  TimingWheel* m_timingWheel;
+  long m_id;
+  uint32_t m_reset;
+};
+
+class TimingWheelTest : public ::testing::Test {
+ protected:
+  TimingWheelTest() : m_deleted(0), m_closed(0) {}
+
+  RecordingHandler* newHandler() {
+    return new RecordingHandler(m_expiries, m_deleted, m_closed);
+  }
+
+  void expireEachSecond(TimingWheel& timingWheel, uint64_t from,
+                        uint64_t to) {
+    for (uint64_t now = from; now <= to; now++) {
+      timingWheel.expire(ACE_Time_Value(static_cast<time_t>(now)));
+    }
+  }
+
+  std::vector<long> m_expiries;
+  int m_deleted;
+  int m_closed;
+};
+}  // namespace
+
+TEST_F(TimingWheelTest, ExpiresInTheSecondDue) {
+  TimingWheel timingWheel(START);
+  // on the first wheel, on the second, and on the third
+  for (uint64_t delay : {0, 1, 255, 256, 5000, 16383, 16384, 100000}) {
+    timingWheel.schedule(newHandler(), nullptr, START + delay, 0);
+  }
+  EXPECT_EQ(8u, timingWheel.size());
+
+  expireEachSecond(timingWheel, START, START + 100000);
+  std::vector<long> expected;
+  for (uint64_t delay : {0, 1, 255, 256, 5000, 16383, 16384, 100000}) {
+    expected.push_back(static_cast<long>(START + delay));
+  }
+  EXPECT_EQ(expected, m_expiries);
+  EXPECT_EQ(0u, timingWheel.size());
+  EXPECT_EQ(8, m_deleted);
+  EXPECT_EQ(0, m_closed);
+}
+
+TEST_F(TimingWheelTest, ExpiresOverdueTimersAtOnce) {
+  TimingWheel timingWheel(START);
+  timingWheel.schedule(newHandler(), nullptr, START + 10, 0);
+  timingWheel.schedule(newHandler(), nullptr, START + 20000, 0);
+  timingWheel.schedule(newHandler(), nullptr, START + 30000, 0);
+
+  EXPECT_EQ(2u, timingWheel.expire(ACE_Time_Value(START + 25000)));
+  EXPECT_EQ(1u, timingWheel.size());
+  EXPECT_EQ(1u, timingWheel.expire(ACE_Time_Value(START + 30000)));
+  EXPECT_EQ(0u, timingWheel.size());
+}
+
+TEST_F(TimingWheelTest, CancelCallsHandleClose) {
+  TimingWheel timingWheel(START);
+  RecordingHandler* handler = newHandler();
+  TimingWheel::id_type id =
+      timingWheel.schedule(handler, nullptr, START + 1000, 0);
+  EXPECT_TRUE(TimingWheel::isTimingWheelId(id));
+
+  EXPECT_EQ(1, timingWheel.cancel(id));
+  EXPECT_EQ(0, timingWheel.cancel(id));
+  EXPECT_EQ(1, m_closed);
+  EXPECT_EQ(0u, timingWheel.size());
+
+  expireEachSecond(timingWheel, START, START + 2000);
+  EXPECT_TRUE(m_expiries.empty());
+  // the handler is left to the caller
+  EXPECT_EQ(0, m_deleted);
+  delete handler;
+}
+
+TEST_F(TimingWheelTest, ResetFromTimeoutReschedules) {
+  TimingWheel timingWheel(START);
+  RecordingHandler* handler = newHandler();
+  TimingWheel::id_type id =
+      timingWheel.schedule(handler, nullptr, START + 10, 0);
+  handler->resetOnTimeout(&timingWheel, id, 300);
+
+  expireEachSecond(timingWheel, START, START + 1000);
+  EXPECT_EQ(std::vector<long>({static_cast<long>(START + 10),
+                               static_cast<long>(START + 310)}),
+            m_expiries);
+  EXPECT_EQ(1, m_deleted);
+}
+
+TEST_F(TimingWheelTest, IntervalRepeats) {
+  TimingWheel timingWheel(START);
+  TimingWheel::id_type id =
+      timingWheel.schedule(newHandler(), nullptr, START + 1, 2);
+
+  expireEachSecond(timingWheel, START, START + 6);
+  EXPECT_EQ(std::vector<long>({static_cast<long>(START + 1),
+                               static_cast<long>(START + 3),
+                               static_cast<long>(START + 5)}),
+            m_expiries);
+  EXPECT_EQ(0, timingWheel.resetInterval(id, 0));
+  expireEachSecond(timingWheel, START + 7, START + 7);
+  EXPECT_EQ(4u, m_expiries.size());
+  EXPECT_EQ(0u, timingWheel.size());
+  EXPECT_EQ(-1, timingWheel.resetInterval(id, 1));
+}
+
+TEST_F(TimingWheelTest, ReusesCancelledTimers) {
+  TimingWheel timingWheel(START);
+  std::vector<RecordingHandler*> handlers;
+  for (int i = 0; i < 1000; i++) {
+    handlers.push_back(newHandler());
+    TimingWheel::id_type id =
+        timingWheel.schedule(handlers.back(), nullptr, START + 1 + i, 0);
+    if (i % 2 == 0) {
+      timingWheel.cancel(id, true);
+    }
+  }
+  EXPECT_EQ(500u, timingWheel.size());
+  EXPECT_EQ(0, m_closed);
+
+  expireEachSecond(timingWheel, START, START + 1000);
+  EXPECT_EQ(500u, m_expiries.size());
+  EXPECT_EQ(500, m_deleted);
+  for (int i = 0; i < 1000; i += 2) {
+    delete handlers[i];
+  }
+}
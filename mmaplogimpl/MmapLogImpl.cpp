@@ -0,0 +1,425 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <geode/Region.hpp>
+#include <geode/Cache.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <ace/OS_NS_fcntl.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
+#include "MmapLogImpl.hpp"
+
+namespace {
+std::string g_default_persistence_directory = "GeodeRegionData";
+uint32_t g_default_segment_size = 64 * 1024 * 1024;
+uint32_t g_default_compaction_threshold = 50;
+
+// crc, key length and value length
+const uint32_t RECORD_HEADER_SIZE = 12;
+// the compactor lets writers in after copying this many records
+const int COMPACTION_RECORDS_PER_LOCK = 64;
+
+uint32_t crc32(const uint8_t* data, size_t length) {
+  static const std::vector<uint32_t> table = [] {
+    std::vector<uint32_t> crcs(256);
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+      }
+      crcs[i] = crc;
+    }
+    return crcs;
+  }();
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+uint32_t readUInt32(const uint8_t* data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void writeUInt32(uint8_t* data, uint32_t value) {
+  memcpy(data, &value, sizeof(value));
+}
+
+// Creates the file with its blocks allocated. A file extended sparsely, as
+// ACE_Mem_Map does, raises SIGBUS on a write to its mapping once the disk is
+// full instead of failing here.
+bool createReserved(const char* fileName, uint32_t size) {
+  ACE_HANDLE handle = ACE_OS::open(fileName, O_RDWR | O_CREAT | O_TRUNC,
+                                   ACE_DEFAULT_FILE_PERMS);
+  if (handle == ACE_INVALID_HANDLE) {
+    return false;
+  }
+#if defined(_WIN32)
+  // extending a file on Windows allocates it
+  bool reserved = ACE_OS::ftruncate(handle, size) == 0;
+#elif defined(__APPLE__)
+  fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0,
+                    static_cast<off_t>(size), 0};
+  bool reserved = fcntl(handle, F_PREALLOCATE, &store) != -1 &&
+                  ACE_OS::ftruncate(handle, size) == 0;
+#else
+  bool reserved = posix_fallocate(handle, 0, size) == 0;
+#endif
+  ACE_OS::close(handle);
+  return reserved;
+}
+
+std::string recordKey(const uint8_t* record) {
+  return std::string(reinterpret_cast<const char*>(record) + RECORD_HEADER_SIZE,
+                     readUInt32(record + 4));
+}
+}  // namespace
+
+using namespace apache::geode::client;
+
+MmapLogImpl::MmapLogImpl()
+    : m_segmentSize(g_default_segment_size),
+      m_compactionThreshold(g_default_compaction_threshold),
+      m_activeSegment(0),
+      m_nextSegment(1),
+      m_stopCompactor(false) {}
+
+MmapLogImpl::~MmapLogImpl() {
+  LOGDEBUG("MmapLogImpl::~MmapLogImpl calling  ~MmapLogImpl");
+  stopCompactor();
+}
+
+void MmapLogImpl::init(const RegionPtr& region,
+                       PropertiesPtr& diskProperties) {
+  m_regionPtr = region;
+  m_regionName = region->getName();
+  m_persistenceDir = g_default_persistence_directory;
+  if (diskProperties != nullptr) {
+    CacheableStringPtr persDir = diskProperties->find(PERSISTENCE_DIR);
+    CacheableStringPtr segmentSizePtr = diskProperties->find(SEGMENT_SIZE);
+    CacheableStringPtr compactionThresholdPtr =
+        diskProperties->find(COMPACTION_THRESHOLD);
+
+    if (persDir != nullptr) m_persistenceDir = persDir->asChar();
+
+    if (segmentSizePtr != nullptr) {
+      m_segmentSize = atoi(segmentSizePtr->asChar());
+    }
+
+    if (compactionThresholdPtr != nullptr) {
+      m_compactionThreshold = atoi(compactionThresholdPtr->asChar());
+    }
+  }
+  if (m_segmentSize == 0) {
+    throw InitFailedException("Overflow log segment size must be positive.");
+  }
+
+  // Create persistence and region directory
+  LOGFINE("MmapLogImpl::init creating persistence directory: %s",
+          m_persistenceDir.c_str());
+  ACE_OS::mkdir(m_persistenceDir.c_str());
+  m_regionDir = m_persistenceDir + "/" + m_regionName;
+  ACE_OS::mkdir(m_regionDir.c_str());
+  ACE_stat dirStat;
+  if (ACE_OS::stat(m_regionDir.c_str(), &dirStat) != 0) {
+    throw InitFailedException(
+        "Failed to create the region directory of the overflow log.");
+  }
+
+  m_compactor = std::thread(&MmapLogImpl::compact, this);
+}
+
+void MmapLogImpl::write(const CacheableKeyPtr& key, const CacheablePtr& value,
+                        void*& dbHandle) {
+  // Serialize key and value.
+  auto* cache = m_regionPtr->getCache().get();
+  auto keyDataBuffer = cache->createDataOutput();
+  auto valueDataBuffer = cache->createDataOutput();
+  uint32_t keyBufferSize, valueBufferSize;
+
+  keyDataBuffer->writeObject(key);
+  valueDataBuffer->writeObject(value);
+  const uint8_t* keyData = keyDataBuffer->getBuffer(&keyBufferSize);
+  const uint8_t* valueData = valueDataBuffer->getBuffer(&valueBufferSize);
+
+  std::vector<uint8_t> record(RECORD_HEADER_SIZE + keyBufferSize +
+                              valueBufferSize);
+  writeUInt32(&record[4], keyBufferSize);
+  writeUInt32(&record[8], valueBufferSize);
+  memcpy(&record[RECORD_HEADER_SIZE], keyData, keyBufferSize);
+  memcpy(&record[RECORD_HEADER_SIZE + keyBufferSize], valueData,
+         valueBufferSize);
+  writeUInt32(&record[0], crc32(&record[4], record.size() - 4));
+
+  std::string keyBytes(reinterpret_cast<const char*>(keyData), keyBufferSize);
+  std::lock_guard<std::mutex> guard(m_lock);
+  Location location =
+      append(record.data(), static_cast<uint32_t>(record.size()));
+  auto inserted = m_index.insert(std::make_pair(keyBytes, location));
+  if (!inserted.second) {
+    release(inserted.first->second);
+    inserted.first->second = location;
+  }
+}
+
+bool MmapLogImpl::writeAll() { return true; }
+
+CacheablePtr MmapLogImpl::read(const CacheableKeyPtr& key, void*& dbHandle) {
+  // Serialize key.
+  auto keyDataBuffer = m_regionPtr->getCache()->createDataOutput();
+  uint32_t keyBufferSize;
+  keyDataBuffer->writeObject(key);
+  const uint8_t* keyData = keyDataBuffer->getBuffer(&keyBufferSize);
+
+  std::vector<uint8_t> record;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto iter = m_index.find(
+        std::string(reinterpret_cast<const char*>(keyData), keyBufferSize));
+    if (iter == m_index.end()) {
+      throw IllegalStateException("Failed to read the value from the log.");
+    }
+    const Location& location = iter->second;
+    const uint8_t* data =
+        m_segments[location.m_segment]->m_data + location.m_offset;
+    record.assign(data, data + location.m_length);
+  }
+
+  if (readUInt32(&record[0]) != crc32(&record[4], record.size() - 4)) {
+    LOGERROR("MmapLogImpl::read CRC mismatch in overflow log of region %s",
+             m_regionName.c_str());
+    throw DiskCorruptException("Overflow log record failed its CRC check.");
+  }
+
+  // Deserialize object and return value.
+  uint32_t valueOffset = RECORD_HEADER_SIZE + readUInt32(&record[4]);
+  auto valueDataBuffer = m_regionPtr->getCache()->createDataInput(
+      &record[valueOffset], readUInt32(&record[8]));
+  CacheablePtr retValue;
+  valueDataBuffer->readObject(retValue);
+  return retValue;
+}
+
+bool MmapLogImpl::readAll() { return true; }
+
+void MmapLogImpl::destroy(const CacheableKeyPtr& key, void*& dbHandle) {
+  // Serialize key.
+  auto keyDataBuffer = m_regionPtr->getCache()->createDataOutput();
+  uint32_t keyBufferSize;
+  keyDataBuffer->writeObject(key);
+  const uint8_t* keyData = keyDataBuffer->getBuffer(&keyBufferSize);
+
+  std::lock_guard<std::mutex> guard(m_lock);
+  auto iter = m_index.find(
+      std::string(reinterpret_cast<const char*>(keyData), keyBufferSize));
+  if (iter != m_index.end()) {
+    release(iter->second);
+    m_index.erase(iter);
+  }
+}
+
+void MmapLogImpl::destroyRegion() {
+  stopCompactor();
+  std::lock_guard<std::mutex> guard(m_lock);
+  removeSegments();
+}
+
+void MmapLogImpl::close() {
+  stopCompactor();
+  std::lock_guard<std::mutex> guard(m_lock);
+  removeSegments();
+}
+
+MmapLogImpl::Location MmapLogImpl::append(const uint8_t* record,
+                                          uint32_t length) {
+  Segment* segment = nullptr;
+  if (m_activeSegment != 0) {
+    segment = m_segments[m_activeSegment].get();
+    if (segment->m_size - segment->m_used < length) {
+      // full, the compactor may take it now
+      if (needsCompaction(*segment)) {
+        m_compactCond.notify_one();
+      }
+      segment = nullptr;
+    }
+  }
+  if (segment == nullptr) {
+    uint32_t id = m_nextSegment++;
+    char fileName[512];
+    ACE_OS::snprintf(fileName, 512, "%s/%s_%u.log", m_regionDir.c_str(),
+                     m_regionName.c_str(), id);
+    std::unique_ptr<Segment> created(new Segment());
+    created->m_size = std::max(m_segmentSize, length);
+    created->m_used = 0;
+    created->m_liveBytes = 0;
+    if (!createReserved(fileName, created->m_size)) {
+      LOGERROR(
+          "MmapLogImpl failed to reserve %u bytes for overflow log file %s",
+          created->m_size, fileName);
+      ACE_OS::unlink(fileName);
+      throw IllegalStateException(
+          "Failed to reserve the disk space of an overflow log file.");
+    }
+    if (created->m_map.map(fileName, created->m_size, O_RDWR,
+                           ACE_DEFAULT_FILE_PERMS, PROT_RDWR,
+                           ACE_MAP_SHARED) == -1) {
+      LOGERROR("MmapLogImpl failed to map overflow log file %s", fileName);
+      throw IllegalStateException("Failed to create an overflow log file.");
+    }
+    LOGFINE("MmapLogImpl created overflow log file %s", fileName);
+    created->m_data = static_cast<uint8_t*>(created->m_map.addr());
+    segment = created.get();
+    m_segments[id] = std::move(created);
+    m_activeSegment = id;
+  }
+
+  Location location;
+  location.m_segment = m_activeSegment;
+  location.m_offset = segment->m_used;
+  location.m_length = length;
+  memcpy(segment->m_data + segment->m_used, record, length);
+  segment->m_used += length;
+  segment->m_liveBytes += length;
+  return location;
+}
+
+void MmapLogImpl::release(const Location& location) {
+  Segment& segment = *m_segments[location.m_segment];
+  segment.m_liveBytes -= location.m_length;
+  if (location.m_segment != m_activeSegment && needsCompaction(segment)) {
+    m_compactCond.notify_one();
+  }
+}
+
+bool MmapLogImpl::needsCompaction(const Segment& segment) const {
+  uint64_t deadBytes = segment.m_used - segment.m_liveBytes;
+  return deadBytes > 0 &&
+         deadBytes * 100 >=
+             static_cast<uint64_t>(segment.m_used) * m_compactionThreshold;
+}
+
+void MmapLogImpl::removeSegments() {
+  for (auto& segment : m_segments) {
+    segment.second->m_map.remove();
+  }
+  m_segments.clear();
+  m_index.clear();
+  m_activeSegment = 0;
+
+  ACE_OS::rmdir(m_regionDir.c_str());
+  ACE_OS::rmdir(m_persistenceDir.c_str());
+}
+
+void MmapLogImpl::compact() {
+  // nothing must escape the thread; the records stay where they are when
+  // there is no room to copy them to
+  try {
+    compactSegments();
+  } catch (const Exception& ex) {
+    LOGERROR(
+        "MmapLogImpl stopped compacting the overflow log of region %s: %s: %s",
+        m_regionName.c_str(), ex.getName(), ex.getMessage());
+  } catch (...) {
+    LOGERROR(
+        "MmapLogImpl stopped compacting the overflow log of region %s on an "
+        "unexpected exception",
+        m_regionName.c_str());
+  }
+}
+
+void MmapLogImpl::compactSegments() {
+  std::unique_lock<std::mutex> guard(m_lock);
+  while (!m_stopCompactor) {
+    // the full segment with the most dead bytes
+    uint32_t id = 0;
+    uint32_t mostDeadBytes = 0;
+    for (const auto& segment : m_segments) {
+      uint32_t deadBytes =
+          segment.second->m_used - segment.second->m_liveBytes;
+      if (segment.first != m_activeSegment &&
+          needsCompaction(*segment.second) && deadBytes >= mostDeadBytes) {
+        id = segment.first;
+        mostDeadBytes = deadBytes;
+      }
+    }
+    if (id == 0) {
+      m_compactCond.wait(guard);
+    } else {
+      compactSegment(id, guard);
+    }
+  }
+}
+
+void MmapLogImpl::compactSegment(uint32_t id,
+                                 std::unique_lock<std::mutex>& guard) {
+  // only the compactor removes segments, so this one stays mapped while the
+  // guard is unlocked, and nothing appends to it any more
+  Segment* segment = m_segments[id].get();
+  uint32_t offset = 0;
+  int copied = 0;
+  while (offset < segment->m_used && segment->m_liveBytes > 0) {
+    if (m_stopCompactor) {
+      return;
+    }
+    const uint8_t* record = segment->m_data + offset;
+    uint32_t length =
+        RECORD_HEADER_SIZE + readUInt32(record + 4) + readUInt32(record + 8);
+    auto iter = m_index.find(recordKey(record));
+    if (iter != m_index.end() && iter->second.m_segment == id &&
+        iter->second.m_offset == offset) {
+      iter->second = append(record, length);
+      segment->m_liveBytes -= length;
+      if (++copied % COMPACTION_RECORDS_PER_LOCK == 0) {
+        guard.unlock();
+        guard.lock();
+      }
+    }
+    offset += length;
+  }
+  LOGFINE("MmapLogImpl compacted overflow log file %u of region %s", id,
+          m_regionName.c_str());
+  segment->m_map.remove();
+  m_segments.erase(id);
+}
+
+void MmapLogImpl::stopCompactor() {
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_stopCompactor = true;
+  }
+  m_compactCond.notify_all();
+  if (m_compactor.joinable()) {
+    m_compactor.join();
+  }
+}
+
+extern "C" {
+
+LIBEXP PersistenceManager* createMmapLogInstance() { return new MmapLogImpl; }
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#ifndef GEODE_MMAPLOGIMPL_MMAPLOGIMPL_H_
+#define GEODE_MMAPLOGIMPL_MMAPLOGIMPL_H_
+
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <ace/Mem_Map.h>
+
+#include <geode/PersistenceManager.hpp>
+#include <geode/GeodeCppCache.hpp>
+
+/**
+ * @file
+ */
+
+namespace apache {
+namespace geode {
+namespace client {
+
+/**
+ * @class MmapLogImpl MmapLogImpl.hpp
+ * Append-only log API for overflow.
+ * The MmapLogImpl class derives from PersistenceManager base class and
+ * stores the overflowed entries of a region in a log of memory mapped files.
+ *
+ * Each write appends a record of the serialized key and value, with a CRC32
+ * of both, to the current file of the log; an in-memory index keeps where
+ * the live record of every key is. Rewritten and destroyed entries leave
+ * dead records behind, a background thread copies the live records of a
+ * full file out of it once COMPACTION_THRESHOLD percent of its records are
+ * dead and removes the file. Nothing is read back from the files on start,
+ * they only hold the overflow of the running cache.
+ */
+class MmapLogImpl : public PersistenceManager {
+ public:
+  /**
+   * Initializes the log for the region. Settings are passed via the
+   * diskProperties argument: PERSISTENCE_DIR, SEGMENT_SIZE and
+   * COMPACTION_THRESHOLD.
+   * @throws InitFailedException if the persistence directory cannot be
+   * created.
+   */
+  void init(const RegionPtr& regionptr, PropertiesPtr& diskProperties);
+
+  /**
+   * Appends a key-value pair to the log.
+   * @param key the key to write.
+   * @param value the value to write
+   * @throws IllegalStateException if a log file cannot be created.
+   */
+  void write(const CacheableKeyPtr& key, const CacheablePtr& value,
+             void*& dbHandle);
+
+  /**
+   * The records are in the mapped files once written.
+   */
+  bool writeAll();
+
+  /**
+   * Reads the value for the key from the log.
+   * @returns value of type CacheablePtr.
+   * @param key is the key for which the value has to be read.
+   * @throws IllegalStateException if the key is not in the log.
+   * @throws DiskCorruptException if the record fails its CRC check.
+   */
+  CacheablePtr read(const CacheableKeyPtr& key, void*& dbHandle);
+
+  /**
+   * Nothing is read back from the files on start.
+   */
+  bool readAll();
+
+  /**
+   * Destroys an entry stored in the log.
+   */
+  void destroy(const CacheableKeyPtr& key, void*& dbHandle);
+
+  /**
+   * Removes the log files of the region.
+   */
+  void destroyRegion();
+
+  /**
+   * Closes the log and removes its files.
+   */
+  void close();
+
+  ~MmapLogImpl();
+
+  MmapLogImpl();
+
+ private:
+  // where the live record of a key is
+  struct Location {
+    uint32_t m_segment;
+    uint32_t m_offset;
+    uint32_t m_length;
+  };
+
+  // a file of the log
+  struct Segment {
+    ACE_Mem_Map m_map;
+    uint8_t* m_data;
+    uint32_t m_size;
+    // the bytes appended so far
+    uint32_t m_used;
+    // the bytes of the records the index points to
+    uint32_t m_liveBytes;
+  };
+
+  // by serialized key
+  typedef std::unordered_map<std::string, Location> Index;
+
+  RegionPtr m_regionPtr;
+  std::string m_regionName;
+  std::string m_regionDir;
+  std::string m_persistenceDir;
+  uint32_t m_segmentSize;
+  uint32_t m_compactionThreshold;
+
+  std::mutex m_lock;
+  Index m_index;
+  std::map<uint32_t, std::unique_ptr<Segment>> m_segments;
+  // the segment appended to, 0 before the first write
+  uint32_t m_activeSegment;
+  uint32_t m_nextSegment;
+
+  // signals the compactor that a full segment has enough dead records
+  std::condition_variable m_compactCond;
+  bool m_stopCompactor;
+  std::thread m_compactor;
+
+  // the caller holds m_lock for these
+  Location append(const uint8_t* record, uint32_t length);
+  void release(const Location& location);
+  bool needsCompaction(const Segment& segment) const;
+  void removeSegments();
+
+  // runs on the compactor thread, logs what compactSegments() throws
+  void compact();
+  void compactSegments();
+  // copies the live records out of the segment and removes it, unlocks the
+  // guard between records
+  void compactSegment(uint32_t id, std::unique_lock<std::mutex>& guard);
+  void stopCompactor();
+};
+}  // namespace client
+}  // namespace geode
+}  // namespace apache
+
+#endif  // GEODE_MMAPLOGIMPL_MMAPLOGIMPL_H_
@@ -16,6 +16,10 @@
  */
 #include "SqLiteHelper.hpp"
 #define QUERY_SIZE 512
+
+SqLiteHelper::SqLiteHelper()
+    : m_dbHandle(nullptr), m_tableName(nullptr), m_insertStmt(nullptr) {}
+
 int SqLiteHelper::initDB(const char *regionName, int maxPageCount, int pageSize,
                          const char *regionDBfile, int busy_timeout_ms) {
   LOGDEBUG(
@@ -67,24 +71,28 @@ int SqLiteHelper::createTable() {
 
 int SqLiteHelper::insertKeyValue(void *keyData, uint32_t keyDataSize,
                                  void *valueData, uint32_t valueDataSize) {
-  // construct query
-  char query[QUERY_SIZE];
-  SNPRINTF(query, QUERY_SIZE, "REPLACE INTO %s VALUES(?,?);", m_tableName);
+  int retCode = SQLITE_OK;
+  if (m_insertStmt == nullptr) {
+    // construct query
+    char query[QUERY_SIZE];
+    SNPRINTF(query, QUERY_SIZE, "REPLACE INTO %s VALUES(?,?);", m_tableName);
 
-  LOGDEBUG("SqLiteHelper::insertKeyValue Inserting key value with query:%s",
-           query);
+    LOGDEBUG("SqLiteHelper::insertKeyValue Preparing insert with query:%s",
+             query);
 
-  // prepare statement
-  sqlite3_stmt *stmt;
-  int retCode = sqlite3_prepare_v2(m_dbHandle, query, -1, &stmt, 0);
+    // prepare statement
+    retCode = sqlite3_prepare_v2(m_dbHandle, query, -1, &m_insertStmt, 0);
+  }
   if (retCode == SQLITE_OK) {
     // bind parameters and execte statement
-    sqlite3_bind_blob(stmt, 1, keyData, keyDataSize, 0);
-    sqlite3_bind_blob(stmt, 2, valueData, valueDataSize, 0);
-    retCode = sqlite3_step(stmt);
+    sqlite3_bind_blob(m_insertStmt, 1, keyData, keyDataSize, 0);
+    sqlite3_bind_blob(m_insertStmt, 2, valueData, valueDataSize, 0);
+    retCode = sqlite3_step(m_insertStmt);
+    // the blobs are not copied, release them before the caller does
+    sqlite3_reset(m_insertStmt);
+    sqlite3_clear_bindings(m_insertStmt);
   }
 
-  sqlite3_finalize(stmt);
   return retCode == SQLITE_DONE ? 0 : retCode;
 }
 
@@ -161,6 +169,8 @@ int SqLiteHelper::dropTable() {
 int SqLiteHelper::closeDB() {
   LOGDEBUG("SqLiteHelper::closeDB closing the database for region %s",
            m_tableName);
+  sqlite3_finalize(m_insertStmt);
+  m_insertStmt = nullptr;
   int retCode = dropTable();
   if (retCode == SQLITE_OK) retCode = sqlite3_close(m_dbHandle);
 
@@ -190,3 +200,26 @@ int SqLiteHelper::executePragma(const char *pragmaName, int pragmaValue) {
   sqlite3_finalize(stmt);
   return retCode == SQLITE_DONE ? 0 : retCode;
 }
+
+int SqLiteHelper::beginTransaction() { return executeStatement("BEGIN;"); }
+
+int SqLiteHelper::commitTransaction() { return executeStatement("COMMIT;"); }
+
+int SqLiteHelper::rollbackTransaction() {
+  return executeStatement("ROLLBACK;");
+}
+
+int SqLiteHelper::executeStatement(const char *query) {
+  LOGDEBUG("SqLiteHelper::executeStatement Executing query:%s", query);
+
+  // prepare statement
+  sqlite3_stmt *stmt;
+  int retCode;
+  retCode = sqlite3_prepare_v2(m_dbHandle, query, -1, &stmt, 0);
+
+  // execute statement
+  if (retCode == SQLITE_OK) retCode = sqlite3_step(stmt);
+
+  sqlite3_finalize(stmt);
+  return retCode == SQLITE_DONE ? 0 : retCode;
+}
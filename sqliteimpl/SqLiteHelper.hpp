@@ -40,6 +40,7 @@ using namespace apache::geode::client;
 
 class SqLiteHelper {
  public:
+  SqLiteHelper();
   int initDB(const char* regionName, int maxPageCount, int pageSize,
              const char* regionDBfile, int busy_timeout_ms = 5000);
   int insertKeyValue(void* keyData, uint32_t keyDataSize, void* valueData,
@@ -49,14 +50,22 @@ class SqLiteHelper {
                uint32_t& valueDataSize);
   int closeDB();
 
+  // the statements between begin and commit are written to disk at once
+  int beginTransaction();
+  int commitTransaction();
+  int rollbackTransaction();
+
  private:
   sqlite3* m_dbHandle;
+  // prepared once, insertKeyValue is called for every overflowed entry
+  sqlite3_stmt* m_insertStmt;
 
   const char* m_tableName;
   // std::string regionName;
   int dropTable();
   int createTable();
   int executePragma(const char* pragmaName, int pragmaValue);
+  int executeStatement(const char* query);
 };
 
 #endif  // GEODE_SQLITEIMPL_SQLITEHELPER_H_
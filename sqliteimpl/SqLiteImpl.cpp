@@ -24,6 +24,23 @@
 
 namespace {
 std::string g_default_persistence_directory = "GeodeRegionData";
+uint32_t g_default_write_batch_size = 1000;
+uint32_t g_default_write_batch_latency_ms = 100;
+// write() waits once this many batches are queued
+uint32_t g_max_pending_batches = 4;
+// a batch that fails this many times in a row is dropped
+uint32_t g_max_batch_attempts = 3;
+
+std::string toString(const DataOutput& dataOutput) {
+  uint32_t size;
+  const uint8_t* data = dataOutput.getBuffer(&size);
+  return std::string(reinterpret_cast<const char*>(data), size);
+}
+
+std::string writeError(const char* what, int retCode) {
+  return std::string("Failed to write ") + what + " in SQLITE: error " +
+         std::to_string(retCode);
+}
 }  // namespace
 
 using namespace apache::geode::client;
@@ -33,6 +50,8 @@ void SqLiteImpl::init(const RegionPtr& region, PropertiesPtr& diskProperties) {
 
   int maxPageCount = 0;
   int pageSize = 0;
+  m_writeBatchSize = g_default_write_batch_size;
+  uint32_t writeBatchLatency = g_default_write_batch_latency_ms;
   m_regionPtr = region;
   m_persistanceDir = g_default_persistence_directory;
   std::string regionName = region->getName();
@@ -40,6 +59,10 @@ void SqLiteImpl::init(const RegionPtr& region, PropertiesPtr& diskProperties) {
     CacheableStringPtr maxPageCountPtr = diskProperties->find(MAX_PAGE_COUNT);
     CacheableStringPtr pageSizePtr = diskProperties->find(PAGE_SIZE);
     CacheableStringPtr persDir = diskProperties->find(PERSISTENCE_DIR);
+    CacheableStringPtr writeBatchSizePtr =
+        diskProperties->find(WRITE_BATCH_SIZE);
+    CacheableStringPtr writeBatchLatencyPtr =
+        diskProperties->find(WRITE_BATCH_LATENCY);
 
     if (maxPageCountPtr != nullptr) {
       maxPageCount = atoi(maxPageCountPtr->asChar());
@@ -48,7 +71,16 @@ void SqLiteImpl::init(const RegionPtr& region, PropertiesPtr& diskProperties) {
     if (pageSizePtr != nullptr) pageSize = atoi(pageSizePtr->asChar());
 
     if (persDir != nullptr) m_persistanceDir = persDir->asChar();
+
+    if (writeBatchSizePtr != nullptr) {
+      m_writeBatchSize = atoi(writeBatchSizePtr->asChar());
+    }
+
+    if (writeBatchLatencyPtr != nullptr) {
+      writeBatchLatency = atoi(writeBatchLatencyPtr->asChar());
+    }
   }
+  m_writeBatchLatency = std::chrono::milliseconds(writeBatchLatency);
 
 #ifndef _WIN32
   char currWDPath[512];
@@ -106,6 +138,12 @@ void SqLiteImpl::init(const RegionPtr& region, PropertiesPtr& diskProperties) {
                              m_regionDBFile.c_str()) != 0) {
     throw IllegalStateException("Failed to initialize database in SQLITE.");
   }
+
+  if (m_writeBatchSize > 0) {
+    LOGFINE("SqLiteImpl::init writing overflowed entries in batches of %u",
+            m_writeBatchSize);
+    m_writer = std::thread(&SqLiteImpl::writeBehind, this);
+  }
 }
 
 void SqLiteImpl::write(const CacheableKeyPtr& key, const CacheablePtr& value,
@@ -118,29 +156,203 @@ void SqLiteImpl::write(const CacheableKeyPtr& key, const CacheablePtr& value,
 
   keyDataBuffer->writeObject(key);
   valueDataBuffer->writeObject(value);
-  void* keyData = const_cast<uint8_t*>(keyDataBuffer->getBuffer(&keyBufferSize));
+
+  if (m_writeBatchSize > 0) {
+    std::unique_lock<std::mutex> guard(m_pendingLock);
+    while (!m_stopWriter && m_writeError == 0 &&
+           m_pending.size() >= m_writeBatchSize * g_max_pending_batches) {
+      m_roomCond.wait(guard);
+    }
+    if (m_writeError == 0) {
+      if (m_pending.empty()) {
+        m_oldestPending = std::chrono::steady_clock::now();
+      }
+      // a later eviction of the same key replaces the queued value
+      m_pending[toString(*keyDataBuffer)] = toString(*valueDataBuffer);
+      if (m_pending.size() == 1 || m_pending.size() == m_writeBatchSize) {
+        m_batchCond.notify_one();
+      }
+      return;
+    }
+  }
+
+  // while the batches fail the entry is written at once, so that the
+  // eviction fails with the error rather than queue up more entries
+  void* keyData =
+      const_cast<uint8_t*>(keyDataBuffer->getBuffer(&keyBufferSize));
   void* valueData =
       const_cast<uint8_t*>(valueDataBuffer->getBuffer(&valueBufferSize));
 
-  if (m_sqliteHelper->insertKeyValue(keyData, keyBufferSize, valueData,
-                                     valueBufferSize) != 0) {
-    throw IllegalStateException("Failed to write key value in SQLITE.");
+  std::lock_guard<std::mutex> dbGuard(m_dbLock);
+  if (m_writeBatchSize > 0) {
+    // a value queued before would overwrite this one
+    std::lock_guard<std::mutex> guard(m_pendingLock);
+    m_pending.erase(toString(*keyDataBuffer));
+  }
+  int retCode = m_sqliteHelper->insertKeyValue(keyData, keyBufferSize,
+                                               valueData, valueBufferSize);
+  if (retCode != 0) {
+    throw IllegalStateException(writeError("key value", retCode).c_str());
+  }
+  if (m_writeBatchSize > 0) {
+    std::lock_guard<std::mutex> guard(m_pendingLock);
+    m_writeError = 0;
+  }
+}
+
+bool SqLiteImpl::writeAll() {
+  if (m_writeBatchSize == 0) {
+    return true;
+  }
+  int retCode = writeBatch();
+  if (retCode == 0) {
+    // the entries of a batch dropped before were not written either
+    std::lock_guard<std::mutex> guard(m_pendingLock);
+    retCode = m_writeError;
+  }
+  if (retCode != 0) {
+    throw IllegalStateException(
+        writeError("overflowed entries", retCode).c_str());
+  }
+  return true;
+}
+
+void SqLiteImpl::writeBehind() {
+  std::unique_lock<std::mutex> guard(m_pendingLock);
+  while (!m_stopWriter) {
+    if (m_pending.empty()) {
+      m_batchCond.wait(guard);
+      continue;
+    }
+    if (m_pending.size() < m_writeBatchSize &&
+        m_batchCond.wait_until(guard, m_oldestPending + m_writeBatchLatency) ==
+            std::cv_status::no_timeout) {
+      continue;
+    }
+    guard.unlock();
+    if (writeBatch() != 0) {
+      // try again after a while rather than spin on a failing disk
+      std::this_thread::sleep_for(m_writeBatchLatency);
+    }
+    guard.lock();
   }
 }
 
-bool SqLiteImpl::writeAll() { return true; }
+int SqLiteImpl::writeBatch() {
+  std::lock_guard<std::mutex> dbGuard(m_dbLock);
+  {
+    std::lock_guard<std::mutex> guard(m_pendingLock);
+    if (m_pending.empty()) {
+      return 0;
+    }
+    m_writing.swap(m_pending);
+  }
+  m_roomCond.notify_all();
+
+  int retCode = m_sqliteHelper->beginTransaction();
+  for (auto iter = m_writing.begin(); retCode == 0 && iter != m_writing.end();
+       ++iter) {
+    retCode = m_sqliteHelper->insertKeyValue(
+        const_cast<char*>(iter->first.data()),
+        static_cast<uint32_t>(iter->first.size()),
+        const_cast<char*>(iter->second.data()),
+        static_cast<uint32_t>(iter->second.size()));
+  }
+  if (retCode == 0) {
+    retCode = m_sqliteHelper->commitTransaction();
+  }
+  if (retCode != 0) {
+    LOGERROR("SqLiteImpl failed to write %zd overflowed entries: %d",
+             m_writing.size(), retCode);
+    m_sqliteHelper->rollbackTransaction();
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_pendingLock);
+    m_writeError = retCode;
+    if (retCode == 0) {
+      m_failedBatches = 0;
+    } else if (++m_failedBatches < g_max_batch_attempts) {
+      if (m_pending.empty()) {
+        m_oldestPending = std::chrono::steady_clock::now();
+      }
+      // requeue the batch, except for the entries evicted again meanwhile;
+      // write() queues nothing more until a write succeeds, so the queue
+      // grows no further
+      for (auto& entry : m_writing) {
+        m_pending.insert(std::move(entry));
+      }
+    } else {
+      LOGERROR("SqLiteImpl dropped %zd overflowed entries after %u attempts",
+               m_writing.size(), m_failedBatches);
+      m_failedBatches = 0;
+    }
+    m_writing.clear();
+  }
+  if (retCode != 0) {
+    // the writers waiting for room write at once and see the error
+    m_roomCond.notify_all();
+  }
+  return retCode;
+}
+
+void SqLiteImpl::stopWriter() {
+  {
+    std::lock_guard<std::mutex> guard(m_pendingLock);
+    m_stopWriter = true;
+  }
+  m_batchCond.notify_all();
+  m_roomCond.notify_all();
+  if (m_writer.joinable()) {
+    m_writer.join();
+  }
+}
 
 CacheablePtr SqLiteImpl::read(const CacheableKeyPtr& key, void*& dbHandle) {
   // Serialize key.
   auto keyDataBuffer = m_regionPtr->getCache()->createDataOutput();
   uint32_t keyBufferSize;
   keyDataBuffer->writeObject(key);
+
+  if (m_writeBatchSize > 0) {
+    std::string pendingValue;
+    bool pending = false;
+    {
+      std::lock_guard<std::mutex> guard(m_pendingLock);
+      std::string keyBytes = toString(*keyDataBuffer);
+      auto iter = m_pending.find(keyBytes);
+      if (iter == m_pending.end()) {
+        iter = m_writing.find(keyBytes);
+        pending = iter != m_writing.end();
+      } else {
+        pending = true;
+      }
+      if (pending) {
+        pendingValue = iter->second;
+      }
+    }
+    // not queued any more means committed already
+    if (pending) {
+      auto valueDataBuffer = m_regionPtr->getCache()->createDataInput(
+          reinterpret_cast<const uint8_t*>(pendingValue.data()),
+          static_cast<int32_t>(pendingValue.size()));
+      CacheablePtr retValue;
+      valueDataBuffer->readObject(retValue);
+      return retValue;
+    }
+  }
+
   void* keyData = const_cast<uint8_t*>(keyDataBuffer->getBuffer(&keyBufferSize));
   void* valueData;
   uint32_t valueBufferSize;
 
-  if (m_sqliteHelper->getValue(keyData, keyBufferSize, valueData,
-                               valueBufferSize) != 0) {
+  int retCode;
+  {
+    std::lock_guard<std::mutex> dbGuard(m_dbLock);
+    retCode = m_sqliteHelper->getValue(keyData, keyBufferSize, valueData,
+                                       valueBufferSize);
+  }
+  if (retCode != 0) {
     throw IllegalStateException("Failed to read the value from SQLITE.");
   }
 
@@ -158,6 +370,9 @@ CacheablePtr SqLiteImpl::read(const CacheableKeyPtr& key, void*& dbHandle) {
 bool SqLiteImpl::readAll() { return true; }
 
 void SqLiteImpl::destroyRegion() {
+  // the queued entries go with the region
+  stopWriter();
+  std::lock_guard<std::mutex> dbGuard(m_dbLock);
   if (m_sqliteHelper->closeDB() != 0) {
     throw IllegalStateException("Failed to destroy region from SQLITE.");
   }
@@ -179,15 +394,31 @@ void SqLiteImpl::destroy(const CacheableKeyPtr& key, void*& dbHandle) {
   uint32_t keyBufferSize;
   keyDataBuffer->writeObject(key);
   void* keyData = const_cast<uint8_t*>(keyDataBuffer->getBuffer(&keyBufferSize));
+  // keeps a batch with the key from being written after it is removed
+  std::lock_guard<std::mutex> dbGuard(m_dbLock);
+  if (m_writeBatchSize > 0) {
+    std::lock_guard<std::mutex> guard(m_pendingLock);
+    m_pending.erase(toString(*keyDataBuffer));
+  }
   if (m_sqliteHelper->removeKey(keyData, keyBufferSize) != 0) {
     throw IllegalStateException("Failed to destroy the key from SQLITE.");
   }
 }
 
-SqLiteImpl::SqLiteImpl() { m_sqliteHelper = new SqLiteHelper(); }
+SqLiteImpl::SqLiteImpl()
+    : m_writeBatchSize(g_default_write_batch_size),
+      m_writeBatchLatency(g_default_write_batch_latency_ms),
+      m_writeError(0),
+      m_failedBatches(0),
+      m_stopWriter(false) {
+  m_sqliteHelper = new SqLiteHelper();
+}
 
 void SqLiteImpl::close() {
   int lastError ATTR_UNUSED = 0;
+  // the queued entries go with the database
+  stopWriter();
+  std::lock_guard<std::mutex> dbGuard(m_dbLock);
   m_sqliteHelper->closeDB();
 
 #ifndef _WIN32
@@ -20,6 +20,13 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
 #include "SqLiteHelper.hpp"
 
 /**
@@ -36,6 +43,11 @@ namespace client {
  * The SqLiteImpl class derives from PersistenceManager base class and
  * implements a persistent store with SqLite DB.
  *
+ * Overflowed entries are written behind: write() queues the serialized entry
+ * and a background thread writes the queue in one transaction once
+ * WRITE_BATCH_SIZE entries are queued or the oldest has waited
+ * WRITE_BATCH_LATENCY milliseconds. Reads of queued entries are served from
+ * the queue, writers wait when it grows to several batches.
  */
 
 class SqLiteImpl : public PersistenceManager {
@@ -52,17 +64,19 @@ class SqLiteImpl : public PersistenceManager {
   void init(const RegionPtr& regionptr, PropertiesPtr& diskProperties);
 
   /**
-   * Stores a key-value pair in the SqLite implementation.
+   * Stores a key-value pair in the SqLite implementation. While the queued
+   * batches fail to be written the pair is written at once instead.
    * @param key the key to write.
    * @param value the value to write
-   * @throws DiskFailureException if the write fails due to disk failure.
+   * @throws IllegalStateException if the pair could not be written.
    */
   void write(const CacheableKeyPtr& key, const CacheablePtr& value,
              void*& dbHandle);
 
   /**
-   * Writes the entire region into the SqLite implementation.
-   * @throws DiskFailureException if the write fails due to disk fail.
+   * Writes the entries queued by write() to SqLite.
+   * @throws IllegalStateException if they, or a batch queued before, could
+   * not be written.
    */
   bool writeAll();
 
@@ -118,7 +132,10 @@ class SqLiteImpl : public PersistenceManager {
   /**
    * @brief destructor
    */
-  ~SqLiteImpl() { LOGDEBUG("SqLiteImpl::~SqLiteImpl calling  ~SqLiteImpl"); }
+  ~SqLiteImpl() {
+    LOGDEBUG("SqLiteImpl::~SqLiteImpl calling  ~SqLiteImpl");
+    stopWriter();
+  }
 
   /**
    * @brief constructor
@@ -136,6 +153,36 @@ class SqLiteImpl : public PersistenceManager {
   std::string m_regionDBFile;
   std::string m_regionDir;
   std::string m_persistanceDir;
+
+  // serialized values of the overflowed entries by serialized key
+  typedef std::unordered_map<std::string, std::string> SerializedEntries;
+
+  uint32_t m_writeBatchSize;
+  std::chrono::milliseconds m_writeBatchLatency;
+
+  // held while m_sqliteHelper is used, by the writer for a whole batch
+  std::mutex m_dbLock;
+  std::mutex m_pendingLock;
+  // the writer waits for a full batch
+  std::condition_variable m_batchCond;
+  // write() waits for room in m_pending
+  std::condition_variable m_roomCond;
+  // the entries queued for the next batch
+  SerializedEntries m_pending;
+  // the batch being written, still read from until it is committed
+  SerializedEntries m_writing;
+  std::chrono::steady_clock::time_point m_oldestPending;
+  // the SQLite error the last batch failed with, 0 once a write succeeds
+  int m_writeError;
+  // the times in a row the queued entries failed to be written
+  uint32_t m_failedBatches;
+  bool m_stopWriter;
+  std::thread m_writer;
+
+  void writeBehind();
+  // writes m_pending in one transaction, returns the SQLite error if any
+  int writeBatch();
+  void stopWriter();
 };
 }  // namespace client
 }  // namespace geode